@@ -0,0 +1,269 @@
+/**
+ * @file        CArgEncoding.hpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Compact binary encoding of typed log arguments
+ * @date        2026-10-16
+ * @details     Producers append tagged values with memcpy only; text is rendered
+ *              by the consumer (text sink, DLT sink or offline decoder)
+ * @copyright   Copyright (c) 2025
+ */
+
+#ifndef LAP_LOG_ARGENCODING_HPP
+#define LAP_LOG_ARGENCODING_HPP
+
+#include <lap/core/CTypedef.hpp>
+#include <lap/core/CString.hpp>
+#include <cstring>
+#include "CCommon.hpp"
+#include "CLogStream.hpp"
+
+namespace lap
+{
+namespace log
+{
+    /**
+     * @brief Type of one encoded argument (low 6 bits of the tag byte)
+     */
+    enum class ArgType : core::UInt8
+    {
+        kNone       = 0x00,
+        kBool       = 0x01,     // 1 byte, 0 or 1
+        kUInt8      = 0x02,
+        kUInt16     = 0x03,
+        kUInt32     = 0x04,
+        kUInt64     = 0x05,
+        kInt8       = 0x06,
+        kInt16      = 0x07,
+        kInt32      = 0x08,
+        kInt64      = 0x09,
+        kFloat      = 0x0A,     // IEEE 754 binary32
+        kDouble     = 0x0B,     // IEEE 754 binary64
+        kHex8       = 0x0C,     // LogHex8..LogHex64: value bytes
+        kHex16      = 0x0D,
+        kHex32      = 0x0E,
+        kHex64      = 0x0F,
+        kBin8       = 0x10,     // LogBin8..LogBin64: value bytes, kArgGrouped flag
+        kBin16      = 0x11,
+        kBin32      = 0x12,
+        kBin64      = 0x13,
+        kString     = 0x14,     // UInt16 length + bytes (no NUL)
+        kLogLevel   = 0x15,     // 1 byte LogLevel value
+        kErrorCode  = 0x16,     // Int64 code + UInt16 domain name length + domain name bytes
+    };
+
+    constexpr core::UInt8 kArgTypeMask  = 0x3F;
+    constexpr core::UInt8 kArgGrouped   = 0x40;     // LogBin*: '_' between nibbles
+    constexpr core::UInt8 kArgNamed     = 0x80;     // UInt8 name length + name bytes follow the tag
+
+    /**
+     * @brief Append-only writer of the argument encoding
+     *
+     * Encoding of one argument (host byte order, no padding):
+     * @code
+     *   [tag:1] [nameLen:1 name:nameLen]? [value]
+     *   tag    = ArgType | kArgGrouped? | kArgNamed?
+     *   value  = 1/2/4/8 bytes for fixed size types, [len:2 bytes:len] for kString
+     * @endcode
+     *
+     * Features:
+     * - Writes into a caller owned buffer, no allocation
+     * - Fixed size values are one memcpy each; strings are copied inline
+     * - An argument that does not fit is dropped (strings are cut to fit) and
+     *   truncated() reports it; the buffer always holds whole arguments
+     */
+    class ArgEncoder final
+    {
+    public:
+        static constexpr core::Size kMaxNameSize    = 255;
+        static constexpr core::Size kMaxStringSize  = 65535;
+
+        ArgEncoder( core::UInt8* buffer, core::Size capacity ) noexcept
+            : m_buffer( buffer )
+            , m_capacity( capacity )
+        {}
+
+        inline void put( core::StringView name, core::Bool value ) noexcept         { putFixed( ArgType::kBool, 0, name, static_cast< core::UInt8 >( value ? 1 : 0 ) ); }
+        inline void put( core::StringView name, core::UInt8 value ) noexcept        { putFixed( ArgType::kUInt8, 0, name, value ); }
+        inline void put( core::StringView name, core::UInt16 value ) noexcept       { putFixed( ArgType::kUInt16, 0, name, value ); }
+        inline void put( core::StringView name, core::UInt32 value ) noexcept       { putFixed( ArgType::kUInt32, 0, name, value ); }
+        inline void put( core::StringView name, core::UInt64 value ) noexcept       { putFixed( ArgType::kUInt64, 0, name, value ); }
+        inline void put( core::StringView name, core::Int8 value ) noexcept         { putFixed( ArgType::kInt8, 0, name, value ); }
+        inline void put( core::StringView name, core::Int16 value ) noexcept        { putFixed( ArgType::kInt16, 0, name, value ); }
+        inline void put( core::StringView name, core::Int32 value ) noexcept        { putFixed( ArgType::kInt32, 0, name, value ); }
+        inline void put( core::StringView name, core::Int64 value ) noexcept        { putFixed( ArgType::kInt64, 0, name, value ); }
+        inline void put( core::StringView name, core::Float value ) noexcept        { putFixed( ArgType::kFloat, 0, name, value ); }
+        inline void put( core::StringView name, core::Double value ) noexcept       { putFixed( ArgType::kDouble, 0, name, value ); }
+        inline void put( core::StringView name, const LogHex8& value ) noexcept     { putFixed( ArgType::kHex8, 0, name, value.value ); }
+        inline void put( core::StringView name, const LogHex16& value ) noexcept    { putFixed( ArgType::kHex16, 0, name, value.value ); }
+        inline void put( core::StringView name, const LogHex32& value ) noexcept    { putFixed( ArgType::kHex32, 0, name, value.value ); }
+        inline void put( core::StringView name, const LogHex64& value ) noexcept    { putFixed( ArgType::kHex64, 0, name, value.value ); }
+        inline void put( core::StringView name, const LogBin8& value ) noexcept     { putFixed( ArgType::kBin8, groupedFlag( value.grouped ), name, value.value ); }
+        inline void put( core::StringView name, const LogBin16& value ) noexcept    { putFixed( ArgType::kBin16, groupedFlag( value.grouped ), name, value.value ); }
+        inline void put( core::StringView name, const LogBin32& value ) noexcept    { putFixed( ArgType::kBin32, groupedFlag( value.grouped ), name, value.value ); }
+        inline void put( core::StringView name, const LogBin64& value ) noexcept    { putFixed( ArgType::kBin64, groupedFlag( value.grouped ), name, value.value ); }
+        inline void put( core::StringView name, LogLevel value ) noexcept           { putFixed( ArgType::kLogLevel, 0, name, static_cast< core::UInt8 >( value ) ); }
+        inline void put( core::StringView name, const core::String& value ) noexcept { putString( name, core::StringView( value ) ); }
+        inline void put( core::StringView name, const core::Char* value ) noexcept  { putString( name, value ? core::StringView( value ) : core::StringView() ); }
+        inline void put( core::StringView name, core::StringView value ) noexcept   { putString( name, value ); }
+        void        put( core::StringView name, const core::ErrorCode& value ) noexcept;
+
+        /**
+         * @brief Append arguments encoded elsewhere (a record replayed by LogCollector)
+         * @details Taken whole or, if they do not fit, not at all
+         */
+        inline void putEncoded( const core::UInt8* data, core::Size size ) noexcept
+        {
+            if ( m_size + size > m_capacity ) {
+                m_truncated = true;
+                return;
+            }
+            ::std::memcpy( m_buffer + m_size, data, size );
+            m_size += size;
+        }
+
+        inline core::Size       size() const noexcept           { return m_size; }
+        inline core::Bool       truncated() const noexcept      { return m_truncated; }
+        inline const core::UInt8* data() const noexcept        { return m_buffer; }
+
+    private:
+        static constexpr core::UInt8 groupedFlag( core::Bool grouped ) noexcept { return grouped ? kArgGrouped : 0; }
+
+        // Write tag and optional name, return where the value goes (nullptr: argument dropped)
+        inline core::UInt8* begin( ArgType type, core::UInt8 flags, core::StringView name, core::Size valueSize ) noexcept
+        {
+            const core::Size nameLen = name.size() > kMaxNameSize ? kMaxNameSize : name.size();
+            const core::Size header = 1 + ( nameLen > 0 ? 1 + nameLen : 0 );
+            if ( m_size + header + valueSize > m_capacity ) {
+                m_truncated = true;
+                return nullptr;
+            }
+
+            core::UInt8* p = m_buffer + m_size;
+            *p++ = static_cast< core::UInt8 >( static_cast< core::UInt8 >( type ) | flags | ( nameLen > 0 ? kArgNamed : 0 ) );
+            if ( nameLen > 0 ) {
+                *p++ = static_cast< core::UInt8 >( nameLen );
+                ::std::memcpy( p, name.data(), nameLen );
+                p += nameLen;
+            }
+            m_size += header + valueSize;
+            return p;
+        }
+
+        template < typename T >
+        inline void putFixed( ArgType type, core::UInt8 flags, core::StringView name, T value ) noexcept
+        {
+            if ( core::UInt8* p = begin( type, flags, name, sizeof( T ) ) ) {
+                ::std::memcpy( p, &value, sizeof( T ) );
+            }
+        }
+
+        void putString( core::StringView name, core::StringView value ) noexcept;
+
+    private:
+        core::UInt8*    m_buffer;
+        core::Size      m_capacity;
+        core::Size      m_size{ 0 };
+        core::Bool      m_truncated{ false };
+    };
+
+    /**
+     * @brief One decoded argument, valid while the encoded buffer lives
+     */
+    struct ArgView
+    {
+        ArgType             type{ ArgType::kNone };
+        core::Bool          grouped{ false };
+        core::StringView    name;               ///< Empty for unnamed arguments
+        core::UInt64        bits{ 0 };          ///< Unsigned, hex, bin, bool and level values (zero extended)
+        core::Int64         integer{ 0 };       ///< Signed values (sign extended)
+        core::Double        real{ 0.0 };        ///< kFloat and kDouble
+        core::StringView    text;               ///< kString, domain name of kErrorCode (code in integer)
+
+        /**
+         * @brief Size in bytes of the fixed size value (0 for kString/kNone)
+         */
+        static core::Size valueSize( ArgType type ) noexcept;
+    };
+
+    inline core::Size ArgView::valueSize( ArgType type ) noexcept
+    {
+        switch ( type ) {
+        case ArgType::kBool:
+        case ArgType::kUInt8:
+        case ArgType::kInt8:
+        case ArgType::kHex8:
+        case ArgType::kBin8:
+        case ArgType::kLogLevel:    return 1;
+        case ArgType::kUInt16:
+        case ArgType::kInt16:
+        case ArgType::kHex16:
+        case ArgType::kBin16:       return 2;
+        case ArgType::kUInt32:
+        case ArgType::kInt32:
+        case ArgType::kFloat:
+        case ArgType::kHex32:
+        case ArgType::kBin32:       return 4;
+        case ArgType::kUInt64:
+        case ArgType::kInt64:
+        case ArgType::kDouble:
+        case ArgType::kHex64:
+        case ArgType::kBin64:       return 8;
+        default:                    return 0;
+        }
+    }
+
+    /**
+     * @brief Sequential reader of an ArgEncoder buffer
+     */
+    class ArgDecoder final
+    {
+    public:
+        ArgDecoder( const core::UInt8* data, core::Size size ) noexcept
+            : m_data( data )
+            , m_size( size )
+        {}
+
+        /**
+         * @brief Decode the next argument
+         * @return false at the end of the buffer or on malformed input
+         */
+        core::Bool next( ArgView& arg ) noexcept;
+
+    private:
+        const core::UInt8*  m_data;
+        core::Size          m_size;
+        core::Size          m_pos{ 0 };
+    };
+
+    /**
+     * @brief Text rendering of decoded arguments
+     * @details Output is identical to what LogStream::operator<< writes for the same value
+     */
+    class ArgFormat final
+    {
+    public:
+        ArgFormat() = delete;
+
+        /**
+         * @brief Render the value of one argument (no name, no NUL)
+         * @param out Destination
+         * @param capacity Bytes available at out
+         * @return Number of characters written, values that do not fit are cut
+         */
+        static core::Size formatValue( core::Char* out, core::Size capacity, const ArgView& arg ) noexcept;
+
+        /**
+         * @brief Render a deferred LogStream record: every value, in order, without separators
+         * @param out Destination
+         * @param capacity Bytes available at out
+         * @param data Encoded arguments
+         * @param size Size of the encoded arguments
+         * @return Number of characters written (no NUL), output beyond capacity is cut
+         */
+        static core::Size formatArgs( core::Char* out, core::Size capacity, const core::UInt8* data, core::Size size ) noexcept;
+    };
+
+} // namespace log
+} // namespace lap
+
+#endif // LAP_LOG_ARGENCODING_HPP
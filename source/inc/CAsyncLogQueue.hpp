@@ -0,0 +1,277 @@
+/**
+ * @file        CAsyncLogQueue.hpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Asynchronous logging backend
+ * @date        2026-10-16
+ * @details     Per-thread lock-free SPSC rings drained by a single sink worker
+ * @copyright   Copyright (c) 2025
+ */
+
+#ifndef LAP_LOG_ASYNCLOGQUEUE_HPP
+#define LAP_LOG_ASYNCLOGQUEUE_HPP
+
+#include "ISink.hpp"
+#include <lap/core/CTypedef.hpp>
+#include <lap/core/CMemory.hpp>
+#include <lap/core/CString.hpp>
+#include <lap/core/CSync.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace lap
+{
+namespace log
+{
+    class SinkManager;
+    class LogRing;
+
+    /**
+     * @brief What a producer does when its ring has no room for a record
+     */
+    enum class OverflowPolicy : core::UInt8
+    {
+        kBlock      = 0x00,     // Wait for the worker (bounded by flushTimeoutMs), then write synchronously
+        kDropNewest = 0x01,     // Discard the record being logged
+        kDropOldest = 0x02,     // Ask the worker to discard queued droppable records to make room
+        kSample     = 0x03,     // Keep 1 of sampleRate records once the ring is under pressure
+    };
+
+    constexpr inline core::StringView toString( const OverflowPolicy& policy ) noexcept
+    {
+        switch( policy )
+        {
+        case OverflowPolicy::kBlock:        return "block";
+        case OverflowPolicy::kDropNewest:   return "dropNewest";
+        case OverflowPolicy::kDropOldest:   return "dropOldest";
+        case OverflowPolicy::kSample:       return "sample";
+        default:                            return "block";
+        }
+    }
+
+    /**
+     * @brief Asynchronous log queue feeding SinkManager from a background worker
+     *
+     * Features:
+     * - One single-producer/single-consumer byte ring per producer thread,
+     *   created lazily on the first push of that thread
+     * - Records are stored in place as 64-byte aligned LogEntry headers
+     *   followed by context ID and message bytes (no per-record allocation)
+     * - A single worker thread drains all rings in batches and dispatches
+     *   each record through SinkManager::write(const LogEntry&)
+     * - Producers never take a lock on the hot path; the worker is only
+     *   signalled when it is parked
+     * - Per-level overflow policies: kFatal/kError block by default while
+     *   lower levels drop or sample, with per-level drop counters and a
+     *   synthetic "N messages dropped" record once the queue runs empty again
+     * - Graceful shutdown: stop() drains every ring before joining
+     * - Crash path: drainEmergency() hands queued records to a signal handler
+     */
+    class AsyncLogQueue final
+    {
+    public:
+        IMP_OPERATOR_NEW(AsyncLogQueue)
+
+        static constexpr core::Size         kLevelCount = static_cast< core::Size >( LogLevel::kLogLevelMax );
+        static constexpr core::Size         kMaxEmergencyRings = 256;      ///< Producer rings visible to drainEmergency()
+
+        /**
+         * @brief Receiver of drainEmergency() records
+         */
+        using EmergencyHandler = void (*)( void* context, const LogEntry& entry ) noexcept;
+
+        /**
+         * @brief Async queue configuration (JSON "asyncQueue" block)
+         */
+        struct Config {
+            core::Size      ringSize;           ///< Bytes per producer ring (rounded up to a power of two)
+            core::Size      batchSize;          ///< Max records drained from one ring per pass
+            core::UInt32    flushTimeoutMs;     ///< Max time flush()/blocking push waits for the worker
+            core::UInt32    idleWaitMs;         ///< Worker park time when all rings are empty
+            core::UInt32    sampleRate;         ///< kSample keeps 1 of N records under pressure
+            core::UInt32    pressurePercent;    ///< Ring fill level (%) at which kSample starts sampling
+            OverflowPolicy  levelPolicy[ kLevelCount ];     ///< Indexed by LogLevel value
+
+            Config() noexcept
+                : ringSize(256 * 1024)
+                , batchSize(256)
+                , flushTimeoutMs(5000)
+                , idleWaitMs(10)
+                , sampleRate(8)
+                , pressurePercent(75)
+                , levelPolicy{ OverflowPolicy::kBlock,          // kOff
+                               OverflowPolicy::kBlock,          // kFatal
+                               OverflowPolicy::kBlock,          // kError
+                               OverflowPolicy::kDropOldest,     // kWarn
+                               OverflowPolicy::kDropNewest,     // kInfo
+                               OverflowPolicy::kSample,         // kDebug
+                               OverflowPolicy::kSample }        // kVerbose
+            {}
+
+            inline void setPolicy( LogLevel level, OverflowPolicy policy ) noexcept
+            {
+                if ( static_cast< core::Size >( level ) < kLevelCount ) {
+                    levelPolicy[ static_cast< core::Size >( level ) ] = policy;
+                }
+            }
+
+            inline void setPolicy( OverflowPolicy policy ) noexcept
+            {
+                for ( auto& entry : levelPolicy ) {
+                    entry = policy;
+                }
+            }
+
+            inline OverflowPolicy policyFor( LogLevelType level ) const noexcept
+            {
+                return level < kLevelCount ? levelPolicy[ level ] : OverflowPolicy::kBlock;
+            }
+        };
+
+        /**
+         * @brief Queue statistics snapshot
+         */
+        struct Stats {
+            core::UInt64    enqueuedCount;      ///< Records accepted by producer rings
+            core::UInt64    processedCount;     ///< Records dispatched to sinks by the worker
+            core::UInt64    rejectedCount;      ///< Records refused (oversized or queue stopped)
+            core::UInt64    droppedCount[ kLevelCount ];    ///< Records discarded by overflow policy, per level
+            core::UInt64    droppedTotal;       ///< Sum of droppedCount
+            core::Size      producerCount;      ///< Producer rings currently registered
+        };
+
+        explicit AsyncLogQueue( SinkManager& sinkManager, const Config& config = Config() ) noexcept;
+        ~AsyncLogQueue() noexcept;
+
+        AsyncLogQueue( const AsyncLogQueue& ) = delete;
+        AsyncLogQueue& operator=( const AsyncLogQueue& ) = delete;
+
+        /**
+         * @brief Start the background worker
+         * @return true if the worker is running
+         */
+        core::Bool                  start() noexcept;
+
+        /**
+         * @brief Drain all pending records, then stop and join the worker
+         * @details Waits for producers already inside push(): a record either lands
+         *          before the final drain or push() returns false (caller writes it)
+         */
+        void                        stop() noexcept;
+
+        inline core::Bool           isRunning() const noexcept          { return m_running.load( ::std::memory_order_acquire ); }
+        inline const Config&        getConfig() const noexcept          { return m_config; }
+
+        /**
+         * @brief Enqueue one record into the calling thread's ring
+         * @param timestamp Nanoseconds since epoch
+         * @param threadId Kernel thread ID of the producer
+         * @param level Log level
+         * @param contextId Context ID string (copied)
+         * @param message Log message string (copied)
+         * @param format Encoding of message (RecordFormat::kArgs: rendered by the worker)
+         * @return true if enqueued or dropped by overflow policy,
+         *         false if the caller must write synchronously
+         * @note With kBlock, yields while the ring is full, bounded by flushTimeoutMs
+         */
+        core::Bool                  push( core::UInt64 timestamp,
+                                          core::UInt32 threadId,
+                                          LogLevelType level,
+                                          core::StringView contextId,
+                                          core::StringView message,
+                                          RecordFormat format = RecordFormat::kText ) noexcept;
+
+        /**
+         * @brief Wait until every record pushed before this call reached the sinks
+         * @return true if drained, false on timeout or if the worker is not running
+         */
+        core::Bool                  flush() noexcept;
+
+        /**
+         * @brief Keep the worker off the rings and sinks (async-signal-safe, CrashHandler)
+         * @param crashing The process is going down: wait for the current pass at most
+         *                 20 ms and take the rings over even from the worker itself
+         *                 (it crashed mid-pass). Otherwise wait for the pass without a bound,
+         *                 a second consumer would corrupt the rings of a live process
+         * @return true if the caller may drain the rings (false: called on the worker mid-pass)
+         * @details Stops the worker from starting another pass, resumeWorker() undoes it
+         */
+        core::Bool                  haltWorker( core::Bool crashing = true ) noexcept;
+
+        /**
+         * @brief Let the worker run again after haltWorker()
+         */
+        void                        resumeWorker() noexcept;
+
+        /**
+         * @brief Hand every queued record to handler from a signal handler (CrashHandler)
+         * @param handler Called once per record, oldest first within each producer ring
+         * @param context Opaque pointer passed back to handler
+         * @return Number of records handed over
+         * @details Async-signal-safe: no lock, no allocation. The caller consumes the
+         *          rings in place of the worker, call haltWorker() first. Producers
+         *          beyond kMaxEmergencyRings are not covered.
+         */
+        core::Size                  drainEmergency( EmergencyHandler handler, void* context ) noexcept;
+
+        Stats                       getStats() const noexcept;
+        core::UInt64                getDroppedCount( LogLevel level ) const noexcept;
+
+    private:
+        using RingHandle = ::std::shared_ptr< LogRing >;
+
+        LogRing*                    acquireRing() noexcept;
+        void                        workerLoop() noexcept;
+        core::Size                  drainAll() noexcept;
+        core::Bool                  hasPending() const noexcept;
+        void                        refreshWorkerRings() noexcept;
+        void                        registerEmergencyRing( LogRing* ring ) noexcept;
+        void                        unregisterEmergencyRing( LogRing* ring ) noexcept;
+        void                        wakeWorker() noexcept;
+        // wakeWorker() only if the worker is parked: producers stay off m_waitMutex
+        void                        wakeWorkerIfIdle() noexcept;
+        core::Bool                  handleOverflow( LogRing* ring,
+                                                    core::UInt64 timestamp,
+                                                    core::UInt32 threadId,
+                                                    LogLevelType level,
+                                                    core::StringView contextId,
+                                                    core::StringView message,
+                                                    RecordFormat format ) noexcept;
+        void                        recordDrop( LogLevelType level ) noexcept;
+        void                        reportDrops() noexcept;
+
+    private:
+        SinkManager&                        m_sinkManager;
+        Config                              m_config;
+        const core::UInt64                  m_queueId;              ///< Unique id, invalidates stale thread-local ring caches
+
+        mutable core::Mutex                 m_ringMutex;            ///< Guards ring registration only (never the hot path)
+        core::Vector< RingHandle >          m_rings;
+        ::std::atomic< core::UInt64 >       m_ringsVersion{ 0 };
+        core::Vector< RingHandle >          m_workerRings;          ///< Worker-private snapshot of m_rings
+        core::UInt64                        m_workerRingsVersion{ 0 };
+
+        ::std::thread                       m_worker;
+        ::std::mutex                        m_waitMutex;
+        ::std::condition_variable           m_wakeCv;
+        ::std::condition_variable           m_drainedCv;
+
+        ::std::atomic< core::Bool >         m_running{ false };
+        ::std::atomic< core::Bool >         m_stopRequested{ false };
+        ::std::atomic< core::Bool >         m_halted{ false };      ///< haltWorker(): the worker stays idle
+        alignas(64) ::std::atomic< core::Bool >     m_workerIdle{ false };
+        ::std::atomic< core::Bool >         m_workerBusy{ false };  ///< Worker is inside a drain/flush pass
+        alignas(64) ::std::atomic< core::UInt64 >   m_processedCount{ 0 };
+        ::std::atomic< core::UInt64 >       m_rejectedCount{ 0 };
+        core::UInt64                        m_retiredEnqueued{ 0 };  ///< Enqueue count of rings already reclaimed
+        ::std::atomic< core::UInt64 >       m_droppedCount[ kLevelCount ]{};
+        core::UInt64                        m_reportedDrops[ kLevelCount ]{};   ///< Worker-only: drops already reported
+        ::std::atomic< LogRing* >           m_emergencyRings[ kMaxEmergencyRings ]{};   ///< Lock-free view of m_rings
+    };
+
+} // namespace log
+} // namespace lap
+
+#endif // LAP_LOG_ASYNCLOGQUEUE_HPP
@@ -0,0 +1,250 @@
+/**
+ * @file        CBinaryFileSink.hpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Compact binary log file sink (memory-mapped, pre-allocated)
+ * @date        2026-10-16
+ * @details     File format: doc/design/BinaryLog_Format.md, decoder: tools/decode_binary_log.py
+ * @copyright   Copyright (c) 2025
+ */
+
+#ifndef LAP_LOG_BINARYFILESINK_HPP
+#define LAP_LOG_BINARYFILESINK_HPP
+
+#include "ISink.hpp"
+#include <lap/core/CMemory.hpp>
+#include <lap/core/CString.hpp>
+
+namespace lap
+{
+namespace log
+{
+    /**
+     * @brief Binary file sink for space efficient persistent logs
+     *
+     * Features:
+     * - Length-prefixed records: LEB128 timestamp delta, level, interned context
+     *   index and payload instead of the ~50 byte text line prefix
+     * - Timestamps are kept at the TimestampPrecision of the text sinks (taken
+     *   when the file is opened), so the delta mostly fits one byte and the
+     *   decoded text equals what FileSink would have written
+     * - Context IDs are written once per file as a context record, records
+     *   refer to them by index; every file (incl. backups) is self-contained
+     * - Payloads are stored as produced: text, deferred LogStream arguments
+     *   (writeArgs) and modeled messages (writeModeled) in their ArgEncoding
+     *   form, so nothing is formatted on the write path
+     * - Repeated payloads are split into a template (text with the numbers cut
+     *   out, or the arguments without their numeric values) written once per
+     *   file, and the values as varints; a payload is templated from its second
+     *   occurrence on, unique payloads stay as they are
+     * - The file is grown with posix_fallocate() in preallocSize steps and
+     *   written through a shared mapping: no syscall per record, and disk space
+     *   is reserved before it is touched (no SIGBUS on a full disk)
+     * - Size-based rotation like FileSink; on close the file is truncated to
+     *   the used size, after a crash the zero-filled tail ends the record stream
+     * - One writer per file: an existing file at the path is rotated out on open
+     */
+    class BinaryFileSink : public ISink
+    {
+    public:
+        IMP_OPERATOR_NEW(BinaryFileSink)
+
+        static constexpr core::UInt8    kFormatVersion      = 2;
+        static constexpr core::Size     kHeaderSize         = 32;
+        static constexpr core::Size     kDefaultPreallocSize = 4 * 1024 * 1024;
+        static constexpr core::Size     kMaxTemplateSize    = 1024;     ///< Larger payloads are stored as they are
+        static constexpr core::UInt32   kMaxTemplates       = 2048;     ///< Templates per file
+        static constexpr core::Size     kMaxTemplateBytes   = 64 * 1024;    ///< Template bytes per file
+
+        /**
+         * @brief Record kinds, bits 4-6 of the record's first byte
+         */
+        enum class RecordKind : core::UInt8
+        {
+            kContext    = 0,    // [index][context ID bytes]
+            kText       = 1,    // [dt][context][tid]?[text]
+            kArgs       = 2,    // [dt][context][tid]?[ArgEncoding, unnamed]
+            kModeled    = 3,    // [dt][context][tid]?[message ID][ArgEncoding, named]
+            kTemplate   = 4,    // [index][template bytes]
+            kTemplatedText      = 5,    // [dt][context][tid]?[template][values]
+            kTemplatedArgs      = 6,    // [dt][context][tid]?[template][values]
+            kTemplatedModeled   = 7,    // [dt][context][tid]?[message ID][template][values]
+        };
+
+        static constexpr core::UInt8    kRecordHasThreadId  = 0x80;     ///< Record carries the producer thread ID
+
+        /**
+         * @brief Constructor
+         * @param filePath Log file path
+         * @param maxSize Maximum file size before rotation (0 = no rotation)
+         * @param maxFiles Maximum number of backup files to keep
+         * @param minLevel Minimum log level to output
+         * @param appId Application ID (max 4 bytes), stored in the file header
+         * @param preallocSize Bytes reserved and mapped per growth step
+         */
+        explicit BinaryFileSink(
+            core::StringView filePath,
+            core::Size maxSize = 10 * 1024 * 1024,  // 10MB default
+            core::UInt32 maxFiles = 5,
+            LogLevel minLevel = LogLevel::kVerbose,
+            core::StringView appId = "",
+            core::Size preallocSize = kDefaultPreallocSize
+        ) noexcept;
+
+        virtual ~BinaryFileSink() noexcept override;
+
+        // ISink interface implementation
+        virtual void write(
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            core::StringView message
+        ) noexcept override;
+
+        virtual core::Bool writeModeled(
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            const ModeledRecord& record
+        ) noexcept override;
+
+        virtual core::Bool writeArgs(
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            const core::UInt8* args,
+            core::Size size
+        ) noexcept override;
+
+        virtual void flush() noexcept override;
+        virtual core::Bool isEnabled() const noexcept override { return m_enabled && m_map != nullptr; }
+        virtual core::StringView getName() const noexcept override { return "BinaryFile"; }
+        virtual void setLevel(LogLevel level) noexcept override { m_minLevel = level; notifyChanged(); }
+        virtual core::Bool shouldLog(LogLevel level) const noexcept override;
+
+        /**
+         * @brief Enable/disable this sink
+         * @param enabled Enable state
+         */
+        void setEnabled(core::Bool enabled) noexcept { m_enabled = enabled; notifyChanged(); }
+
+        /**
+         * @brief Store the producer's kernel thread ID with each record
+         * @param enabled Store thread ID (default: false), the decoder prints "[tid:N]"
+         */
+        void setWithThreadId(core::Bool enabled) noexcept { m_withThreadId = enabled; }
+
+        /**
+         * @brief Get bytes used in the current file (header and records)
+         * @return Used size in bytes, the file itself is pre-allocated beyond it
+         */
+        core::Size getCurrentSize() const noexcept { return m_used; }
+
+        /**
+         * @brief Manually trigger log rotation
+         * @return true if rotation succeeded, false otherwise
+         */
+        core::Bool rotate() noexcept;
+
+    private:
+        /**
+         * @brief Open a new file at m_filePath, map it and write the header
+         */
+        core::Bool openFile() noexcept;
+
+        /**
+         * @brief Unmap, truncate to the used size and close
+         */
+        void closeFile() noexcept;
+
+        /**
+         * @brief Shift m_filePath -> .1 -> .2 ... (file must be closed)
+         */
+        void shiftBackups() noexcept;
+
+        /**
+         * @brief Make room for need more bytes: rotate at maxSize, grow the mapping
+         * @return false if the bytes cannot be provided (record is dropped)
+         */
+        core::Bool reserve(core::Size need) noexcept;
+
+        /**
+         * @brief Index of contextId in this file, writing its context record on first use
+         */
+        core::UInt32 internContext(core::StringView contextId) noexcept;
+
+        /**
+         * @brief Split a payload into m_shape (template) and m_values
+         * @return false if the payload is not templated (too large, malformed, NUL in text)
+         */
+        core::Bool split(RecordKind kind, const core::UInt8* payload, core::Size size) noexcept;
+
+        /**
+         * @brief Index of the template in m_shape, writing its template record when it repeats
+         * @return Template index, or kNoTemplate to store the payload as it is
+         */
+        core::UInt32 internTemplate() noexcept;
+
+        /**
+         * @brief Append one record: [len][kind|tid|level][dt][context][tid]?[msgId]?[payload]
+         */
+        void append(
+            RecordKind kind,
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            core::UInt32 messageId,
+            const void* payload,
+            core::Size size
+        ) noexcept;
+
+    private:
+        core::String    m_filePath;     ///< Log file path
+        core::Size      m_maxSize;      ///< Max size before rotation
+        core::UInt32    m_maxFiles;     ///< Max backup files
+        core::Size      m_preallocSize; ///< Growth step of file and mapping
+        core::Bool      m_enabled;      ///< Enable state
+        core::Bool      m_withThreadId; ///< Store thread ID per record
+        LogLevel        m_minLevel;     ///< Minimum log level
+        char            m_appId[4];     ///< Application ID (NUL padded, not terminated)
+
+        core::Int32     m_fd;           ///< File descriptor, -1 if closed
+        core::UInt8*    m_map;          ///< Shared mapping of [0, m_mapSize)
+        core::Size      m_mapSize;      ///< Mapped and allocated bytes
+        core::Size      m_used;         ///< Bytes of header and records written
+        core::UInt64    m_timeUnit;     ///< Nanoseconds per timestamp tick (10^(9 - precision digits))
+        core::UInt64    m_lastTick;     ///< Base of the next timestamp delta
+        core::Bool      m_growFailedReported;
+
+        core::UnorderedMap<core::String, core::UInt32>  m_contexts;     ///< Context ID -> index, per file
+        core::String    m_lastContext;  ///< Last looked up context (one entry cache)
+        core::UInt32    m_lastIndex;    ///< Index of m_lastContext
+
+        /**
+         * @brief Open addressed slot of the template table, per file
+         */
+        struct TemplateSlot
+        {
+            core::UInt64    hash;       ///< Hash of the template bytes
+            core::UInt32    index;      ///< Template index, kSeenOnce or kEmptySlot
+            core::UInt32    offset;     ///< Bytes in m_templateBytes (defined templates)
+            core::UInt32    size;
+        };
+
+        core::Vector<TemplateSlot>  m_templateSlots;    ///< Empty if the table could not be allocated
+        core::Vector<core::UInt8>   m_templateBytes;    ///< Defined templates, compared on lookup
+        core::UInt32    m_templateCount;    ///< Templates defined in this file
+        core::UInt32    m_slotsUsed;        ///< Defined and seen once slots
+        core::Vector<core::UInt8>   m_shape;    ///< Template of the payload being written, kMaxTemplateSize
+        core::Vector<core::UInt8>   m_values;   ///< Its values; an 8 byte value (9 payload bytes) takes up to 10 bytes
+        core::Size      m_shapeSize;
+        core::Size      m_valuesSize;
+    };
+
+} // namespace log
+} // namespace lap
+
+#endif // LAP_LOG_BINARYFILESINK_HPP
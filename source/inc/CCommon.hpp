@@ -106,6 +106,14 @@ namespace log
         kTraceStatusMax
     };
 
+    // Encoding of the message bytes of a record
+    enum class RecordFormat : core::UInt8
+    {
+        kText       = 0x00,     // Formatted text
+        kArgs       = 0x01,     // Deferred LogStream record: ArgEncoder encoded values, rendered by the consumer
+        kModeled    = 0x02,     // Modeled message: ModeledRecord::pack() (message ID + encoded arguments)
+    };
+
     enum class ClientState : core::Int8
     {
         kUnknown    = -1,
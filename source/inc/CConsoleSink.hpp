@@ -3,7 +3,7 @@
  * @author      ddkv587 ( ddkv587@gmail.com )
  * @brief       Console output sink with ANSI color support
  * @date        2025-10-28
- * @details     Outputs formatted logs to stderr with colors and timestamps
+ * @details     Outputs formatted logs to stderr or stdout with colors and timestamps
  * @copyright   Copyright (c) 2025
  */
 
@@ -12,18 +12,42 @@
 
 #include "ISink.hpp"
 #include <lap/core/CMemory.hpp>
+#include <lap/core/CTypedef.hpp>
+#include <sys/types.h>
 
 namespace lap
 {
 namespace log
 {
+    /**
+     * @brief File descriptor ConsoleSink writes to
+     */
+    enum class ConsoleStream : core::UInt8
+    {
+        kStderr     = 0,    ///< STDERR_FILENO
+        kStdout     = 1     ///< STDOUT_FILENO (bypasses the stdout FILE buffer)
+    };
+
+    /**
+     * @brief ConsoleSink output configuration
+     */
+    struct ConsoleConfig
+    {
+        ConsoleStream   stream{ ConsoleStream::kStderr };
+        core::Size      bufferSize{ 0 };            ///< Coalescing buffer in bytes, 0 = one writev() per record
+        core::UInt32    flushIntervalMs{ 100 };     ///< Max age of buffered records, checked on each write and by SinkManager's flush timer
+        core::Bool      forceColor{ false };        ///< Keep ANSI colors when the stream is not a terminal
+    };
+
     /**
      * @brief Console sink for terminal output
      * 
      * Features:
-     * - ANSI color codes for different log levels
-     * - Formatted timestamp (HH:MM:SS.mmm)
-     * - Thread-safe output to stderr
+     * - ANSI color codes for different log levels, dropped when the stream is
+     *   redirected to a file or pipe (unless ConsoleConfig::forceColor)
+     * - Formatted timestamp (HH:MM:SS.mmm, .uuuuuu or .nnnnnnnnn per TimestampPrecision)
+     * - Lines formatted into a stack buffer, no stdio: one writev() per record,
+     *   or batched into one write() per ConsoleConfig::bufferSize
      */
     class ConsoleSink : public ISink
     {
@@ -34,10 +58,16 @@ namespace log
          * @brief Constructor
          * @param colorized Enable ANSI colors (default: true)
          * @param minLevel Minimum log level to output (default: Verbose)
+         * @param config Stream and batching (default: stderr, one writev() per record)
          */
-        explicit ConsoleSink(core::Bool colorized = true, LogLevel minLevel = LogLevel::kVerbose) noexcept;
+        explicit ConsoleSink(
+            core::Bool colorized = true,
+            LogLevel minLevel = LogLevel::kVerbose,
+            const ConsoleConfig& config = ConsoleConfig()
+        ) noexcept;
         
-        virtual ~ConsoleSink() noexcept override = default;
+        // Writes what is still buffered
+        virtual ~ConsoleSink() noexcept override;
         
         // ISink interface implementation
         virtual void write(
@@ -49,22 +79,61 @@ namespace log
         ) noexcept override;
         
         virtual void flush() noexcept override;
+        
+        // Pending batch, then the line, with write(2) straight to the stream's fd
+        virtual core::Bool writeEmergency(
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            core::StringView message
+        ) noexcept override;
+        
+        // The line alone, the batch stays with the thread holding the buffer lock
+        virtual core::Bool writeEmergencyUnbatched(
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            core::StringView message
+        ) noexcept override;
+        
+        virtual core::UInt32 getFlushIntervalMs() const noexcept override
+        {
+            return m_config.bufferSize > 0 ? m_config.flushIntervalMs : 0;
+        }
+        
+        virtual void flushExpired(core::UInt32 slackMs) noexcept override;
+        
         virtual core::Bool isEnabled() const noexcept override { return m_enabled; }
         virtual core::StringView getName() const noexcept override { return "Console"; }
-        virtual void setLevel(LogLevel level) noexcept override { m_minLevel = level; }
+        virtual void setLevel(LogLevel level) noexcept override { m_minLevel = level; notifyChanged(); }
         virtual core::Bool shouldLog(LogLevel level) const noexcept override;
+        // One writev() per record needs no lock; the batch buffer does
+        virtual core::Bool isThreadSafe() const noexcept override { return m_config.bufferSize == 0; }
         
         /**
          * @brief Enable/disable this sink
          * @param enabled Enable state
          */
-        void setEnabled(core::Bool enabled) noexcept { m_enabled = enabled; }
+        void setEnabled(core::Bool enabled) noexcept { m_enabled = enabled; notifyChanged(); }
         
         /**
          * @brief Enable/disable colorized output
-         * @param colorized Colorized state
+         * @param colorized Colorized state (ignored when the stream is not a terminal, unless forceColor)
+         */
+        void setColorized(core::Bool colorized) noexcept { m_colorized = colorized && (m_isTerminal || m_config.forceColor); }
+        
+        /**
+         * @brief Whether lines currently carry ANSI color codes
          */
-        void setColorized(core::Bool colorized) noexcept { m_colorized = colorized; }
+        core::Bool isColorized() const noexcept { return m_colorized; }
+        
+        /**
+         * @brief Print the producer's kernel thread ID as "[tid:N]" after the context
+         * @param enabled Show thread ID (default: false)
+         */
+        void setWithThreadId(core::Bool enabled) noexcept { m_withThreadId = enabled; }
         
     private:
         /**
@@ -82,17 +151,44 @@ namespace log
         const char* getLevelName(LogLevelType level) const noexcept;
         
         /**
-         * @brief Format timestamp from microseconds
-         * @param timestamp Microseconds since epoch
-         * @param buffer Output buffer (at least 16 bytes)
+         * @brief Format timestamp from nanoseconds
+         * @param timestamp Nanoseconds since epoch
+         * @param buffer Output buffer (at least TimestampFormat::kMaxTimeChars + 1 bytes)
          * @return Number of characters written
          */
         core::Size formatTimestamp(core::UInt64 timestamp, char* buffer) const noexcept;
         
+        /**
+         * @brief Format "[time] [LEVEL] [ctx] [tid:N]" with colors and the trailing space
+         * @param buffer Output buffer (at least kMaxPrefixChars bytes)
+         * @return Number of characters written
+         */
+        core::Size formatPrefix(char* buffer, core::UInt64 timestamp, core::UInt32 threadId,
+                                LogLevelType level, core::StringView contextId) const noexcept;
+        
+        // write(2) until done, retried on EINTR, dropped on any other error
+        void writeAll(const char* data, core::Size len) noexcept;
+        // writev(2) of prefix, message and newline, partial writes completed
+        void writeLine(const char* prefix, core::Size prefixLen, core::StringView message) noexcept;
+        void flushBuffer() noexcept;
+        
     private:
-        core::Bool  m_enabled;      ///< Enable state
-        core::Bool  m_colorized;    ///< Use ANSI colors
-        LogLevel    m_minLevel;     ///< Minimum log level
+        static constexpr core::Size kMaxContextChars = 256;    ///< Longer context IDs are cut
+        static constexpr core::Size kMaxPrefixChars = 384;     ///< Colors, time, level, context, tid
+        
+        core::Bool          m_enabled;      ///< Enable state
+        core::Bool          m_colorized;    ///< Use ANSI colors
+        core::Bool          m_isTerminal;   ///< isatty() of m_fd at construction
+        core::Bool          m_withThreadId; ///< Print "[tid:N]"
+        LogLevel            m_minLevel;     ///< Minimum log level
+        ConsoleConfig       m_config;
+        int                 m_fd;           ///< STDERR_FILENO or STDOUT_FILENO
+        
+        // Batching (bufferSize > 0)
+        core::Vector<char>  m_buffer;
+        core::Size          m_bufferUsed{ 0 };
+        core::UInt64        m_firstPendingMs{ 0 };  ///< Monotonic time of the oldest buffered record
+        pid_t               m_pid;                  ///< A fork() child does not write the parent's pending batch
     };
     
 } // namespace log
@@ -0,0 +1,96 @@
+/**
+ * @file        CCrashHandler.hpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Fatal signal handler and async-signal-safe emergency log path
+ * @date        2026-10-16
+ * @details     Design: doc/design/CrashHandler_Design.md
+ * @copyright   Copyright (c) 2025
+ */
+
+#ifndef LAP_LOG_CRASHHANDLER_HPP
+#define LAP_LOG_CRASHHANDLER_HPP
+
+#include <lap/core/CTypedef.hpp>
+#include <lap/core/CString.hpp>
+#include "CCommon.hpp"
+
+namespace lap
+{
+namespace log
+{
+    class SinkManager;
+    class AsyncLogQueue;
+
+    /**
+     * @brief Process wide crash handler (opt-in) and signal-safe FATAL path
+     *
+     * Features:
+     * - install() catches SIGSEGV, SIGBUS, SIGFPE, SIGILL and SIGABRT on an
+     *   alternate stack (stack overflows of the installing thread included)
+     * - On a fatal signal: records still queued in the async rings and bytes
+     *   batched in sinks are written out, followed by a FATAL record naming
+     *   the signal, then the previous disposition is restored and the signal
+     *   re-raised (core dump and exit status unchanged)
+     * - logFatal() is the same path without a signal: callable from any
+     *   signal handler of the application
+     * - Async-signal-safe throughout: no lock, no allocation, no stdio; only
+     *   write(2) on descriptors the sinks opened beforehand (ISink::writeEmergency)
+     * - Best effort against concurrent writers: the async worker is stopped and
+     *   waited for (bounded on a fatal signal, unbounded for logFatal() since the
+     *   process lives on), synchronous writers on other threads are not
+     */
+    class CrashHandler final
+    {
+    public:
+        static constexpr core::Size     kAltStackSize   = 64 * 1024;
+        static constexpr const char*    kContextId      = "CRSH";  ///< Context of the signal record
+
+        CrashHandler() = delete;
+
+        /**
+         * @brief Point the emergency path at the sinks and queue of the LogManager
+         * @param sinkManager Sinks to write to, nullptr to detach
+         * @param asyncQueue Queue to drain, nullptr if async mode is off
+         * @note Called by LogManager on initialize/uninitialize
+         */
+        static void         attach( SinkManager* sinkManager, AsyncLogQueue* asyncQueue ) noexcept;
+
+        /**
+         * @brief Install the fatal signal handlers (idempotent)
+         * @return true if installed
+         * @details The alternate stack is set up for the calling thread only
+         */
+        static core::Bool   install() noexcept;
+
+        /**
+         * @brief Restore the dispositions found by install()
+         */
+        static void         uninstall() noexcept;
+
+        static core::Bool   isInstalled() noexcept;
+
+        /**
+         * @brief Write out queued and batched records (async-signal-safe)
+         * @param halt Keep the async worker stopped afterwards (process is going down).
+         *             Only then are sink batches written without the sink lock; otherwise
+         *             batches whose lock is held stay with their owner
+         */
+        static void         emergencyFlush( core::Bool halt = false ) noexcept;
+
+        /**
+         * @brief Log a FATAL record from any context, signal handlers included
+         * @param contextId Context ID of the record
+         * @param message Message text (cut at 4 KiB)
+         * @details emergencyFlush() first so the record lands after everything
+         *          logged before it; sinks without ISink::writeEmergency() are skipped.
+         *          The process keeps running: a sink whose lock is held (by another
+         *          thread or the interrupted one) keeps its batch and gets the record
+         *          through ISink::writeEmergencyUnbatched(), possibly ahead of that batch
+         */
+        static void         logFatal( core::StringView contextId, core::StringView message ) noexcept;
+    };
+
+} // namespace log
+} // namespace lap
+
+#endif // LAP_LOG_CRASHHANDLER_HPP
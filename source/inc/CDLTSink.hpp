@@ -13,6 +13,8 @@
 #include "ISink.hpp"
 #include <lap/core/CMemory.hpp>
 #include <lap/core/CString.hpp>
+#include <lap/core/CSync.hpp>
+#include <atomic>
 #include "dlt/dlt.h"
 
 namespace lap
@@ -24,15 +26,27 @@ namespace log
      * 
      * Encapsulates all DLT API operations including:
      * - DLT application registration
-     * - DLT context management
+     * - DLT context management: one DLT context per Logger context ID,
+     *   registered on first use (or eagerly via registerContext()) and
+     *   unregistered on destruction
+     * - O(1) context lookup on the write path: the 4-char ID is packed into a
+     *   32-bit key and probed in a lock-free open-addressed table; the mutex is
+     *   only taken to register a context not seen before
      * - Log level and trace status configuration
-     * - DLT log output
+     * - DLT log output: verbose text records, and modeled messages in non-verbose
+     *   form (dlt_user_log_write_start_id with the message ID, argument values
+     *   without type info or names; the viewer decodes them with the catalog)
+     * - Deferred LogStream records (RecordFormat::kArgs) are sent as verbose
+     *   typed DLT arguments, never rendered to text
      */
     class DLTSink : public ISink
     {
     public:
         IMP_OPERATOR_NEW(DLTSink)
         
+        static constexpr core::Size     kContextTableSize   = 256;  ///< Open-addressed slots (power of two)
+        static constexpr core::Size     kMaxContexts        = 192;  ///< Context IDs (registered or failed) before falling back to the default one
+        
         /**
          * @brief DLT configuration structure
          */
@@ -85,11 +99,29 @@ namespace log
             core::StringView message
         ) noexcept override;
         
+        virtual core::Bool writeModeled(
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            const ModeledRecord& record
+        ) noexcept override;
+        
+        virtual core::Bool writeArgs(
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            const core::UInt8* args,
+            core::Size size
+        ) noexcept override;
+        
         virtual void flush() noexcept override;
         virtual core::Bool isEnabled() const noexcept override { return m_enabled; }
         virtual core::StringView getName() const noexcept override { return "DLT"; }
-        virtual void setLevel(LogLevel level) noexcept override { m_minLevel = level; }
+        virtual void setLevel(LogLevel level) noexcept override { m_minLevel = level; notifyChanged(); }
         virtual core::Bool shouldLog(LogLevel level) const noexcept override;
+        virtual core::Bool isThreadSafe() const noexcept override { return true; }     // libdlt serializes writes internally
         
         /**
          * @brief Set minimum log level
@@ -101,34 +133,104 @@ namespace log
          * @brief Enable or disable the sink
          * @param enabled true to enable, false to disable
          */
-        void setEnabled(core::Bool enabled) noexcept { m_enabled = enabled; }
+        void setEnabled(core::Bool enabled) noexcept { m_enabled = enabled; notifyChanged(); }
         
         /**
-         * @brief Register a DLT context
-         * @param contextId Context ID (max 4 chars)
-         * @param contextDesc Context description
+         * @brief Register a DLT context ahead of its first record
+         * @param contextId Context ID (max 4 chars, longer IDs are truncated)
+         * @param contextDesc Context description shown by the DLT viewer
          * @param level Log level for this context
          * @param status Trace status for this context
-         * @return true if registered successfully
+         * @return true if records of this context have a DLT context to go to
+         * @details Contexts not registered here are registered by write() on
+         *          first use with the ID as description and the sink default level
          */
-        core::Bool registerContext(
+        virtual core::Bool registerContext(
             core::StringView contextId, 
             core::StringView contextDesc,
             LogLevel level = LogLevel::kWarn,
             TraceStatus status = TraceStatus::kDefault
-        ) noexcept;
+        ) noexcept override;
+        
+        /**
+         * @brief Number of DLT contexts registered besides the default one
+         */
+        core::Size getContextCount() const noexcept { return m_contextCount.load(std::memory_order_relaxed); }
         
     private:
+        /**
+         * @brief Registry slot, key 0 marks an empty slot
+         * @details key is published (release) only after target was set: &context
+         *          once registered, or the default context if registration failed
+         */
+        struct ContextSlot {
+            std::atomic<core::UInt32>   key{0};
+            DltContext*                 target{nullptr};
+            DltContext                  context;
+        };
+        
+
         core::Bool          m_enabled;
         LogLevel            m_minLevel;
         DltContext          m_defaultContext;  // Default DLT context
         core::Bool          m_dltInitialized;
         core::Bool          m_appRegistered;   // DLT app registration status
         core::String        m_appId;           // Stored app ID
+        core::UInt32        m_defaultKey;      // Packed ID of m_defaultContext
+        LogLevel            m_contextLevel;    // Level of lazily registered contexts
+        TraceStatus         m_traceStatus;     // Trace status of lazily registered contexts
+        
+        ContextSlot         m_contexts[kContextTableSize];
+        std::atomic<core::Size> m_contextCount{0};
+        core::Size          m_usedSlots{0};    // Registered plus failed IDs (under m_registerMutex)
+        core::Mutex         m_registerMutex;   // Serializes registration only, never taken by lookups
+        core::Bool          m_tableFullReported{false};
         
-        // Helper to get or create DLT context (simplified: using default context for now)
+        /**
+         * @brief Get the DLT context of a context ID, registering it on first use
+         * @return Registered context, or the default context if the table is full
+         *         or registration failed
+         */
         DltContext* getContext(core::StringView contextId) noexcept;
         
+        /**
+         * @brief Register contextId under m_registerMutex (slow path of getContext())
+         * @return Registered context; the default context if registration failed
+         *         (remembered in the slot); nullptr if the table is full
+         */
+        DltContext* addContext(
+            core::UInt32 key,
+            core::StringView contextId,
+            core::StringView contextDesc,
+            LogLevel level,
+            TraceStatus status
+        ) noexcept;
+        
+        /**
+         * @brief Append ArgEncoder encoded values as DLT arguments of a started message
+         * @return Result of the last DLT write (negative on failure)
+         */
+        static int appendArgs(DltContextData& contextData, const core::UInt8* args, core::Size size) noexcept;
+        
+        /**
+         * @brief Pack up to 4 ID characters into a key (0 for an empty ID)
+         */
+        static inline core::UInt32 packId(core::StringView contextId) noexcept {
+            core::UInt32 key = 0;
+            const core::Size len = contextId.size() < 4 ? contextId.size() : 4;
+            for (core::Size i = 0; i < len; ++i) {
+                key |= static_cast<core::UInt32>(static_cast<core::UInt8>(contextId[i])) << (8 * i);
+            }
+            return key;
+        }
+        
+        /**
+         * @brief First probe position of a key (Fibonacci hashing)
+         */
+        static constexpr core::Size slotOf(core::UInt32 key) noexcept {
+            return static_cast<core::Size>((key * 2654435769u) >> 24) & (kContextTableSize - 1);
+        }
+        
         /**
          * @brief Convert internal LogLevelType to DltLogLevelType
          * @param level Internal log level
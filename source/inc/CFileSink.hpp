@@ -11,19 +11,146 @@
 #define LAP_LOG_FILESINK_HPP
 
 #include "ISink.hpp"
+#include "CLogCompressor.hpp"
+#include "CIoUringWriter.hpp"
 #include <lap/core/CMemory.hpp>
 #include <lap/core/CFile.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <sys/types.h>
 
 namespace lap
 {
 namespace log
 {
+    /**
+     * @brief How FileSink hands batches to the kernel
+     */
+    enum class FileIoEngine : core::UInt8
+    {
+        kWrite      = 0,    ///< write(2) per chunk on the flushing thread
+        kIoUring    = 1     ///< Asynchronous io_uring submission (batched mode only), write(2) fallback
+    };
+
+    /**
+     * @brief FileSink write batching configuration
+     */
+    struct FileBufferConfig
+    {
+        core::Size      bufferSize{ 0 };            ///< Coalescing buffer in bytes, 0 = one write() per record
+        core::UInt32    flushIntervalMs{ 1000 };    ///< Max age of buffered records, checked on each write and by SinkManager's flush timer
+        core::Bool      multiProcess{ false };      ///< Flush under flock() instead of PIPE_BUF sized chunks
+        FileIoEngine    ioEngine{ FileIoEngine::kWrite };   ///< Submission engine for batches
+    };
+
+    /**
+     * @brief When FileSink forces written records to stable storage
+     */
+    enum class FileSyncPolicy : core::UInt8
+    {
+        kNone       = 0,    ///< Kernel writeback only, fsync on close
+        kPeriodic   = 1,    ///< fdatasync every intervalMs while records arrive
+        kOnError    = 2,    ///< fdatasync after ERROR records; FATAL waits for it
+        kEveryBytes = 3     ///< fdatasync after every everyBytes bytes written
+    };
+
+    /**
+     * @brief FileSink durability policy
+     *
+     * Syncs run on a helper thread and cover the records already handed to
+     * the kernel (batched records once their batch is written). Requests that
+     * arrive while a sync is running are served together by the next one.
+     */
+    struct FileSyncConfig
+    {
+        FileSyncPolicy  policy{ FileSyncPolicy::kNone };
+        core::UInt32    intervalMs{ 1000 };             ///< kPeriodic: sync period
+        core::Size      everyBytes{ 1024 * 1024 };      ///< kEveryBytes: bytes between syncs
+    };
+
+    /**
+     * @brief FileSink disk space and page cache management
+     *
+     * Preallocation reserves the blocks a file will grow into
+     * (fallocate(FALLOC_FL_KEEP_SIZE), the file size is unchanged), so appends
+     * do not allocate blocks one at a time; the unused tail is trimmed again
+     * when the file is rotated out or closed. Dropping the page cache keeps
+     * written log pages from pushing application data out of memory.
+     */
+    struct FileSpaceConfig
+    {
+        core::Bool      preallocate{ false };   ///< Reserve blocks on open and for each new file
+        core::Size      preallocateBytes{ 0 };  ///< Bytes to reserve, 0 = maxSize
+        core::Size      dropCacheBytes{ 0 };    ///< posix_fadvise(DONTNEED) every N bytes written, 0 = off
+    };
+
+    /**
+     * @brief Syscalls a FileSink has issued (benchmarks, diagnostics)
+     */
+    struct FileIoStats
+    {
+        core::UInt64    writeCalls{ 0 };    ///< write(2) calls
+        core::UInt64    ringEnters{ 0 };    ///< io_uring_enter(2) calls (submissions and waits)
+        core::UInt64    syncCalls{ 0 };     ///< fdatasync(2) calls of the sync thread and sync()
+    };
+
+    /**
+     * @brief Time-based rotation period (local time boundaries)
+     */
+    enum class RotationInterval : core::UInt8
+    {
+        kNone   = 0,    ///< Size-based only
+        kHourly = 1,    ///< At every full hour
+        kDaily  = 2     ///< At local midnight
+    };
+
+    /**
+     * @brief FileSink rotation policy
+     *
+     * Rotation happens when the file reaches maxSize (if > 0) or when an
+     * interval boundary has passed (if interval is set), whichever comes first.
+     */
+    struct FileRotationConfig
+    {
+        RotationInterval    interval{ RotationInterval::kNone };    ///< Time-based trigger
+        core::Bool          background{ false };    ///< Rename/cleanup on a helper thread, writers only swap descriptors (single-process files only)
+        CompressionType     compression{ CompressionType::kNone };  ///< Codec for rotated files (".gz"/".zst")
+        core::Int32         compressionLevel{ 0 };                  ///< 0 = codec default (gzip 6, zstd 3)
+        core::Size          compressBytesPerSec{ 8 * 1024 * 1024 }; ///< Input budget of the compressor, 0 = unthrottled
+    };
+
     /**
      * @brief File sink for persistent log storage
      * 
      * Features:
-     * - Buffered file I/O for performance
-     * - Size-based log rotation
+     * - Optional write batching (FileBufferConfig): records are coalesced
+     *   and flushed when the buffer fills, the interval expires, on flush(),
+     *   on ERROR/FATAL records and before rotation
+     * - Records are never torn across processes: batches are written in
+     *   chunks of at most PIPE_BUF bytes that end on record boundaries, or
+     *   as one write under an exclusive flock() in multi-process mode
+     * - Optional io_uring engine for batches: a full buffer is submitted as a
+     *   linked chain of fixed-buffer writes from one of two registered halves
+     *   and the writer carries on in the other half; completions are reaped on
+     *   the flushing thread. Falls back to write(2) when io_uring is missing
+     * - Durability policies (FileSyncConfig): periodic, after ERROR or every N
+     *   bytes, run as group commits on a sync thread so writers do not wait
+     *   (except FATAL); flush() only writes batches out, sync() waits for
+     *   stable storage
+     * - Optional preallocation of maxSize per file, page cache dropping of
+     *   written ranges and trimming of the unused tail (FileSpaceConfig)
+     * - Crash path (writeEmergency/flushEmergency): pending batch and records
+     *   go out with write(2) on the open descriptor, no lock, no rotation
+     * - Size-based, hourly/daily and hybrid rotation (FileRotationConfig)
+     * - Background rotation: a helper thread keeps "<path>.next" opened, the
+     *   writer hard-links the full file to "<path>.rotating", renames the
+     *   staging file over <path> and switches descriptors; shifting the
+     *   backups happens on the helper thread. <path> always exists
+     * - Optional compression of rotated files on an idle priority thread
+     *   (SCHED_IDLE, idle I/O class, byte rate budget); writers never wait
+     *   for it, retention counts "<path>.N", "<path>.N.gz" and "<path>.N.zst" alike
      * - Automatic backup file management
      * - Configurable flush policy
      */
@@ -39,13 +166,21 @@ namespace log
          * @param maxFiles Maximum number of backup files to keep
          * @param minLevel Minimum log level to output
          * @param appId Application ID (max 4 bytes)
+         * @param bufferConfig Write batching (default: unbuffered)
+         * @param rotationConfig Rotation triggers (default: size only, inline on the writer; background rotation is opt-in)
+         * @param syncConfig Durability policy (default: none)
+         * @param spaceConfig Preallocation and page cache dropping (default: off)
          */
         explicit FileSink(
             core::StringView filePath,
             core::Size maxSize = 10 * 1024 * 1024,  // 10MB default
             core::UInt32 maxFiles = 5,
             LogLevel minLevel = LogLevel::kVerbose,
-            core::StringView appId = ""
+            core::StringView appId = "",
+            const FileBufferConfig& bufferConfig = FileBufferConfig(),
+            const FileRotationConfig& rotationConfig = FileRotationConfig(),
+            const FileSyncConfig& syncConfig = FileSyncConfig(),
+            const FileSpaceConfig& spaceConfig = FileSpaceConfig()
         ) noexcept;
         
         virtual ~FileSink() noexcept override;
@@ -59,17 +194,52 @@ namespace log
             core::StringView message
         ) noexcept override;
         
+        /**
+         * @brief Write out batched records to the OS buffer cache, no fdatasync wait
+         * @details The sync policy still applies to the bytes written out; use sync() for durability
+         */
         virtual void flush() noexcept override;
-        virtual core::Bool isEnabled() const noexcept override { return m_enabled && m_file.isOpen(); }
+        
+        virtual core::Bool writeEmergency(
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            core::StringView message
+        ) noexcept override;
+        
+        virtual core::Bool writeEmergencyUnbatched(
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            core::StringView message
+        ) noexcept override;
+        
+        virtual void flushEmergency() noexcept override;
+        
+        virtual core::UInt32 getFlushIntervalMs() const noexcept override
+        {
+            return m_bufferConfig.bufferSize > 0 ? m_bufferConfig.flushIntervalMs : 0;
+        }
+        
+        virtual void flushExpired(core::UInt32 slackMs) noexcept override;
+        virtual core::Bool isEnabled() const noexcept override { return m_enabled && m_file->isOpen(); }
         virtual core::StringView getName() const noexcept override { return "File"; }
-        virtual void setLevel(LogLevel level) noexcept override { m_minLevel = level; }
+        virtual void setLevel(LogLevel level) noexcept override { m_minLevel = level; notifyChanged(); }
         virtual core::Bool shouldLog(LogLevel level) const noexcept override;
         
         /**
          * @brief Enable/disable this sink
          * @param enabled Enable state
          */
-        void setEnabled(core::Bool enabled) noexcept { m_enabled = enabled; }
+        void setEnabled(core::Bool enabled) noexcept { m_enabled = enabled; notifyChanged(); }
+        
+        /**
+         * @brief Print the producer's kernel thread ID as "[tid:N]" after the context
+         * @param enabled Show thread ID (default: false)
+         */
+        void setWithThreadId(core::Bool enabled) noexcept { m_withThreadId = enabled; }
         
         /**
          * @brief Get current file size
@@ -78,11 +248,34 @@ namespace log
         core::Size getCurrentSize() const noexcept { return m_currentSize; }
         
         /**
-         * @brief Manually trigger log rotation
+         * @brief Manually trigger log rotation (synchronous, on the calling thread)
          * @return true if rotation succeeded, false otherwise
+         * @note Serialized with other processes through flock() on the directory; if another
+         *       process has rotated the file meanwhile, only the new file is opened
          */
         core::Bool rotate() noexcept;
         
+        /**
+         * @brief Wait until the rotator thread is idle: backups shifted, staging file opened
+         */
+        void waitRotation() noexcept;
+        
+        /**
+         * @brief Wait until the compressor thread has compressed every backup it found
+         */
+        void waitCompression() noexcept;
+        
+        /**
+         * @brief Write out batched records and fdatasync them, whatever the policy
+         * @return false if the file is not open or the sync failed
+         */
+        core::Bool sync() noexcept;
+        
+        /**
+         * @brief Syscalls issued so far by the writing and sync threads
+         */
+        FileIoStats getIoStats() const noexcept;
+        
     private:
         /**
          * @brief Open log file for writing (append mode with O_APPEND for atomicity)
@@ -100,15 +293,226 @@ namespace log
          */
         void checkRotation() noexcept;
         
+        /**
+         * @brief Rotate if the interval boundary has passed (time-based rotation)
+         */
+        void checkInterval() noexcept;
+        
+        /**
+         * @brief Switch to the staging file and hand the rest to the rotator thread
+         * @return false if the staging file is not available (caller rotates inline)
+         */
+        core::Bool rotateInBackground() noexcept;
+        
+        /**
+         * @brief Open the log file's directory and flock() it exclusively
+         * @return Descriptor holding the lock (close to release), -1 on failure
+         */
+        core::Int32 lockDirectory() const noexcept;
+        
+        /**
+         * @brief Rotator thread: shift backups after a switch, then open the next staging file
+         */
+        void rotatorLoop() noexcept;
+        
+        /**
+         * @brief <path>.N[.gz|.zst] -> <path>.N+1[...], newest -> <path>.1, dropping the oldest
+         * @param newest File to become <path>.1
+         */
+        void shiftBackups(const core::String& newest) noexcept;
+        
+        /**
+         * @brief Compressor thread: compress plain backups whenever the chain changed
+         */
+        void compressorLoop() noexcept;
+        
+        /**
+         * @brief Compress every uncompressed <path>.N, oldest first
+         */
+        void compressBackups() noexcept;
+        
+        /**
+         * @brief Wall-clock second of the first interval boundary after since
+         */
+        core::Int64 nextBoundary(core::Int64 since) const noexcept;
+        
+        /**
+         * @brief Rotator thread running in this process (not a fork() child copy)
+         */
+        core::Bool ownsRotator() const noexcept;
+        
+        /**
+         * @brief Compressor thread running in this process (not a fork() child copy)
+         */
+        core::Bool ownsCompressor() const noexcept;
+        
+        /**
+         * @brief Write "[timestamp] [APPID] [LEVEL] [context] " (plus "[tid:N] ") to out
+         * @param signalSafe Use the signal-safe timestamp formatter
+         * @return Prefix length, at most ~330 bytes
+         */
+        core::Size formatPrefix(char* out, core::UInt64 timestamp, core::UInt32 threadId, LogLevelType level,
+                                core::StringView contextId, core::Bool signalSafe) const noexcept;
+        
+        /**
+         * @brief Prefix + message (cut) + '\n' into line (EMERGENCY_LINE_SIZE bytes), signal-safe
+         * @return Line length
+         */
+        core::Size formatEmergencyLine(char* line, core::UInt64 timestamp, core::UInt32 threadId, LogLevelType level,
+                                       core::StringView contextId, core::StringView message) const noexcept;
+        
+        /**
+         * @brief Append one formatted line to the batch, flushing when a threshold is crossed
+         */
+        void appendBuffered(const char* line, core::Size len, LogLevelType level) noexcept;
+        
+        /**
+         * @brief Write out all batched records (PIPE_BUF chunks or one write under flock)
+         */
+        void flushBuffer() noexcept;
+        
+        /**
+         * @brief io_uring engine in use by this process
+         */
+        core::Bool usesRing() const noexcept;
+        
+        /**
+         * @brief Submit the batch as one linked chain (plus fsync if sync) and switch buffer halves
+         */
+        void submitBatch(core::Bool sync) noexcept;
+        
+        /**
+         * @brief Handle finished ring writes, rewriting short or cancelled chunks with write(2)
+         * @param waitFor Completions to block for, 0 = only what has finished
+         */
+        void reapWrites(core::UInt32 waitFor) noexcept;
+        
+        /**
+         * @brief Wait for every submitted ring request (before the descriptor changes or goes away)
+         */
+        void waitWrites() noexcept;
+        
+        /**
+         * @brief Ask for a sync if the policy calls for one after this record
+         */
+        void checkSync(LogLevelType level) noexcept;
+        
+        /**
+         * @brief Have everything written so far synced by the sync thread
+         * @param wait Block until that sync has completed
+         * @return false if a sync done on the calling thread failed
+         */
+        core::Bool requestSync(core::Bool wait) noexcept;
+        
+        /**
+         * @brief Sync thread: group commits on request or every intervalMs
+         */
+        void syncerLoop() noexcept;
+        
+        /**
+         * @brief fdatasync() the file currently at m_filePath
+         */
+        core::Bool syncFile() noexcept;
+        
+        /**
+         * @brief Sync thread running in this process (not a fork() child copy)
+         */
+        core::Bool ownsSyncer() const noexcept;
+        
+        /**
+         * @brief Reserve blocks for the file behind fd (FileSpaceConfig::preallocate)
+         */
+        void preallocate(core::Int32 fd) noexcept;
+        
+        /**
+         * @brief Give back the reserved blocks past the end of the file behind fd
+         */
+        void trimFile(core::Int32 fd) noexcept;
+        
+        /**
+         * @brief Drop the written range of the active file from the page cache
+         */
+        void dropCache() noexcept;
+        
+        /**
+         * @brief Write the batch as PIPE_BUF sized, record aligned chunks (no lock)
+         */
+        void writeChunks() noexcept;
+        
+        /**
+         * @brief write() until len bytes are out or an error occurs
+         */
+        void writeAll(const char* data, core::Size len) noexcept;
+        
     private:
         core::String    m_filePath;     ///< Log file path
-        core::File      m_file;         ///< File instance (RAII fd wrapper)
+        core::File      m_files[2];     ///< Active file and staging file (RAII fd wrappers)
+        core::File*     m_file;         ///< Active file, one of m_files
         core::Size      m_maxSize;      ///< Max size before rotation
         core::UInt32    m_maxFiles;     ///< Max backup files
         core::Size      m_currentSize;  ///< Current file size
         core::Bool      m_enabled;      ///< Enable state
+        core::Bool      m_withThreadId; ///< Print "[tid:N]"
         LogLevel        m_minLevel;     ///< Minimum log level
         char            m_appId[5];     ///< Application ID (4 bytes + null)
+        
+        FileBufferConfig        m_bufferConfig;     ///< Write batching configuration
+        core::Vector<char>      m_buffer;           ///< Batched lines, bufferSize bytes (two halves with io_uring)
+        char*                   m_batch;            ///< Half of m_buffer being filled
+        core::Size              m_bufferUsed;       ///< Bytes pending in m_buffer
+        core::Size              m_chunkStart;       ///< Start of the open PIPE_BUF chunk
+        core::Vector<core::Size> m_chunkEnds;       ///< Closed chunk boundaries (record aligned)
+        core::UInt64            m_firstPendingMs;   ///< Monotonic time of the oldest pending record
+        core::Int32             m_lockFd;           ///< Descriptor used for flock() in multi-process mode
+        core::UInt64            m_writeCalls;       ///< write(2) calls, see getIoStats()
+        
+        IoUringWriter           m_ring;             ///< io_uring engine, not ready = write(2)
+        core::Int32             m_ringFd;           ///< Write descriptor of the active file for the ring
+        core::Int32             m_nextRingFd;       ///< Same for the staging file
+        core::UInt32            m_ringPending[2];   ///< Chunks in flight per buffer half
+        
+        FileSyncConfig          m_syncConfig;       ///< Durability policy
+        ::std::thread           m_syncer;           ///< fdatasync thread
+        pid_t                   m_syncerPid;        ///< Process that started m_syncer
+        ::std::mutex            m_syncMutex;        ///< Guards the fields below
+        ::std::condition_variable m_syncCv;
+        core::Bool              m_syncStop;         ///< Sync thread exits
+        core::UInt64            m_syncTarget;       ///< Highest m_writtenBytes a sync was requested for
+        core::UInt64            m_syncedBytes;      ///< m_writtenBytes value covered by the last completed sync
+        ::std::atomic<core::UInt64> m_writtenBytes; ///< Bytes handed to the kernel, all files (writer only)
+        core::UInt64            m_nextSyncAt;       ///< kEveryBytes: m_writtenBytes that triggers the next request
+        ::std::atomic<core::UInt64> m_syncCalls;    ///< fdatasync(2) calls, see getIoStats()
+        
+        FileSpaceConfig         m_spaceConfig;      ///< Preallocation and page cache dropping
+        core::Int32             m_spaceFd;          ///< Descriptor of the active file for fallocate/fadvise/ftruncate, -1 = off
+        core::Int32             m_nextSpaceFd;      ///< Same for the staging file
+        pid_t                   m_spacePid;         ///< Process that opened the files: only it trims them
+        core::Size              m_dropFrom;         ///< Start of the range not dropped from the cache yet
+        core::Size              m_dropMark;         ///< End of the range whose writeback the last drop started
+        core::Bool              m_preallocFailed;   ///< fallocate unsupported here, warned once
+        
+        FileRotationConfig      m_rotationConfig;   ///< Rotation triggers
+        core::Int64             m_nextRotateSec;    ///< Wall-clock second of the next interval boundary, 0 = none
+        core::String            m_nextPath;         ///< Staging file "<path>.next"
+        core::String            m_rotatingPath;     ///< Rotated out file awaiting the backup shift "<path>.rotating"
+        ::std::thread           m_rotator;          ///< Background rename/cleanup thread
+        pid_t                   m_rotatorPid;       ///< Process that started m_rotator
+        ::std::mutex            m_rotateMutex;      ///< Guards the staging file and the flags below
+        ::std::condition_variable m_rotateCv;
+        core::Bool              m_rotateStop;       ///< Rotator thread exits when idle
+        core::Bool              m_rotatorIdle;      ///< Rotator thread waits for work
+        core::Bool              m_nextReady;        ///< Staging file open in the other m_files slot
+        core::Bool              m_jobPending;       ///< Retired file in the other slot awaits close and backup shift
+        core::Int32             m_nextLockFd;       ///< flock() descriptor of the staging file (multi-process mode)
+        
+        ::std::mutex            m_backupMutex;      ///< Held while backup names change (shift, compressed file in place)
+        ::std::thread           m_compressor;       ///< Background compression thread
+        pid_t                   m_compressorPid;    ///< Process that started m_compressor
+        ::std::mutex            m_compressMutex;    ///< Guards the two flags below
+        ::std::condition_variable m_compressCv;
+        core::Bool              m_compressPending;  ///< Backup chain changed since the last scan
+        core::Bool              m_compressBusy;     ///< Scan in progress
+        ::std::atomic<core::Bool> m_compressStop;   ///< Abandons the file being compressed
     };
     
 } // namespace log
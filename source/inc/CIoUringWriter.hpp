@@ -0,0 +1,159 @@
+/**
+ * @file        CIoUringWriter.hpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Minimal io_uring submission engine for append-only log files
+ * @date        2026-10-16
+ * @details     Raw io_uring_setup/enter/register syscalls, no liburing dependency.
+ *              Compiled to a stub that is never ready when <linux/io_uring.h> is missing
+ * @copyright   Copyright (c) 2025
+ */
+
+#ifndef LAP_LOG_IOURINGWRITER_HPP
+#define LAP_LOG_IOURINGWRITER_HPP
+
+#include <lap/core/CTypedef.hpp>
+#include <sys/types.h>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace lap
+{
+namespace log
+{
+    /**
+     * @brief Asynchronous writes and fsyncs through one io_uring instance
+     *
+     * Features:
+     * - One buffer region registered once, writes use IORING_OP_WRITE_FIXED
+     *   (plain IORING_OP_WRITE when registration is refused, e.g. RLIMIT_MEMLOCK)
+     * - Requests queued between two submit() calls form one linked chain
+     *   (IOSQE_IO_LINK) and execute in order; the first request of a chain is
+     *   drained (IOSQE_IO_DRAIN) behind everything submitted before, so the
+     *   file sees the same order as the sequence of queue calls
+     * - Completions are reaped by the owner thread, no helper thread
+     * - Not thread-safe: one owner, like the FileSink that holds it
+     * - Ring memory is shared with fork() children: only the creating process
+     *   sees the engine as ready
+     */
+    class IoUringWriter final
+    {
+    public:
+        /**
+         * @brief One reaped completion
+         */
+        struct Completion
+        {
+            core::UInt64    userData;   ///< Value passed to queueWrite()/queueFsync()
+            core::Int32     result;     ///< Bytes written, 0 for fsync, or -errno (-ECANCELED: earlier link failed)
+        };
+
+        IoUringWriter() noexcept;
+        ~IoUringWriter() noexcept;
+
+        IoUringWriter(const IoUringWriter&) = delete;
+        IoUringWriter& operator=(const IoUringWriter&) = delete;
+
+        /**
+         * @brief Whether this build can use io_uring at all
+         */
+        static core::Bool isSupported() noexcept;
+
+        /**
+         * @brief Create the ring and register [buffer, buffer + size)
+         * @param entries Submission queue size (rounded up to a power of two by the kernel)
+         * @return false with errno set if io_uring is unavailable (old kernel, seccomp, sysctl)
+         */
+        core::Bool init(core::UInt32 entries, void* buffer, core::Size size) noexcept;
+
+        /**
+         * @brief Unmap and close the ring, requests not yet submitted are discarded
+         */
+        void close() noexcept;
+
+        /**
+         * @brief Ring open and created by this process
+         */
+        core::Bool isReady() const noexcept;
+
+        /**
+         * @brief Queue a write of [data, data + len) to fd (O_APPEND files: appended)
+         * @param data Must lie inside the registered region
+         * @return false if the submission queue is full and could not be submitted
+         */
+        core::Bool queueWrite(core::Int32 fd, const void* data, core::UInt32 len, core::UInt64 userData) noexcept;
+
+        /**
+         * @brief Queue an fsync (fdatasync if dataOnly) of fd after the writes queued before it
+         * @return false if the submission queue is full and could not be submitted
+         */
+        core::Bool queueFsync(core::Int32 fd, core::Bool dataOnly, core::UInt64 userData) noexcept;
+
+        /**
+         * @brief Hand the queued chain to the kernel (one io_uring_enter)
+         * @return false with errno set on failure; the chain stays queued
+         */
+        core::Bool submit() noexcept;
+
+        /**
+         * @brief Collect finished requests
+         * @param waitFor Block until this many completions are available (capped at the requests in flight), 0 = poll
+         * @return Number of entries stored in out
+         */
+        core::UInt32 reap(Completion* out, core::UInt32 max, core::UInt32 waitFor) noexcept;
+
+        /**
+         * @brief Block until every submitted request has completed, without reaping
+         * @note Async-signal-safe: only io_uring_enter(), no ring state is modified
+         */
+        void waitIdle() const noexcept;
+
+        /**
+         * @brief Submitted requests whose completion has not been reaped yet
+         */
+        core::UInt32 getInflight() const noexcept { return m_inflight; }
+
+        /**
+         * @brief io_uring_enter() calls made so far (submissions and waits)
+         */
+        core::UInt64 getEnterCount() const noexcept { return m_enterCount; }
+
+    private:
+        /**
+         * @brief Next free SQE, submitting the current chain first if the queue is full
+         * @return nullptr if the queue stays full
+         */
+        io_uring_sqe* nextSqe() noexcept;
+
+        core::Int32 enter(core::UInt32 toSubmit, core::UInt32 minComplete, core::UInt32 flags) const noexcept;
+
+    private:
+        core::Int32     m_ringFd;       ///< io_uring instance, -1 = not ready
+        pid_t           m_pid;          ///< Process that created the ring
+        void*           m_sqRing;       ///< SQ ring mapping (also the CQ ring with IORING_FEAT_SINGLE_MMAP)
+        core::Size      m_sqRingSize;
+        void*           m_cqRing;       ///< CQ ring mapping, m_sqRing when shared
+        core::Size      m_cqRingSize;
+        io_uring_sqe*   m_sqes;         ///< SQE array mapping
+        core::Size      m_sqesSize;
+        core::UInt32*   m_sqHead;
+        core::UInt32*   m_sqTail;
+        core::UInt32*   m_sqArray;
+        core::UInt32    m_sqMask;
+        core::UInt32    m_sqEntries;
+        core::UInt32*   m_cqHead;
+        core::UInt32*   m_cqTail;
+        io_uring_cqe*   m_cqes;
+        core::UInt32    m_cqMask;
+        core::UInt32    m_localTail;    ///< SQ tail including queued, unpublished SQEs
+        core::UInt32    m_queued;       ///< SQEs queued since the last submit
+        io_uring_sqe*   m_lastSqe;      ///< Tail of the chain being built, gets IOSQE_IO_LINK on the next queue
+        core::UInt32    m_inflight;     ///< Submitted, not reaped
+        core::Bool      m_fixed;        ///< Buffer registered, WRITE_FIXED usable
+        mutable core::UInt64 m_enterCount;
+    };
+
+} // namespace log
+} // namespace lap
+
+#endif // LAP_LOG_IOURINGWRITER_HPP
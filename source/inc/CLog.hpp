@@ -30,21 +30,25 @@ namespace log
 {
     #define LAP_LOG( ... )                                      ::lap::log::CreateLogger( __VA_ARGS__ )
 
-    #define LAP_LOG_VERBOSE( ... )                              LAP_LOG( __VA_ARGS__ ).LogVerbose()
-    #define LAP_LOG_DEBUG( ... )                                LAP_LOG( __VA_ARGS__ ).LogDebug()
-    #define LAP_LOG_INFO( ... )                                 LAP_LOG( __VA_ARGS__ ).LogInfo()
-    #define LAP_LOG_WARN( ... )                                 LAP_LOG( __VA_ARGS__ ).LogWarn()
-    #define LAP_LOG_ERROR( ... )                                LAP_LOG( __VA_ARGS__ ).LogError()
-    #define LAP_LOG_FATAL( ... )                                LAP_LOG( __VA_ARGS__ ).LogFatal()
-    #define LAP_LOG_OFF( ... )                                  LAP_LOG( __VA_ARGS__ ).LogOff()
+    // Short-circuits on Logger::ShouldLog(): when the level is disabled no LogStream is
+    // built and none of the streamed arguments are evaluated. Safe in if/else chains.
+    #define LAP_LOG_WITH_LEVEL( level, ... )                    if ( auto& _lapLogger = LAP_LOG( __VA_ARGS__ ); !_lapLogger.ShouldLog( level ) ) {} else _lapLogger.WithLevel( level )
 
-    #define LAP_LOG_VERBOSE_WITH_FILE_LINE( ... )               LAP_LOG( __VA_ARGS__ ).LogVerbose().WithLocation( __FILE__, __LINE__ )
-    #define LAP_LOG_DEBUG_WITH_FILE_LINE( ... )                 LAP_LOG( __VA_ARGS__ ).LogDebug().WithLocation( __FILE__, __LINE__ )
-    #define LAP_LOG_INFO_WITH_FILE_LINE( ... )                  LAP_LOG( __VA_ARGS__ ).LogInfo().WithLocation( __FILE__, __LINE__ )
-    #define LAP_LOG_WARN_WITH_FILE_LINE( ... )                  LAP_LOG( __VA_ARGS__ ).LogWarn().WithLocation( __FILE__, __LINE__ )
-    #define LAP_LOG_ERROR_WITH_FILE_LINE( ... )                 LAP_LOG( __VA_ARGS__ ).LogError().WithLocation( __FILE__, __LINE__ )
-    #define LAP_LOG_FATAL_WITH_FILE_LINE( ... )                 LAP_LOG( __VA_ARGS__ ).LogFatal().WithLocation( __FILE__, __LINE__ )
-    #define LAP_LOG_OFF_WITH_FILE_LINE( ... )                   LAP_LOG( __VA_ARGS__ ).LogOff().WithLocation( __FILE__, __LINE__ )
+    #define LAP_LOG_VERBOSE( ... )                              LAP_LOG_WITH_LEVEL( ::lap::log::LogLevel::kVerbose, __VA_ARGS__ )
+    #define LAP_LOG_DEBUG( ... )                                LAP_LOG_WITH_LEVEL( ::lap::log::LogLevel::kDebug, __VA_ARGS__ )
+    #define LAP_LOG_INFO( ... )                                 LAP_LOG_WITH_LEVEL( ::lap::log::LogLevel::kInfo, __VA_ARGS__ )
+    #define LAP_LOG_WARN( ... )                                 LAP_LOG_WITH_LEVEL( ::lap::log::LogLevel::kWarn, __VA_ARGS__ )
+    #define LAP_LOG_ERROR( ... )                                LAP_LOG_WITH_LEVEL( ::lap::log::LogLevel::kError, __VA_ARGS__ )
+    #define LAP_LOG_FATAL( ... )                                LAP_LOG_WITH_LEVEL( ::lap::log::LogLevel::kFatal, __VA_ARGS__ )
+    #define LAP_LOG_OFF( ... )                                  LAP_LOG_WITH_LEVEL( ::lap::log::LogLevel::kOff, __VA_ARGS__ )
+
+    #define LAP_LOG_VERBOSE_WITH_FILE_LINE( ... )               LAP_LOG_VERBOSE( __VA_ARGS__ ).WithLocation( __FILE__, __LINE__ )
+    #define LAP_LOG_DEBUG_WITH_FILE_LINE( ... )                 LAP_LOG_DEBUG( __VA_ARGS__ ).WithLocation( __FILE__, __LINE__ )
+    #define LAP_LOG_INFO_WITH_FILE_LINE( ... )                  LAP_LOG_INFO( __VA_ARGS__ ).WithLocation( __FILE__, __LINE__ )
+    #define LAP_LOG_WARN_WITH_FILE_LINE( ... )                  LAP_LOG_WARN( __VA_ARGS__ ).WithLocation( __FILE__, __LINE__ )
+    #define LAP_LOG_ERROR_WITH_FILE_LINE( ... )                 LAP_LOG_ERROR( __VA_ARGS__ ).WithLocation( __FILE__, __LINE__ )
+    #define LAP_LOG_FATAL_WITH_FILE_LINE( ... )                 LAP_LOG_FATAL( __VA_ARGS__ ).WithLocation( __FILE__, __LINE__ )
+    #define LAP_LOG_OFF_WITH_FILE_LINE( ... )                   LAP_LOG_OFF( __VA_ARGS__ ).WithLocation( __FILE__, __LINE__ )
 } // namespace log
 } // namespace lap
 #endif
\ No newline at end of file
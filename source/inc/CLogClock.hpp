@@ -0,0 +1,76 @@
+/**
+ * @file        CLogClock.hpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Record timestamp clock
+ * @date        2026-10-16
+ * @details     Nanosecond wall clock read once per record, in the LogStream constructor
+ * @copyright   Copyright (c) 2025
+ */
+
+#ifndef LAP_LOG_LOGCLOCK_HPP
+#define LAP_LOG_LOGCLOCK_HPP
+
+#include <lap/core/CTypedef.hpp>
+#include <lap/core/CString.hpp>
+
+namespace lap
+{
+namespace log
+{
+    /**
+     * @brief Clock used to stamp log records
+     */
+    enum class ClockSource : core::UInt8
+    {
+        kRealtime       = 0x00,     // CLOCK_REALTIME through the vDSO, ns resolution (default)
+        kRealtimeCoarse = 0x01,     // CLOCK_REALTIME_COARSE, cheapest read, scheduler tick resolution
+        kMonotonic      = 0x02,     // CLOCK_MONOTONIC anchored to the wall clock once, immune to clock steps
+        kTsc            = 0x03,     // Invariant TSC calibrated against CLOCK_MONOTONIC (x86 only, else kMonotonic)
+    };
+
+    constexpr inline core::StringView toString( const ClockSource& source ) noexcept
+    {
+        switch( source )
+        {
+        case ClockSource::kRealtime:        return "realtime";
+        case ClockSource::kRealtimeCoarse:  return "realtimeCoarse";
+        case ClockSource::kMonotonic:       return "monotonic";
+        case ClockSource::kTsc:             return "tsc";
+        default:                            return "realtime";
+        }
+    }
+
+    /**
+     * @brief Process wide record clock
+     *
+     * Features:
+     * - now() returns nanoseconds since the Unix epoch for every source
+     * - kMonotonic/kTsc timestamps never go backwards; they follow the wall
+     *   clock as it was when the source was selected (re-anchor by selecting
+     *   the source again)
+     * - kTsc reads the time stamp counter (no vDSO call) and scales it with a
+     *   32.32 fixed point factor measured over ~10 ms at selection
+     */
+    class LogClock final
+    {
+    public:
+        LogClock() = delete;
+
+        /**
+         * @brief Read the current time
+         * @return Nanoseconds since epoch
+         */
+        static core::UInt64 now() noexcept;
+
+        /**
+         * @brief Select the clock source, calibrating/anchoring it as needed
+         * @return The source in use (kTsc falls back to kMonotonic without an invariant TSC)
+         */
+        static ClockSource  setSource( ClockSource source ) noexcept;
+        static ClockSource  getSource() noexcept;
+    };
+
+} // namespace log
+} // namespace lap
+
+#endif // LAP_LOG_LOGCLOCK_HPP
@@ -0,0 +1,179 @@
+/**
+ * @file        CLogCollector.hpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Local log collector: drains per-process shared memory rings into one set of sinks
+ * @date        2026-10-16
+ * @details     Client side: ShmRingSink in collected mode (JSON sink "collector"),
+ *              host process: test/examples/log_collector.cpp, design: doc/design/LogCollector_Design.md
+ * @copyright   Copyright (c) 2025
+ */
+
+#ifndef LAP_LOG_LOGCOLLECTOR_HPP
+#define LAP_LOG_LOGCOLLECTOR_HPP
+
+#include "ISink.hpp"
+#include <lap/core/CTypedef.hpp>
+#include <lap/core/CMemory.hpp>
+#include <lap/core/CString.hpp>
+#include <atomic>
+#include <sys/types.h>
+
+namespace lap
+{
+namespace log
+{
+    class SinkManager;
+
+    /**
+     * @brief Single owner of the log files for many client processes
+     *
+     * Features:
+     * - Client processes log into their own ShmRingSink in collected mode
+     *   (<directory>/lightap-collect-<appId>-<pid>.ring); nothing they do
+     *   touches the files, so there is no cross-process lock and no rotation race
+     * - One collector thread attaches to every ring found in the directory,
+     *   replays the records in ring order through SinkManager (text, deferred
+     *   and modeled records keep their timestamp and thread ID) and releases
+     *   the space by advancing the ring tail
+     * - Records a client refused because its ring was full are reported as
+     *   one WARN record per client and drain pass
+     * - A ring whose client has shut down (closed flag) or died is drained,
+     *   then removed; records torn by a dying client are skipped
+     * - Each ring is locked (flock) by the collector that attached it: a second
+     *   collector on the same directory leaves it alone
+     * - Client liveness is checked with kill(pid, 0): clients and collector
+     *   must share a PID namespace
+     * - Not thread-safe: poll()/run() from one thread
+     */
+    class LogCollector final
+    {
+    public:
+        IMP_OPERATOR_NEW(LogCollector)
+
+        /**
+         * @brief Collector configuration
+         */
+        struct Config
+        {
+            core::String    directory;          ///< Where clients create their rings
+            core::UInt32    idleWaitMs;         ///< run(): sleep when every ring is empty
+            core::UInt32    scanIntervalMs;     ///< Look for new rings (and dead clients) at most this often
+
+            Config() noexcept
+                : directory("/dev/shm")
+                , idleWaitMs(2)
+                , scanIntervalMs(200)
+            {}
+        };
+
+        /**
+         * @brief Collector statistics snapshot
+         */
+        struct Stats
+        {
+            core::UInt64    records{ 0 };       ///< Records handed to the sinks
+            core::UInt64    dropped{ 0 };       ///< Records clients refused, ring full
+            core::UInt64    tornBytes{ 0 };     ///< Ring bytes skipped behind clients that died mid-record
+            core::UInt64    retired{ 0 };       ///< Rings drained and removed
+            core::Size      rings{ 0 };         ///< Rings attached now
+        };
+
+        explicit LogCollector(SinkManager& sinkManager, const Config& config = Config()) noexcept;
+        ~LogCollector() noexcept;
+
+        LogCollector(const LogCollector&) = delete;
+        LogCollector& operator=(const LogCollector&) = delete;
+
+        /**
+         * @brief One pass: attach new rings (if the scan is due), drain all, retire finished ones
+         * @return Records forwarded in this pass
+         */
+        core::Size poll() noexcept;
+
+        /**
+         * @brief poll() until stop is raised, then drain what is left and flush the sinks
+         * @details Sinks are flushed whenever the rings run empty
+         */
+        void run(const ::std::atomic<core::Bool>& stop) noexcept;
+
+        Stats getStats() const noexcept;
+
+    private:
+        /**
+         * @brief One attached client ring
+         */
+        struct Ring
+        {
+            core::String                    path;
+            dev_t                           device;
+            ino_t                           inode;
+            core::Int32                     fd;             ///< Holds the flock that makes this collector the only consumer
+            core::UInt8*                    map;
+            core::Size                      mapSize;
+            core::UInt8*                    data;           ///< Ring data, capacity bytes
+            core::Size                      capacity;
+            core::UInt32                    pid;            ///< Client process
+            ::std::atomic<core::UInt64>*    head;
+            ::std::atomic<core::UInt64>*    tail;
+            ::std::atomic<core::UInt64>*    dropped;
+            ::std::atomic<core::UInt32>*    flags;
+            core::UInt64                    reportedDrops;  ///< dropped value already reported
+            core::UInt64                    checkedAliveMs; ///< Last liveness check of pid
+            core::Bool                      gone;           ///< Client closed or dead: nothing more will commit
+        };
+
+        /**
+         * @brief Attach rings created since the last scan
+         */
+        void scan() noexcept;
+
+        /**
+         * @brief Map and validate one ring file
+         * @return false if it is not (yet) a collected ring
+         */
+        core::Bool attach(const core::String& path, Ring& ring) noexcept;
+
+        /**
+         * @brief Forward the committed records between tail and head
+         */
+        core::Size drain(Ring& ring) noexcept;
+
+        /**
+         * @brief Replay the committed record at pos through the sinks
+         */
+        void forward(const Ring& ring, core::UInt64 pos, core::UInt32 size) noexcept;
+
+        /**
+         * @brief Copy len bytes from ring stream position pos, wrapping at the end
+         */
+        static void copyOut(const Ring& ring, core::UInt64 pos, void* dst, core::Size len) noexcept;
+
+        /**
+         * @brief WARN record for records the client dropped since the last report
+         */
+        void reportDrops(Ring& ring) noexcept;
+
+        /**
+         * @brief Client closed its ring or exited (checked at most every scanIntervalMs)
+         */
+        core::Bool clientGone(Ring& ring, core::UInt64 nowMs) noexcept;
+
+        void detach(Ring& ring, core::Bool remove) noexcept;
+
+    private:
+        SinkManager&                            m_sinkManager;
+        Config                                  m_config;
+        core::Vector<Ring>                      m_rings;
+        core::UInt64                            m_lastScanMs;
+        core::Vector<LogEntry>                  m_entry;        ///< Replay buffer, LogEntry aligned
+        ::std::atomic<core::UInt64>             m_records;
+        ::std::atomic<core::UInt64>             m_dropped;
+        ::std::atomic<core::UInt64>             m_tornBytes;
+        ::std::atomic<core::UInt64>             m_retired;
+        ::std::atomic<core::Size>               m_ringCount;
+    };
+
+} // namespace log
+} // namespace lap
+
+#endif // LAP_LOG_LOGCOLLECTOR_HPP
@@ -0,0 +1,88 @@
+/**
+ * @file        CLogCompressor.hpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Streaming gzip/zstd compression of rotated log files
+ * @date        2026-10-16
+ * @details     Codecs are compiled in when zlib (LAP_LOG_HAS_ZLIB) / libzstd (LAP_LOG_HAS_ZSTD) are found
+ * @copyright   Copyright (c) 2025
+ */
+
+#ifndef LAP_LOG_LOGCOMPRESSOR_HPP
+#define LAP_LOG_LOGCOMPRESSOR_HPP
+
+#include <lap/core/CTypedef.hpp>
+#include <lap/core/CString.hpp>
+#include <atomic>
+
+namespace lap
+{
+namespace log
+{
+    /**
+     * @brief Compression applied to rotated log files
+     */
+    enum class CompressionType : core::UInt8
+    {
+        kNone   = 0x00,
+        kGzip   = 0x01,     // ".gz", zlib deflate with gzip header
+        kZstd   = 0x02,     // ".zst", zstd frame
+    };
+
+    constexpr inline core::StringView toString( const CompressionType& type ) noexcept
+    {
+        switch( type )
+        {
+        case CompressionType::kGzip:        return "gzip";
+        case CompressionType::kZstd:        return "zstd";
+        default:                            return "none";
+        }
+    }
+
+    /**
+     * @brief Whole-file compressor used by FileSink's background compression thread
+     *
+     * Features:
+     * - Streams kChunkSize blocks: memory use is independent of the file size
+     * - Rate budget: input consumption is held to bytesPerSec, which bounds
+     *   both CPU time and the read/write bandwidth taken from the device
+     * - Cancellable between chunks (process shutdown does not wait for a large file)
+     * - Destination keeps the source's modification time
+     */
+    class LogCompressor final
+    {
+    public:
+        static constexpr core::Size     kChunkSize          = 64 * 1024;
+        static constexpr core::Int32    kDefaultGzipLevel   = 6;
+        static constexpr core::Int32    kDefaultZstdLevel   = 3;
+
+        LogCompressor() = delete;
+
+        /**
+         * @brief File name suffix of a codec (".gz", ".zst", "" for kNone)
+         */
+        static const char*  suffix( CompressionType type ) noexcept;
+
+        /**
+         * @brief Whether the codec was compiled in
+         */
+        static core::Bool   isAvailable( CompressionType type ) noexcept;
+
+        /**
+         * @brief Compress everything readable from srcFd into a new file dstPath
+         * @param srcFd Source descriptor, read from its current offset to EOF (not closed)
+         * @param dstPath Destination, created or truncated
+         * @param type Codec, must be available
+         * @param level Codec level, 0 = codec default
+         * @param bytesPerSec Input budget, 0 = unthrottled
+         * @param stop Checked between chunks, nullptr = never cancelled
+         * @return true if dstPath is complete; on false the caller removes dstPath
+         */
+        static core::Bool   compressFile( core::Int32 srcFd, const core::String& dstPath, CompressionType type,
+                                          core::Int32 level, core::Size bytesPerSec,
+                                          const ::std::atomic< core::Bool >* stop ) noexcept;
+    };
+
+} // namespace log
+} // namespace lap
+
+#endif // LAP_LOG_LOGCOMPRESSOR_HPP
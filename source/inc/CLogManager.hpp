@@ -26,6 +26,12 @@
 #include "CCommon.hpp"
 #include "CLogger.hpp"
 #include "CSinkManager.hpp"
+#include "CAsyncLogQueue.hpp"
+#include "CNumberFormat.hpp"
+#include "CFileSink.hpp"
+#include "CConsoleSink.hpp"
+#include "CLogClock.hpp"
+#include "CTimestampFormat.hpp"
 #include <lap/core/CInstanceSpecifier.hpp>
 #include <nlohmann/json.hpp>
 
@@ -58,10 +64,34 @@ namespace log
             core::Int8               iWithEcuId;
             core::Bool               isLogMarker;
             core::Bool               isVerboseMode;
+            core::Bool               isWithThreadId;        // File/console lines carry "[tid:N]" (default: false)
+            ConsoleConfig            consoleConfig;         // ConsoleSink stream and batching ("console" block, default: stderr, unbatched)
             
             // FileSink rotation configuration
             core::Size               logFileMaxSize;        // Max file size in bytes (default: 10MB)
             core::UInt32             logFileMaxBackups;     // Max backup files (default: 5)
+            FileBufferConfig         fileBufferConfig;      // FileSink write batching ("fileBuffer" block, default: off)
+            FileRotationConfig       fileRotationConfig;    // Time-based/background rotation, compression ("fileRotation" block, default: size only, background, uncompressed)
+            FileSyncConfig           fileSyncConfig;        // FileSink durability policy ("fileSync" block, default: none)
+            FileSpaceConfig          fileSpaceConfig;       // FileSink preallocation and page cache dropping ("fileSpace" block, default: off)
+
+            // Hard cap of one record; longer messages spill from the inline buffer to the thread arena
+            core::Size               maxMessageSize;        // Bytes (default: LogStream::DEFAULT_MAX_MESSAGE_SIZE)
+            core::Bool               isDeferredFormat;      // LogStream records encoded values, consumers render text (default: false)
+
+            // Async queue configuration ("asyncQueue" block)
+            core::Bool               isAsyncEnabled;        // Route records through AsyncLogQueue (default: false)
+            AsyncLogQueue::Config    asyncConfig;           // Ring size, batch size, timeouts
+
+            // Fatal signal handler ("crashHandler" block)
+            core::Bool               isCrashHandlerEnabled; // Install CrashHandler on initialize (default: false)
+
+            // Numeric output configuration ("floatFormat" block)
+            NumberFormat::FloatConfig floatConfig;          // Float/Double text format and precision
+
+            // Record timestamp configuration ("timestamp" block)
+            ClockSource              clockSource;           // Clock read in the LogStream constructor (default: realtime)
+            TimestampPrecision       timestampPrecision;    // Fraction digits in file/console output (default: ms)
         };
 
     public:
@@ -105,6 +135,9 @@ namespace log
         inline SinkManager&                 getSinkManager() noexcept                                   { return m_sinkManager; }
         inline const SinkManager&           getSinkManager() const noexcept                             { return m_sinkManager; }
 
+        // Async queue (nullptr when async mode is disabled)
+        inline AsyncLogQueue*               getAsyncQueue() noexcept                                    { return m_asyncQueue.get(); }
+
         // inline void                         setDefaultLogLevel( LogLevel level ) noexcept       { m_logConfig.logTraceDefaultLogLevel = level; }
         // inline LogLevel                     defaultLogLevel() noexcept                          { return m_logConfig.logTraceDefaultLogLevel; }
 
@@ -118,11 +151,23 @@ namespace log
         void                                resetLogConfig() noexcept;
         core::Bool                          initWithLogConfig() noexcept;
         void                                initializeSinks() noexcept;
+        // SinkManager::LevelListener: push the new maximum level into every Logger
+        static void                         onSinkLevelChanged( void* context, LogLevel maxLevel ) noexcept;
         // Load and parse logging config from Core::ConfigManager (module: "logConfig")
         core::Bool                          loadFromCoreConfig() noexcept;
         // Save current log config to Core::ConfigManager
         void                                saveToCoreConfig() noexcept;
         void                                createSinkFromConfig(const nlohmann::json& sinkConfig) noexcept;
+        // Read "stream"/"bufferSize"/"flushIntervalMs"/"forceColor" from obj, keeping absent keys
+        static void                         parseConsoleConfig(const nlohmann::json& obj, ConsoleConfig& config) noexcept;
+        // Read "bufferSize"/"flushIntervalMs"/"multiProcess"/"ioEngine" from obj, keeping absent keys
+        static void                         parseFileBufferConfig(const nlohmann::json& obj, FileBufferConfig& config) noexcept;
+        // Read "rotateInterval"/"rotateInBackground"/"compression*" from obj, keeping absent keys
+        static void                         parseFileRotationConfig(const nlohmann::json& obj, FileRotationConfig& config) noexcept;
+        // Read "syncPolicy"/"syncIntervalMs"/"syncEveryBytes" from obj, keeping absent keys
+        static void                         parseFileSyncConfig(const nlohmann::json& obj, FileSyncConfig& config) noexcept;
+        // Read "preallocate"/"preallocateBytes"/"dropCacheBytes" from obj, keeping absent keys
+        static void                         parseFileSpaceConfig(const nlohmann::json& obj, FileSpaceConfig& config) noexcept;
 
         core::StringView                    formatId( core::StringView strId ) const noexcept;
         LogLevel                            formatLevel( core::StringView strLevel ) const noexcept;
@@ -142,6 +187,7 @@ namespace log
         core::UniqueHandle< Logger >        m_defaultLogCtx{ nullptr };
         
         SinkManager                         m_sinkManager;      // Sink manager for Console/File/Syslog outputs
+        core::UniqueHandle< AsyncLogQueue > m_asyncQueue;       // Async backend, destroyed before m_sinkManager
     };
 } // namespace log
 } // namespace lap
@@ -24,8 +24,11 @@
 #include <lap/core/CInstanceSpecifier.hpp>
 #include <lap/core/CMemory.hpp>
 #include <lap/core/CSpan.hpp>
+#include <atomic>
 
 #include "CCommon.hpp"
+#include "CLogClock.hpp"
+#include "CThreadId.hpp"
 
 namespace lap
 {
@@ -35,19 +38,39 @@ namespace log
     struct LogHex16 { core::UInt16 value; };
     struct LogHex32 { core::UInt32 value; };
     struct LogHex64 { core::UInt64 value; };
-    struct LogBin8  { core::UInt8 value; };
-    struct LogBin16 { core::UInt16 value; };
-    struct LogBin32 { core::UInt32 value; };
-    struct LogBin64 { core::UInt64 value; };
+    struct LogBin8  { core::UInt8 value;  core::Bool grouped{ false }; };    // grouped: '_' between nibbles
+    struct LogBin16 { core::UInt16 value; core::Bool grouped{ false }; };
+    struct LogBin32 { core::UInt32 value; core::Bool grouped{ false }; };
+    struct LogBin64 { core::UInt64 value; core::Bool grouped{ false }; };
 
     class Logger;
+    class LogManager;
     class LogStream final
     {
     public:
-        static constexpr size_t MAX_LOG_SIZE = 200;  // Fixed log message size
+        static constexpr size_t MAX_LOG_SIZE = 200;  // Inline buffer size, longer messages spill to the thread arena
+        static constexpr size_t DEFAULT_MAX_MESSAGE_SIZE = 16384;  // Default hard cap of one record
+        static constexpr size_t MAX_MESSAGE_SIZE_LIMIT = 65535;  // LogEntry::messageLen is 16 bit
         
         IMP_OPERATOR_NEW(LogStream)  // Use Core Memory allocator (256-byte block)
 
+        /** @fn         void SetMaxMessageSize( size_t size ) noexcept;
+         *  @brief      Set the hard cap of one record, clamped to [MAX_LOG_SIZE - 1, MAX_MESSAGE_SIZE_LIMIT]
+         *  @details    A message never splits: output beyond the cap is dropped
+         */
+        static void     SetMaxMessageSize( size_t size ) noexcept;
+        static size_t   GetMaxMessageSize() noexcept;
+
+        /** @fn         void SetDeferredFormat( bool enable ) noexcept;
+         *  @brief      Deferred formatting of streams created from now on
+         *  @details    Enabled: operator<< appends the ArgEncoder binary encoding of each value
+         *              (a tag byte plus memcpy) instead of text; the record is rendered by the
+         *              consumer (async worker, sink or offline decoder) with identical output.
+         *              See doc/design/ArgEncoding_Format.md
+         */
+        static void     SetDeferredFormat( bool enable ) noexcept   { s_deferredFormat.store( enable, ::std::memory_order_relaxed ); }
+        static bool     IsDeferredFormat() noexcept                 { return s_deferredFormat.load( ::std::memory_order_relaxed ); }
+
         void        Flush () noexcept;
         LogStream&  WithLocation ( core::StringView file, core::Int32 line ) noexcept;
 
@@ -96,13 +119,40 @@ namespace log
          */
     LogStream&  logFormat ( const core::Char *fmt, ... ) noexcept;
 
-        ~LogStream() noexcept;
+        inline ~LogStream() noexcept
+        {
+            // Flush any remaining content
+            if ( m_bufferPos > 0 ) {
+                flushBuffer();
+            }
+            if ( m_logBuffer != m_inlineBuffer ) {
+                releaseSpill();
+            }
+        }
+
+        /** @fn         bool IsEnabled () const noexcept;
+         *  @brief      Whether this stream records anything (level passed the logger's gate)
+         */
+        inline core::Bool IsEnabled() const noexcept        { return m_enabled; }
 
     protected:
         friend class Logger;
         friend class SinkManager;  // Allow SinkManager to access m_logBuffer directly
 
-        LogStream( LogLevel, const Logger& ) noexcept;
+        inline LogStream( LogLevel level, const Logger& logger, core::Bool enabled = true ) noexcept
+            : m_logger( logger )
+            , m_logBuffer( m_inlineBuffer )
+            , m_capacity( MAX_LOG_SIZE )
+            , m_bufferPos( 0 )
+            , m_timestamp( enabled ? LogClock::now() : 0 )  // Creation time; inert streams skip the clock read
+            , m_threadId( enabled ? ThreadId::current() : 0 )
+            , m_logLevel( static_cast< LogLevelType >( level ) )
+            , m_enabled( enabled )
+            , m_deferred( enabled && IsDeferredFormat() )
+        {
+            // Initialize buffer to empty
+            m_logBuffer[0] = '\0';
+        }
 
         // Explicitly delete all copy and move operations (zero-copy only)
         LogStream() = delete;
@@ -122,11 +172,20 @@ namespace log
         static constexpr inline size_t estimateSize(core::Int16) noexcept { return 6; }
         static constexpr inline size_t estimateSize(core::Int32) noexcept { return 11; }
         static constexpr inline size_t estimateSize(core::Int64) noexcept { return 20; }
-        static constexpr inline size_t estimateSize(core::Float) noexcept { return 16; }
-        static constexpr inline size_t estimateSize(core::Double) noexcept { return 24; }
         
         void                    flushBuffer() noexcept;  // Flush current buffer to sinks
-        void                    checkAndFlush(size_t additionalSize) noexcept;  // Check if flush needed
+        void                    submit( LogManager& logMgr ) noexcept;  // Hand buffer to async queue or sinks
+        
+        // Make room for additionalSize characters plus the terminating NUL, false at the hard cap
+        inline bool             reserve(size_t additionalSize) noexcept
+        {
+            return m_bufferPos + additionalSize < m_capacity || grow(additionalSize);
+        }
+        bool                    grow(size_t additionalSize) noexcept;  // Move the content to a spill buffer
+        template < typename T >
+        LogStream&              putArg(const T& value, size_t encodedSize) noexcept;  // Deferred: append the encoded value
+        void                    releaseSpill() noexcept;  // Return the spill buffer to the arena
+        inline size_t           available() const noexcept { return m_capacity - m_bufferPos - 1; }
 
     public:
         // Direct access methods (no copy, for friend classes)
@@ -134,13 +193,29 @@ namespace log
         inline size_t getBufferSize() const noexcept { return m_bufferPos; }
         inline LogLevelType getLevel() const noexcept { return m_logLevel; }
         inline const Logger& getLogger() const noexcept { return m_logger; }
+        inline core::UInt64 getTimestamp() const noexcept { return m_timestamp; }  // Nanoseconds since epoch
+        inline core::UInt32 getThreadId() const noexcept { return m_threadId; }  // Kernel TID of the creating thread
+        inline RecordFormat getFormat() const noexcept { return m_deferred ? RecordFormat::kArgs : RecordFormat::kText; }
 
     private:
-        LogLevelType            m_logLevel;
+        // Word sized members first so sizeof(LogStream) stays within the 256-byte block
         const Logger&           m_logger;
-        char                    m_logBuffer[MAX_LOG_SIZE];  // Fixed-size log buffer
+        char*                   m_logBuffer;  // m_inlineBuffer, or a spill buffer once the message outgrew it
+        size_t                  m_capacity;  // Size of m_logBuffer including the terminating NUL
         size_t                  m_bufferPos;  // Current position in buffer
+        core::UInt64            m_timestamp;  // LogClock::now() at construction, nanoseconds since epoch
+        core::UInt32            m_threadId;  // ThreadId::current() at construction
+        LogLevelType            m_logLevel;
+        core::Bool              m_enabled;  // false: every operator<< is a no-op
         bool                    m_encodeEnabled{ false };  // Base64 encoding flag
+        bool                    m_spillFromArena{ false };  // Spill buffer belongs to the thread arena (else heap)
+        bool                    m_deferred;  // Buffer holds ArgEncoder encoded values instead of text
+        char                    m_inlineBuffer[MAX_LOG_SIZE];  // Small-message buffer, no allocation
+
+        static ::std::atomic< bool >    s_deferredFormat;
+
+        friend LogStream& operator<< ( LogStream &out, LogLevel value ) noexcept;
+        friend LogStream& operator<< ( LogStream &out, const lap::core::ErrorCode &ec ) noexcept;
     };
 
     LogStream& operator<< ( LogStream &out, LogLevel value ) noexcept;
@@ -22,6 +22,9 @@
 
 #include "CCommon.hpp"
 #include "CLogStream.hpp"
+#include "CModeledMessage.hpp"
+#include "CTraceSwitch.hpp"
+#include <atomic>
 
 namespace lap
 {
@@ -31,13 +34,28 @@ namespace log
     class Logger final
     {
     public:
-        LogStream           LogFatal() const noexcept;
-        LogStream           LogError() const noexcept;
-        LogStream           LogWarn() const noexcept;
-        LogStream           LogInfo() const noexcept;
-        LogStream           LogDebug() const noexcept;
-        LogStream           LogVerbose() const noexcept;
-        LogStream           LogOff() const noexcept;
+        // Disabled levels return an inert LogStream: one atomic load, no formatting
+        inline LogStream    LogFatal() const noexcept                   { return { LogLevel::kFatal, *this, ShouldLog( LogLevel::kFatal ) }; }
+        inline LogStream    LogError() const noexcept                   { return { LogLevel::kError, *this, ShouldLog( LogLevel::kError ) }; }
+        inline LogStream    LogWarn() const noexcept                    { return { LogLevel::kWarn, *this, ShouldLog( LogLevel::kWarn ) }; }
+        inline LogStream    LogInfo() const noexcept                    { return { LogLevel::kInfo, *this, ShouldLog( LogLevel::kInfo ) }; }
+        inline LogStream    LogDebug() const noexcept                   { return { LogLevel::kDebug, *this, ShouldLog( LogLevel::kDebug ) }; }
+        inline LogStream    LogVerbose() const noexcept                 { return { LogLevel::kVerbose, *this, ShouldLog( LogLevel::kVerbose ) }; }
+        inline LogStream    LogOff() const noexcept                     { return { LogLevel::kOff, *this, ShouldLog( LogLevel::kOff ) }; }
+
+        /** @fn         void LogFatalSignalSafe (core::StringView message) const noexcept;
+         *  @brief      Async-signal-safe FATAL record, usable from signal handlers.
+         *  @details    Writes out queued and batched records first, then the message with write(2)
+         *              only (no blocking lock, no allocation); sinks without an emergency path are
+         *              skipped. The process is not going down, so a sink batch is only written out
+         *              when its lock can be taken (try-lock). If the lock is held, by another thread
+         *              or by the thread this call interrupted, the batch is left alone and the
+         *              message is written unbatched, possibly ahead of those batched records.
+         *              Only the crash path (fatal signal) uses sinks without their lock.
+         *              See CrashHandler::logFatal().
+         *  @param[in]  message         Plain text (no stream formatting, cut at 4 KiB)
+         */
+        void                LogFatalSignalSafe( core::StringView message ) const noexcept;
 
         /** @fn         bool IsEnabled (LogLevel logLevel) const noexcept;
          *  @brief      Check current configured log reporting level.
@@ -46,12 +64,54 @@ namespace log
          */
         bool                IsEnabled( LogLevel logLevel ) const noexcept;
 
+        /** @fn         core::Bool ShouldLog (LogLevel logLevel) const noexcept;
+         *  @brief      Fast gate used by Log*() and the LAP_LOG_* macros.
+         *  @param[in]  logLevel        The to be checked log level.
+         *  @return     core::Bool      True if the logger level, the global minimum level and at least
+         *                              one sink all accept logLevel (single relaxed atomic load).
+         */
+        inline core::Bool   ShouldLog( LogLevel logLevel ) const noexcept
+        {
+            return static_cast< LogLevelType >( logLevel ) <= m_effectiveLevel.load( ::std::memory_order_relaxed );
+        }
+
         /** @fn         LogStream WithLevel (LogLevel logLevel) const noexcept;
          *  @brief      Log message with a programmatically determined log level can be written.
          *  @param[in]  logLevel        the log level to use for this LogStream instance
          *  @return     LogStream       a new LogStream instance with the given log level
          */
-        LogStream           WithLevel( LogLevel logLevel ) const noexcept;
+        inline LogStream    WithLevel( LogLevel logLevel ) const noexcept   { return { logLevel, *this, ShouldLog( logLevel ) }; }
+
+        /** @fn         template <typename MsgId, typename... Params> void Log (const MsgId &id, const Params &... args) const noexcept;
+         *  @brief      Log a modeled message.
+         *  @param      MsgId           message type derived from MessageId<ID, Level>
+         *  @param      Params          alternating parameter names (string literals) and values
+         *  @param[in]  id              the message object, only its type is used
+         *  @param[in]  args            "name", value, "name", value, ...
+         *  @return     None
+         *  @details    Routed at compile time by TraceSwitch<MsgId>::route: kLogger (default) and
+         *              kBoth store the values in the ArgEncoder binary encoding (no text formatting
+         *              on the calling thread); DLTSink sends them non-verbose with MsgId::id as DLT
+         *              message ID, text sinks print "[MsgId:NNNN] name=value, name=value".
+         *              kArti and kBoth call TraceArti( id, args... ). kNone compiles to nothing.
+         */
+        template < typename MsgId, typename... Params >
+        inline void         Log( [[maybe_unused]] const MsgId &id, [[maybe_unused]] const Params &... args ) const noexcept
+        {
+            static_assert( sizeof...( Params ) % 2 == 0, "Log(): arguments are \"name\", value pairs" );
+
+            if constexpr ( isRoutedToLogger< MsgId >() ) {
+                if ( ShouldLog( MsgId::level ) ) {
+                    ModeledRecord record( MsgId::id, MsgId::level );
+                    encodeArgs( record.encoder(), args... );
+                    submit( record );
+                }
+            }
+
+            if constexpr ( isRoutedToArti< MsgId >() ) {
+                TraceArti( id, args... );
+            }
+        }
 
         inline core::StringView getContextId() const noexcept { return m_strContextID; }
 
@@ -62,7 +122,7 @@ namespace log
         ~Logger() noexcept;
 
     protected:
-        friend class CLogManager;
+        friend class LogManager;
         friend class LogStream;
 
         Logger() = delete;
@@ -71,11 +131,33 @@ namespace log
         Logger( Logger&& ) = delete;
         Logger& operator=( Logger&& ) = delete;
 
+    private:
+        static inline void          encodeArgs( ArgEncoder& ) noexcept {}
+
+        template < typename Value, typename... Rest >
+        static inline void          encodeArgs( ArgEncoder& encoder, const core::Char* name, const Value& value, const Rest&... rest ) noexcept
+        {
+            encoder.put( name, value );
+            encodeArgs( encoder, rest... );
+        }
+
+        /**
+         * @brief Hand a modeled message to the async queue (as text) or the sinks
+         */
+        void                        submit( const ModeledRecord& record ) const noexcept;
+
+        /**
+         * @brief Recompute the effective level from the sinks' maximum level
+         * @param sinkMaxLevel SinkManager::getMaxLevel()
+         */
+        void                        updateEffectiveLevel( LogLevel sinkMaxLevel ) noexcept;
+
     private:
         core::String                m_strContextID;
         core::String                m_strContextDesc;
         LogLevel                    m_logLevel;
         TraceStatus                 m_traceStatus;
+        ::std::atomic< LogLevelType > m_effectiveLevel;     // min(logger, global, most permissive sink)
     };
 
     /** @fn         Logger& CreateLogger (ara::core::StringView ctxId, lap::core::StringView ctxDescription, LogLevel ctxDefLogLevel=LogLevel::kWarn) noexcept;
@@ -104,17 +186,6 @@ namespace log
     // template < typename T >
     // Argument< T >       Arg(T &&arg, const char *name = nullptr, const char *unit = nullptr) noexcept;
 
-    /** @fn         template <typename MsgId, typename... Params> void Log (const MsgId &id, const Params &... args) noexcept;
-     *  @brief      Log a modeled message.
-     *  @param      MsgId           the type of the id parameter
-     *  @param      arg             the types of the args parameters
-     *  @param[in]  id              an implementation-defined type identifying the message object
-     *  @param[in]  args            the arguments to add to the message
-     *  @return     None
-     */
-    template < typename MsgId, typename... Params >
-    void                Log ( const MsgId &id, const Params &... args ) noexcept;
-
     constexpr LogHex8   HexFormat ( uint8_t value ) noexcept        { return LogHex8{ value }; }
     constexpr LogHex8   HexFormat ( int8_t value ) noexcept         { return LogHex8{ static_cast< core::UInt8 >( value ) }; }
     constexpr LogHex16  HexFormat ( uint16_t value ) noexcept       { return LogHex16{ value }; }
@@ -124,14 +195,15 @@ namespace log
     constexpr LogHex64  HexFormat ( uint64_t value ) noexcept       { return LogHex64{ value }; }
     constexpr LogHex64  HexFormat ( int64_t value ) noexcept        { return LogHex64{ static_cast< core::UInt64 >( value ) }; }
 
-    constexpr LogBin8   BinFormat ( uint8_t value ) noexcept        { return LogBin8{ value }; }
-    constexpr LogBin8   BinFormat ( int8_t value ) noexcept         { return LogBin8{ static_cast< core::UInt8 >( value ) }; }
-    constexpr LogBin16  BinFormat ( uint16_t value ) noexcept       { return LogBin16{ value }; }
-    constexpr LogBin16  BinFormat ( int16_t value ) noexcept        { return LogBin16{ static_cast< core::UInt16 >( value ) }; }
-    constexpr LogBin32  BinFormat ( uint32_t value ) noexcept       { return LogBin32{ value }; }
-    constexpr LogBin32  BinFormat ( int32_t value ) noexcept        { return LogBin32{ static_cast< core::UInt32 >( value ) }; }
-    constexpr LogBin64  BinFormat ( uint64_t value ) noexcept       { return LogBin64{ value }; }
-    constexpr LogBin64  BinFormat ( int64_t value ) noexcept        { return LogBin64{ static_cast< core::UInt64 >( value ) }; }
+    /** @brief      Binary output "0b..." with all digits; grouped inserts '_' every 4 bits ("0b1010_0101") */
+    constexpr LogBin8   BinFormat ( uint8_t value, core::Bool grouped = false ) noexcept   { return LogBin8{ value, grouped }; }
+    constexpr LogBin8   BinFormat ( int8_t value, core::Bool grouped = false ) noexcept    { return LogBin8{ static_cast< core::UInt8 >( value ), grouped }; }
+    constexpr LogBin16  BinFormat ( uint16_t value, core::Bool grouped = false ) noexcept  { return LogBin16{ value, grouped }; }
+    constexpr LogBin16  BinFormat ( int16_t value, core::Bool grouped = false ) noexcept   { return LogBin16{ static_cast< core::UInt16 >( value ), grouped }; }
+    constexpr LogBin32  BinFormat ( uint32_t value, core::Bool grouped = false ) noexcept  { return LogBin32{ value, grouped }; }
+    constexpr LogBin32  BinFormat ( int32_t value, core::Bool grouped = false ) noexcept   { return LogBin32{ static_cast< core::UInt32 >( value ), grouped }; }
+    constexpr LogBin64  BinFormat ( uint64_t value, core::Bool grouped = false ) noexcept  { return LogBin64{ value, grouped }; }
+    constexpr LogBin64  BinFormat ( int64_t value, core::Bool grouped = false ) noexcept   { return LogBin64{ static_cast< core::UInt64 >( value ), grouped }; }
 } // namespace core
 } // namespace lap
 #endif
\ No newline at end of file
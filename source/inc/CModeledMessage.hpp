@@ -0,0 +1,143 @@
+/**
+ * @file        CModeledMessage.hpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Modeled (non-verbose) messages: MessageId and the record handed to sinks
+ * @date        2026-10-16
+ * @details     AUTOSAR SWS_LOG_20001..20004, see doc/design/ModeledMessages_Design.md
+ * @copyright   Copyright (c) 2025
+ */
+
+#ifndef LAP_LOG_MODELEDMESSAGE_HPP
+#define LAP_LOG_MODELEDMESSAGE_HPP
+
+#include <lap/core/CTypedef.hpp>
+#include <lap/core/CString.hpp>
+#include "CCommon.hpp"
+#include "CArgEncoding.hpp"
+#include "CLogClock.hpp"
+#include "CThreadId.hpp"
+
+namespace lap
+{
+namespace log
+{
+    /**
+     * @brief Base of user defined message types
+     * @tparam ID       Message ID, unique per application (DLT non-verbose message ID)
+     * @tparam Level    Severity every instance of the message is logged with
+     *
+     * Usage:
+     * @code
+     *   struct StartupMessage : MessageId< 1000 > {};
+     *   struct OverTempMessage : MessageId< 1001, LogLevel::kWarn > {};
+     *
+     *   logger.Log( StartupMessage{}, "version", "1.0.0", "pid", getpid() );
+     * @endcode
+     */
+    template < core::UInt32 ID, LogLevel Level = LogLevel::kInfo >
+    struct MessageId
+    {
+        static constexpr core::UInt32   id      = ID;
+        static constexpr LogLevel       level   = Level;
+
+        constexpr core::UInt32 getId() const noexcept { return id; }
+    };
+
+    /**
+     * @brief One modeled message on its way to the sinks
+     *
+     * Features:
+     * - Arguments are held in the ArgEncoder binary encoding, names included;
+     *   the producer only copies values
+     * - Binary aware sinks (DLT) consume getPayload() directly
+     * - Text sinks get getText(): "[MsgId:NNNN] name=value, name=value",
+     *   rendered on first request and shared by all text sinks of one dispatch.
+     *   String values containing ',' or '"' are quoted with '"' and inner
+     *   quotes escaped as \"
+     * - Lives on the producer's stack, never shared between threads
+     */
+    class ModeledRecord final
+    {
+    public:
+        static constexpr core::Size kMaxPayloadSize = 512;      // Encoded arguments
+        static constexpr core::Size kMaxTextSize    = 1024;     // Text rendering incl. "[MsgId:NNNN] "
+        static constexpr core::Size kMaxPackedSize  = sizeof( core::UInt32 ) + kMaxPayloadSize;  // pack() output
+
+        ModeledRecord( core::UInt32 messageId, LogLevel level ) noexcept
+            : m_timestamp( LogClock::now() )
+            , m_threadId( ThreadId::current() )
+            , m_messageId( messageId )
+            , m_level( static_cast< LogLevelType >( level ) )
+            , m_encoder( m_payload, kMaxPayloadSize )
+        {}
+
+        /**
+         * @brief Rebuild a record stored elsewhere (shared memory ring consumed by LogCollector)
+         */
+        ModeledRecord( core::UInt64 timestamp, core::UInt32 threadId, core::UInt32 messageId, LogLevelType level,
+                       const core::UInt8* payload, core::Size size ) noexcept
+            : m_timestamp( timestamp )
+            , m_threadId( threadId )
+            , m_messageId( messageId )
+            , m_level( level )
+            , m_encoder( m_payload, kMaxPayloadSize )
+        {
+            m_encoder.putEncoded( payload, size );
+        }
+
+        ModeledRecord( const ModeledRecord& ) = delete;
+        ModeledRecord& operator=( const ModeledRecord& ) = delete;
+
+        inline ArgEncoder&          encoder() noexcept              { return m_encoder; }
+
+        inline core::UInt64         getTimestamp() const noexcept   { return m_timestamp; }    // Nanoseconds since epoch
+        inline core::UInt32         getThreadId() const noexcept    { return m_threadId; }
+        inline core::UInt32         getMessageId() const noexcept   { return m_messageId; }
+        inline LogLevelType         getLevel() const noexcept       { return m_level; }
+        inline const core::UInt8*   getPayload() const noexcept     { return m_payload; }
+        inline core::Size           getPayloadSize() const noexcept { return m_encoder.size(); }
+
+        /**
+         * @brief Message ID (host order) followed by the encoded arguments (RecordFormat::kModeled)
+         * @param out At least kMaxPackedSize bytes
+         * @return Bytes written
+         */
+        inline core::Size           pack( core::UInt8* out ) const noexcept
+        {
+            ::std::memcpy( out, &m_messageId, sizeof( m_messageId ) );
+            ::std::memcpy( out + sizeof( m_messageId ), m_payload, m_encoder.size() );
+            return sizeof( m_messageId ) + m_encoder.size();
+        }
+
+        /**
+         * @brief Message ID of pack() output, false if packed is too short
+         */
+        static inline core::Bool    unpackId( const core::UInt8* packed, core::Size size, core::UInt32& messageId ) noexcept
+        {
+            if ( size < sizeof( messageId ) ) {
+                return false;
+            }
+            ::std::memcpy( &messageId, packed, sizeof( messageId ) );
+            return true;
+        }
+
+        /**
+         * @brief Text rendering for text sinks (rendered once, then cached)
+         */
+        core::StringView            getText() const noexcept;
+
+    private:
+        core::UInt64                m_timestamp;
+        core::UInt32                m_threadId;
+        core::UInt32                m_messageId;
+        LogLevelType                m_level;
+        mutable core::Size          m_textSize{ 0 };    // 0: not rendered yet
+        ArgEncoder                  m_encoder;
+        core::UInt8                 m_payload[ kMaxPayloadSize ];
+        mutable core::Char          m_text[ kMaxTextSize ];
+    };
+
+} // namespace log
+} // namespace lap
+
+#endif // LAP_LOG_MODELEDMESSAGE_HPP
@@ -0,0 +1,264 @@
+/**
+ * @file        CNumberFormat.hpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Numeric formatting kernels for LogStream
+ * @date        2026-10-16
+ * @details     snprintf-free integer, hexadecimal, binary and floating point formatting
+ * @copyright   Copyright (c) 2025
+ */
+
+#ifndef LAP_LOG_NUMBERFORMAT_HPP
+#define LAP_LOG_NUMBERFORMAT_HPP
+
+#include <lap/core/CTypedef.hpp>
+#include <lap/core/CString.hpp>
+#include <cstring>
+
+namespace lap
+{
+namespace log
+{
+    /**
+     * @brief Text representation of Float/Double values in LogStream
+     */
+    enum class FloatFormat : core::UInt8
+    {
+        kFixed      = 0x00,     // "%.*f" with the configured precision (default, 6 for Float / 12 for Double)
+        kScientific = 0x01,     // "%.*e" with the configured precision
+        kShortest   = 0x02,     // Shortest text that parses back to the same value, precision ignored
+    };
+
+    constexpr inline core::StringView toString( const FloatFormat& format ) noexcept
+    {
+        switch( format )
+        {
+        case FloatFormat::kFixed:           return "fixed";
+        case FloatFormat::kScientific:      return "scientific";
+        case FloatFormat::kShortest:        return "shortest";
+        default:                            return "fixed";
+        }
+    }
+
+    /**
+     * @brief Formatting kernels used by LogStream::operator<<
+     *
+     * Features:
+     * - Integers: two digits per division through a 200-byte digit pair table,
+     *   output identical to "%u"/"%d"/"%lu"/"%ld"
+     * - Hexadecimal: one byte per lookup through a 512-byte table,
+     *   output identical to "0x%02X"/"0x%04X"/"0x%08X"/"0x%016lX"
+     * - Binary: each byte expanded to 8 ASCII digits with one multiply
+     *   (SWAR bit spread), optional '_' between nibbles
+     * - Floating point: std::to_chars (Ryu based in libstdc++/libc++),
+     *   identical to "%.*f"/"%.*e" in fixed/scientific mode
+     * - No locale, no format string parsing, no trailing NUL written
+     */
+    class NumberFormat final
+    {
+    public:
+        static constexpr core::Size     kMaxIntegerChars    = 20;   // "-9223372036854775808", "18446744073709551615"
+        static constexpr core::Size     kMaxHexChars        = 18;   // "0x" + 16 digits
+        static constexpr core::Size     kMaxBinChars        = 81;   // "0b" + 64 digits + 15 group separators
+        static constexpr core::Int32    kMaxPrecision       = 32;   // Larger configured precisions are clamped
+        static constexpr core::Size     kMaxRealChars       = 1 + 309 + 1 + kMaxPrecision + 7;  // '-' + DBL_MAX digits + '.' + precision, any FloatFormat
+
+        /**
+         * @brief Floating point output configuration (process wide)
+         */
+        struct FloatConfig
+        {
+            FloatFormat     format{ FloatFormat::kFixed };
+            core::Int32     floatPrecision{ 6 };        // Digits after the point for Float
+            core::Int32     doublePrecision{ 12 };      // Digits after the point for Double
+        };
+
+        NumberFormat() = delete;
+
+        /**
+         * @brief Write the decimal digits of value
+         * @param out Destination, at least kMaxIntegerChars bytes
+         * @return Number of characters written
+         */
+        static inline core::Size formatUInt( core::Char* out, core::UInt64 value ) noexcept
+        {
+            const core::Size len = countDigits( value );
+            core::Char* p = out + len;
+
+            while ( value >= 100 ) {
+                const core::Char* pair = &kDigitPairs[ ( value % 100 ) * 2 ];
+                value /= 100;
+                *--p = pair[1];
+                *--p = pair[0];
+            }
+
+            if ( value < 10 ) {
+                *--p = static_cast< core::Char >( '0' + value );
+            } else {
+                *--p = kDigitPairs[ value * 2 + 1 ];
+                *--p = kDigitPairs[ value * 2 ];
+            }
+
+            return len;
+        }
+
+        /**
+         * @brief Write the decimal digits of a signed value, '-' prefixed when negative
+         * @param out Destination, at least kMaxIntegerChars bytes
+         * @return Number of characters written
+         */
+        static inline core::Size formatInt( core::Char* out, core::Int64 value ) noexcept
+        {
+            if ( value < 0 ) {
+                *out = '-';
+                // Negate in unsigned arithmetic: INT64_MIN has no positive counterpart
+                return 1 + formatUInt( out + 1, 0 - static_cast< core::UInt64 >( value ) );
+            }
+            return formatUInt( out, static_cast< core::UInt64 >( value ) );
+        }
+
+        /**
+         * @brief Write "0x" followed by exactly 2 * bytes upper case hex digits
+         * @param out Destination, at least 2 + 2 * bytes bytes
+         * @param value Value, only the lowest bytes are written
+         * @param bytes Number of bytes to print (1, 2, 4 or 8)
+         * @return Number of characters written
+         */
+        static inline core::Size formatHex( core::Char* out, core::UInt64 value, core::Size bytes ) noexcept
+        {
+            out[0] = '0';
+            out[1] = 'x';
+
+            core::Char* p = out + 2 + bytes * 2;
+            for ( core::Size i = 0; i < bytes; ++i ) {
+                const core::Char* pair = &kHexPairs[ ( value & 0xFF ) * 2 ];
+                value >>= 8;
+                *--p = pair[1];
+                *--p = pair[0];
+            }
+
+            return 2 + bytes * 2;
+        }
+
+        /**
+         * @brief Write "0b" followed by exactly 8 * bytes binary digits, most significant first
+         * @param out Destination, at least binLength( bytes, grouped ) bytes
+         * @param value Value, only the lowest bytes are written
+         * @param bytes Number of bytes to print (1, 2, 4 or 8)
+         * @param grouped Insert '_' between groups of 4 digits
+         * @return Number of characters written
+         */
+        static inline core::Size formatBin( core::Char* out, core::UInt64 value, core::Size bytes, core::Bool grouped ) noexcept
+        {
+            out[0] = '0';
+            out[1] = 'b';
+            core::Char* p = out + 2;
+
+            for ( core::Size i = bytes; i-- > 0; ) {
+                core::Char digits[8];
+                const core::UInt64 ascii = spreadBits( static_cast< core::UInt8 >( value >> ( i * 8 ) ) );
+                ::std::memcpy( digits, &ascii, sizeof( digits ) );
+
+                if ( grouped ) {
+                    if ( i + 1 < bytes ) {
+                        *p++ = '_';
+                    }
+                    ::std::memcpy( p, digits, 4 );
+                    p[4] = '_';
+                    ::std::memcpy( p + 5, digits + 4, 4 );
+                    p += 9;
+                } else {
+                    ::std::memcpy( p, digits, 8 );
+                    p += 8;
+                }
+            }
+
+            return static_cast< core::Size >( p - out );
+        }
+
+        static constexpr core::Size binLength( core::Size bytes, core::Bool grouped ) noexcept
+        {
+            return 2 + bytes * 8 + ( grouped ? bytes * 2 - 1 : 0 );
+        }
+
+        /**
+         * @brief Write a Double according to the current FloatConfig
+         * @param out Destination
+         * @param capacity Bytes available at out; longer results are truncated
+         * @return Number of characters written (<= capacity)
+         */
+        static core::Size formatDouble( core::Char* out, core::Size capacity, core::Double value ) noexcept;
+
+        /**
+         * @brief Write a Float according to the current FloatConfig
+         * @details Fixed/scientific output equals printf of the value promoted to
+         *          double; shortest output is the shortest text of the float itself
+         */
+        static core::Size formatFloat( core::Char* out, core::Size capacity, core::Float value ) noexcept;
+
+        static void         setFloatConfig( const FloatConfig& config ) noexcept;
+        static FloatConfig  getFloatConfig() noexcept;
+
+    private:
+        /**
+         * @brief Expand 8 bits to 8 ASCII digits, bit 7 in the lowest addressed byte
+         * @details The multiply places copies of the byte 9 bits apart, so after the
+         *          shift every byte lane holds one distinct bit in its lowest position
+         */
+        static inline core::UInt64 spreadBits( core::UInt8 byte ) noexcept
+        {
+            const core::UInt64 bits = ( ( byte * 0x8040201008040201ULL ) >> 7 ) & 0x0101010101010101ULL;
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            return __builtin_bswap64( bits ) | 0x3030303030303030ULL;
+#else
+            return bits | 0x3030303030303030ULL;
+#endif
+        }
+
+        static inline core::Size countDigits( core::UInt64 value ) noexcept
+        {
+            core::Size len = 1;
+            for ( ;; ) {
+                if ( value < 10 )       return len;
+                if ( value < 100 )      return len + 1;
+                if ( value < 1000 )     return len + 2;
+                if ( value < 10000 )    return len + 3;
+                value /= 10000;
+                len += 4;
+            }
+        }
+
+        static constexpr core::Char kDigitPairs[] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        static constexpr core::Char kHexPairs[] =
+            "000102030405060708090A0B0C0D0E0F"
+            "101112131415161718191A1B1C1D1E1F"
+            "202122232425262728292A2B2C2D2E2F"
+            "303132333435363738393A3B3C3D3E3F"
+            "404142434445464748494A4B4C4D4E4F"
+            "505152535455565758595A5B5C5D5E5F"
+            "606162636465666768696A6B6C6D6E6F"
+            "707172737475767778797A7B7C7D7E7F"
+            "808182838485868788898A8B8C8D8E8F"
+            "909192939495969798999A9B9C9D9E9F"
+            "A0A1A2A3A4A5A6A7A8A9AAABACADAEAF"
+            "B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+            "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECF"
+            "D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+            "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+            "F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+    };
+
+} // namespace log
+} // namespace lap
+
+#endif // LAP_LOG_NUMBERFORMAT_HPP
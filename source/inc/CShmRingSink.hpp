@@ -0,0 +1,229 @@
+/**
+ * @file        CShmRingSink.hpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Shared memory ring buffer sink (flight recorder)
+ * @date        2026-10-16
+ * @details     Ring layout: doc/design/ShmRing_Format.md, recovery: tools/recover_shm_ring.py
+ * @copyright   Copyright (c) 2025
+ */
+
+#ifndef LAP_LOG_SHMRINGSINK_HPP
+#define LAP_LOG_SHMRINGSINK_HPP
+
+#include "ISink.hpp"
+#include <lap/core/CMemory.hpp>
+#include <lap/core/CString.hpp>
+#include <atomic>
+
+namespace lap
+{
+namespace log
+{
+    /**
+     * @brief Crash-surviving in-memory ring of the most recent records
+     *
+     * Features:
+     * - Records go into a file on tmpfs (/dev/shm) mapped MAP_SHARED: the
+     *   kernel keeps the pages when the process dies on a signal, so the last
+     *   records are still there after SIGSEGV/abort/SIGKILL
+     * - Lock-free multi-producer: a record reserves its bytes with one
+     *   fetch_add on the head counter in the shared header, copies itself in
+     *   and publishes a commit tag derived from its position; no lock, no syscall
+     * - Old records are overwritten; records torn by a crash or by a lapping
+     *   writer fail the commit check and are skipped by the recovery tool
+     * - Payloads are stored as produced (text, deferred arguments, modeled
+     *   messages), nothing is formatted on the write path
+     * - The ring file is removed on clean shutdown unless keepOnExit is set;
+     *   after a crash it stays in place for tools/recover_shm_ring.py
+     * - Collected mode (LogCollector): a collector process consumes the ring
+     *   and owns the files. Producers never overwrite records it has not
+     *   consumed yet; a record that does not fit is dropped and counted. On
+     *   clean shutdown the ring is marked closed and left for the collector
+     */
+    class ShmRingSink : public ISink
+    {
+    public:
+        IMP_OPERATOR_NEW(ShmRingSink)
+
+        static constexpr core::UInt8    kFormatVersion      = 1;
+        static constexpr core::Size     kHeaderSize         = 128;     ///< Ring header, data follows
+        static constexpr core::Size     kHeadOffset         = 64;      ///< Head counter, own cache line
+        static constexpr core::Size     kRecordHeaderSize   = 32;
+        static constexpr core::Size     kRecordAlign        = 8;
+        static constexpr core::Size     kFlagsOffset        = 40;      ///< Ring flags (UInt32)
+        static constexpr core::Size     kTailOffset         = 48;      ///< Collected: consumer position
+        static constexpr core::Size     kDroppedOffset      = 56;      ///< Collected: records refused, ring full
+        static constexpr core::Size     kMinCapacity        = 4096;
+        static constexpr core::Size     kDefaultCapacity    = 4 * 1024 * 1024;
+
+        /**
+         * @brief Record kinds (same values as BinaryFileSink::RecordKind)
+         */
+        enum class RecordKind : core::UInt8
+        {
+            kText       = 1,    // Text message
+            kArgs       = 2,    // ArgEncoding, unnamed (deferred LogStream record)
+            kModeled    = 3,    // ArgEncoding, named (modeled message)
+        };
+
+        static constexpr core::UInt8    kRecordHasThreadId  = 0x01;     ///< Flags: print "[tid:N]"
+
+        static constexpr core::UInt32   kRingCollected      = 0x01;     ///< Ring flags: consumed by a LogCollector
+        static constexpr core::UInt32   kRingClosed         = 0x02;     ///< Ring flags: producer shut down cleanly
+
+        static constexpr const char*    kCollectPrefix      = "lightap-collect-";  ///< File name prefix of collected rings
+
+        /**
+         * @brief Commit tag of a record at ring stream position pos (never 0 for real positions)
+         */
+        static constexpr core::UInt32 commitTag(core::UInt64 pos) noexcept {
+            return ~static_cast<core::UInt32>(pos / kRecordAlign);
+        }
+
+        /**
+         * @brief Default ring path: /dev/shm/lightap-<appId>-<pid>.ring
+         */
+        static core::String defaultPath(core::StringView appId);
+
+        /**
+         * @brief Collected ring path: <directory>/lightap-collect-<appId>-<pid>.ring
+         */
+        static core::String collectPath(core::StringView directory, core::StringView appId);
+
+        /**
+         * @brief Constructor
+         * @param path Ring file, should be on tmpfs (see defaultPath())
+         * @param capacity Ring bytes, rounded up to a power of two (min kMinCapacity)
+         * @param minLevel Minimum log level to output
+         * @param appId Application ID (max 4 bytes), stored in the ring header
+         * @param keepOnExit Keep the ring file on clean shutdown (default: remove it)
+         * @param collected Consumed by a LogCollector: no overwriting, the file is
+         *        always kept for the collector (default: flight recorder)
+         */
+        explicit ShmRingSink(
+            core::StringView path,
+            core::Size capacity = kDefaultCapacity,
+            LogLevel minLevel = LogLevel::kVerbose,
+            core::StringView appId = "",
+            core::Bool keepOnExit = false,
+            core::Bool collected = false
+        ) noexcept;
+
+        virtual ~ShmRingSink() noexcept override;
+
+        // ISink interface implementation
+        virtual void write(
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            core::StringView message
+        ) noexcept override;
+
+        virtual core::Bool writeModeled(
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            const ModeledRecord& record
+        ) noexcept override;
+
+        virtual core::Bool writeArgs(
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            const core::UInt8* args,
+            core::Size size
+        ) noexcept override;
+
+        virtual void flush() noexcept override;
+        
+        // The lock-free append is async-signal-safe as it is
+        virtual core::Bool writeEmergency(
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            core::StringView message
+        ) noexcept override;
+        
+        virtual core::Bool isEnabled() const noexcept override { return m_enabled && m_map != nullptr; }
+        virtual core::StringView getName() const noexcept override { return "ShmRing"; }
+        virtual void setLevel(LogLevel level) noexcept override { m_minLevel = level; notifyChanged(); }
+        virtual core::Bool shouldLog(LogLevel level) const noexcept override;
+        virtual core::Bool isThreadSafe() const noexcept override { return true; }    // Lock-free reservation
+
+        /**
+         * @brief Enable/disable this sink
+         * @param enabled Enable state
+         */
+        void setEnabled(core::Bool enabled) noexcept { m_enabled = enabled; notifyChanged(); }
+
+        /**
+         * @brief Mark records to be printed with "[tid:N]" by the recovery tool
+         * @param enabled Show thread ID (default: false), the ID is always stored
+         */
+        void setWithThreadId(core::Bool enabled) noexcept { m_withThreadId = enabled; }
+
+        /**
+         * @brief Ring file path
+         */
+        core::StringView getPath() const noexcept { return core::StringView(m_path.data(), m_path.size()); }
+
+        /**
+         * @brief Ring data capacity in bytes (power of two)
+         */
+        core::Size getCapacity() const noexcept { return m_capacity; }
+
+        /**
+         * @brief Total bytes reserved since creation (head of the ring stream)
+         */
+        core::UInt64 getHead() const noexcept { return m_head ? m_head->load(std::memory_order_relaxed) : 0; }
+
+        /**
+         * @brief Records refused because the collector had not made room yet (collected mode)
+         */
+        core::UInt64 getDropped() const noexcept { return m_dropped ? m_dropped->load(std::memory_order_relaxed) : 0; }
+
+    private:
+        /**
+         * @brief Copy len bytes to ring stream position pos, wrapping at the end
+         */
+        void copyIn(core::UInt64 pos, const void* src, core::Size len) noexcept;
+
+        /**
+         * @brief Reserve, fill and commit one record
+         */
+        void append(
+            RecordKind kind,
+            core::UInt64 timestamp,
+            core::UInt32 threadId,
+            LogLevelType level,
+            core::StringView contextId,
+            core::UInt32 messageId,
+            const void* payload,
+            core::Size size
+        ) noexcept;
+
+    private:
+        core::String    m_path;         ///< Ring file path
+        core::Size      m_capacity;     ///< Data bytes (power of two)
+        core::Bool      m_enabled;      ///< Enable state
+        core::Bool      m_withThreadId; ///< Flag records for "[tid:N]"
+        core::Bool      m_keepOnExit;   ///< Keep the file on destruction
+        core::Bool      m_collected;    ///< Consumed by a LogCollector
+        LogLevel        m_minLevel;     ///< Minimum log level
+
+        core::UInt8*    m_map;          ///< Shared mapping: header + data
+        core::UInt8*    m_data;         ///< Start of the ring data
+        std::atomic<core::UInt64>*  m_head;     ///< Reservation counter in the header
+        std::atomic<core::UInt64>*  m_tail;     ///< Collected: consumed up to here
+        std::atomic<core::UInt64>*  m_dropped;  ///< Collected: refused records
+        std::atomic<core::UInt32>*  m_flags;    ///< Ring flags in the header
+    };
+
+} // namespace log
+} // namespace lap
+
+#endif // LAP_LOG_SHMRINGSINK_HPP
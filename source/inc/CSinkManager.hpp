@@ -15,29 +15,49 @@
 #include <lap/core/CMemory.hpp>
 #include <lap/core/CString.hpp>
 #include <lap/core/CSync.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <sys/types.h>
 
 namespace lap
 {
 namespace log
 {
+    struct SinkReader;
+    
     /**
      * @brief Manager for multiple log sinks
      * 
      * Features:
      * - Dynamic sink registration
      * - Parallel writing to multiple destinations
-     * - Thread-safe operation
+     * - Lock-free read path: the sink list is an immutable snapshot; write()/shouldLog()/
+     *   flushAll() announce their epoch in a per-thread slot and load the snapshot once,
+     *   no shared cache line is written and no manager lock is taken
+     * - Copy-on-write updates: addSink()/removeSink()/clearAll() build a new snapshot,
+     *   publish it and reclaim the old one once every reader of an older epoch left
+     *   (epoch-based grace period, removed sinks are destroyed after their last write)
+     * - Per-sink serialization only for sinks not declaring ISink::isThreadSafe()
+     * - Flush timer thread (started with the first batching sink) bounding the age
+     *   of batched records (ISink::getFlushIntervalMs()) when no further write comes
      * - Centralized flush control
      * - Global minimum log level filtering
+     * - Precomputed effective maximum level for lock-free gating in Logger
      */
     class SinkManager
     {
     public:
+        /**
+         * @brief Callback invoked (under the writer lock) when getMaxLevel() changes
+         */
+        using LevelListener = void (*)(void* context, LogLevel maxLevel) noexcept;
+        
         IMP_OPERATOR_NEW(SinkManager)
-        SinkManager() noexcept 
-            : m_globalMinLevel(LogLevel::kVerbose) // Default: allow all levels (most permissive)
-        {}
-        ~SinkManager() noexcept = default;
+        SinkManager() noexcept;
+        ~SinkManager() noexcept;
         
         // Non-copyable, non-movable
         SinkManager(const SinkManager&) = delete;
@@ -48,11 +68,7 @@ namespace log
          * @param level Minimum level to log (default: kWarn)
          * @details All logs below this level will be filtered out before reaching sinks
          */
-        void setGlobalMinLevel(LogLevel level) noexcept
-        {
-            core::LockGuard lock(m_mutex);
-            m_globalMinLevel = level;
-        }
+        void setGlobalMinLevel(LogLevel level) noexcept;
         
         /**
          * @brief Get current global minimum log level
@@ -60,8 +76,7 @@ namespace log
          */
         LogLevel getGlobalMinLevel() const noexcept
         {
-            core::LockGuard lock(m_mutex);
-            return m_globalMinLevel;
+            return m_globalMinLevel.load(std::memory_order_relaxed);
         }
         
         /**
@@ -81,29 +96,76 @@ namespace log
          * @brief Get a sink by name
          * @param name Sink name
          * @return Pointer to sink or nullptr if not found
+         * @note The pointer is only valid until the sink is removed
          */
         ISink* getSink(core::StringView name) noexcept;
         
         /**
          * @brief Write log from LogStream to all enabled sinks
          * @param stream LogStream containing the log data
+         * @details Deferred streams (RecordFormat::kArgs) are dispatched as by
+         *          write(const LogEntry&)
          */
         void write(const class LogStream& stream) noexcept;
         
+        /**
+         * @brief Write a pre-built log entry to all enabled sinks
+         * @param entry LogEntry header followed by context ID and message
+         * @details Used by the async worker; timestamp and thread ID are taken from the entry.
+         *          RecordFormat::kArgs entries go as is to sinks consuming them (ISink::writeArgs),
+         *          all others get the text rendered once on the calling (worker) thread.
+         *          RecordFormat::kModeled entries are rebuilt and dispatched as by
+         *          write(const ModeledRecord&, StringView)
+         */
+        void write(const LogEntry& entry) noexcept;
+        
+        /**
+         * @brief Write a modeled message to all enabled sinks
+         * @param record Modeled message (binary arguments, text rendered on demand)
+         * @param contextId Context ID of the logging Logger
+         * @details Sinks consuming the binary form (ISink::writeModeled) get it as is,
+         *          all others get the text rendering through ISink::write
+         */
+        void write(const class ModeledRecord& record, core::StringView contextId) noexcept;
+        
+        /**
+         * @brief ISink::registerContext() on every registered sink
+         * @details Called by LogManager::registerLogger() so sinks with per-context
+         *          state (DLT) can set it up with the registered description and level
+         */
+        void registerContext(core::StringView contextId, core::StringView contextDesc,
+                             LogLevel level, TraceStatus status) noexcept;
+        
         /**
          * @brief Flush all sinks
          */
         void flushAll() noexcept;
         
+        /**
+         * @brief Write one record to all enabled sinks from a signal handler
+         * @param format Encoding of message, kArgs records are rendered into a stack buffer (4 KiB)
+         * @param crashing The process is going down: sinks are used without their lock
+         * @details Async-signal-safe: the snapshot is pinned with one counter (PinGuard),
+         *          no blocking lock is taken. Only sinks
+         *          implementing ISink::writeEmergency() receive the record. Used by CrashHandler.
+         *          Otherwise (crashing == false) a serialized sink is only try-locked; when
+         *          its lock is held the record goes through ISink::writeEmergencyUnbatched().
+         */
+        void writeEmergency(core::UInt64 timestamp, core::UInt32 threadId, LogLevelType levelValue,
+                            core::StringView contextId, core::StringView message,
+                            RecordFormat format = RecordFormat::kText, core::Bool crashing = true) noexcept;
+        
+        /**
+         * @brief ISink::flushEmergency() on all enabled sinks (async-signal-safe)
+         * @param crashing As for writeEmergency(); otherwise a sink whose lock is held is skipped
+         */
+        void flushEmergency(core::Bool crashing = true) noexcept;
+        
         /**
          * @brief Get number of registered sinks
          * @return Sink count
          */
-        core::Size getSinkCount() const noexcept
-        {
-            core::LockGuard lock(m_mutex);
-            return m_sinks.size();
-        }
+        core::Size getSinkCount() const noexcept;
         
         /**
          * @brief Clear all sinks
@@ -118,10 +180,152 @@ namespace log
          */
         core::Bool shouldLog(LogLevel level) const noexcept;
         
+        /**
+         * @brief Most verbose level that at least one enabled sink outputs
+         * @return min(global minimum level, most permissive sink level), kOff without sinks
+         * @details Precomputed on every add/remove/level change: a single relaxed load
+         */
+        LogLevel getMaxLevel() const noexcept
+        {
+            return static_cast<LogLevel>(m_maxLevel.load(std::memory_order_relaxed));
+        }
+        
+        /**
+         * @brief Recompute getMaxLevel() from the registered sinks
+         * @details setLevel()/setEnabled() of a registered sink already trigger this
+         *          (ISink change listener installed by addSink()); only needed for sinks
+         *          that change their filtering without ISink::notifyChanged()
+         */
+        void refreshLevels() noexcept;
+        
+        /**
+         * @brief Register the listener notified when getMaxLevel() changes
+         * @param listener Callback, nullptr to remove
+         * @param context Opaque pointer passed back to the callback
+         */
+        void setLevelListener(LevelListener listener, void* context) noexcept;
+        
+    private:
+        /**
+         * @brief One registered sink plus the lock serializing it when needed
+         */
+        struct SinkSlot
+        {
+            core::UniqueHandle<ISink>       sink;
+            core::UniqueHandle<core::Mutex> serial;     ///< nullptr when the sink is thread-safe
+            core::UInt32                    flushIntervalMs{ 0 };   ///< ISink::getFlushIntervalMs()
+        };
+        
+        using SinkList = core::Vector<std::shared_ptr<SinkSlot>>;
+        
+        /**
+         * @brief RAII read-side critical section pinning the current snapshot
+         * @details Nests; a thread without a slot (allocation failed, thread exiting)
+         *          is counted in m_pinnedReaders instead
+         */
+        class ReadGuard
+        {
+        public:
+            explicit ReadGuard(const SinkManager& manager) noexcept;
+            ~ReadGuard() noexcept;
+            
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+            
+            inline const SinkList& sinks() const noexcept  { return *m_list; }
+            
+        private:
+            const SinkManager&          m_manager;
+            SinkReader*                 m_reader;           ///< This thread's slot, nullptr when pinned
+            const SinkList*             m_list;
+        };
+        
+        /**
+         * @brief Async-signal-safe read-side critical section (emergency path)
+         * @details Counted in m_pinnedReaders: no thread-local slot is touched or allocated
+         */
+        class PinGuard
+        {
+        public:
+            explicit PinGuard(const SinkManager& manager) noexcept;
+            ~PinGuard() noexcept;
+            
+            PinGuard(const PinGuard&) = delete;
+            PinGuard& operator=(const PinGuard&) = delete;
+            
+            inline const SinkList& sinks() const noexcept  { return *m_list; }
+            
+        private:
+            const SinkManager&          m_manager;
+            const SinkList*             m_list;
+        };
+        
+        /**
+         * @brief Map a LogLevelType value to LogLevel (unknown values map to kVerbose)
+         */
+        static LogLevel toLogLevel(LogLevelType levelValue) noexcept;
+        
+        /**
+         * @brief Dispatch one record to all enabled sinks of a snapshot
+         */
+        void dispatch(const SinkList& sinks, core::UInt64 timestamp, core::UInt32 threadId, LogLevelType levelValue,
+                      core::StringView contextId, core::StringView message) noexcept;
+        
+        /**
+         * @brief Dispatch one deferred record (ArgEncoder encoded values) to all enabled sinks of a snapshot
+         */
+        void dispatchArgs(const SinkList& sinks, core::UInt64 timestamp, core::UInt32 threadId, LogLevelType levelValue,
+                          core::StringView contextId, const core::UInt8* args, core::Size size) noexcept;
+        
+        /**
+         * @brief Publish a new snapshot and reclaim the previous one (caller holds m_mutex)
+         * @details Waits for the readers that may still hold it; when the calling thread
+         *          is itself inside a read-side section the list is retired instead and
+         *          reclaimed by the next publish() or the destructor
+         */
+        void publish(SinkList* list) noexcept;
+        
+        /**
+         * @brief Wait until no reader that started before this call is still inside its section
+         */
+        void waitForReaders() const noexcept;
+        
+        /**
+         * @brief Recompute m_maxLevel from the current snapshot (caller holds m_mutex)
+         */
+        void updateMaxLevel() noexcept;
+        
+        /**
+         * @brief Recompute the timer tick from the current snapshot, start the timer if needed (caller holds m_mutex)
+         */
+        void updateFlushTimer() noexcept;
+        
+        /**
+         * @brief ISink change listener: recompute getMaxLevel() after a sink was reconfigured
+         */
+        static void onSinkChanged(void* context) noexcept;
+        
+        /**
+         * @brief Timer thread: ISink::flushExpired() on batching sinks every tick
+         */
+        void flusherLoop() noexcept;
+        
     private:
-        mutable core::Mutex                     m_mutex;            ///< Mutex for thread safety
-        core::Vector<core::UniqueHandle<ISink>> m_sinks;            ///< Registered sinks
-        LogLevel                                m_globalMinLevel;   ///< Global minimum log level
+        core::Mutex                             m_mutex;            ///< Serializes writers (add/remove/clear) only
+        std::atomic<const SinkList*>            m_snapshot;         ///< Current immutable sink list
+        mutable std::atomic<core::UInt32>       m_pinnedReaders{ 0 };   ///< Readers without a slot (signal handlers)
+        core::Vector<const SinkList*>           m_retired;          ///< Lists awaiting a grace period (under m_mutex)
+        std::atomic<LogLevel>                   m_globalMinLevel;   ///< Global minimum log level
+        std::atomic<LogLevelType>               m_maxLevel;         ///< Effective maximum level (see getMaxLevel)
+        LevelListener                           m_levelListener{ nullptr };
+        void*                                   m_levelListenerContext{ nullptr };
+        
+        ::std::thread                           m_flusher;          ///< Flush timer thread
+        pid_t                                   m_flusherPid{ 0 };  ///< Process that started m_flusher
+        ::std::mutex                            m_flusherMutex;
+        ::std::condition_variable               m_flusherCv;
+        core::UInt32                            m_flushTickMs{ 0 }; ///< 0: no batching sink (under m_flusherMutex)
+        core::Bool                              m_flusherStop{ false };
     };
     
 } // namespace log
@@ -58,14 +58,15 @@ namespace log
         virtual void flush() noexcept override;
         virtual core::Bool isEnabled() const noexcept override { return m_enabled; }
         virtual core::StringView getName() const noexcept override { return "Syslog"; }
-        virtual void setLevel(LogLevel level) noexcept override { m_minLevel = level; }
+        virtual void setLevel(LogLevel level) noexcept override { m_minLevel = level; notifyChanged(); }
         virtual core::Bool shouldLog(LogLevel level) const noexcept override;
+        virtual core::Bool isThreadSafe() const noexcept override { return true; }     // syslog() is thread-safe
         
         /**
          * @brief Enable/disable this sink
          * @param enabled Enable state
          */
-        void setEnabled(core::Bool enabled) noexcept { m_enabled = enabled; }
+        void setEnabled(core::Bool enabled) noexcept { m_enabled = enabled; notifyChanged(); }
         
     private:
         /**
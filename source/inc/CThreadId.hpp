@@ -0,0 +1,46 @@
+/**
+ * @file        CThreadId.hpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Cached kernel thread ID for log records
+ * @date        2026-10-16
+ * @details     One gettid() per thread, a thread-local load afterwards
+ * @copyright   Copyright (c) 2025
+ */
+
+#ifndef LAP_LOG_THREADID_HPP
+#define LAP_LOG_THREADID_HPP
+
+#include <lap/core/CTypedef.hpp>
+
+namespace lap
+{
+namespace log
+{
+    /**
+     * @brief Kernel thread ID (as shown by ps -L, top -H, gdb) of the calling thread
+     *
+     * Features:
+     * - The first call on a thread issues gettid(), later calls read a
+     *   constant-initialized thread_local (no TLS wrapper, no syscall)
+     * - A forked child re-reads its TID (pthread_atfork handler)
+     */
+    class ThreadId final
+    {
+    public:
+        ThreadId() = delete;
+
+        static inline core::UInt32 current() noexcept
+        {
+            return s_tid != 0 ? s_tid : lookup();
+        }
+
+    private:
+        static core::UInt32 lookup() noexcept;     // gettid() and cache it
+
+        static inline thread_local core::UInt32 s_tid = 0;
+    };
+
+} // namespace log
+} // namespace lap
+
+#endif // LAP_LOG_THREADID_HPP
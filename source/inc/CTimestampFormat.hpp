@@ -0,0 +1,106 @@
+/**
+ * @file        CTimestampFormat.hpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Cached wall clock formatting for sink line prefixes
+ * @date        2026-10-16
+ * @details     localtime_r() once per second per thread, fraction digits patched per record
+ * @copyright   Copyright (c) 2025
+ */
+
+#ifndef LAP_LOG_TIMESTAMPFORMAT_HPP
+#define LAP_LOG_TIMESTAMPFORMAT_HPP
+
+#include <lap/core/CTypedef.hpp>
+#include <lap/core/CString.hpp>
+
+namespace lap
+{
+namespace log
+{
+    /**
+     * @brief Digits after the second in sink timestamps
+     */
+    enum class TimestampPrecision : core::UInt8
+    {
+        kMilli  = 3,    // ".mmm" (default)
+        kMicro  = 6,    // ".uuuuuu"
+        kNano   = 9,    // ".nnnnnnnnn"
+    };
+
+    constexpr inline core::StringView toString( const TimestampPrecision& precision ) noexcept
+    {
+        switch( precision )
+        {
+        case TimestampPrecision::kMilli:    return "ms";
+        case TimestampPrecision::kMicro:    return "us";
+        case TimestampPrecision::kNano:     return "ns";
+        default:                            return "ms";
+        }
+    }
+
+    /**
+     * @brief Local time formatting used by FileSink and ConsoleSink
+     *
+     * Features:
+     * - Each thread caches the "YYYY-MM-DD HH:MM:SS" text of the last second
+     *   it formatted; localtime_r() (which takes the glibc tz lock) and the
+     *   date formatting only run when the second changes
+     * - Records within the cached second only get their fraction digits written
+     *   (3, 6 or 9 depending on the process wide TimestampPrecision)
+     * - Thread-local cache: no locking, no sharing between sink threads
+     * - Output identical to "%04d-%02d-%02d %02d:%02d:%02d.%03u" of localtime_r()
+     *   at millisecond precision
+     * - *SignalSafe() variants for the crash handler compute the date from a
+     *   sampled UTC offset instead (no tz lock, no thread-local state)
+     * - No trailing NUL written
+     */
+    class TimestampFormat final
+    {
+    public:
+        static constexpr core::Size     kMaxDateTimeChars   = 29;   // "YYYY-MM-DD HH:MM:SS.nnnnnnnnn"
+        static constexpr core::Size     kMaxTimeChars       = 18;   // "HH:MM:SS.nnnnnnnnn"
+
+        TimestampFormat() = delete;
+
+        /**
+         * @brief Write "YYYY-MM-DD HH:MM:SS.fff" in local time
+         * @param out Destination, at least kMaxDateTimeChars bytes
+         * @param timestamp Nanoseconds since epoch
+         * @return Number of characters written
+         */
+        static core::Size formatDateTime( core::Char* out, core::UInt64 timestamp ) noexcept;
+
+        /**
+         * @brief Write "HH:MM:SS.fff" in local time
+         * @param out Destination, at least kMaxTimeChars bytes
+         * @param timestamp Nanoseconds since epoch
+         * @return Number of characters written
+         */
+        static core::Size formatTime( core::Char* out, core::UInt64 timestamp ) noexcept;
+
+        /**
+         * @brief formatDateTime() for signal handlers
+         * @details No localtime_r(), no thread-local cache: the date is computed
+         *          arithmetically from the UTC offset seen by the last localtime_r()
+         *          call (or refreshUtcOffset()). Async-signal-safe.
+         */
+        static core::Size formatDateTimeSignalSafe( core::Char* out, core::UInt64 timestamp ) noexcept;
+
+        /**
+         * @brief formatTime() for signal handlers, see formatDateTimeSignalSafe()
+         */
+        static core::Size formatTimeSignalSafe( core::Char* out, core::UInt64 timestamp ) noexcept;
+
+        /**
+         * @brief Sample the local UTC offset used by the signal-safe formatters
+         */
+        static void                 refreshUtcOffset() noexcept;
+
+        static void                 setPrecision( TimestampPrecision precision ) noexcept;
+        static TimestampPrecision   getPrecision() noexcept;
+    };
+
+} // namespace log
+} // namespace lap
+
+#endif // LAP_LOG_TIMESTAMPFORMAT_HPP
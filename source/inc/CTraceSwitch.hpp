@@ -0,0 +1,79 @@
+/**
+ * @file        CTraceSwitch.hpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Compile-time routing of modeled messages (TraceSwitch)
+ * @date        2026-10-16
+ * @details     AUTOSAR SWS_LOG_20001, see doc/design/ModeledMessages_Design.md
+ * @copyright   Copyright (c) 2025
+ */
+
+#ifndef LAP_LOG_TRACESWITCH_HPP
+#define LAP_LOG_TRACESWITCH_HPP
+
+#include <lap/core/CTypedef.hpp>
+
+namespace lap
+{
+namespace log
+{
+    /**
+     * @brief Destination of a modeled message, fixed at compile time
+     */
+    enum class TraceRoute : core::UInt8
+    {
+        kNone   = 0,    // Dropped: Logger::Log() compiles to nothing, names and values included
+        kLogger = 1,    // Log sinks only (default, SWS_LOG_20001)
+        kArti   = 2,    // TraceArti() only
+        kBoth   = 3,    // Log sinks and TraceArti()
+    };
+
+    /**
+     * @brief Route of MsgId, specialize to change it
+     *
+     * Usage:
+     * @code
+     *   template <>
+     *   struct lap::log::TraceSwitch< myapp::DebugMessage > {
+     *       static constexpr TraceRoute route = TraceRoute::kNone;
+     *   };
+     * @endcode
+     */
+    template < typename MsgId >
+    struct TraceSwitch
+    {
+        static constexpr TraceRoute route = TraceRoute::kLogger;
+    };
+
+    template < typename MsgId >
+    constexpr core::Bool isRoutedToLogger() noexcept
+    {
+        return TraceSwitch< MsgId >::route == TraceRoute::kLogger || TraceSwitch< MsgId >::route == TraceRoute::kBoth;
+    }
+
+    template < typename MsgId >
+    constexpr core::Bool isRoutedToArti() noexcept
+    {
+        return TraceSwitch< MsgId >::route == TraceRoute::kArti || TraceSwitch< MsgId >::route == TraceRoute::kBoth;
+    }
+
+    /**
+     * @brief ARTI trace hook for messages routed to kArti/kBoth, does nothing by default
+     * @details Logger::Log() calls TraceArti( id, args... ) unqualified: an overload
+     *          declared in the namespace of the message type is found by argument
+     *          dependent lookup and preferred over this template, e.g.
+     * @code
+     *   namespace myapp {
+     *       template < typename... Params >
+     *       void TraceArti( const StartupMessage&, const Params&... args ) noexcept { tracepoint(...); }
+     *   }
+     * @endcode
+     */
+    template < typename MsgId, typename... Params >
+    inline void TraceArti( const MsgId&, const Params&... ) noexcept
+    {
+    }
+
+} // namespace log
+} // namespace lap
+
+#endif // LAP_LOG_TRACESWITCH_HPP
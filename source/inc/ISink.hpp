@@ -28,6 +28,8 @@ namespace lap
 {
 namespace log
 {
+    class ModeledRecord;
+    
     /**
      * @brief Log entry structure for zero-copy optimization
      * 
@@ -36,9 +38,10 @@ namespace log
      */
     struct alignas(64) LogEntry
     {
-        core::UInt64    timestamp;      ///< Microseconds since epoch
-        core::UInt32    threadId;       ///< Thread ID
+        core::UInt64    timestamp;      ///< Nanoseconds since epoch (LogClock)
+        core::UInt32    threadId;       ///< Kernel thread ID of the producer
         LogLevelType    level;          ///< Log level
+        RecordFormat    format{ RecordFormat::kText };  ///< Encoding of the message bytes
         core::UInt16    contextIdLen;   ///< Length of context ID
         core::UInt16    messageLen;     ///< Length of message
         
@@ -75,7 +78,10 @@ namespace log
      * @brief Abstract log sink interface
      * 
      * All concrete sinks (Console, File, Syslog, DLT) implement this interface.
-     * Thread-safety is guaranteed by the caller (SinkManager).
+     * Concurrency contract: SinkManager calls write()/flush() from many threads
+     * at once. Sinks returning false from isThreadSafe() (the default) are
+     * serialized by SinkManager with a per-sink lock; sinks returning true
+     * are called without any lock and must synchronize themselves.
      */
     class ISink
     {
@@ -84,8 +90,8 @@ namespace log
         
         /**
          * @brief Write a log message to the sink
-         * @param timestamp Microseconds since epoch
-         * @param threadId Thread ID
+         * @param timestamp Nanoseconds since epoch, taken when the record was created
+         * @param threadId Kernel thread ID of the thread that created the record
          * @param level Log level
          * @param contextId Context ID string
          * @param message Log message string
@@ -99,12 +105,105 @@ namespace log
             core::StringView message
         ) noexcept = 0;
         
+        /**
+         * @brief Write a modeled message in its binary form
+         * @param timestamp Nanoseconds since epoch, taken when the record was created
+         * @param threadId Kernel thread ID of the thread that created the record
+         * @param level Log level
+         * @param contextId Context ID string
+         * @param record Message ID plus ArgEncoder encoded arguments
+         * @return true if consumed; false (default) to receive record.getText()
+         *         through write() instead
+         */
+        virtual core::Bool writeModeled(
+            core::UInt64 /*timestamp*/,
+            core::UInt32 /*threadId*/,
+            LogLevelType /*level*/,
+            core::StringView /*contextId*/,
+            const ModeledRecord& /*record*/
+        ) noexcept
+        {
+            return false;
+        }
+        
+        /**
+         * @brief Write a deferred LogStream record in its binary form
+         * @param timestamp Nanoseconds since epoch, taken when the record was created
+         * @param threadId Kernel thread ID of the thread that created the record
+         * @param level Log level
+         * @param contextId Context ID string
+         * @param args ArgEncoder encoded values (unnamed), see doc/design/ArgEncoding_Format.md
+         * @param size Size of args in bytes
+         * @return true if consumed; false (default) to receive the rendered text
+         *         through write() instead
+         */
+        virtual core::Bool writeArgs(
+            core::UInt64 /*timestamp*/,
+            core::UInt32 /*threadId*/,
+            LogLevelType /*level*/,
+            core::StringView /*contextId*/,
+            const core::UInt8* /*args*/,
+            core::Size /*size*/
+        ) noexcept
+        {
+            return false;
+        }
+        
         /**
          * @brief Flush buffered data to underlying storage
          * @note Called periodically or on critical logs
          */
         virtual void flush() noexcept = 0;
-        
+
+        /**
+         * @brief Write one record from a signal handler (CrashHandler)
+         * @param timestamp Nanoseconds since epoch, taken when the record was created
+         * @param threadId Kernel thread ID of the thread that created the record
+         * @param level Log level
+         * @param contextId Context ID string
+         * @param message Log message string
+         * @return true if written or staged for flushEmergency(); false (default) if the
+         *         sink cannot write from a signal handler
+         * @note Must be async-signal-safe: no lock, no allocation, no stdio,
+         *       no localtime_r(); only write(2) on descriptors opened beforehand
+         *       or plain stores to memory mapped earlier. May run while another
+         *       thread is inside write().
+         */
+        virtual core::Bool writeEmergency(
+            core::UInt64 /*timestamp*/,
+            core::UInt32 /*threadId*/,
+            LogLevelType /*level*/,
+            core::StringView /*contextId*/,
+            core::StringView /*message*/
+        ) noexcept
+        {
+            return false;
+        }
+
+        /**
+         * @brief writeEmergency() that leaves the sink's batch alone
+         * @return true if written; false (default) if the sink has no such path
+         * @details Used outside the crash path (logFatal) while another thread holds
+         *          the sink's lock: the line goes out at once and may land before
+         *          records still batched. Same rules as writeEmergency(), plus it
+         *          must not touch state owned by the lock holder.
+         */
+        virtual core::Bool writeEmergencyUnbatched(
+            core::UInt64 /*timestamp*/,
+            core::UInt32 /*threadId*/,
+            LogLevelType /*level*/,
+            core::StringView /*contextId*/,
+            core::StringView /*message*/
+        ) noexcept
+        {
+            return false;
+        }
+
+        /**
+         * @brief Write out buffered records from a signal handler, same rules as writeEmergency()
+         */
+        virtual void flushEmergency() noexcept {}
+
         /**
          * @brief Check if this sink is enabled
          * @return true if enabled, false otherwise
@@ -129,6 +228,78 @@ namespace log
          * @return true if should output, false otherwise
          */
         virtual core::Bool shouldLog(LogLevel level) const noexcept = 0;
+        
+        /**
+         * @brief Announce a Logger context ahead of its first record (LogManager::registerLogger)
+         * @param contextId Context ID
+         * @param contextDesc Context description
+         * @param level Log level the context was registered with
+         * @param status Trace status the context was registered with
+         * @return true if records of this context have somewhere to go (default: nothing to register)
+         */
+        virtual core::Bool registerContext(
+            core::StringView /*contextId*/,
+            core::StringView /*contextDesc*/,
+            LogLevel /*level*/,
+            TraceStatus /*status*/
+        ) noexcept
+        {
+            return true;
+        }
+        
+        /**
+         * @brief Max age of batched records, enforced by SinkManager's flush timer
+         * @return Interval in ms, 0 (default) if the sink holds no records back
+         * @details Queried once on addSink(); a non-zero value makes SinkManager call
+         *          flushExpired() from its timer thread, under the sink's lock
+         */
+        virtual core::UInt32 getFlushIntervalMs() const noexcept { return 0; }
+        
+        /**
+         * @brief Write out the batch if its oldest record is due within slackMs
+         * @param slackMs Time until the timer's next call
+         */
+        virtual void flushExpired(core::UInt32 /*slackMs*/) noexcept {}
+        
+        /**
+         * @brief Whether write()/flush() may be called concurrently
+         * @return true if the sink synchronizes internally, false to let
+         *         SinkManager serialize calls (queried once on addSink)
+         */
+        virtual core::Bool isThreadSafe() const noexcept { return false; }
+        
+        /**
+         * @brief Callback told about level or enable changes of a registered sink
+         */
+        using ChangeListener = void (*)(void* context) noexcept;
+        
+        /**
+         * @brief Install the change listener (SinkManager::addSink(), before the sink is published)
+         * @param listener Callback, nullptr to remove
+         * @param context Opaque pointer passed back to the callback
+         */
+        void setChangeListener(ChangeListener listener, void* context) noexcept
+        {
+            m_changeListener = listener;
+            m_changeContext = context;
+        }
+        
+    protected:
+        /**
+         * @brief Report that shouldLog()/isEnabled() may answer differently now
+         * @details Called by setLevel()/setEnabled() so the owning SinkManager
+         *          recomputes the level Loggers gate on right away
+         */
+        void notifyChanged() noexcept
+        {
+            if (m_changeListener) {
+                m_changeListener(m_changeContext);
+            }
+        }
+        
+    private:
+        ChangeListener  m_changeListener{ nullptr };
+        void*           m_changeContext{ nullptr };
     };
     
 } // namespace log
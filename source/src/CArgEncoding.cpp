@@ -0,0 +1,211 @@
+/**
+ * @file        CArgEncoding.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Compact binary encoding of typed log arguments
+ * @date        2026-10-16
+ */
+
+#include "CArgEncoding.hpp"
+#include "CNumberFormat.hpp"
+
+namespace lap
+{
+namespace log
+{
+    void ArgEncoder::putString( core::StringView name, core::StringView value ) noexcept
+    {
+        const core::Size nameLen = name.size() > kMaxNameSize ? kMaxNameSize : name.size();
+        const core::Size header = 1 + ( nameLen > 0 ? 1 + nameLen : 0 ) + sizeof( core::UInt16 );
+        if ( m_size + header > m_capacity ) {
+            m_truncated = true;
+            return;
+        }
+
+        // Cut the string to what is left rather than dropping it
+        core::Size len = value.size() > kMaxStringSize ? kMaxStringSize : value.size();
+        if ( m_size + header + len > m_capacity ) {
+            len = m_capacity - m_size - header;
+            m_truncated = true;
+        }
+
+        core::UInt8* p = begin( ArgType::kString, 0, name, sizeof( core::UInt16 ) + len );
+        const core::UInt16 len16 = static_cast< core::UInt16 >( len );
+        ::std::memcpy( p, &len16, sizeof( len16 ) );
+        ::std::memcpy( p + sizeof( len16 ), value.data(), len );
+    }
+
+    void ArgEncoder::put( core::StringView name, const core::ErrorCode& value ) noexcept
+    {
+        const core::StringView domain( value.Domain().Name() );
+        const core::Size len = domain.size() > kMaxNameSize ? kMaxNameSize : domain.size();
+        const core::Int64 code = static_cast< core::Int64 >( value.Value() );
+        const core::UInt16 len16 = static_cast< core::UInt16 >( len );
+
+        if ( core::UInt8* p = begin( ArgType::kErrorCode, 0, name, sizeof( code ) + sizeof( len16 ) + len ) ) {
+            ::std::memcpy( p, &code, sizeof( code ) );
+            ::std::memcpy( p + sizeof( code ), &len16, sizeof( len16 ) );
+            ::std::memcpy( p + sizeof( code ) + sizeof( len16 ), domain.data(), len );
+        }
+    }
+
+    core::Bool ArgDecoder::next( ArgView& arg ) noexcept
+    {
+        if ( m_pos >= m_size ) {
+            return false;
+        }
+
+        const core::UInt8 tag = m_data[m_pos++];
+        arg = ArgView();
+        arg.type    = static_cast< ArgType >( tag & kArgTypeMask );
+        arg.grouped = ( tag & kArgGrouped ) != 0;
+
+        if ( tag & kArgNamed ) {
+            if ( m_pos >= m_size || m_pos + 1 + m_data[m_pos] > m_size ) {
+                return false;
+            }
+            const core::Size nameLen = m_data[m_pos++];
+            arg.name = core::StringView( reinterpret_cast< const core::Char* >( m_data + m_pos ), nameLen );
+            m_pos += nameLen;
+        }
+
+        if ( arg.type == ArgType::kErrorCode ) {
+            core::UInt16 len = 0;
+            if ( m_pos + sizeof( arg.integer ) + sizeof( len ) > m_size ) {
+                return false;
+            }
+            ::std::memcpy( &arg.integer, m_data + m_pos, sizeof( arg.integer ) );
+            ::std::memcpy( &len, m_data + m_pos + sizeof( arg.integer ), sizeof( len ) );
+            m_pos += sizeof( arg.integer ) + sizeof( len );
+            if ( m_pos + len > m_size ) {
+                return false;
+            }
+            arg.text = core::StringView( reinterpret_cast< const core::Char* >( m_data + m_pos ), len );
+            m_pos += len;
+            return true;
+        }
+
+        if ( arg.type == ArgType::kString ) {
+            core::UInt16 len = 0;
+            if ( m_pos + sizeof( len ) > m_size ) {
+                return false;
+            }
+            ::std::memcpy( &len, m_data + m_pos, sizeof( len ) );
+            m_pos += sizeof( len );
+            if ( m_pos + len > m_size ) {
+                return false;
+            }
+            arg.text = core::StringView( reinterpret_cast< const core::Char* >( m_data + m_pos ), len );
+            m_pos += len;
+            return true;
+        }
+
+        const core::Size size = ArgView::valueSize( arg.type );
+        if ( size == 0 || m_pos + size > m_size ) {
+            return false;
+        }
+
+        const core::UInt8* p = m_data + m_pos;
+        m_pos += size;
+        switch ( arg.type ) {
+        case ArgType::kInt8:    { core::Int8 v;  ::std::memcpy( &v, p, 1 ); arg.integer = v; break; }
+        case ArgType::kInt16:   { core::Int16 v; ::std::memcpy( &v, p, 2 ); arg.integer = v; break; }
+        case ArgType::kInt32:   { core::Int32 v; ::std::memcpy( &v, p, 4 ); arg.integer = v; break; }
+        case ArgType::kInt64:   { core::Int64 v; ::std::memcpy( &v, p, 8 ); arg.integer = v; break; }
+        case ArgType::kFloat:   { core::Float v; ::std::memcpy( &v, p, 4 ); arg.real = v; break; }
+        case ArgType::kDouble:  { core::Double v; ::std::memcpy( &v, p, 8 ); arg.real = v; break; }
+        default:
+            // Host byte order: copying into the low bytes of a zeroed UInt64 zero extends on little endian
+            ::std::memcpy( &arg.bits, p, size );
+            break;
+        }
+        return true;
+    }
+
+    core::Size ArgFormat::formatValue( core::Char* out, core::Size capacity, const ArgView& arg ) noexcept
+    {
+        // Fixed size values are formatted into scratch first so a short capacity cuts them cleanly
+        core::Char scratch[ NumberFormat::kMaxBinChars ];
+        core::Size len = 0;
+        const core::Char* src = scratch;
+
+        switch ( arg.type ) {
+        case ArgType::kBool:
+            scratch[0] = arg.bits ? '1' : '0';
+            len = 1;
+            break;
+        case ArgType::kUInt8:
+        case ArgType::kUInt16:
+        case ArgType::kUInt32:
+        case ArgType::kUInt64:
+            len = NumberFormat::formatUInt( scratch, arg.bits );
+            break;
+        case ArgType::kInt8:
+        case ArgType::kInt16:
+        case ArgType::kInt32:
+        case ArgType::kInt64:
+            len = NumberFormat::formatInt( scratch, arg.integer );
+            break;
+        case ArgType::kFloat:
+            return NumberFormat::formatFloat( out, capacity, static_cast< core::Float >( arg.real ) );
+        case ArgType::kDouble:
+            return NumberFormat::formatDouble( out, capacity, arg.real );
+        case ArgType::kHex8:
+        case ArgType::kHex16:
+        case ArgType::kHex32:
+        case ArgType::kHex64:
+            len = NumberFormat::formatHex( scratch, arg.bits, ArgView::valueSize( arg.type ) );
+            break;
+        case ArgType::kBin8:
+        case ArgType::kBin16:
+        case ArgType::kBin32:
+        case ArgType::kBin64:
+            len = NumberFormat::formatBin( scratch, arg.bits, ArgView::valueSize( arg.type ), arg.grouped );
+            break;
+        case ArgType::kLogLevel: {
+            const core::StringView level = toString( static_cast< LogLevel >( arg.bits ) );
+            src = level.data();
+            len = level.size();
+            break;
+        }
+        case ArgType::kString:
+            src = arg.text.data();
+            len = arg.text.size();
+            break;
+        case ArgType::kErrorCode: {
+            // "Domain:Value", as operator<<( LogStream&, const ErrorCode& )
+            core::Size pos = arg.text.size() < capacity ? arg.text.size() : capacity;
+            ::std::memcpy( out, arg.text.data(), pos );
+            if ( pos < capacity ) {
+                out[pos++] = ':';
+            }
+            len = NumberFormat::formatInt( scratch, arg.integer );
+            if ( len > capacity - pos ) {
+                len = capacity - pos;
+            }
+            ::std::memcpy( out + pos, scratch, len );
+            return pos + len;
+        }
+        default:
+            return 0;
+        }
+
+        if ( len > capacity ) {
+            len = capacity;
+        }
+        ::std::memcpy( out, src, len );
+        return len;
+    }
+
+    core::Size ArgFormat::formatArgs( core::Char* out, core::Size capacity, const core::UInt8* data, core::Size size ) noexcept
+    {
+        ArgDecoder decoder( data, size );
+        ArgView arg;
+        core::Size len = 0;
+        while ( len < capacity && decoder.next( arg ) ) {
+            len += formatValue( out + len, capacity - len, arg );
+        }
+        return len;
+    }
+
+} // namespace log
+} // namespace lap
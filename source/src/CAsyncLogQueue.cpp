@@ -0,0 +1,819 @@
+/**
+ * @file        CAsyncLogQueue.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Asynchronous log queue implementation
+ * @date        2026-10-16
+ */
+
+#include "CAsyncLogQueue.hpp"
+#include "CSinkManager.hpp"
+#include "CLogClock.hpp"
+#include "CThreadId.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <new>
+
+namespace lap
+{
+namespace log
+{
+    /**
+     * @brief Single-producer/single-consumer byte ring of LogEntry records
+     *
+     * Memory layout of one record: [LogEntry header][context id][message][pad to 64]
+     * A header with level == kPaddingLevel marks the unused tail before a wrap.
+     * head/tail are free-running byte counters; (pos & mask) is the offset.
+     */
+    class LogRing final
+    {
+    public:
+        static constexpr core::Size     kAlign          = alignof( LogEntry );
+        static constexpr LogLevelType   kPaddingLevel   = 0xFF;
+
+        explicit LogRing( core::Size capacity ) noexcept
+            : m_buffer( nullptr )
+            , m_capacity( roundUpPow2( capacity < kMinCapacity ? kMinCapacity : capacity ) )
+            , m_mask( m_capacity - 1 )
+        {
+            m_buffer = static_cast< char* >( ::operator new( m_capacity, ::std::align_val_t{ kAlign }, ::std::nothrow ) );
+        }
+
+        ~LogRing() noexcept
+        {
+            if ( m_buffer ) {
+                ::operator delete( m_buffer, ::std::align_val_t{ kAlign } );
+            }
+        }
+
+        LogRing( const LogRing& ) = delete;
+        LogRing& operator=( const LogRing& ) = delete;
+
+        inline core::Bool valid() const noexcept                    { return m_buffer != nullptr; }
+
+        static inline core::Size recordSize( core::Size contextLen, core::Size msgLen ) noexcept
+        {
+            return ( LogEntry::calculateSize( contextLen, msgLen ) + kAlign - 1 ) & ~( kAlign - 1 );
+        }
+
+        /**
+         * @brief Whether a record can ever fit (worst case: wrap padding + record)
+         */
+        inline core::Bool fits( core::Size contextLen, core::Size msgLen ) const noexcept
+        {
+            return contextLen <= 0xFFFF && msgLen <= 0xFFFF &&
+                   recordSize( contextLen, msgLen ) <= ( m_capacity >> 1 );
+        }
+
+        //=====================================================================
+        // Producer side
+        //=====================================================================
+        core::Bool tryPush( core::UInt64 timestamp,
+                            core::UInt32 threadId,
+                            LogLevelType level,
+                            core::StringView contextId,
+                            core::StringView message,
+                            RecordFormat format ) noexcept
+        {
+            const core::Size need   = recordSize( contextId.size(), message.size() );
+            core::Size head         = m_head.load( ::std::memory_order_relaxed );
+            core::Size offset       = head & m_mask;
+            const core::Size contiguous = m_capacity - offset;
+            const core::Size total  = ( need <= contiguous ) ? need : contiguous + need;
+
+            if ( m_capacity - ( head - m_cachedTail ) < total ) {
+                m_cachedTail = m_tail.load( ::std::memory_order_acquire );
+                if ( m_capacity - ( head - m_cachedTail ) < total ) {
+                    return false;
+                }
+            }
+
+            if ( need > contiguous ) {
+                // Not enough room before the end: mark the tail as padding and wrap
+                LogEntry* pad = new ( m_buffer + offset ) LogEntry;
+                pad->level = kPaddingLevel;
+                head   += contiguous;
+                offset  = 0;
+            }
+
+            LogEntry* entry     = new ( m_buffer + offset ) LogEntry;
+            entry->timestamp    = timestamp;
+            entry->threadId     = threadId;
+            entry->level        = level;
+            entry->format       = format;
+            entry->contextIdLen = static_cast< core::UInt16 >( contextId.size() );
+            entry->messageLen   = static_cast< core::UInt16 >( message.size() );
+
+            char* data = reinterpret_cast< char* >( entry + 1 );
+            std::memcpy( data, contextId.data(), contextId.size() );
+            std::memcpy( data + contextId.size(), message.data(), message.size() );
+
+            m_head.store( head + need, ::std::memory_order_release );
+            m_pushed.store( m_pushed.load( ::std::memory_order_relaxed ) + 1, ::std::memory_order_relaxed );
+            return true;
+        }
+
+        //=====================================================================
+        // Consumer side
+        //=====================================================================
+        template < typename Fn >
+        core::Size drain( core::Size maxRecords, Fn&& fn ) noexcept
+        {
+            core::Size tail      = m_tail.load( ::std::memory_order_relaxed );
+            core::Size processed = 0;
+
+            while ( processed < maxRecords ) {
+                if ( tail == m_cachedHead ) {
+                    m_cachedHead = m_head.load( ::std::memory_order_acquire );
+                    if ( tail == m_cachedHead ) {
+                        break;
+                    }
+                }
+
+                const core::Size offset = tail & m_mask;
+                const LogEntry* entry   = reinterpret_cast< const LogEntry* >( m_buffer + offset );
+
+                if ( entry->level == kPaddingLevel ) {
+                    tail += m_capacity - offset;
+                } else {
+                    fn( *entry );
+                    tail += recordSize( entry->contextIdLen, entry->messageLen );
+                    ++processed;
+                }
+
+                // Release space record by record so a blocked producer resumes early
+                m_tail.store( tail, ::std::memory_order_release );
+            }
+
+            return processed;
+        }
+
+        inline core::Size headPosition() const noexcept             { return m_head.load( ::std::memory_order_acquire ); }
+        inline core::Size tailPosition() const noexcept             { return m_tail.load( ::std::memory_order_acquire ); }
+        inline core::Bool empty() const noexcept                    { return tailPosition() == headPosition(); }
+
+        //=====================================================================
+        // Overflow handling
+        //=====================================================================
+
+        /**
+         * @brief Producer side: fill level in percent
+         * @details Uses the cached tail first; it can only overestimate, so the
+         *          shared tail is loaded only when the cheap check crosses the line.
+         */
+        inline core::Bool underPressure( core::UInt32 percent ) noexcept
+        {
+            const core::Size head = m_head.load( ::std::memory_order_relaxed );
+            if ( ( head - m_cachedTail ) * 100 < m_capacity * percent ) {
+                return false;
+            }
+            m_cachedTail = m_tail.load( ::std::memory_order_acquire );
+            return ( head - m_cachedTail ) * 100 >= m_capacity * percent;
+        }
+
+        /**
+         * @brief Producer side: advance the sampling counter
+         * @return true for the one record of every `rate` that is kept
+         */
+        inline core::Bool sample( core::UInt32 rate ) noexcept
+        {
+            return rate <= 1 || ( m_sampleCounter++ % rate ) == 0;
+        }
+
+        inline void requestDiscard( core::Size bytes ) noexcept     { m_discardRequest.store( bytes, ::std::memory_order_release ); }
+        inline core::Bool discardPending() const noexcept           { return m_discardRequest.load( ::std::memory_order_acquire ) != 0; }
+
+        /**
+         * @brief Consumer side: account bytes discarded for a pending request
+         */
+        inline void discarded( core::Size bytes ) noexcept
+        {
+            core::Size pending = m_discardRequest.load( ::std::memory_order_acquire );
+            while ( pending != 0 &&
+                    !m_discardRequest.compare_exchange_weak( pending, pending > bytes ? pending - bytes : 0,
+                                                             ::std::memory_order_acq_rel ) ) {
+            }
+        }
+        inline core::UInt64 pushedCount() const noexcept            { return m_pushed.load( ::std::memory_order_relaxed ); }
+
+        /**
+         * @brief Producer side: bracket one push() so stop() can wait for it
+         * @details Written by the producer only, on its own cache line
+         */
+        inline void beginPush() noexcept                            { m_pushing.store( true, ::std::memory_order_seq_cst ); }
+        inline void endPush() noexcept                              { m_pushing.store( false, ::std::memory_order_release ); }
+        inline core::Bool pushing() const noexcept                  { return m_pushing.load( ::std::memory_order_seq_cst ); }
+
+        inline void abandon() noexcept                              { m_abandoned.store( true, ::std::memory_order_release ); }
+        inline core::Bool isAbandoned() const noexcept              { return m_abandoned.load( ::std::memory_order_acquire ); }
+
+    private:
+        static constexpr core::Size     kMinCapacity    = 4096;
+
+        static constexpr core::Size roundUpPow2( core::Size value ) noexcept
+        {
+            core::Size result = 1;
+            while ( result < value ) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+    private:
+        char*                                   m_buffer;
+        const core::Size                        m_capacity;
+        const core::Size                        m_mask;
+
+        // Producer cache line
+        alignas(64) ::std::atomic< core::Size > m_head{ 0 };
+        core::Size                              m_cachedTail{ 0 };
+        ::std::atomic< core::UInt64 >           m_pushed{ 0 };
+        ::std::atomic< core::Bool >             m_pushing{ false };
+        core::UInt32                            m_sampleCounter{ 0 };
+
+        // Consumer cache line
+        alignas(64) ::std::atomic< core::Size > m_tail{ 0 };
+        core::Size                              m_cachedHead{ 0 };
+
+        alignas(64) ::std::atomic< core::Bool > m_abandoned{ false };
+        ::std::atomic< core::Size >             m_discardRequest{ 0 };  ///< Bytes the producer wants freed (kDropOldest)
+    };
+
+    namespace
+    {
+        /**
+         * @brief Per-thread producer ring cache
+         * @details Keeps a shared reference so the ring outlives whichever of
+         *          thread and queue goes away first; the queue reclaims rings
+         *          that were abandoned by exited threads once they are empty.
+         */
+        struct ProducerSlot
+        {
+            core::UInt64                    queueId{ 0 };
+            ::std::shared_ptr< LogRing >    ring;
+
+            ~ProducerSlot() noexcept
+            {
+                if ( ring ) {
+                    ring->abandon();
+                }
+            }
+        };
+
+        thread_local ProducerSlot           t_producer;
+
+        /**
+         * @brief Marks a push() in progress on the producer's ring
+         */
+        struct PushScope
+        {
+            LogRing*    ring;
+
+            explicit PushScope( LogRing* pushRing ) noexcept : ring( pushRing )    { ring->beginPush(); }
+            ~PushScope() noexcept                                                   { ring->endPush(); }
+        };
+        ::std::atomic< core::UInt64 >       s_nextQueueId{ 1 };
+
+        // kDropOldest never waits longer than this for the worker to discard
+        constexpr ::std::chrono::microseconds   kDropOldestWait{ 1000 };
+        constexpr core::StringView              kDropReportContextId{ "LOGQ" };
+
+        // haltWorker() waits at most this long for the worker to finish its pass
+        constexpr core::UInt64                  kEmergencyWaitNs = 20 * 1000 * 1000;
+
+        inline core::UInt64 monotonicNs() noexcept
+        {
+            struct timespec ts;
+            ::clock_gettime( CLOCK_MONOTONIC, &ts );
+            return static_cast< core::UInt64 >( ts.tv_sec ) * 1000000000ULL + static_cast< core::UInt64 >( ts.tv_nsec );
+        }
+    }
+
+    AsyncLogQueue::AsyncLogQueue( SinkManager& sinkManager, const Config& config ) noexcept
+        : m_sinkManager( sinkManager )
+        , m_config( config )
+        , m_queueId( s_nextQueueId.fetch_add( 1, ::std::memory_order_relaxed ) )
+    {
+        if ( m_config.batchSize == 0 ) {
+            m_config.batchSize = 1;
+        }
+    }
+
+    AsyncLogQueue::~AsyncLogQueue() noexcept
+    {
+        stop();
+    }
+
+    core::Bool AsyncLogQueue::start() noexcept
+    {
+        if ( isRunning() ) {
+            return true;
+        }
+
+        m_stopRequested.store( false, ::std::memory_order_release );
+
+        try {
+            m_worker = ::std::thread( &AsyncLogQueue::workerLoop, this );
+        } catch ( const ::std::exception& e ) {
+            fprintf( stderr, "[LightAP] AsyncLogQueue: failed to start worker: %s\n", e.what() );
+            return false;
+        }
+
+        m_running.store( true, ::std::memory_order_release );
+        return true;
+    }
+
+    void AsyncLogQueue::stop() noexcept
+    {
+        // New records fall back to synchronous writes from here on
+        if ( !m_running.exchange( false, ::std::memory_order_seq_cst ) ) {
+            return;
+        }
+
+        // Producers that passed the running check finish their push before the final drain
+        {
+            core::LockGuard lock( m_ringMutex );
+            for ( const auto& ring : m_rings ) {
+                while ( ring->pushing() ) {
+                    ::std::this_thread::yield();
+                }
+            }
+        }
+
+        m_stopRequested.store( true, ::std::memory_order_release );
+        wakeWorker();
+
+        if ( m_worker.joinable() ) {
+            m_worker.join();
+        }
+
+        // Pick up records from producers that raced with the shutdown
+        drainAll();
+        reportDrops();
+        m_sinkManager.flushAll();
+    }
+
+    core::Bool AsyncLogQueue::push( core::UInt64 timestamp,
+                                    core::UInt32 threadId,
+                                    LogLevelType level,
+                                    core::StringView contextId,
+                                    core::StringView message,
+                                    RecordFormat format ) noexcept
+    {
+        if ( !isRunning() ) {
+            return false;
+        }
+
+        LogRing* ring = ( t_producer.queueId == m_queueId ) ? t_producer.ring.get() : acquireRing();
+        if ( !ring || !ring->fits( contextId.size(), message.size() ) ) {
+            m_rejectedCount.fetch_add( 1, ::std::memory_order_relaxed );
+            return false;
+        }
+
+        // Pairs with stop(): either it waits for this push or we see it stopped
+        PushScope scope( ring );
+        if ( !m_running.load( ::std::memory_order_seq_cst ) ) {
+            return false;
+        }
+
+        if ( m_config.policyFor( level ) == OverflowPolicy::kSample &&
+             ring->underPressure( m_config.pressurePercent ) &&
+             !ring->sample( m_config.sampleRate ) ) {
+            recordDrop( level );
+            return true;
+        }
+
+        if ( !ring->tryPush( timestamp, threadId, level, contextId, message, format ) ) {
+            return handleOverflow( ring, timestamp, threadId, level, contextId, message, format );
+        }
+
+        wakeWorkerIfIdle();
+        return true;
+    }
+
+    core::Bool AsyncLogQueue::handleOverflow( LogRing* ring,
+                                              core::UInt64 timestamp,
+                                              core::UInt32 threadId,
+                                              LogLevelType level,
+                                              core::StringView contextId,
+                                              core::StringView message,
+                                              RecordFormat format ) noexcept
+    {
+        switch ( m_config.policyFor( level ) ) {
+        case OverflowPolicy::kDropNewest:
+        case OverflowPolicy::kSample:
+            // Sustained overflow drops on every call: no mutex unless the worker sleeps
+            recordDrop( level );
+            wakeWorkerIfIdle();
+            return true;
+
+        case OverflowPolicy::kDropOldest: {
+            // Worker skips queued droppable records until the request is met
+            const core::Size need = LogRing::recordSize( contextId.size(), message.size() );
+            const auto deadline   = ::std::chrono::steady_clock::now() + kDropOldestWait;
+
+            ring->requestDiscard( need << 1 );     // Room for a wrap padding as well
+            wakeWorker();
+            while ( isRunning() && ::std::chrono::steady_clock::now() < deadline ) {
+                ::std::this_thread::yield();
+                if ( ring->tryPush( timestamp, threadId, level, contextId, message, format ) ) {
+                    ring->requestDiscard( 0 );
+                    return true;
+                }
+            }
+            ring->requestDiscard( 0 );
+            recordDrop( level );
+            return true;
+        }
+
+        case OverflowPolicy::kBlock:
+        default:
+            break;
+        }
+
+        // Ring full: let the worker make room, bounded by flushTimeoutMs
+        const auto deadline = ::std::chrono::steady_clock::now() +
+                              ::std::chrono::milliseconds( m_config.flushTimeoutMs );
+
+        wakeWorker();
+        while ( isRunning() ) {
+            ::std::this_thread::yield();
+            if ( ring->tryPush( timestamp, threadId, level, contextId, message, format ) ) {
+                return true;
+            }
+            if ( ::std::chrono::steady_clock::now() >= deadline ) {
+                break;
+            }
+        }
+
+        m_rejectedCount.fetch_add( 1, ::std::memory_order_relaxed );
+        return false;
+    }
+
+    void AsyncLogQueue::recordDrop( LogLevelType level ) noexcept
+    {
+        if ( level < kLevelCount ) {
+            m_droppedCount[ level ].fetch_add( 1, ::std::memory_order_relaxed );
+        }
+    }
+
+    void AsyncLogQueue::reportDrops() noexcept
+    {
+        core::UInt64 delta[ kLevelCount ];
+        core::UInt64 total = 0;
+
+        for ( core::Size i = 0; i < kLevelCount; ++i ) {
+            const core::UInt64 dropped = m_droppedCount[ i ].load( ::std::memory_order_relaxed );
+            delta[ i ]          = dropped - m_reportedDrops[ i ];
+            m_reportedDrops[ i ] = dropped;
+            total              += delta[ i ];
+        }
+
+        if ( total == 0 ) {
+            return;
+        }
+
+        char message[ 256 ];
+        int len = std::snprintf( message, sizeof( message ), "%llu messages dropped by async queue overflow policy (",
+                                 static_cast< unsigned long long >( total ) );
+        const char* separator = "";
+        for ( core::Size i = 0; i < kLevelCount && len > 0 && static_cast< core::Size >( len ) < sizeof( message ); ++i ) {
+            if ( delta[ i ] == 0 ) {
+                continue;
+            }
+            auto name = toString( static_cast< LogLevel >( i ) );
+            len += std::snprintf( message + len, sizeof( message ) - len, "%s%.*s=%llu", separator,
+                                  static_cast< int >( name.size() ), name.data(),
+                                  static_cast< unsigned long long >( delta[ i ] ) );
+            separator = ", ";
+        }
+        if ( len > 0 && static_cast< core::Size >( len ) < sizeof( message ) - 1 ) {
+            message[ len++ ] = ')';
+        }
+        len = ( len < 0 ) ? 0 : ( static_cast< core::Size >( len ) >= sizeof( message ) ? sizeof( message ) - 1 : len );
+
+        alignas( LogEntry ) char storage[ sizeof( LogEntry ) + sizeof( message ) + kDropReportContextId.size() ];
+        LogEntry* entry     = new ( storage ) LogEntry;
+        entry->timestamp    = LogClock::now();
+        entry->threadId     = ThreadId::current();
+        entry->level        = static_cast< LogLevelType >( LogLevel::kWarn );
+        entry->contextIdLen = static_cast< core::UInt16 >( kDropReportContextId.size() );
+        entry->messageLen   = static_cast< core::UInt16 >( len );
+
+        char* data = reinterpret_cast< char* >( entry + 1 );
+        std::memcpy( data, kDropReportContextId.data(), kDropReportContextId.size() );
+        std::memcpy( data + kDropReportContextId.size(), message, static_cast< core::Size >( len ) );
+
+        m_sinkManager.write( *entry );
+    }
+
+    core::Bool AsyncLogQueue::flush() noexcept
+    {
+        if ( !isRunning() ) {
+            return false;
+        }
+
+        // Snapshot producer positions: only records pushed so far are waited for
+        core::Vector< ::std::pair< RingHandle, core::Size > > targets;
+        {
+            core::LockGuard lock( m_ringMutex );
+            targets.reserve( m_rings.size() );
+            for ( const auto& ring : m_rings ) {
+                targets.emplace_back( ring, ring->headPosition() );
+            }
+        }
+
+        auto drained = [&targets]() noexcept {
+            for ( const auto& target : targets ) {
+                if ( target.first->tailPosition() < target.second ) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        const auto deadline = ::std::chrono::steady_clock::now() +
+                              ::std::chrono::milliseconds( m_config.flushTimeoutMs );
+
+        ::std::unique_lock< ::std::mutex > lock( m_waitMutex );
+        while ( !drained() ) {
+            if ( !isRunning() || ::std::chrono::steady_clock::now() >= deadline ) {
+                return drained();
+            }
+            m_wakeCv.notify_one();
+            m_drainedCv.wait_for( lock, ::std::chrono::milliseconds( 1 ) );
+        }
+
+        return true;
+    }
+
+    AsyncLogQueue::Stats AsyncLogQueue::getStats() const noexcept
+    {
+        Stats stats{};
+
+        core::LockGuard lock( m_ringMutex );
+        stats.enqueuedCount = m_retiredEnqueued;
+        for ( const auto& ring : m_rings ) {
+            stats.enqueuedCount += ring->pushedCount();
+        }
+        stats.producerCount  = m_rings.size();
+        stats.processedCount = m_processedCount.load( ::std::memory_order_relaxed );
+        stats.rejectedCount  = m_rejectedCount.load( ::std::memory_order_relaxed );
+        stats.droppedTotal   = 0;
+        for ( core::Size i = 0; i < kLevelCount; ++i ) {
+            stats.droppedCount[ i ] = m_droppedCount[ i ].load( ::std::memory_order_relaxed );
+            stats.droppedTotal     += stats.droppedCount[ i ];
+        }
+
+        return stats;
+    }
+
+    core::UInt64 AsyncLogQueue::getDroppedCount( LogLevel level ) const noexcept
+    {
+        const core::Size index = static_cast< core::Size >( level );
+        return index < kLevelCount ? m_droppedCount[ index ].load( ::std::memory_order_relaxed ) : 0;
+    }
+
+    LogRing* AsyncLogQueue::acquireRing() noexcept
+    {
+        ProducerSlot& slot = t_producer;
+
+        // Ring of a previous (stopped or destroyed) queue: hand it back first
+        if ( slot.ring ) {
+            slot.ring->abandon();
+            slot.ring.reset();
+            slot.queueId = 0;
+        }
+
+        RingHandle ring;
+        try {
+            ring = ::std::make_shared< LogRing >( m_config.ringSize );
+        } catch ( const ::std::exception& ) {
+            return nullptr;
+        }
+
+        if ( !ring->valid() ) {
+            return nullptr;
+        }
+
+        {
+            core::LockGuard lock( m_ringMutex );
+            m_rings.push_back( ring );
+            registerEmergencyRing( ring.get() );
+            m_ringsVersion.fetch_add( 1, ::std::memory_order_release );
+        }
+
+        slot.queueId = m_queueId;
+        slot.ring    = core::Move( ring );
+
+        return slot.ring.get();
+    }
+
+    void AsyncLogQueue::workerLoop() noexcept
+    {
+        for ( ;; ) {
+            const core::Bool stopping = m_stopRequested.load( ::std::memory_order_acquire );
+
+            // Pairs with haltWorker(): either it sees us busy or we see it halted
+            m_workerBusy.store( true, ::std::memory_order_seq_cst );
+            if ( m_halted.load( ::std::memory_order_seq_cst ) ) {
+                m_workerBusy.store( false, ::std::memory_order_release );
+                if ( stopping ) {
+                    break;
+                }
+                ::std::this_thread::sleep_for( ::std::chrono::milliseconds( m_config.idleWaitMs ) );
+                continue;
+            }
+
+            if ( drainAll() > 0 ) {
+                m_workerBusy.store( false, ::std::memory_order_release );
+                m_drainedCv.notify_all();
+                continue;
+            }
+
+            if ( stopping ) {
+                m_workerBusy.store( false, ::std::memory_order_release );
+                break;
+            }
+
+            // Pressure cleared: account for whatever the overflow policies discarded
+            reportDrops();
+
+            // Queue went idle: give sinks a chance to push out their own buffers
+            m_sinkManager.flushAll();
+            m_workerBusy.store( false, ::std::memory_order_release );
+            m_drainedCv.notify_all();
+
+            ::std::unique_lock< ::std::mutex > lock( m_waitMutex );
+            m_workerIdle.store( true, ::std::memory_order_seq_cst );
+            if ( !hasPending() && !m_stopRequested.load( ::std::memory_order_acquire ) ) {
+                m_wakeCv.wait_for( lock, ::std::chrono::milliseconds( m_config.idleWaitMs ) );
+            }
+            m_workerIdle.store( false, ::std::memory_order_relaxed );
+        }
+
+        if ( !m_halted.load( ::std::memory_order_acquire ) ) {
+            m_sinkManager.flushAll();
+        }
+        m_drainedCv.notify_all();
+    }
+
+    core::Size AsyncLogQueue::drainAll() noexcept
+    {
+        refreshWorkerRings();
+
+        core::Size total        = 0;
+        core::Size dispatched   = 0;
+        core::Bool reclaim      = false;
+
+        for ( const auto& ring : m_workerRings ) {
+            LogRing* current = ring.get();
+            total += current->drain( m_config.batchSize, [this, current, &dispatched]( const LogEntry& entry ) noexcept {
+                // kDropOldest producer waiting for room: skip droppable records
+                if ( current->discardPending() && m_config.policyFor( entry.level ) != OverflowPolicy::kBlock ) {
+                    current->discarded( LogRing::recordSize( entry.contextIdLen, entry.messageLen ) );
+                    recordDrop( entry.level );
+                    return;
+                }
+                m_sinkManager.write( entry );
+                ++dispatched;
+            } );
+
+            if ( current->isAbandoned() && current->empty() ) {
+                reclaim = true;
+            }
+        }
+
+        if ( dispatched > 0 ) {
+            m_processedCount.fetch_add( dispatched, ::std::memory_order_relaxed );
+        }
+
+        if ( reclaim ) {
+            // Drop rings of exited threads; they can no longer receive records
+            core::LockGuard lock( m_ringMutex );
+            auto it = m_rings.begin();
+            while ( it != m_rings.end() ) {
+                if ( ( *it )->isAbandoned() && ( *it )->empty() ) {
+                    m_retiredEnqueued += ( *it )->pushedCount();
+                    unregisterEmergencyRing( it->get() );
+                    it = m_rings.erase( it );
+                } else {
+                    ++it;
+                }
+            }
+            m_ringsVersion.fetch_add( 1, ::std::memory_order_release );
+        }
+
+        return total;
+    }
+
+    core::Bool AsyncLogQueue::hasPending() const noexcept
+    {
+        if ( m_ringsVersion.load( ::std::memory_order_acquire ) != m_workerRingsVersion ) {
+            return true;
+        }
+
+        for ( const auto& ring : m_workerRings ) {
+            if ( !ring->empty() ) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void AsyncLogQueue::refreshWorkerRings() noexcept
+    {
+        if ( m_ringsVersion.load( ::std::memory_order_acquire ) == m_workerRingsVersion ) {
+            return;
+        }
+
+        core::LockGuard lock( m_ringMutex );
+        m_workerRings        = m_rings;
+        m_workerRingsVersion = m_ringsVersion.load( ::std::memory_order_relaxed );
+    }
+
+    void AsyncLogQueue::registerEmergencyRing( LogRing* ring ) noexcept
+    {
+        // Caller holds m_ringMutex
+        for ( auto& slot : m_emergencyRings ) {
+            if ( slot.load( ::std::memory_order_relaxed ) == nullptr ) {
+                slot.store( ring, ::std::memory_order_release );
+                return;
+            }
+        }
+    }
+
+    void AsyncLogQueue::unregisterEmergencyRing( LogRing* ring ) noexcept
+    {
+        // Caller holds m_ringMutex
+        for ( auto& slot : m_emergencyRings ) {
+            if ( slot.load( ::std::memory_order_relaxed ) == ring ) {
+                slot.store( nullptr, ::std::memory_order_release );
+                return;
+            }
+        }
+    }
+
+    core::Bool AsyncLogQueue::haltWorker( core::Bool crashing ) noexcept
+    {
+        m_halted.store( true, ::std::memory_order_seq_cst );
+
+        // Called from a sink on the worker: its pass is below us on the stack
+        if ( m_worker.get_id() == ::std::this_thread::get_id() ) {
+            return crashing;
+        }
+
+        // Let a pass in progress finish; a slow sink may hold it for long
+        if ( crashing ) {
+            const core::UInt64 deadline = monotonicNs() + kEmergencyWaitNs;
+            while ( m_workerBusy.load( ::std::memory_order_seq_cst ) && monotonicNs() < deadline ) {
+            }
+        } else {
+            while ( m_workerBusy.load( ::std::memory_order_seq_cst ) ) {
+                const struct timespec pause = { 0, 100000 };
+                ::nanosleep( &pause, nullptr );
+            }
+        }
+        return true;
+    }
+
+    void AsyncLogQueue::resumeWorker() noexcept
+    {
+        m_halted.store( false, ::std::memory_order_release );
+    }
+
+    core::Size AsyncLogQueue::drainEmergency( EmergencyHandler handler, void* context ) noexcept
+    {
+        core::Size total = 0;
+        for ( auto& slot : m_emergencyRings ) {
+            LogRing* ring = slot.load( ::std::memory_order_acquire );
+            if ( ring ) {
+                total += ring->drain( ~static_cast< core::Size >( 0 ), [handler, context]( const LogEntry& entry ) noexcept {
+                    handler( context, entry );
+                } );
+            }
+        }
+        return total;
+    }
+
+    void AsyncLogQueue::wakeWorker() noexcept
+    {
+        {
+            ::std::lock_guard< ::std::mutex > lock( m_waitMutex );
+        }
+        m_wakeCv.notify_one();
+    }
+
+    void AsyncLogQueue::wakeWorkerIfIdle() noexcept
+    {
+        // Only signal a parked worker; a missed wake-up is bounded by idleWaitMs
+        if ( m_workerIdle.load( ::std::memory_order_relaxed ) &&
+             m_workerIdle.exchange( false, ::std::memory_order_acq_rel ) ) {
+            wakeWorker();
+        }
+    }
+
+} // namespace log
+} // namespace lap
@@ -0,0 +1,674 @@
+/**
+ * @file        CBinaryFileSink.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Binary file sink implementation
+ * @date        2026-10-16
+ */
+
+#include "CBinaryFileSink.hpp"
+#include "CArgEncoding.hpp"
+#include "CModeledMessage.hpp"
+#include "CNumberFormat.hpp"
+#include "CTimestampFormat.hpp"
+#include "CLogClock.hpp"
+#include <lap/core/CFile.hpp>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lap
+{
+namespace log
+{
+    namespace
+    {
+        // Longest context ID stored in a context record, as FileSink prints it
+        constexpr core::Size kMaxContextChars = 256;
+
+        // [kind|tid|level:1][dt:10][context:5][tid:5][messageId:5]
+        constexpr core::Size kMaxRecordHeader = 1 + 10 + 5 + 5 + 5;
+
+        // Length prefix of the largest record header plus a context record
+        constexpr core::Size kMaxLengthPrefix = 10;
+
+        inline core::Size putVarint(core::UInt8* out, core::UInt64 value) noexcept
+        {
+            core::Size len = 0;
+            while (value >= 0x80) {
+                out[len++] = static_cast<core::UInt8>(value | 0x80);
+                value >>= 7;
+            }
+            out[len++] = static_cast<core::UInt8>(value);
+            return len;
+        }
+
+        inline core::Size varintSize(core::UInt64 value) noexcept
+        {
+            core::Size len = 1;
+            while (value >= 0x80) {
+                value >>= 7;
+                ++len;
+            }
+            return len;
+        }
+
+        // Records of different threads are not strictly ordered in time
+        inline core::UInt64 zigzag(core::Int64 value) noexcept
+        {
+            return (static_cast<core::UInt64>(value) << 1) ^ static_cast<core::UInt64>(value >> 63);
+        }
+
+        inline core::Size roundUp(core::Size value, core::Size step) noexcept
+        {
+            return (value + step - 1) / step * step;
+        }
+
+        // Template table: at most half of the slots are used, probes stay short
+        constexpr core::Size    kTemplateSlots  = 2 * 2 * BinaryFileSink::kMaxTemplates;
+        constexpr core::UInt32  kEmptySlot      = 0xFFFFFFFFu;
+        constexpr core::UInt32  kSeenOnce       = 0xFFFFFFFEu;
+        constexpr core::UInt32  kNoTemplate     = 0xFFFFFFFFu;
+        static_assert((kTemplateSlots & (kTemplateSlots - 1)) == 0, "template slots are masked");
+
+        // Longest digit run cut out of a text template, always below 2^64
+        constexpr core::Size    kMaxNumberDigits = 19;
+
+        // Eight bytes per step, templates are hashed on every record
+        inline core::UInt64 hashBytes(const core::UInt8* data, core::Size size) noexcept
+        {
+            constexpr core::UInt64 kMul = 0x9E3779B97F4A7C15ULL;
+            core::UInt64 hash = size * kMul;
+            core::UInt64 word;
+            for (; size >= sizeof(word); data += sizeof(word), size -= sizeof(word)) {
+                std::memcpy(&word, data, sizeof(word));
+                hash = (hash ^ word) * kMul;
+                hash ^= hash >> 32;
+            }
+            if (size > 0) {
+                word = 0;
+                std::memcpy(&word, data, size);
+                hash = (hash ^ word) * kMul;
+                hash ^= hash >> 32;
+            }
+            return hash;
+        }
+
+        // Template pieces are a few bytes: word copies beat the rep movs GCC emits for memcpy here
+        inline void copyBytes(core::UInt8* out, const core::UInt8* in, core::Size size) noexcept
+        {
+            constexpr core::Size kWord = sizeof(core::UInt64);
+            for (; size >= kWord; in += kWord, out += kWord, size -= kWord) {
+                std::memcpy(out, in, kWord);
+            }
+            for (; size > 0; --size) {
+                *out++ = *in++;
+            }
+        }
+
+        template <typename T>
+        inline core::UInt64 loadUnsigned(const core::UInt8* p) noexcept
+        {
+            T value;
+            std::memcpy(&value, p, sizeof(T));
+            return static_cast<core::UInt64>(value);
+        }
+
+        template <typename T>
+        inline core::Int64 loadSigned(const core::UInt8* p) noexcept
+        {
+            T value;
+            std::memcpy(&value, p, sizeof(T));
+            return static_cast<core::Int64>(value);
+        }
+    }
+
+    BinaryFileSink::BinaryFileSink(
+        core::StringView filePath,
+        core::Size maxSize,
+        core::UInt32 maxFiles,
+        LogLevel minLevel,
+        core::StringView appId,
+        core::Size preallocSize
+    ) noexcept
+        : m_filePath(filePath.data(), filePath.size())
+        , m_maxSize(maxSize)
+        , m_maxFiles(maxFiles)
+        , m_preallocSize(preallocSize)
+        , m_enabled(true)
+        , m_withThreadId(false)
+        , m_minLevel(minLevel)
+        , m_fd(-1)
+        , m_map(nullptr)
+        , m_mapSize(0)
+        , m_used(0)
+        , m_timeUnit(1000000)
+        , m_lastTick(0)
+        , m_growFailedReported(false)
+        , m_lastIndex(0)
+        , m_templateCount(0)
+        , m_slotsUsed(0)
+        , m_shapeSize(0)
+        , m_valuesSize(0)
+    {
+        // Store appId (max 4 bytes, NUL padded)
+        size_t appIdLen = (appId.size() > 4) ? 4 : appId.size();
+        std::memset(m_appId, 0, sizeof(m_appId));
+        std::memcpy(m_appId, appId.data(), appIdLen);
+
+        // Whole pages, and room for the header plus a typical record
+        const core::Size page = static_cast<core::Size>(::sysconf(_SC_PAGESIZE));
+        m_preallocSize = roundUp(m_preallocSize < page ? page : m_preallocSize, page);
+
+        // Without the table every payload is stored as it is
+        try {
+            m_shape.resize(kMaxTemplateSize);
+            m_values.resize(kMaxTemplateSize + kMaxTemplateSize / 8);
+            m_templateSlots.resize(kTemplateSlots, TemplateSlot{0, kEmptySlot, 0, 0});
+        } catch (const std::exception&) {
+            m_templateSlots.clear();
+        }
+
+        // Records are never appended to a file of another run
+        struct stat st;
+        if (::stat(m_filePath.c_str(), &st) == 0 && st.st_size > 0) {
+            shiftBackups();
+        }
+
+        openFile();
+    }
+
+    BinaryFileSink::~BinaryFileSink() noexcept
+    {
+        closeFile();
+    }
+
+    void BinaryFileSink::write(
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        core::StringView message
+    ) noexcept
+    {
+        append(RecordKind::kText, timestamp, threadId, level, contextId, 0, message.data(), message.size());
+    }
+
+    core::Bool BinaryFileSink::writeModeled(
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        const ModeledRecord& record
+    ) noexcept
+    {
+        append(RecordKind::kModeled, timestamp, threadId, level, contextId, record.getMessageId(),
+               record.getPayload(), record.getPayloadSize());
+        return true;
+    }
+
+    core::Bool BinaryFileSink::writeArgs(
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        const core::UInt8* args,
+        core::Size size
+    ) noexcept
+    {
+        append(RecordKind::kArgs, timestamp, threadId, level, contextId, 0, args, size);
+        return true;
+    }
+
+    void BinaryFileSink::append(
+        RecordKind kind,
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        core::UInt32 messageId,
+        const void* payload,
+        core::Size size
+    ) noexcept
+    {
+        if (!isEnabled()) {
+            return;
+        }
+
+        const core::UInt8* bytes = static_cast<const core::UInt8*>(payload);
+        const core::Bool templated = split(kind, bytes, size);
+
+        // Worst case incl. a context and a template record: rotation happens here,
+        // before the context, template and timestamp delta are taken from the current file
+        const core::Size contextLen = contextId.size() > kMaxContextChars ? kMaxContextChars : contextId.size();
+        const core::Size body = templated && m_valuesSize + 5 > size ? m_valuesSize + 5 : size;
+        const core::Size need = 3 * kMaxLengthPrefix + kMaxRecordHeader + 1 + 5 + contextLen + body +
+                                (templated ? 1 + 5 + m_shapeSize : 0);
+        if (!reserve(need)) {
+            return;
+        }
+
+        const core::UInt32 context = internContext(contextId);
+        const core::UInt32 index = templated ? internTemplate() : kNoTemplate;
+        if (index != kNoTemplate) {
+            // kText -> kTemplatedText, kArgs -> kTemplatedArgs, kModeled -> kTemplatedModeled
+            kind = static_cast<RecordKind>(static_cast<core::UInt8>(kind) + 4);
+            bytes = m_values.data();
+            size = m_valuesSize;
+        }
+
+        core::UInt8 header[kMaxRecordHeader + 5];
+        core::Size headerLen = 0;
+        header[headerLen++] = static_cast<core::UInt8>((static_cast<core::UInt8>(kind) << 4) |
+                                                      (m_withThreadId ? kRecordHasThreadId : 0) |
+                                                      (level & 0x0F));
+        const core::UInt64 tick = timestamp / m_timeUnit;
+        headerLen += putVarint(header + headerLen, zigzag(static_cast<core::Int64>(tick - m_lastTick)));
+        headerLen += putVarint(header + headerLen, context);
+        if (m_withThreadId) {
+            headerLen += putVarint(header + headerLen, threadId);
+        }
+        if (kind == RecordKind::kModeled || kind == RecordKind::kTemplatedModeled) {
+            headerLen += putVarint(header + headerLen, messageId);
+        }
+        if (index != kNoTemplate) {
+            headerLen += putVarint(header + headerLen, index);
+        }
+        m_lastTick = tick;
+
+        // Plain stores into the mapping; the page cache owns the data from here
+        core::UInt8* p = m_map + m_used;
+        p += putVarint(p, headerLen + size);
+        std::memcpy(p, header, headerLen);
+        p += headerLen;
+        if (size > 0) {
+            std::memcpy(p, bytes, size);
+            p += size;
+        }
+        m_used = static_cast<core::Size>(p - m_map);
+    }
+
+    core::Bool BinaryFileSink::split(RecordKind kind, const core::UInt8* payload, core::Size size) noexcept
+    {
+        if (m_templateSlots.empty() || size > kMaxTemplateSize) {
+            return false;
+        }
+
+        core::UInt8* const shapeOut = m_shape.data();
+        core::UInt8* const valuesOut = m_values.data();
+        core::Size shape = 0;
+        core::Size values = 0;
+        core::Size pos = 0;
+
+        if (kind == RecordKind::kText) {
+            // Digit runs without a leading zero become a 0x00 placeholder and a varint
+            while (pos < size) {
+                const core::UInt8 c = payload[pos];
+                if (c == 0) {
+                    return false;
+                }
+                if (c < '0' || c > '9') {
+                    shapeOut[shape++] = c;
+                    ++pos;
+                    continue;
+                }
+                core::Size end = pos;
+                core::UInt64 number = 0;
+                while (end < size && payload[end] >= '0' && payload[end] <= '9') {
+                    if (end - pos < kMaxNumberDigits) {
+                        number = number * 10 + static_cast<core::UInt64>(payload[end] - '0');
+                    }
+                    ++end;
+                }
+                if (end - pos > kMaxNumberDigits || (c == '0' && end - pos > 1)) {
+                    copyBytes(shapeOut + shape, payload + pos, end - pos);
+                    shape += end - pos;
+                } else {
+                    shapeOut[shape++] = 0;
+                    values += putVarint(valuesOut + values, number);
+                }
+                pos = end;
+            }
+            m_shapeSize = shape;
+            m_valuesSize = values;
+            return true;
+        }
+
+        // Arguments: tags, names and strings form the template, integers become
+        // (zigzag) varints, other fixed size values are kept as bytes
+        while (pos < size) {
+            const core::Size start = pos;
+            const core::UInt8 tag = payload[pos++];
+            const ArgType type = static_cast<ArgType>(tag & kArgTypeMask);
+            if (tag & kArgNamed) {
+                if (pos >= size || pos + 1 + payload[pos] > size) {
+                    return false;
+                }
+                pos += 1 + payload[pos];
+            }
+
+            if (type == ArgType::kErrorCode) {
+                // Tag and name, the code as value, then the domain like a string
+                if (pos + sizeof(core::Int64) > size) {
+                    return false;
+                }
+                copyBytes(shapeOut + shape, payload + start, pos - start);
+                shape += pos - start;
+                values += putVarint(valuesOut + values, zigzag(loadSigned<core::Int64>(payload + pos)));
+                pos += sizeof(core::Int64);
+            }
+            if (type == ArgType::kString || type == ArgType::kErrorCode) {
+                core::UInt16 len;
+                if (pos + sizeof(len) > size) {
+                    return false;
+                }
+                std::memcpy(&len, payload + pos, sizeof(len));
+                if (pos + sizeof(len) + len > size) {
+                    return false;
+                }
+                const core::Size from = type == ArgType::kString ? start : pos;
+                pos += sizeof(len) + len;
+                copyBytes(shapeOut + shape, payload + from, pos - from);
+                shape += pos - from;
+                continue;
+            }
+
+            const core::Size width = ArgView::valueSize(type);
+            if (width == 0 || pos + width > size) {
+                return false;
+            }
+            if (pos == start + 1) {
+                shapeOut[shape++] = tag;
+            } else {
+                copyBytes(shapeOut + shape, payload + start, pos - start);
+                shape += pos - start;
+            }
+            const core::UInt8* value = payload + pos;
+            pos += width;
+            switch (type) {
+            case ArgType::kUInt8:   values += putVarint(valuesOut + values, loadUnsigned<core::UInt8>(value)); break;
+            case ArgType::kUInt16:  values += putVarint(valuesOut + values, loadUnsigned<core::UInt16>(value)); break;
+            case ArgType::kUInt32:  values += putVarint(valuesOut + values, loadUnsigned<core::UInt32>(value)); break;
+            case ArgType::kUInt64:  values += putVarint(valuesOut + values, loadUnsigned<core::UInt64>(value)); break;
+            case ArgType::kInt8:    values += putVarint(valuesOut + values, zigzag(loadSigned<core::Int8>(value))); break;
+            case ArgType::kInt16:   values += putVarint(valuesOut + values, zigzag(loadSigned<core::Int16>(value))); break;
+            case ArgType::kInt32:   values += putVarint(valuesOut + values, zigzag(loadSigned<core::Int32>(value))); break;
+            case ArgType::kInt64:   values += putVarint(valuesOut + values, zigzag(loadSigned<core::Int64>(value))); break;
+            default:
+                std::memcpy(valuesOut + values, value, width);
+                values += width;
+                break;
+            }
+        }
+        m_shapeSize = shape;
+        m_valuesSize = values;
+        return true;
+    }
+
+    core::UInt32 BinaryFileSink::internTemplate() noexcept
+    {
+        const core::UInt64 hash = hashBytes(m_shape.data(), m_shapeSize);
+        const core::Size mask = m_templateSlots.size() - 1;
+        core::Size i = static_cast<core::Size>(hash) & mask;
+        for (;; i = (i + 1) & mask) {
+            TemplateSlot& slot = m_templateSlots[i];
+            if (slot.index == kEmptySlot) {
+                break;
+            }
+            if (slot.hash != hash) {
+                continue;
+            }
+            if (slot.index != kSeenOnce) {
+                if (slot.size == m_shapeSize &&
+                    std::memcmp(m_templateBytes.data() + slot.offset, m_shape.data(), m_shapeSize) == 0) {
+                    return slot.index;
+                }
+                continue;
+            }
+
+            // Second occurrence: define the template, unless this file is out of templates
+            if (m_templateCount >= kMaxTemplates || m_templateBytes.size() + m_shapeSize > kMaxTemplateBytes) {
+                return kNoTemplate;
+            }
+            try {
+                slot.offset = static_cast<core::UInt32>(m_templateBytes.size());
+                m_templateBytes.insert(m_templateBytes.end(), m_shape.begin(), m_shape.begin() + m_shapeSize);
+            } catch (const std::exception&) {
+                return kNoTemplate;
+            }
+            slot.size = static_cast<core::UInt32>(m_shapeSize);
+            slot.index = m_templateCount++;
+
+            // [len][kind][index][template], space was reserved by append()
+            core::UInt8* p = m_map + m_used;
+            p += putVarint(p, 1 + varintSize(slot.index) + m_shapeSize);
+            *p++ = static_cast<core::UInt8>(static_cast<core::UInt8>(RecordKind::kTemplate) << 4);
+            p += putVarint(p, slot.index);
+            std::memcpy(p, m_shape.data(), m_shapeSize);
+            p += m_shapeSize;
+            m_used = static_cast<core::Size>(p - m_map);
+            return slot.index;
+        }
+
+        // First occurrence: remember it, the payload is stored as it is
+        if (m_slotsUsed < m_templateSlots.size() / 2) {
+            TemplateSlot& slot = m_templateSlots[i];
+            slot.hash = hash;
+            slot.index = kSeenOnce;
+            slot.offset = 0;
+            slot.size = 0;
+            ++m_slotsUsed;
+        }
+        return kNoTemplate;
+    }
+
+    core::UInt32 BinaryFileSink::internContext(core::StringView contextId) noexcept
+    {
+        if (contextId.size() > kMaxContextChars) {
+            contextId = core::StringView(contextId.data(), kMaxContextChars);
+        }
+
+        // Consecutive records mostly share their context
+        if (!m_contexts.empty() &&
+            contextId.size() == m_lastContext.size() &&
+            std::memcmp(contextId.data(), m_lastContext.data(), contextId.size()) == 0) {
+            return m_lastIndex;
+        }
+
+        try {
+            core::String key(contextId.data(), contextId.size());
+            auto it = m_contexts.find(key);
+            if (it == m_contexts.end()) {
+                const core::UInt32 index = static_cast<core::UInt32>(m_contexts.size());
+                it = m_contexts.emplace(key, index).first;
+
+                // [len][kind][index][context ID], space was reserved by append()
+                core::UInt8* p = m_map + m_used;
+                p += putVarint(p, 1 + varintSize(index) + contextId.size());
+                *p++ = static_cast<core::UInt8>(static_cast<core::UInt8>(RecordKind::kContext) << 4);
+                p += putVarint(p, index);
+                std::memcpy(p, contextId.data(), contextId.size());
+                p += contextId.size();
+                m_used = static_cast<core::Size>(p - m_map);
+            }
+            m_lastContext = core::Move(key);
+            m_lastIndex = it->second;
+        } catch (const std::exception&) {
+            // Out of memory: the record goes to the first context of the file
+            return 0;
+        }
+        return m_lastIndex;
+    }
+
+    core::Bool BinaryFileSink::reserve(core::Size need) noexcept
+    {
+        if (m_maxSize > 0 && m_used > kHeaderSize && m_used + need > m_maxSize) {
+            if (!rotate()) {
+                return false;
+            }
+        }
+
+        if (m_used + need <= m_mapSize) {
+            return true;
+        }
+
+        // Grow file and mapping by whole steps; one fallocate + mremap per step
+        const core::Size newSize = roundUp(m_used + need, m_preallocSize);
+        const int err = ::posix_fallocate(m_fd, 0, static_cast<off_t>(newSize));
+        void* map = (err == 0) ? ::mremap(m_map, m_mapSize, newSize, MREMAP_MAYMOVE) : MAP_FAILED;
+        if (map == MAP_FAILED) {
+            if (!m_growFailedReported) {
+                fprintf(stderr, "[LightAP] BinaryFileSink: Cannot grow %s to %zu bytes: %s, records dropped\n",
+                        m_filePath.c_str(), newSize, std::strerror(err != 0 ? err : errno));
+                m_growFailedReported = true;
+            }
+            return false;
+        }
+        m_map = static_cast<core::UInt8*>(map);
+        m_mapSize = newSize;
+        return true;
+    }
+
+    void BinaryFileSink::flush() noexcept
+    {
+        // Records are in the page cache as soon as they are copied into the
+        // mapping (visible to readers, survive a process crash); write-back
+        // is left to the kernel and forced only on close
+    }
+
+    core::Bool BinaryFileSink::shouldLog(LogLevel level) const noexcept
+    {
+        if (!isEnabled()) {
+            return false;
+        }
+
+        // Lower numeric value = higher priority
+        using LevelType = typename std::underlying_type<LogLevel>::type;
+        return static_cast<LevelType>(level) <= static_cast<LevelType>(m_minLevel);
+    }
+
+    core::Bool BinaryFileSink::rotate() noexcept
+    {
+        if (m_fd < 0) {
+            return false;
+        }
+
+        closeFile();
+        shiftBackups();
+        return openFile();
+    }
+
+    void BinaryFileSink::shiftBackups() noexcept
+    {
+        // Rotate backup files: app.lapb.N -> app.lapb.N+1
+        for (core::Int32 i = m_maxFiles - 1; i >= 1; --i) {
+            core::String oldPath = m_filePath + "." + std::to_string(i);
+            core::String newPath = m_filePath + "." + std::to_string(i + 1);
+
+            // Delete oldest backup if exists
+            if (i == static_cast<core::Int32>(m_maxFiles) - 1) {
+                core::File::Util::remove(newPath);
+            }
+
+            core::File::Util::rename(oldPath, newPath);
+        }
+
+        // Rename current log file to .1
+        core::String backupPath = m_filePath + ".1";
+        core::File::Util::rename(m_filePath, backupPath);
+    }
+
+    core::Bool BinaryFileSink::openFile() noexcept
+    {
+        m_fd = ::open(m_filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (m_fd < 0) {
+            fprintf(stderr, "[LightAP] BinaryFileSink: Cannot open %s: %s\n", m_filePath.c_str(), std::strerror(errno));
+            return false;
+        }
+
+        const int err = ::posix_fallocate(m_fd, 0, static_cast<off_t>(m_preallocSize));
+        void* map = (err == 0)
+            ? ::mmap(nullptr, m_preallocSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0)
+            : MAP_FAILED;
+        if (map == MAP_FAILED) {
+            fprintf(stderr, "[LightAP] BinaryFileSink: Cannot map %zu bytes of %s: %s\n",
+                    m_preallocSize, m_filePath.c_str(), std::strerror(err != 0 ? err : errno));
+            ::close(m_fd);
+            m_fd = -1;
+            return false;
+        }
+        m_map = static_cast<core::UInt8*>(map);
+        m_mapSize = m_preallocSize;
+
+        // File header, see doc/design/BinaryLog_Format.md
+        // Deltas count ticks of the text sinks' precision, the base is a whole tick
+        const TimestampPrecision precision = TimestampFormat::getPrecision();
+        m_timeUnit = 1;
+        for (core::UInt8 i = static_cast<core::UInt8>(precision); i < 9; ++i) {
+            m_timeUnit *= 10;
+        }
+        m_lastTick = LogClock::now() / m_timeUnit;
+        const core::UInt64 base = m_lastTick * m_timeUnit;
+        const core::UInt16 headerSize = static_cast<core::UInt16>(kHeaderSize);
+        const NumberFormat::FloatConfig floatConfig = NumberFormat::getFloatConfig();
+
+        // Offset of local time at open, the decoder renders local time like FileSink
+        core::Int32 utcOffset = 0;
+        struct tm tmInfo;
+        const time_t now = ::time(nullptr);
+        if (::localtime_r(&now, &tmInfo) != nullptr) {
+            utcOffset = static_cast<core::Int32>(tmInfo.tm_gmtoff);
+        }
+
+        core::UInt8* h = m_map;
+        std::memcpy(h, "LAPB", 4);
+        h[4] = kFormatVersion;
+        h[5] = (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) ? 1 : 2;
+        std::memcpy(h + 6, &headerSize, sizeof(headerSize));
+        std::memcpy(h + 8, m_appId, sizeof(m_appId));
+        h[12] = static_cast<core::UInt8>(precision);
+        h[13] = static_cast<core::UInt8>(floatConfig.format);
+        h[14] = static_cast<core::UInt8>(floatConfig.floatPrecision);
+        h[15] = static_cast<core::UInt8>(floatConfig.doublePrecision);
+        std::memcpy(h + 16, &base, sizeof(base));
+        std::memcpy(h + 24, &utcOffset, sizeof(utcOffset));
+        std::memset(h + 28, 0, 4);
+
+        m_used = kHeaderSize;
+        m_contexts.clear();
+        m_lastContext.clear();
+        m_lastIndex = 0;
+        for (TemplateSlot& slot : m_templateSlots) {
+            slot.index = kEmptySlot;
+        }
+        m_templateBytes.clear();
+        m_templateCount = 0;
+        m_slotsUsed = 0;
+        m_growFailedReported = false;
+        return true;
+    }
+
+    void BinaryFileSink::closeFile() noexcept
+    {
+        if (m_map != nullptr) {
+            ::msync(m_map, m_used, MS_SYNC);
+            ::munmap(m_map, m_mapSize);
+            m_map = nullptr;
+            m_mapSize = 0;
+        }
+        if (m_fd >= 0) {
+            // Drop the unused pre-allocated tail
+            if (::ftruncate(m_fd, static_cast<off_t>(m_used)) != 0) {
+                fprintf(stderr, "[LightAP] BinaryFileSink: Cannot truncate %s: %s\n", m_filePath.c_str(), std::strerror(errno));
+            }
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+} // namespace log
+} // namespace lap
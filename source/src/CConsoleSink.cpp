@@ -6,19 +6,60 @@
  */
 
 #include "CConsoleSink.hpp"
+#include "CTimestampFormat.hpp"
+#include "CNumberFormat.hpp"
+#include <cerrno>
 #include <cstdio>
+#include <cstring>
 #include <ctime>
+#include <sys/uio.h>
+#include <unistd.h>
 #include <lap/core/CTime.hpp>
 
 namespace lap
 {
 namespace log
 {
-    ConsoleSink::ConsoleSink(core::Bool colorized, LogLevel minLevel) noexcept
+    namespace
+    {
+        // Checked on every buffered record: vDSO, no syscall
+        inline core::UInt64 monotonicMs() noexcept
+        {
+            struct timespec ts;
+            ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+            return static_cast<core::UInt64>(ts.tv_sec) * 1000 + static_cast<core::UInt64>(ts.tv_nsec) / 1000000;
+        }
+    }
+    
+    ConsoleSink::ConsoleSink(core::Bool colorized, LogLevel minLevel, const ConsoleConfig& config) noexcept
         : m_enabled(true)
-        , m_colorized(colorized)
+        , m_colorized(false)
+        , m_isTerminal(false)
+        , m_withThreadId(false)
         , m_minLevel(minLevel)
+        , m_config(config)
+        , m_fd(config.stream == ConsoleStream::kStdout ? STDOUT_FILENO : STDERR_FILENO)
+        , m_pid(::getpid())
+    {
+        // Redirected to a file or pipe (journald, docker, CI): no escape codes in the captured text
+        m_isTerminal = ::isatty(m_fd) == 1;
+        setColorized(colorized);
+        
+        if (m_config.bufferSize > 0) {
+            try {
+                m_buffer.resize(m_config.bufferSize);
+            } catch (const std::exception&) {
+                fprintf(stderr, "[LightAP] ConsoleSink: Cannot allocate %zu byte write buffer, writing unbuffered\n",
+                        m_config.bufferSize);
+                m_buffer.clear();
+                m_config.bufferSize = 0;
+            }
+        }
+    }
+    
+    ConsoleSink::~ConsoleSink() noexcept
     {
+        flushBuffer();
     }
     
     void ConsoleSink::write(
@@ -29,38 +70,190 @@ namespace log
         core::StringView message
     ) noexcept
     {
-        UNUSED(threadId);
-        
         if (!m_enabled) {
             return;
         }
         
-        // Format timestamp
-        char timeBuffer[16];
-        formatTimestamp(timestamp, timeBuffer);
+        // Format: [BOLD][COLOR][TIME] [LEVEL] [CONTEXT] [tid:N][RESET] message\n
+        char prefix[kMaxPrefixChars];
+        const core::Size prefixLen = formatPrefix(prefix, timestamp, threadId, level, contextId);
+        
+        if (m_config.bufferSize == 0) {
+            writeLine(prefix, prefixLen, message);
+            return;
+        }
+        
+        const core::Size len = prefixLen + message.size() + 1;
+        if (m_bufferUsed + len > m_config.bufferSize) {
+            flushBuffer();
+        }
+        
+        if (len > m_config.bufferSize) {
+            // Larger than the whole buffer: write through
+            writeLine(prefix, prefixLen, message);
+            return;
+        }
+        
+        if (m_bufferUsed == 0) {
+            m_firstPendingMs = monotonicMs();
+            m_pid = ::getpid();
+        }
+        char* out = m_buffer.data() + m_bufferUsed;
+        std::memcpy(out, prefix, prefixLen);
+        std::memcpy(out + prefixLen, message.data(), message.size());
+        out[len - 1] = '\n';
+        m_bufferUsed += len;
+        
+        // ERROR/FATAL go out immediately: they are read when something goes wrong
+        const core::Bool urgent = level <= static_cast<LogLevelType>(LogLevel::kError);
+        if (urgent || monotonicMs() - m_firstPendingMs >= m_config.flushIntervalMs) {
+            flushBuffer();
+        }
+    }
+    
+    core::Bool ConsoleSink::writeEmergency(
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        core::StringView message
+    ) noexcept
+    {
+        if (!m_enabled) {
+            return false;
+        }
+        
+        // Earlier records first; the buffer lock may be held by the interrupted thread
+        flushBuffer();
+        return writeEmergencyUnbatched(timestamp, threadId, level, contextId, message);
+    }
+    
+    core::Bool ConsoleSink::writeEmergencyUnbatched(
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        core::StringView message
+    ) noexcept
+    {
+        if (!m_enabled) {
+            return false;
+        }
+        
+        // Same layout as write(), assembled on the stack: no stdio from a signal handler
+        char line[4096];
+        char* const end = line + sizeof(line) - 1;
+        char* p = line;
+        auto append = [&p, end](const char* data, core::Size len) noexcept {
+            const core::Size room = static_cast<core::Size>(end - p);
+            len = len < room ? len : room;
+            std::memcpy(p, data, len);
+            p += len;
+        };
         
-        // Get level info
-        const char* levelColor = m_colorized ? getLevelColor(level) : "";
-        const char* levelName = getLevelName(level);
-        const char* resetColor = m_colorized ? ANSI_RESET : "";
-        const char* boldColor = m_colorized ? ANSI_BOLD : "";
+        if (m_colorized) {
+            append(ANSI_BOLD, std::strlen(ANSI_BOLD));
+            const char* levelColor = getLevelColor(level);
+            append(levelColor, std::strlen(levelColor));
+        }
+        *p++ = '[';
+        p += TimestampFormat::formatTimeSignalSafe(p, timestamp);
+        append("] [", 3);
+        append(getLevelName(level), 5);
+        append("] [", 3);
+        append(contextId.data(), contextId.size() > kMaxContextChars ? kMaxContextChars : contextId.size());
+        *p++ = ']';
+        if (m_withThreadId) {
+            append(" [tid:", 6);
+            p += NumberFormat::formatUInt(p, threadId);
+            *p++ = ']';
+        }
+        if (m_colorized) {
+            append(ANSI_RESET, std::strlen(ANSI_RESET));
+        }
+        append(" ", 1);
+        append(message.data(), message.size());
+        *p++ = '\n';
         
-        // Output formatted log
-        // Format: [BOLD][COLOR][TIME] [LEVEL] [CONTEXT][RESET] message\n
-        fprintf(stderr, "%s%s[%s] [%s] [%.*s]%s %.*s\n",
-                boldColor,
-                levelColor,
-                timeBuffer,
-                levelName,
-                static_cast<int>(contextId.size()), contextId.data(),
-                resetColor,
-                static_cast<int>(message.size()), message.data());
+        writeAll(line, static_cast<core::Size>(p - line));
+        return true;
+    }
+    
+    void ConsoleSink::flushExpired(core::UInt32 slackMs) noexcept
+    {
+        // Timer side of the age check in write()
+        if (m_enabled && m_bufferUsed > 0 && monotonicMs() - m_firstPendingMs + slackMs >= m_config.flushIntervalMs) {
+            flushBuffer();
+        }
     }
     
     void ConsoleSink::flush() noexcept
     {
         if (m_enabled) {
-            fflush(stderr);
+            flushBuffer();
+        }
+    }
+    
+    void ConsoleSink::flushBuffer() noexcept
+    {
+        if (m_bufferUsed == 0) {
+            return;
+        }
+        
+        // Batch started before fork(): the parent writes it, the child drops its copy
+        if (::getpid() == m_pid) {
+            writeAll(m_buffer.data(), m_bufferUsed);
+        }
+        m_bufferUsed = 0;
+    }
+    
+    void ConsoleSink::writeAll(const char* data, core::Size len) noexcept
+    {
+        while (len > 0) {
+            const ssize_t written = ::write(m_fd, data, len);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written <= 0) {
+                break;      // Closed or broken stream: nothing to report to
+            }
+            data += written;
+            len -= static_cast<core::Size>(written);
+        }
+    }
+    
+    void ConsoleSink::writeLine(const char* prefix, core::Size prefixLen, core::StringView message) noexcept
+    {
+        struct iovec iov[3];
+        iov[0].iov_base = const_cast<char*>(prefix);
+        iov[0].iov_len = prefixLen;
+        iov[1].iov_base = const_cast<char*>(message.data());
+        iov[1].iov_len = message.size();
+        iov[2].iov_base = const_cast<char*>("\n");
+        iov[2].iov_len = 1;
+        
+        struct iovec* first = iov;
+        int count = 3;
+        while (count > 0) {
+            const ssize_t written = ::writev(m_fd, first, count);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written <= 0) {
+                break;
+            }
+            
+            // Partial write: skip what went out, resume inside the current iovec
+            core::Size done = static_cast<core::Size>(written);
+            while (count > 0 && done >= first->iov_len) {
+                done -= first->iov_len;
+                ++first;
+                --count;
+            }
+            if (count > 0) {
+                first->iov_base = static_cast<char*>(first->iov_base) + done;
+                first->iov_len -= done;
+            }
         }
     }
     
@@ -104,23 +297,43 @@ namespace log
     
     core::Size ConsoleSink::formatTimestamp(core::UInt64 timestamp, char* buffer) const noexcept
     {
-        // Convert microseconds to seconds and microseconds
-        time_t seconds = timestamp / 1000000;
-        core::UInt32 microseconds = timestamp % 1000000;
-        core::UInt32 milliseconds = microseconds / 1000;
-        
-        // Convert to local time
-        struct tm tmInfo;
-        localtime_r(&seconds, &tmInfo);
+        // Format as HH:MM:SS.fff from the per-thread second cache (no localtime_r per record)
+        core::Size len = TimestampFormat::formatTime(buffer, timestamp);
+        buffer[len] = '\0';
+        return len;
+    }
+    
+    core::Size ConsoleSink::formatPrefix(char* buffer, core::UInt64 timestamp, core::UInt32 threadId,
+                                         LogLevelType level, core::StringView contextId) const noexcept
+    {
+        char* p = buffer;
+        auto append = [&p](const char* data, core::Size len) noexcept {
+            std::memcpy(p, data, len);
+            p += len;
+        };
         
-        // Format as HH:MM:SS.mmm
-        return static_cast<core::Size>(
-            snprintf(buffer, 16, "%02d:%02d:%02d.%03u",
-                    tmInfo.tm_hour,
-                    tmInfo.tm_min,
-                    tmInfo.tm_sec,
-                    milliseconds)
-        );
+        if (m_colorized) {
+            append(ANSI_BOLD, std::strlen(ANSI_BOLD));
+            const char* levelColor = getLevelColor(level);
+            append(levelColor, std::strlen(levelColor));
+        }
+        *p++ = '[';
+        p += formatTimestamp(timestamp, p);
+        append("] [", 3);
+        append(getLevelName(level), 5);
+        append("] [", 3);
+        append(contextId.data(), contextId.size() > kMaxContextChars ? kMaxContextChars : contextId.size());
+        *p++ = ']';
+        if (m_withThreadId) {
+            append(" [tid:", 6);
+            p += NumberFormat::formatUInt(p, threadId);
+            *p++ = ']';
+        }
+        if (m_colorized) {
+            append(ANSI_RESET, std::strlen(ANSI_RESET));
+        }
+        *p++ = ' ';
+        return static_cast<core::Size>(p - buffer);
     }
     
 } // namespace log
@@ -0,0 +1,290 @@
+/**
+ * @file        CCrashHandler.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Fatal signal handler and async-signal-safe emergency log path
+ * @date        2026-10-16
+ */
+
+#include "CCrashHandler.hpp"
+#include "CSinkManager.hpp"
+#include "CAsyncLogQueue.hpp"
+#include "CLogClock.hpp"
+#include "CNumberFormat.hpp"
+#include "CTimestampFormat.hpp"
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace lap
+{
+namespace log
+{
+    namespace
+    {
+        constexpr int           kSignals[]      = { SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT };
+        constexpr core::Size    kSignalCount    = sizeof( kSignals ) / sizeof( kSignals[0] );
+
+        // A second thread faulting while the first is still writing waits this long before dying
+        constexpr core::UInt64  kConcurrentWaitNs = 2ULL * 1000 * 1000 * 1000;
+
+        ::std::atomic< SinkManager* >   s_sinkManager{ nullptr };
+        ::std::atomic< AsyncLogQueue* > s_asyncQueue{ nullptr };
+        ::std::atomic< core::Bool >     s_installed{ false };
+        ::std::atomic< core::Int32 >    s_handlingTid{ 0 };     ///< Thread running the handler, 0 if none
+        ::std::atomic< core::Int32 >    s_drainingTid{ 0 };     ///< Thread draining the rings for logFatal(), 0 if none
+
+        struct sigaction                s_previous[ kSignalCount ];
+        alignas( 16 ) char              s_altStack[ CrashHandler::kAltStackSize ];
+
+        const char* signalName( int sig ) noexcept
+        {
+            switch ( sig ) {
+                case SIGSEGV:   return "SIGSEGV";
+                case SIGBUS:    return "SIGBUS";
+                case SIGFPE:    return "SIGFPE";
+                case SIGILL:    return "SIGILL";
+                case SIGABRT:   return "SIGABRT";
+                default:        return "signal";
+            }
+        }
+
+        inline core::Int32 currentTid() noexcept
+        {
+            // ThreadId::current() reads a thread_local: not in a signal handler
+            return static_cast< core::Int32 >( ::syscall( SYS_gettid ) );
+        }
+
+        inline core::UInt64 monotonicNs() noexcept
+        {
+            struct timespec ts;
+            ::clock_gettime( CLOCK_MONOTONIC, &ts );
+            return static_cast< core::UInt64 >( ts.tv_sec ) * 1000000000ULL + static_cast< core::UInt64 >( ts.tv_nsec );
+        }
+
+        struct ForwardTarget
+        {
+            SinkManager*        sinks;
+            core::Bool          crashing;
+        };
+
+        void forwardQueued( void* context, const LogEntry& entry ) noexcept
+        {
+            const ForwardTarget* target = static_cast< const ForwardTarget* >( context );
+            target->sinks->writeEmergency( entry.timestamp, entry.threadId, entry.level, entry.getContextId(),
+                                           entry.getMessage(), entry.format, target->crashing );
+        }
+
+        struct EmergencyRecord
+        {
+            core::UInt64        timestamp;
+            core::UInt32        threadId;
+            core::StringView    contextId;
+            core::StringView    message;
+        };
+
+        /**
+         * @brief Batched and queued records, then record (if any), with the async worker held off
+         * @param halt Leave the worker halted (the process is going down); only then are
+         *             sink batches touched without their lock, otherwise a sink whose lock
+         *             is held keeps its batch and gets the records unbatched
+         */
+        void writeOut( const EmergencyRecord* record, core::Bool halt ) noexcept
+        {
+            SinkManager* sinks = s_sinkManager.load( ::std::memory_order_acquire );
+            if ( sinks == nullptr ) {
+                return;
+            }
+
+            // Without a crash the rings take one consumer besides the worker at a time:
+            // concurrent logFatal() callers take turns, a nested one (signal handler
+            // interrupting logFatal() on the same thread) leaves the rings alone
+            AsyncLogQueue* queue = s_asyncQueue.load( ::std::memory_order_acquire );
+            core::Bool draining = false;
+            if ( queue != nullptr && !halt ) {
+                const core::Int32 tid = currentTid();
+                for ( ;; ) {
+                    core::Int32 expected = 0;
+                    if ( s_drainingTid.compare_exchange_strong( expected, tid, ::std::memory_order_acq_rel ) ) {
+                        draining = true;
+                        break;
+                    }
+                    if ( expected == tid ) {
+                        queue = nullptr;
+                        break;
+                    }
+                    const struct timespec pause = { 0, 100000 };
+                    ::nanosleep( &pause, nullptr );
+                }
+            }
+
+            // Unbounded wait unless crashing: the worker must be off the rings before we drain them
+            const core::Bool drain = queue != nullptr && queue->haltWorker( halt );
+
+            // Sink batches hold records dispatched before anything still in the rings
+            sinks->flushEmergency( halt );
+            if ( drain ) {
+                ForwardTarget target{ sinks, halt };
+                queue->drainEmergency( &forwardQueued, &target );
+            }
+            if ( record != nullptr ) {
+                sinks->writeEmergency( record->timestamp, record->threadId, static_cast< LogLevelType >( LogLevel::kFatal ),
+                                       record->contextId, record->message, RecordFormat::kText, halt );
+            }
+            sinks->flushEmergency( halt );
+
+            if ( queue != nullptr && !halt ) {
+                queue->resumeWorker();
+            }
+            if ( draining ) {
+                s_drainingTid.store( 0, ::std::memory_order_release );
+            }
+        }
+
+        // "Fatal signal 11 (SIGSEGV), code 1, address 0x0000000000000010"
+        core::Size describeSignal( char* out, int sig, const siginfo_t* info ) noexcept
+        {
+            char* p = out;
+            auto append = [&p]( const char* text ) noexcept {
+                const core::Size len = std::strlen( text );
+                std::memcpy( p, text, len );
+                p += len;
+            };
+
+            append( "Fatal signal " );
+            p += NumberFormat::formatInt( p, sig );
+            append( " (" );
+            append( signalName( sig ) );
+            append( ")" );
+            if ( info != nullptr ) {
+                append( ", code " );
+                p += NumberFormat::formatInt( p, info->si_code );
+                if ( sig != SIGABRT ) {
+                    append( ", address " );
+                    p += NumberFormat::formatHex( p, reinterpret_cast< core::UInt64 >( info->si_addr ), sizeof( void* ) );
+                }
+            }
+            return static_cast< core::Size >( p - out );
+        }
+
+        void onFatalSignal( int sig, siginfo_t* info, void* ) noexcept
+        {
+            const int savedErrno = errno;
+            const core::Int32 tid = currentTid();
+
+            core::Int32 expected = 0;
+            if ( s_handlingTid.compare_exchange_strong( expected, tid, ::std::memory_order_acq_rel ) ) {
+                // Queued and batched records first, then the record naming the signal
+                char message[ 128 ];
+                const EmergencyRecord record{ LogClock::now(), static_cast< core::UInt32 >( tid ), CrashHandler::kContextId,
+                                              core::StringView( message, describeSignal( message, sig, info ) ) };
+                writeOut( &record, true );
+            } else if ( expected != tid ) {
+                // Another thread is writing the crash records: give it time to re-raise
+                const core::UInt64 deadline = monotonicNs() + kConcurrentWaitNs;
+                while ( monotonicNs() < deadline ) {
+                    const struct timespec pause = { 0, 1000000 };
+                    ::nanosleep( &pause, nullptr );
+                }
+            }
+            // else: fault inside the emergency path itself, give up on it
+
+            // Previous disposition (default unless someone else was installed first)
+            for ( core::Size i = 0; i < kSignalCount; ++i ) {
+                if ( kSignals[ i ] == sig ) {
+                    struct sigaction previous = s_previous[ i ];
+                    if ( !( previous.sa_flags & SA_SIGINFO ) && previous.sa_handler == SIG_IGN ) {
+                        previous.sa_handler = SIG_DFL;
+                    }
+                    ::sigaction( sig, &previous, nullptr );
+                    break;
+                }
+            }
+
+            // Blocked while this handler runs: taken by the restored disposition on return
+            errno = savedErrno;
+            ::raise( sig );
+        }
+    }
+
+    void CrashHandler::attach( SinkManager* sinkManager, AsyncLogQueue* asyncQueue ) noexcept
+    {
+        s_asyncQueue.store( asyncQueue, ::std::memory_order_release );
+        s_sinkManager.store( sinkManager, ::std::memory_order_release );
+    }
+
+    core::Bool CrashHandler::install() noexcept
+    {
+        if ( s_installed.exchange( true, ::std::memory_order_acq_rel ) ) {
+            return true;
+        }
+
+        // Sampled here, localtime_r() cannot be called from the handler
+        TimestampFormat::refreshUtcOffset();
+
+        // Stack overflows need a stack of their own to run the handler on
+        stack_t current;
+        if ( ::sigaltstack( nullptr, &current ) == 0 && ( current.ss_flags & SS_DISABLE ) ) {
+            stack_t altStack;
+            altStack.ss_sp    = s_altStack;
+            altStack.ss_size  = sizeof( s_altStack );
+            altStack.ss_flags = 0;
+            if ( ::sigaltstack( &altStack, nullptr ) != 0 ) {
+                fprintf( stderr, "[LightAP] CrashHandler: sigaltstack failed: %s\n", std::strerror( errno ) );
+            }
+        }
+
+        struct sigaction action;
+        std::memset( &action, 0, sizeof( action ) );
+        action.sa_sigaction = &onFatalSignal;
+        action.sa_flags     = SA_SIGINFO | SA_ONSTACK;
+        ::sigemptyset( &action.sa_mask );
+
+        for ( core::Size i = 0; i < kSignalCount; ++i ) {
+            if ( ::sigaction( kSignals[ i ], &action, &s_previous[ i ] ) != 0 ) {
+                fprintf( stderr, "[LightAP] CrashHandler: Cannot install handler for %s: %s\n",
+                         signalName( kSignals[ i ] ), std::strerror( errno ) );
+                for ( core::Size j = 0; j < i; ++j ) {
+                    ::sigaction( kSignals[ j ], &s_previous[ j ], nullptr );
+                }
+                s_installed.store( false, ::std::memory_order_release );
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void CrashHandler::uninstall() noexcept
+    {
+        if ( !s_installed.exchange( false, ::std::memory_order_acq_rel ) ) {
+            return;
+        }
+
+        for ( core::Size i = 0; i < kSignalCount; ++i ) {
+            ::sigaction( kSignals[ i ], &s_previous[ i ], nullptr );
+        }
+    }
+
+    core::Bool CrashHandler::isInstalled() noexcept
+    {
+        return s_installed.load( ::std::memory_order_acquire );
+    }
+
+    void CrashHandler::emergencyFlush( core::Bool halt ) noexcept
+    {
+        writeOut( nullptr, halt );
+    }
+
+    void CrashHandler::logFatal( core::StringView contextId, core::StringView message ) noexcept
+    {
+        const EmergencyRecord record{ LogClock::now(), static_cast< core::UInt32 >( currentTid() ), contextId, message };
+        writeOut( &record, false );
+    }
+
+} // namespace log
+} // namespace lap
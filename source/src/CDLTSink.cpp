@@ -6,6 +6,7 @@
  */
 
 #include "CDLTSink.hpp"
+#include "CModeledMessage.hpp"
 #include <cstring>
 #include <ctime>
 
@@ -22,6 +23,9 @@ namespace log
         , m_dltInitialized(false)
         , m_appRegistered(false)
         , m_appId(config.appId)
+        , m_defaultKey(packId(config.contextId))
+        , m_contextLevel(config.defaultLogLevel)
+        , m_traceStatus(config.traceStatus)
     {
         // Configure DLT options
         dlt_with_session_id(config.withSessionId);
@@ -76,6 +80,13 @@ namespace log
     
     DLTSink::~DLTSink() noexcept
     {
+        for (auto& slot : m_contexts) {
+            if (slot.key.load(std::memory_order_acquire) != 0 && slot.target == &slot.context) {
+                dlt_unregister_context(&slot.context);
+                slot.key.store(0, std::memory_order_relaxed);
+            }
+        }
+        
         if (m_dltInitialized) {
             dlt_unregister_context(&m_defaultContext);
         }
@@ -114,7 +125,7 @@ namespace log
         int ret = dlt_user_log_write_start(ctx, &contextData, dltLevel);
         if (ret > 0) {
             // DLT has a maximum message size of 1390 bytes (DLT_USER_BUF_MAX_SIZE)
-            // Our MAX_LOG_SIZE is 200, so we should be safe, but truncate just in case
+            // LogStream records can exceed this (up to LogStream::GetMaxMessageSize()): truncate
             uint16_t msgLen = static_cast<uint16_t>(message.size());
             if (msgLen > 1300) {  // Leave some margin for DLT headers
                 msgLen = 1300;
@@ -133,6 +144,122 @@ namespace log
         }
     }
     
+    core::Bool DLTSink::writeModeled(
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        const ModeledRecord& record
+    ) noexcept
+    {
+        UNUSED(timestamp);
+        UNUSED(threadId);
+        
+        if (!m_enabled || !m_dltInitialized) {
+            return true;
+        }
+        
+        DltContext* ctx = getContext(contextId);
+        if (!ctx) {
+            return true;
+        }
+        
+        // Non-verbose: message ID, then raw values; names stay in the message catalog
+        DltContextData contextData;
+        if (dlt_user_log_write_start_id(ctx, &contextData, toDltLevel(level), record.getMessageId()) <= 0) {
+            return true;
+        }
+        
+        int ret = appendArgs(contextData, record.getPayload(), record.getPayloadSize());
+        
+        dlt_user_log_write_finish(&contextData);
+        
+        if (ret < 0) {
+            fprintf(stderr, "[LightAP] DLTSink: modeled message %u argument write failed with %d\n",
+                    static_cast<unsigned>(record.getMessageId()), ret);
+        }
+        return true;
+    }
+    
+    core::Bool DLTSink::writeArgs(
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        const core::UInt8* args,
+        core::Size size
+    ) noexcept
+    {
+        UNUSED(timestamp);
+        UNUSED(threadId);
+        
+        if (!m_enabled || !m_dltInitialized) {
+            return true;
+        }
+        
+        DltContext* ctx = getContext(contextId);
+        if (!ctx) {
+            return true;
+        }
+        
+        // Verbose: every value goes out as a typed DLT argument, nothing is formatted
+        DltContextData contextData;
+        if (dlt_user_log_write_start(ctx, &contextData, toDltLevel(level)) <= 0) {
+            return true;
+        }
+        
+        int ret = appendArgs(contextData, args, size);
+        
+        dlt_user_log_write_finish(&contextData);
+        
+        if (ret < 0) {
+            fprintf(stderr, "[LightAP] DLTSink: deferred record argument write failed with %d\n", ret);
+        }
+        return true;
+    }
+    
+    int DLTSink::appendArgs(DltContextData& contextData, const core::UInt8* args, core::Size size) noexcept
+    {
+        ArgDecoder decoder(args, size);
+        ArgView arg;
+        int ret = DLT_RETURN_OK;
+        while (ret >= 0 && decoder.next(arg)) {
+            switch (arg.type) {
+                case ArgType::kBool:        ret = dlt_user_log_write_bool(&contextData, static_cast<uint8_t>(arg.bits)); break;
+                case ArgType::kUInt8:
+                case ArgType::kHex8:
+                case ArgType::kBin8:
+                case ArgType::kLogLevel:    ret = dlt_user_log_write_uint8(&contextData, static_cast<uint8_t>(arg.bits)); break;
+                case ArgType::kUInt16:
+                case ArgType::kHex16:
+                case ArgType::kBin16:       ret = dlt_user_log_write_uint16(&contextData, static_cast<uint16_t>(arg.bits)); break;
+                case ArgType::kUInt32:
+                case ArgType::kHex32:
+                case ArgType::kBin32:       ret = dlt_user_log_write_uint32(&contextData, static_cast<uint32_t>(arg.bits)); break;
+                case ArgType::kUInt64:
+                case ArgType::kHex64:
+                case ArgType::kBin64:       ret = dlt_user_log_write_uint64(&contextData, arg.bits); break;
+                case ArgType::kInt8:        ret = dlt_user_log_write_int8(&contextData, static_cast<int8_t>(arg.integer)); break;
+                case ArgType::kInt16:       ret = dlt_user_log_write_int16(&contextData, static_cast<int16_t>(arg.integer)); break;
+                case ArgType::kInt32:       ret = dlt_user_log_write_int32(&contextData, static_cast<int32_t>(arg.integer)); break;
+                case ArgType::kInt64:       ret = dlt_user_log_write_int64(&contextData, arg.integer); break;
+                case ArgType::kFloat:       ret = dlt_user_log_write_float32(&contextData, static_cast<float>(arg.real)); break;
+                case ArgType::kDouble:      ret = dlt_user_log_write_float64(&contextData, arg.real); break;
+                case ArgType::kString:
+                    ret = dlt_user_log_write_sized_string(&contextData, arg.text.data(), static_cast<uint16_t>(arg.text.size()));
+                    break;
+                default: {
+                    // No DLT type (kErrorCode): send the text rendering
+                    core::Char text[128];
+                    const core::Size len = ArgFormat::formatValue(text, sizeof(text), arg);
+                    ret = dlt_user_log_write_sized_string(&contextData, text, static_cast<uint16_t>(len));
+                    break;
+                }
+            }
+        }
+        return ret;
+    }
+    
     void DLTSink::flush() noexcept
     {
         // DLT flushes automatically
@@ -153,22 +280,99 @@ namespace log
         TraceStatus status
     ) noexcept
     {
-        // For now, we use the default context
-        // In a complete implementation, this would manage a pool of contexts
-        // and register new contexts dynamically
-        UNUSED(contextId);
-        UNUSED(contextDesc);
-        UNUSED(level);
-        UNUSED(status);
-        return m_dltInitialized;
+        if (!m_dltInitialized) {
+            return false;
+        }
+        
+        const core::UInt32 key = packId(contextId);
+        if (key == 0 || key == m_defaultKey) {
+            return true;
+        }
+        
+        DltContext* ctx = addContext(key, contextId, contextDesc, level, status);
+        return ctx != nullptr && ctx != &m_defaultContext;
     }
     
     DltContext* DLTSink::getContext(core::StringView contextId) noexcept
     {
-        // For now, always return default context
-        // TODO: Implement context lookup/creation
-        UNUSED(contextId);
-        return &m_defaultContext;
+        const core::UInt32 key = packId(contextId);
+        if (key == 0 || key == m_defaultKey) {
+            return &m_defaultContext;
+        }
+        
+        // Lock-free probe; an empty slot ends the chain (slots are never freed while the sink lives)
+        for (core::Size i = 0, pos = slotOf(key); i < kContextTableSize; ++i, pos = (pos + 1) & (kContextTableSize - 1)) {
+            const core::UInt32 slotKey = m_contexts[pos].key.load(std::memory_order_acquire);
+            if (slotKey == key) {
+                return m_contexts[pos].target;
+            }
+            if (slotKey == 0) {
+                break;
+            }
+        }
+        
+        DltContext* ctx = addContext(key, contextId, contextId, m_contextLevel, m_traceStatus);
+        return ctx ? ctx : &m_defaultContext;
+    }
+    
+    DltContext* DLTSink::addContext(
+        core::UInt32 key,
+        core::StringView contextId,
+        core::StringView contextDesc,
+        LogLevel level,
+        TraceStatus status
+    ) noexcept
+    {
+        core::LockGuard lock(m_registerMutex);
+        
+        // Re-probe under the lock: another thread may have registered it meanwhile
+        core::Size pos = slotOf(key);
+        for (core::Size i = 0; i < kContextTableSize; ++i, pos = (pos + 1) & (kContextTableSize - 1)) {
+            const core::UInt32 slotKey = m_contexts[pos].key.load(std::memory_order_relaxed);
+            if (slotKey == key) {
+                return m_contexts[pos].target;
+            }
+            if (slotKey == 0) {
+                break;
+            }
+        }
+        
+        if (m_usedSlots >= kMaxContexts) {
+            if (!m_tableFullReported) {
+                fprintf(stderr, "[LightAP] DLTSink: more than %zu contexts, further contexts use the default context\n", kMaxContexts);
+                m_tableFullReported = true;
+            }
+            return nullptr;
+        }
+        
+        // libdlt copies the strings; both need a NUL terminator
+        core::Char id[5] = {};
+        ::memcpy(id, contextId.data(), contextId.size() < 4 ? contextId.size() : 4);
+        core::String desc(contextDesc.data(), contextDesc.size());
+        
+        ContextSlot& slot = m_contexts[pos];
+        DltReturnValue ret = dlt_register_context_ll_ts(
+            &slot.context,
+            id,
+            desc.c_str(),
+            toDltLevel(level),
+            toDltTraceStatus(status)
+        );
+        ++m_usedSlots;
+        if (DLT_RETURN_OK != ret) {
+            // Remembered: later records of this ID go to the default context without
+            // the lock, and the error is reported once
+            fprintf(stderr, "[LightAP] DLTSink: dlt_register_context '%s' error %d, using the default context\n",
+                    id, static_cast<int>(ret));
+            slot.target = &m_defaultContext;
+            slot.key.store(key, std::memory_order_release);
+            return &m_defaultContext;
+        }
+        
+        slot.target = &slot.context;
+        slot.key.store(key, std::memory_order_release);
+        m_contextCount.fetch_add(1, std::memory_order_relaxed);
+        return &slot.context;
     }
 
 } // namespace log
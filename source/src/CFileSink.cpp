@@ -6,41 +6,295 @@
  */
 
 #include "CFileSink.hpp"
+#include "CTimestampFormat.hpp"
+#include "CNumberFormat.hpp"
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 namespace lap
 {
 namespace log
 {
+    namespace
+    {
+        // Longest context ID copied into the line prefix, keeps the prefix well inside the stack buffer
+        constexpr size_t MAX_CONTEXT_CHARS = 256;
+        
+        // ioprio_set(2) values, <linux/ioprio.h> is not available everywhere
+        constexpr int IO_PRIORITY_WHO_PROCESS    = 1;
+        constexpr int IO_PRIORITY_CLASS_IDLE     = 3;
+        constexpr int IO_PRIORITY_CLASS_SHIFT    = 13;
+        
+        // Line buffer of writeEmergency() (signal handler stack), longer messages are cut
+        constexpr size_t EMERGENCY_LINE_SIZE = 4096;
+        
+        // io_uring request tags: (chunk start << 32) | (chunk length << 1) | buffer half, 0 = fsync
+        constexpr core::UInt64 RING_SYNC_TAG = 0;
+        constexpr core::Size RING_MAX_CHUNK = 0x7fffffff;
+        constexpr core::UInt32 RING_MAX_ENTRIES = 32768;
+        constexpr core::UInt32 RING_REAP_BATCH = 32;
+        
+        inline core::UInt64 ringTag(core::UInt32 half, core::Size start, core::Size len) noexcept
+        {
+            return (static_cast<core::UInt64>(start) << 32) | (static_cast<core::UInt64>(len) << 1) | half;
+        }
+        
+        // Coarse clock is enough for a millisecond flush interval and costs no syscall
+        inline core::UInt64 monotonicMs() noexcept
+        {
+            struct timespec ts;
+            ::clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+            return static_cast<core::UInt64>(ts.tv_sec) * 1000 + static_cast<core::UInt64>(ts.tv_nsec) / 1000000;
+        }
+        
+        // Checked on every record when time-based rotation is on: vDSO, no syscall
+        inline core::Int64 realtimeSec() noexcept
+        {
+            struct timespec ts;
+            ::clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+            return static_cast<core::Int64>(ts.tv_sec);
+        }
+        
+        // Open with O_APPEND for atomic multi-process writes
+        // O_APPEND ensures kernel-level atomic positioning + write operations
+        // Single write() syscall with complete log line (< PIPE_BUF) guarantees atomicity
+        // No O_SYNC needed - buffered I/O is fine as long as writes are not interrupted
+        inline core::UInt32 openFlags() noexcept
+        {
+            using OpenMode = core::File::OpenMode;
+            return static_cast<core::UInt32>(OpenMode::WriteOnly) |
+                   static_cast<core::UInt32>(OpenMode::Create) |
+                   static_cast<core::UInt32>(OpenMode::Append) |
+                   static_cast<core::UInt32>(OpenMode::CloseOnExec);
+        }
+    }
+
     FileSink::FileSink(
         core::StringView filePath,
         core::Size maxSize,
         core::UInt32 maxFiles,
         LogLevel minLevel,
-        core::StringView appId
+        core::StringView appId,
+        const FileBufferConfig& bufferConfig,
+        const FileRotationConfig& rotationConfig,
+        const FileSyncConfig& syncConfig,
+        const FileSpaceConfig& spaceConfig
     ) noexcept
         : m_filePath(filePath.data(), filePath.size())
-        , m_file()
+        , m_files()
+        , m_file(&m_files[0])
         , m_maxSize(maxSize)
         , m_maxFiles(maxFiles)
         , m_currentSize(0)
         , m_enabled(true)
+        , m_withThreadId(false)
         , m_minLevel(minLevel)
+        , m_bufferConfig(bufferConfig)
+        , m_batch(nullptr)
+        , m_bufferUsed(0)
+        , m_chunkStart(0)
+        , m_firstPendingMs(0)
+        , m_lockFd(-1)
+        , m_writeCalls(0)
+        , m_ring()
+        , m_ringFd(-1)
+        , m_nextRingFd(-1)
+        , m_ringPending{ 0, 0 }
+        , m_syncConfig(syncConfig)
+        , m_syncerPid(0)
+        , m_syncStop(false)
+        , m_syncTarget(0)
+        , m_syncedBytes(0)
+        , m_writtenBytes(0)
+        , m_nextSyncAt(syncConfig.everyBytes)
+        , m_syncCalls(0)
+        , m_spaceConfig(spaceConfig)
+        , m_spaceFd(-1)
+        , m_nextSpaceFd(-1)
+        , m_spacePid(::getpid())
+        , m_dropFrom(0)
+        , m_dropMark(0)
+        , m_preallocFailed(false)
+        , m_rotationConfig(rotationConfig)
+        , m_nextRotateSec(0)
+        , m_nextPath(m_filePath + ".next")
+        , m_rotatingPath(m_filePath + ".rotating")
+        , m_rotatorPid(0)
+        , m_rotateStop(false)
+        , m_rotatorIdle(false)
+        , m_nextReady(false)
+        , m_jobPending(false)
+        , m_nextLockFd(-1)
+        , m_compressorPid(0)
+        , m_compressPending(true)
+        , m_compressBusy(false)
+        , m_compressStop(false)
     {
         // Store appId (max 4 bytes)
         size_t appIdLen = (appId.size() > 4) ? 4 : appId.size();
         std::memcpy(m_appId, appId.data(), appIdLen);
         m_appId[appIdLen] = '\0';
         
+        if (m_bufferConfig.bufferSize > 0) {
+            try {
+                m_buffer.resize(m_bufferConfig.bufferSize);
+                // Two neighbouring chunks always exceed PIPE_BUF together
+                m_chunkEnds.reserve(2 * (m_bufferConfig.bufferSize / PIPE_BUF) + 1);
+            } catch (const std::exception&) {
+                fprintf(stderr, "[LightAP] FileSink: Cannot allocate %zu byte write buffer, writing unbuffered\n",
+                        m_bufferConfig.bufferSize);
+                m_buffer.clear();
+                m_bufferConfig.bufferSize = 0;
+            }
+        }
+        
+        if (m_bufferConfig.ioEngine == FileIoEngine::kIoUring) {
+            // One submission holds a whole batch (every PIPE_BUF chunk) plus an fsync
+            const core::Size entries = 2 * (m_bufferConfig.bufferSize / PIPE_BUF) + 3;
+            m_bufferConfig.ioEngine = FileIoEngine::kWrite;
+            if (m_bufferConfig.bufferSize == 0 || m_bufferConfig.multiProcess ||
+                m_bufferConfig.bufferSize > RING_MAX_CHUNK || entries > RING_MAX_ENTRIES) {
+                fprintf(stderr, "[LightAP] FileSink: io_uring needs a batch buffer (up to %u KiB) without "
+                        "multiProcess, using write()\n", RING_MAX_ENTRIES / 2 * PIPE_BUF / 1024);
+            } else {
+                try {
+                    // Two halves: the writer fills one while the kernel writes the other
+                    m_buffer.resize(2 * m_bufferConfig.bufferSize);
+                    if (m_ring.init(static_cast<core::UInt32>(entries), m_buffer.data(), m_buffer.size())) {
+                        m_bufferConfig.ioEngine = FileIoEngine::kIoUring;
+                    } else {
+                        fprintf(stderr, "[LightAP] FileSink: io_uring unavailable (%s), using write()\n",
+                                std::strerror(errno));
+                        m_buffer.resize(m_bufferConfig.bufferSize);
+                    }
+                } catch (const std::exception&) {
+                    fprintf(stderr, "[LightAP] FileSink: Cannot allocate io_uring buffers, using write()\n");
+                }
+            }
+        }
+        m_batch = m_buffer.data();
+        
+        if (m_spaceConfig.preallocate && m_spaceConfig.preallocateBytes == 0) {
+            m_spaceConfig.preallocateBytes = m_maxSize;
+            if (m_maxSize == 0) {
+                fprintf(stderr, "[LightAP] FileSink: preallocate needs maxSize or preallocateBytes, disabled\n");
+                m_spaceConfig.preallocate = false;
+            }
+        }
+        
         openFile();
+        
+        // Before the rotator: its first backup shift already coordinates with the compressor
+        if (m_rotationConfig.compression != CompressionType::kNone) {
+            if (!LogCompressor::isAvailable(m_rotationConfig.compression)) {
+                fprintf(stderr, "[LightAP] FileSink: %s support not built in, rotated files stay uncompressed\n",
+                        toString(m_rotationConfig.compression).data());
+            } else {
+                try {
+                    m_compressorPid = ::getpid();
+                    m_compressor = ::std::thread(&FileSink::compressorLoop, this);
+                } catch (const std::exception&) {
+                    fprintf(stderr, "[LightAP] FileSink: Cannot start compressor thread, rotated files stay uncompressed\n");
+                }
+            }
+        }
+        
+        if (m_file->isOpen() && m_syncConfig.policy != FileSyncPolicy::kNone) {
+            try {
+                m_syncerPid = ::getpid();
+                m_syncer = ::std::thread(&FileSink::syncerLoop, this);
+            } catch (const std::exception&) {
+                fprintf(stderr, "[LightAP] FileSink: Cannot start sync thread, syncing on flush() only\n");
+            }
+        }
+        
+        // Staging and rotating names are per path, not per process: shared files rotate inline under flock()
+        // (processes sharing a path without multiProcess must leave background off as well)
+        if (m_file->isOpen() && m_rotationConfig.background && !m_bufferConfig.multiProcess &&
+            (m_maxSize > 0 || m_rotationConfig.interval != RotationInterval::kNone)) {
+            try {
+                m_rotatorPid = ::getpid();
+                m_rotator = ::std::thread(&FileSink::rotatorLoop, this);
+            } catch (const std::exception&) {
+                fprintf(stderr, "[LightAP] FileSink: Cannot start rotator thread, rotating inline\n");
+            }
+        }
     }
     
     FileSink::~FileSink() noexcept
     {
         // Force sync to disk before closing
-        if (m_file.isOpen()) {
-            m_file.fsync();
+        if (m_file->isOpen()) {
+            if (usesRing()) {
+                submitBatch(true);  // fsync linked behind the last writes
+                waitWrites();
+            } else {
+                flushBuffer();
+                m_file->fsync();
+            }
+        }
+        
+        // Everything is on disk now: nothing left for the sync thread
+        if (ownsSyncer()) {
+            {
+                ::std::lock_guard<::std::mutex> lock(m_syncMutex);
+                m_syncStop = true;
+            }
+            m_syncCv.notify_all();
+            m_syncer.join();
+        } else if (m_syncer.joinable()) {
+            m_syncer.detach();
+        }
+        
+        if (ownsRotator()) {
+            // Finishes a pending backup shift before exiting
+            {
+                ::std::lock_guard<::std::mutex> lock(m_rotateMutex);
+                m_rotateStop = true;
+            }
+            m_rotateCv.notify_all();
+            m_rotator.join();
+            
+            if (m_nextReady) {
+                core::File* staging = (m_file == &m_files[0]) ? &m_files[1] : &m_files[0];
+                staging->close();
+                ::unlink(m_nextPath.c_str());
+            }
+            if (m_nextLockFd >= 0) {
+                ::close(m_nextLockFd);
+            }
+            if (m_nextRingFd >= 0) {
+                ::close(m_nextRingFd);
+            }
+            if (m_nextSpaceFd >= 0) {
+                ::close(m_nextSpaceFd);
+            }
+        } else if (m_rotator.joinable()) {
+            // Copy inherited through fork(): the thread and its staging file belong to the parent
+            m_rotator.detach();
+        }
+        
+        if (ownsCompressor()) {
+            // Abandons the file in progress: it stays uncompressed and is picked up on the next start
+            {
+                ::std::lock_guard<::std::mutex> lock(m_compressMutex);
+                m_compressStop.store(true, ::std::memory_order_relaxed);
+            }
+            m_compressCv.notify_all();
+            m_compressor.join();
+        } else if (m_compressor.joinable()) {
+            m_compressor.detach();
         }
         closeFile();
     }
@@ -53,99 +307,579 @@ namespace log
         core::StringView message
     ) noexcept
     {
-        UNUSED(threadId);
-        
-        if (!isEnabled() || !m_file.isOpen()) {
+        if (!isEnabled() || !m_file->isOpen()) {
             return;
         }
         
-        // Message is from LogStream buffer with MAX_LOG_SIZE=200 bytes fixed size
+        // Time-based rotation before the record: it belongs to the new period
+        if (m_nextRotateSec > 0) {
+            checkInterval();
+        }
+        
+        // Message is one LogStream record: usually <= MAX_LOG_SIZE (200) bytes,
+        // up to LogStream::GetMaxMessageSize() for spilled messages
         // Format: [YYYY-MM-DD HH:MM:SS.mmm] [LEVEL] [CONTEXT] message\n
         // Timestamp prefix: ~27 bytes, level: 7 bytes, context: variable
-        // Total prefix typically < 100 bytes, so 512 byte buffer is sufficient
-        
-        // Convert timestamp
-        time_t seconds = timestamp / 1000000;
-        core::UInt32 microseconds = timestamp % 1000000;
-        core::UInt32 milliseconds = microseconds / 1000;
-        
-        struct tm tmInfo;
-        localtime_r(&seconds, &tmInfo);
-        
-        // Get level name (5 chars fixed width)
-        const char* levelName;
-        switch (level) {
-            case 0x01:  levelName = "FATAL"; break;
-            case 0x02:  levelName = "ERROR"; break;
-            case 0x03:  levelName = "WARN "; break;
-            case 0x04:  levelName = "INFO "; break;
-            case 0x05:  levelName = "DEBUG"; break;
-            case 0x06:  levelName = "VERB "; break;
-            default:    levelName = "UNKNW"; break;
-        }
+        // Total prefix typically < 100 bytes, so 512 byte buffer covers the common case
         
         // Optimized: Fixed-size buffer sized for prefix + MAX_LOG_SIZE + newline
         // Format: [timestamp] [APPID] [LEVEL] [context] message\n
         // 128 (prefix reserve) + 200 (MAX_LOG_SIZE) + 1 (newline) = 329, rounded to 512 for alignment
         char buffer[512];
         
-        // Format timestamp + appId + level + context prefix
-        int prefixLen = snprintf(
-            buffer,
-            sizeof(buffer),
-            "[%04d-%02d-%02d %02d:%02d:%02d.%03u] [%s] [%s] [%.*s] ",
-            tmInfo.tm_year + 1900,
-            tmInfo.tm_mon + 1,
-            tmInfo.tm_mday,
-            tmInfo.tm_hour,
-            tmInfo.tm_min,
-            tmInfo.tm_sec,
-            milliseconds,
-            m_appId,
-            levelName,
-            static_cast<int>(contextId.size()), contextId.data()
-        );
-        
-        if (prefixLen <= 0 || prefixLen >= static_cast<int>(sizeof(buffer))) {
-            return;  // Format error or buffer too small
-        }
+        // Timestamp text comes from the per-thread second cache (no localtime_r per record)
+        size_t prefixLen = formatPrefix(buffer, timestamp, threadId, level, contextId, false);
         
         // Calculate available space for message
         size_t availableSpace = sizeof(buffer) - prefixLen - 2; // Reserve 2 bytes for \n and \0
         size_t msgLen = message.size();
+        char* line = buffer;
         
-        // Truncate message if necessary
+        // Long message: build the line in a per-thread buffer so the record
+        // still goes out as a single write
         if (msgLen > availableSpace) {
-            msgLen = availableSpace;
+            thread_local core::Vector<char> t_longLine;
+            try {
+                if (t_longLine.size() < prefixLen + msgLen + 1) {
+                    t_longLine.resize(prefixLen + msgLen + 1);
+                }
+                std::memcpy(t_longLine.data(), buffer, prefixLen);
+                line = t_longLine.data();
+            } catch (const std::exception&) {
+                msgLen = availableSpace;  // Out of memory: truncate
+            }
         }
         
         // Copy message
-        std::memcpy(buffer + prefixLen, message.data(), msgLen);
+        std::memcpy(line + prefixLen, message.data(), msgLen);
         size_t totalLen = prefixLen + msgLen;
-        buffer[totalLen] = '\n';
+        line[totalLen] = '\n';
         totalLen++;
         
+        if (m_bufferConfig.bufferSize > 0) {
+            appendBuffered(line, totalLen, level);
+            return;
+        }
+        
         // Direct unbuffered write via fd (O_APPEND ensures atomic append)
-        core::Int64 bytesWritten = m_file.write(buffer, totalLen);
+        core::Int64 bytesWritten = m_file->write(line, totalLen);
+        ++m_writeCalls;
         if (bytesWritten > 0) {
             m_currentSize += static_cast<core::Size>(bytesWritten);
+            m_writtenBytes.store(m_writtenBytes.load(::std::memory_order_relaxed) + static_cast<core::UInt64>(bytesWritten),
+                                 ::std::memory_order_relaxed);
+            if (m_syncConfig.policy != FileSyncPolicy::kNone) {
+                checkSync(level);
+            }
+            if (m_spaceConfig.dropCacheBytes > 0) {
+                dropCache();
+            }
             
             // Check if rotation is needed
             checkRotation();
         }
     }
     
+    core::Size FileSink::formatPrefix(
+        char* out,
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        core::Bool signalSafe
+    ) const noexcept
+    {
+        // Get level name (5 chars fixed width)
+        const char* levelName;
+        switch (level) {
+            case 0x01:  levelName = "FATAL"; break;
+            case 0x02:  levelName = "ERROR"; break;
+            case 0x03:  levelName = "WARN "; break;
+            case 0x04:  levelName = "INFO "; break;
+            case 0x05:  levelName = "DEBUG"; break;
+            case 0x06:  levelName = "VERB "; break;
+            default:    levelName = "UNKNW"; break;
+        }
+        
+        // Format timestamp + appId + level + context prefix
+        size_t contextLen = contextId.size() > MAX_CONTEXT_CHARS ? MAX_CONTEXT_CHARS : contextId.size();
+        size_t appIdLen = std::strlen(m_appId);
+        char* p = out;
+        *p++ = '[';
+        p += signalSafe ? TimestampFormat::formatDateTimeSignalSafe(p, timestamp)
+                        : TimestampFormat::formatDateTime(p, timestamp);
+        std::memcpy(p, "] [", 3);
+        p += 3;
+        std::memcpy(p, m_appId, appIdLen);
+        p += appIdLen;
+        std::memcpy(p, "] [", 3);
+        p += 3;
+        std::memcpy(p, levelName, 5);
+        p += 5;
+        std::memcpy(p, "] [", 3);
+        p += 3;
+        std::memcpy(p, contextId.data(), contextLen);
+        p += contextLen;
+        if (m_withThreadId) {
+            std::memcpy(p, "] [tid:", 7);
+            p += 7;
+            p += NumberFormat::formatUInt(p, threadId);
+        }
+        std::memcpy(p, "] ", 2);
+        p += 2;
+        return static_cast<core::Size>(p - out);
+    }
+    
+    core::Size FileSink::formatEmergencyLine(
+        char* line,
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        core::StringView message
+    ) const noexcept
+    {
+        size_t prefixLen = formatPrefix(line, timestamp, threadId, level, contextId, true);
+        size_t msgLen = message.size() < EMERGENCY_LINE_SIZE - prefixLen - 1 ? message.size() : EMERGENCY_LINE_SIZE - prefixLen - 1;
+        std::memcpy(line + prefixLen, message.data(), msgLen);
+        line[prefixLen + msgLen] = '\n';
+        return prefixLen + msgLen + 1;
+    }
+    
+    core::Bool FileSink::writeEmergency(
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        core::StringView message
+    ) noexcept
+    {
+        if (!isEnabled()) {
+            return false;
+        }
+        
+        char line[EMERGENCY_LINE_SIZE];
+        size_t totalLen = formatEmergencyLine(line, timestamp, threadId, level, contextId, message);
+        
+        // No rotation from a signal handler: the size only grows
+        m_currentSize += totalLen;
+        
+        // Stage in the batch buffer (the caller holds the writers off): one write per buffer
+        if (totalLen <= m_bufferConfig.bufferSize) {
+            if (m_bufferUsed + totalLen > m_bufferConfig.bufferSize) {
+                flushEmergency();
+            }
+            std::memcpy(m_batch + m_bufferUsed, line, totalLen);
+            m_bufferUsed += totalLen;
+            return true;
+        }
+        
+        // Unbuffered: batched lines are older than this record
+        flushEmergency();
+        writeAll(line, totalLen);
+        return true;
+    }
+    
+    core::Bool FileSink::writeEmergencyUnbatched(
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        core::StringView message
+    ) noexcept
+    {
+        if (!isEnabled()) {
+            return false;
+        }
+        
+        // The batch, size and counters belong to the thread holding the sink lock:
+        // one write(2) of the line (O_APPEND) and nothing else
+        char line[EMERGENCY_LINE_SIZE];
+        size_t totalLen = formatEmergencyLine(line, timestamp, threadId, level, contextId, message);
+        return m_file->write(line, totalLen) > 0;
+    }
+    
+    void FileSink::flushEmergency() noexcept
+    {
+        // flushBuffer() without flock(): the lock may be held by the interrupted thread
+        if (m_bufferUsed == 0 || !m_file->isOpen()) {
+            return;
+        }
+        
+        // Batches already handed to io_uring land first (waits without touching the ring)
+        if (m_ring.isReady()) {
+            m_ring.waitIdle();
+        }
+        writeChunks();
+        m_bufferUsed = 0;
+        m_chunkStart = 0;
+        m_chunkEnds.clear();    // Keeps the capacity, no deallocation
+    }
+    
+    void FileSink::flushExpired(core::UInt32 slackMs) noexcept
+    {
+        // Timer side of the age threshold in appendBuffered(): no further write needed
+        if (m_bufferUsed > 0 && m_file->isOpen() &&
+            monotonicMs() - m_firstPendingMs + slackMs >= m_bufferConfig.flushIntervalMs) {
+            flushBuffer();
+        }
+    }
+    
+    void FileSink::appendBuffered(const char* line, core::Size len, LogLevelType level) noexcept
+    {
+        // Not enough room: push out what is pending first
+        if (m_bufferUsed + len > m_bufferConfig.bufferSize) {
+            flushBuffer();
+        }
+        
+        if (len > m_bufferConfig.bufferSize) {
+            // Larger than the whole buffer: write through
+            writeAll(line, len);
+        } else {
+            // Close the open chunk if this record would push it over PIPE_BUF;
+            // a single record larger than PIPE_BUF forms a chunk of its own
+            if (!m_bufferConfig.multiProcess &&
+                m_bufferUsed > m_chunkStart &&
+                m_bufferUsed - m_chunkStart + len > PIPE_BUF) {
+                m_chunkEnds.push_back(m_bufferUsed);
+                m_chunkStart = m_bufferUsed;
+            }
+            
+            if (m_bufferUsed == 0) {
+                m_firstPendingMs = monotonicMs();
+            }
+            std::memcpy(m_batch + m_bufferUsed, line, len);
+            m_bufferUsed += len;
+        }
+        m_currentSize += len;
+        
+        // ERROR/FATAL go out immediately so they survive a crash right after
+        const core::Bool urgent = level <= static_cast<LogLevelType>(LogLevel::kError);
+        if (m_bufferUsed > 0 && (urgent || monotonicMs() - m_firstPendingMs >= m_bufferConfig.flushIntervalMs)) {
+            flushBuffer();
+            if (urgent) {
+                waitWrites();   // In the page cache before write() returns, as with write(2)
+            }
+        }
+        
+        if (m_syncConfig.policy != FileSyncPolicy::kNone) {
+            checkSync(level);
+        }
+        if (m_spaceConfig.dropCacheBytes > 0) {
+            dropCache();
+        }
+        checkRotation();
+    }
+    
+    void FileSink::flushBuffer() noexcept
+    {
+        if (m_bufferUsed == 0) {
+            return;
+        }
+        
+        if (m_bufferConfig.multiProcess && m_lockFd >= 0) {
+            // One write for the whole batch, serialized against other processes
+            ::flock(m_lockFd, LOCK_EX);
+            writeAll(m_batch, m_bufferUsed);
+            ::flock(m_lockFd, LOCK_UN);
+        } else if (usesRing()) {
+            submitBatch(false);
+        } else {
+            writeChunks();
+        }
+        
+        m_bufferUsed = 0;
+        m_chunkStart = 0;
+        m_chunkEnds.clear();
+    }
+    
+    void FileSink::writeChunks() noexcept
+    {
+        // O_APPEND write of at most PIPE_BUF bytes per chunk, split on record boundaries
+        core::Size start = 0;
+        for (core::Size end : m_chunkEnds) {
+            writeAll(m_batch + start, end - start);
+            start = end;
+        }
+        writeAll(m_batch + start, m_bufferUsed - start);
+    }
+    
+    core::Bool FileSink::usesRing() const noexcept
+    {
+        return m_ringFd >= 0 && m_ring.isReady();
+    }
+    
+    void FileSink::submitBatch(core::Bool sync) noexcept
+    {
+        // Finished batches no longer need to be drained behind
+        reapWrites(0);
+        
+        // The ring is sized for a whole batch and empty between batches: queueing cannot fail
+        const core::UInt32 half = (m_batch == m_buffer.data()) ? 0 : 1;
+        core::UInt32 queued = 0;
+        core::Size start = 0;
+        for (core::Size i = 0; i <= m_chunkEnds.size(); ++i) {
+            const core::Size end = (i < m_chunkEnds.size()) ? m_chunkEnds[i] : m_bufferUsed;
+            if (end > start &&
+                m_ring.queueWrite(m_ringFd, m_batch + start, static_cast<core::UInt32>(end - start),
+                                  ringTag(half, start, end - start))) {
+                ++queued;
+            }
+            start = end;
+        }
+        if (sync) {
+            m_ring.queueFsync(m_ringFd, false, RING_SYNC_TAG);
+        }
+        
+        if (!m_ring.submit()) {
+            // Nothing of this batch reached the kernel: finish the earlier ones, then stay on write(2)
+            fprintf(stderr, "[LightAP] FileSink: io_uring submission failed (%s), using write()\n",
+                    std::strerror(errno));
+            waitWrites();
+            m_ring.close();
+            writeChunks();
+            if (sync) {
+                m_file->fsync();
+            }
+            return;
+        }
+        m_ringPending[half] += queued;
+        
+        // Carry on in the other half as soon as its previous batch is written
+        if (m_bufferUsed > 0) {
+            m_batch = (half == 0) ? m_buffer.data() + m_bufferConfig.bufferSize : m_buffer.data();
+            while (m_ringPending[half ^ 1] > 0 && m_ring.getInflight() > 0) {
+                reapWrites(m_ringPending[half ^ 1]);
+            }
+        }
+    }
+    
+    void FileSink::reapWrites(core::UInt32 waitFor) noexcept
+    {
+        IoUringWriter::Completion done[RING_REAP_BATCH];
+        const core::UInt32 count = m_ring.reap(done, RING_REAP_BATCH, waitFor);
+        
+        for (core::UInt32 i = 0; i < count; ++i) {
+            const core::UInt64 tag = done[i].userData;
+            if (tag == RING_SYNC_TAG) {
+                if (done[i].result < 0) {
+                    fprintf(stderr, "[LightAP] FileSink: fsync failed: %s\n", std::strerror(-done[i].result));
+                }
+                continue;
+            }
+            
+            const core::UInt32 half = static_cast<core::UInt32>(tag & 1);
+            const core::Size len = static_cast<core::Size>((tag >> 1) & RING_MAX_CHUNK);
+            const core::Size start = static_cast<core::Size>(tag >> 32);
+            const core::Size written = done[i].result > 0 ? static_cast<core::Size>(done[i].result) : 0;
+            if (m_ringPending[half] > 0) {
+                --m_ringPending[half];
+            }
+            m_writtenBytes.store(m_writtenBytes.load(::std::memory_order_relaxed) + written, ::std::memory_order_relaxed);
+            
+            // Short write, error or cancelled by an earlier link: the rest goes out with write(2)
+            if (written < len) {
+                writeAll(m_buffer.data() + half * m_bufferConfig.bufferSize + start + written, len - written);
+            }
+        }
+    }
+    
+    void FileSink::waitWrites() noexcept
+    {
+        if (!usesRing()) {
+            return;
+        }
+        while (m_ring.getInflight() > 0) {
+            reapWrites(m_ring.getInflight());
+        }
+    }
+    
+    FileIoStats FileSink::getIoStats() const noexcept
+    {
+        FileIoStats stats;
+        stats.writeCalls = m_writeCalls;
+        stats.ringEnters = m_ring.getEnterCount();
+        stats.syncCalls = m_syncCalls.load(::std::memory_order_relaxed);
+        return stats;
+    }
+    
+    void FileSink::checkSync(LogLevelType level) noexcept
+    {
+        switch (m_syncConfig.policy) {
+            case FileSyncPolicy::kOnError:
+                if (level <= static_cast<LogLevelType>(LogLevel::kError)) {
+                    // FATAL usually precedes an abort or a reset: only it waits for the disk
+                    requestSync(level == static_cast<LogLevelType>(LogLevel::kFatal));
+                }
+                break;
+            case FileSyncPolicy::kEveryBytes: {
+                const core::UInt64 written = m_writtenBytes.load(::std::memory_order_relaxed);
+                if (written >= m_nextSyncAt) {
+                    m_nextSyncAt = written + m_syncConfig.everyBytes;
+                    requestSync(false);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    
+    core::Bool FileSink::requestSync(core::Bool wait) noexcept
+    {
+        if (!ownsSyncer()) {
+            return !wait || syncFile();
+        }
+        
+        const core::UInt64 target = m_writtenBytes.load(::std::memory_order_relaxed);
+        ::std::unique_lock<::std::mutex> lock(m_syncMutex);
+        if (target > m_syncTarget) {
+            m_syncTarget = target;
+            m_syncCv.notify_all();
+        }
+        if (wait) {
+            // Group commit: a sync already running for later bytes serves this request too
+            m_syncCv.wait(lock, [this, target] { return m_syncedBytes >= target || m_syncStop; });
+        }
+        return true;
+    }
+    
+    void FileSink::syncerLoop() noexcept
+    {
+        ::std::unique_lock<::std::mutex> lock(m_syncMutex);
+        for (;;) {
+            const auto requested = [this] { return m_syncStop || m_syncTarget > m_syncedBytes; };
+            if (m_syncConfig.policy == FileSyncPolicy::kPeriodic) {
+                m_syncCv.wait_for(lock, ::std::chrono::milliseconds(m_syncConfig.intervalMs), requested);
+            } else {
+                m_syncCv.wait(lock, requested);
+            }
+            if (m_syncStop) {
+                break;
+            }
+            
+            // Periodic: whatever has been written by now; otherwise everything requested so far
+            core::UInt64 target = m_writtenBytes.load(::std::memory_order_relaxed);
+            if (target < m_syncTarget) {
+                target = m_syncTarget;
+            }
+            if (target <= m_syncedBytes) {
+                continue;   // Nothing written since the last sync
+            }
+            
+            lock.unlock();
+            syncFile();
+            lock.lock();
+            m_syncedBytes = target;
+            m_syncCv.notify_all();
+        }
+    }
+    
+    core::Bool FileSink::syncFile() noexcept
+    {
+        // <path> always names the active file; fdatasync() works on any descriptor of it
+        const int fd = ::open(m_filePath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        const core::Bool ok = ::fdatasync(fd) == 0;
+        ::close(fd);
+        m_syncCalls.fetch_add(1, ::std::memory_order_relaxed);
+        return ok;
+    }
+    
+    core::Bool FileSink::ownsSyncer() const noexcept
+    {
+        return m_syncer.joinable() && ::getpid() == m_syncerPid;
+    }
+    
+    void FileSink::preallocate(core::Int32 fd) noexcept
+    {
+        if (fd < 0 || !m_spaceConfig.preallocate || m_preallocFailed) {
+            return;
+        }
+        
+        // Blocks already allocated are skipped: reopening a grown file costs little
+        if (::fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(m_spaceConfig.preallocateBytes)) != 0) {
+            fprintf(stderr, "[LightAP] FileSink: Cannot preallocate %s: %s, files grow on demand\n",
+                    m_filePath.c_str(), std::strerror(errno));
+            m_preallocFailed = true;
+        }
+    }
+    
+    void FileSink::trimFile(core::Int32 fd) noexcept
+    {
+        // Other writers may append between fstat() and ftruncate(): only a sole writer trims
+        if (fd < 0 || !m_spaceConfig.preallocate || m_bufferConfig.multiProcess || ::getpid() != m_spacePid) {
+            return;
+        }
+        
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && static_cast<core::Size>(st.st_blocks) * 512 > static_cast<core::Size>(st.st_size)) {
+            ::ftruncate(fd, st.st_size);    // Same size: only the blocks past the end are freed
+        }
+    }
+    
+    void FileSink::dropCache() noexcept
+    {
+        // Batched records still in memory have no pages yet
+        const core::Size written = m_currentSize - m_bufferUsed;
+        if (m_spaceFd < 0 || written < m_dropMark + m_spaceConfig.dropCacheBytes) {
+            return;
+        }
+        
+        // DONTNEED starts writeback of dirty pages and only drops clean ones: each range is
+        // passed twice, once to start its writeback and one window later to drop it
+        ::posix_fadvise(m_spaceFd, static_cast<off_t>(m_dropFrom), static_cast<off_t>(written - m_dropFrom),
+                        POSIX_FADV_DONTNEED);
+        m_dropFrom = m_dropMark;
+        m_dropMark = written;
+    }
+    
+    void FileSink::writeAll(const char* data, core::Size len) noexcept
+    {
+        while (len > 0) {
+            core::Int64 written = m_file->write(data, len);
+            ++m_writeCalls;
+            if (written <= 0) {
+                return;  // Disk full or I/O error: drop the rest like the unbuffered path
+            }
+            m_writtenBytes.store(m_writtenBytes.load(::std::memory_order_relaxed) + static_cast<core::UInt64>(written),
+                                 ::std::memory_order_relaxed);
+            data += written;
+            len -= static_cast<core::Size>(written);
+        }
+    }
+    
     void FileSink::flush() noexcept
     {
-        // Note: flush() only ensures data is sent to OS buffer cache
-        // It does NOT force fsync() - that's expensive and done only in destructor/rotate
-        // For unbuffered fd writes with O_APPEND, data is already in kernel buffer
-        // No explicit action needed here as ::write() already completed
+        // Hands records to the OS buffer cache: unbuffered records are already in the kernel,
+        // batched records are written out here. Called whenever an async queue or collector
+        // goes idle, so durability stays with the policy (a kEveryBytes threshold crossed by
+        // the batch requests its sync without waiting) and with sync()
+        if (m_file->isOpen()) {
+            flushBuffer();
+            waitWrites();
+            if (m_syncConfig.policy != FileSyncPolicy::kNone) {
+                checkSync(static_cast<LogLevelType>(LogLevel::kVerbose));
+            }
+        }
+    }
+    
+    core::Bool FileSink::sync() noexcept
+    {
+        if (!m_file->isOpen()) {
+            return false;
+        }
+        
+        flushBuffer();
+        waitWrites();
+        return ownsSyncer() ? requestSync(true) : syncFile();
     }
     
     core::Bool FileSink::shouldLog(LogLevel level) const noexcept
     {
-        if (!m_enabled || !m_file.isOpen()) {
+        if (!m_enabled || !m_file->isOpen()) {
             return false;
         }
         
@@ -156,64 +890,381 @@ namespace log
     
     core::Bool FileSink::rotate() noexcept
     {
-        if (!m_file.isOpen()) {
+        if (!m_file->isOpen()) {
             return false;
         }
         
-        // Acquire exclusive lock for rotation (multi-process safety)
-        if (!m_file.lock(true)) {
+        // Keep the rotator thread out of the backups while they are renamed here
+        ::std::unique_lock<::std::mutex> rotateLock(m_rotateMutex, ::std::defer_lock);
+        if (ownsRotator()) {
+            rotateLock.lock();
+            m_rotateCv.wait(rotateLock, [this] { return !m_jobPending; });
+        }
+        
+        // Pending records belong to the file being rotated out
+        flushBuffer();
+        
+        // Processes sharing the path rotate one at a time. The lock is on the directory:
+        // a lock on the log file itself stops excluding anyone once the file is renamed,
+        // and two backup shifts running at once overwrite each other's backups
+        const core::Int32 dirFd = lockDirectory();
+        if (dirFd < 0) {
             return false;  // Failed to lock, skip rotation
         }
         
-        // Close current file
+        // Records synced so far stay synced when the file becomes a backup
+        if (m_syncConfig.policy != FileSyncPolicy::kNone) {
+            waitWrites();
+            m_file->fsync();
+        }
+        
+        // Another process may have rotated this file since it was found full here:
+        // then <path> is already a new file and this process only reopens it
+        struct stat ours;
+        struct stat current;
+        const core::Bool owner = m_file->fstat(&ours) && ::stat(m_filePath.c_str(), &current) == 0 &&
+                                 ours.st_ino == current.st_ino && ours.st_dev == current.st_dev;
+        if (owner) {
+            // Rename current log file to .1, older backups move up by one
+            shiftBackups(m_filePath);
+        }
+        
+        // Reopen <path>; another process's records in it count towards maxSize
         closeFile();
+        m_currentSize = 0;
+        const core::Bool opened = openFile();
+        ::close(dirFd);     // Releases the lock
+        return opened;
+    }
+    
+    core::Int32 FileSink::lockDirectory() const noexcept
+    {
+        const auto slash = m_filePath.rfind('/');
+        const core::String dir = slash == core::String::npos ? core::String(".")
+                                 : slash == 0 ? core::String("/") : m_filePath.substr(0, slash);
+        const core::Int32 fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            return -1;
+        }
+        while (::flock(fd, LOCK_EX) != 0) {
+            if (errno != EINTR) {
+                ::close(fd);
+                return -1;
+            }
+        }
+        return fd;
+    }
+    
+    void FileSink::waitRotation() noexcept
+    {
+        if (ownsRotator()) {
+            ::std::unique_lock<::std::mutex> lock(m_rotateMutex);
+            m_rotateCv.wait(lock, [this] { return m_rotatorIdle && !m_jobPending; });
+        }
+    }
+    
+    core::Bool FileSink::rotateInBackground() noexcept
+    {
+        if (!ownsRotator()) {
+            return false;
+        }
         
-        // Rotate backup files: app.log.N -> app.log.N+1
-        for (core::Int32 i = m_maxFiles - 1; i >= 1; --i) {
-            core::String oldPath = m_filePath + "." + std::to_string(i);
-            core::String newPath = m_filePath + "." + std::to_string(i + 1);
+        ::std::unique_lock<::std::mutex> lock(m_rotateMutex);
+        // Only blocks when rotations come faster than the previous backup shift
+        m_rotateCv.wait(lock, [this] { return !m_jobPending; });
+        if (!m_nextReady) {
+            return false;
+        }
+        
+        // Pending records belong to the file being rotated out
+        flushBuffer();
+        waitWrites();
+        
+        // Keep the full file reachable, then replace <path> atomically: it never goes missing
+        if (::link(m_filePath.c_str(), m_rotatingPath.c_str()) != 0) {
+            return false;
+        }
+        if (::rename(m_nextPath.c_str(), m_filePath.c_str()) != 0) {
+            ::unlink(m_rotatingPath.c_str());
+            return false;
+        }
+        
+        // Switch descriptors; the old ones are closed by the rotator thread
+        m_file = (m_file == &m_files[0]) ? &m_files[1] : &m_files[0];
+        ::std::swap(m_lockFd, m_nextLockFd);
+        ::std::swap(m_ringFd, m_nextRingFd);
+        ::std::swap(m_spaceFd, m_nextSpaceFd);
+        m_currentSize = 0;
+        m_dropFrom = 0;
+        m_dropMark = 0;
+        if (m_nextRotateSec > 0) {
+            m_nextRotateSec = nextBoundary(realtimeSec());
+        }
+        m_nextReady = false;
+        m_jobPending = true;
+        
+        lock.unlock();
+        m_rotateCv.notify_all();
+        return true;
+    }
+    
+    void FileSink::rotatorLoop() noexcept
+    {
+        // Batch class: waking up does not preempt the writer that handed over the work
+        struct sched_param param;
+        param.sched_priority = 0;
+        ::pthread_setschedparam(::pthread_self(), SCHED_BATCH, &param);
+        
+        ::std::unique_lock<::std::mutex> lock(m_rotateMutex);
+        
+        // Left behind by a process that died between the switch and the shift
+        if (::access(m_rotatingPath.c_str(), F_OK) == 0) {
+            shiftBackups(m_rotatingPath);
+        }
+        
+        for (;;) {
+            core::File* other = (m_file == &m_files[0]) ? &m_files[1] : &m_files[0];
+            
+            if (m_jobPending) {
+                // The writer has moved on: the tail of the retired file is synced here
+                if (m_syncConfig.policy != FileSyncPolicy::kNone) {
+                    other->fsync();
+                }
+                other->close();
+                if (m_nextLockFd >= 0) {
+                    ::close(m_nextLockFd);
+                    m_nextLockFd = -1;
+                }
+                if (m_nextRingFd >= 0) {
+                    ::close(m_nextRingFd);
+                    m_nextRingFd = -1;
+                }
+                if (m_nextSpaceFd >= 0) {
+                    trimFile(m_nextSpaceFd);
+                    if (m_spaceConfig.dropCacheBytes > 0) {
+                        ::posix_fadvise(m_nextSpaceFd, 0, 0, POSIX_FADV_DONTNEED);
+                    }
+                    ::close(m_nextSpaceFd);
+                    m_nextSpaceFd = -1;
+                }
+                shiftBackups(m_rotatingPath);
+                m_jobPending = false;
+            }
+            
+            if (!m_nextReady && !m_rotateStop) {
+                // A staging file left by an earlier run holds no records
+                ::unlink(m_nextPath.c_str());
+                if (other->open(m_nextPath, openFlags(), 0644)) {
+                    if (m_bufferConfig.bufferSize > 0 && m_bufferConfig.multiProcess) {
+                        m_nextLockFd = ::open(m_nextPath.c_str(), O_RDONLY | O_CLOEXEC);
+                    }
+                    if (m_bufferConfig.ioEngine == FileIoEngine::kIoUring) {
+                        m_nextRingFd = ::open(m_nextPath.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+                    }
+                    // The next file's blocks are reserved here, off the writer thread
+                    if (m_spaceConfig.preallocate || m_spaceConfig.dropCacheBytes > 0) {
+                        m_nextSpaceFd = ::open(m_nextPath.c_str(), O_WRONLY | O_CLOEXEC);
+                        preallocate(m_nextSpaceFd);
+                    }
+                    m_nextReady = true;
+                } else {
+                    fprintf(stderr, "[LightAP] FileSink: Cannot open staging file %s: %s, rotating inline\n",
+                            m_nextPath.c_str(), std::strerror(errno));
+                }
+            }
+            
+            if (m_rotateStop) {
+                break;
+            }
+            m_rotatorIdle = true;
+            m_rotateCv.notify_all();
+            m_rotateCv.wait(lock, [this] { return m_rotateStop || m_jobPending; });
+            m_rotatorIdle = false;
+        }
+    }
+    
+    void FileSink::shiftBackups(const core::String& newest) noexcept
+    {
+        // A backup keeps its index whether or not it has been compressed yet
+        static const char* const kSuffixes[] = { "", ".gz", ".zst" };
+        
+        {
+            ::std::unique_lock<::std::mutex> backupLock(m_backupMutex, ::std::defer_lock);
+            if (ownsCompressor()) {
+                backupLock.lock();
+            }
             
             // Delete oldest backup if exists
-            if (i == static_cast<core::Int32>(m_maxFiles) - 1) {
-                core::File::Util::remove(newPath);
+            const core::String oldest = m_filePath + "." + std::to_string(m_maxFiles > 0 ? m_maxFiles : 1);
+            for (const char* suffix : kSuffixes) {
+                core::File::Util::remove(oldest + suffix);
             }
             
-            // Rename (move operation)
-            core::File::Util::rename(oldPath, newPath);
+            // Rotate backup files: app.log.N -> app.log.N+1
+            for (core::Int32 i = m_maxFiles - 1; i >= 1; --i) {
+                core::String oldPath = m_filePath + "." + std::to_string(i);
+                core::String newPath = m_filePath + "." + std::to_string(i + 1);
+                for (const char* suffix : kSuffixes) {
+                    core::File::Util::rename(oldPath + suffix, newPath + suffix);
+                }
+            }
+            
+            core::String backupPath = m_filePath + ".1";
+            core::File::Util::rename(newest, backupPath);
         }
         
-        // Rename current log file to .1
-        core::String backupPath = m_filePath + ".1";
-        core::File::Util::rename(m_filePath, backupPath);
+        if (ownsCompressor()) {
+            {
+                ::std::lock_guard<::std::mutex> lock(m_compressMutex);
+                m_compressPending = true;
+            }
+            m_compressCv.notify_all();
+        }
+    }
+    
+    void FileSink::waitCompression() noexcept
+    {
+        if (ownsCompressor()) {
+            ::std::unique_lock<::std::mutex> lock(m_compressMutex);
+            m_compressCv.wait(lock, [this] { return !m_compressPending && !m_compressBusy; });
+        }
+    }
+    
+    void FileSink::compressorLoop() noexcept
+    {
+        // Runs only when the CPU and the device have nothing else to do
+        struct sched_param param;
+        param.sched_priority = 0;
+        ::pthread_setschedparam(::pthread_self(), SCHED_IDLE, &param);
+        ::syscall(SYS_ioprio_set, IO_PRIORITY_WHO_PROCESS, 0, IO_PRIORITY_CLASS_IDLE << IO_PRIORITY_CLASS_SHIFT);
         
-        // Open new log file
-        m_currentSize = 0;
-        return openFile();
+        ::std::unique_lock<::std::mutex> lock(m_compressMutex);
+        for (;;) {
+            m_compressCv.wait(lock, [this] {
+                return m_compressPending || m_compressStop.load(::std::memory_order_relaxed);
+            });
+            if (m_compressStop.load(::std::memory_order_relaxed)) {
+                break;
+            }
+            
+            m_compressPending = false;
+            m_compressBusy = true;
+            lock.unlock();
+            compressBackups();
+            lock.lock();
+            m_compressBusy = false;
+            m_compressCv.notify_all();
+        }
+    }
+    
+    void FileSink::compressBackups() noexcept
+    {
+        const core::String ext = LogCompressor::suffix(m_rotationConfig.compression);
+        const core::String tmpPath = m_filePath + ".compressing";
+        const core::UInt32 count = m_maxFiles > 0 ? m_maxFiles : 1;
         
-        // Lock is automatically released when file is closed/reopened
+        // Oldest first: it is the next one retention would drop
+        for (core::UInt32 i = count; i >= 1 && !m_compressStop.load(::std::memory_order_relaxed); --i) {
+            const int fd = ::open((m_filePath + "." + std::to_string(i)).c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                continue;   // Missing or already compressed
+            }
+            
+            struct stat st;
+            const core::Bool ok = ::fstat(fd, &st) == 0 &&
+                                  LogCompressor::compressFile(fd, tmpPath, m_rotationConfig.compression,
+                                                              m_rotationConfig.compressionLevel,
+                                                              m_rotationConfig.compressBytesPerSec, &m_compressStop);
+            ::close(fd);
+            
+            ::std::lock_guard<::std::mutex> backupLock(m_backupMutex);
+            // Rotations may have shifted the file meanwhile (or retention dropped it): find it again
+            core::String current;
+            for (core::UInt32 j = 1; ok && j <= count; ++j) {
+                const core::String candidate = m_filePath + "." + std::to_string(j);
+                struct stat now;
+                if (::stat(candidate.c_str(), &now) == 0 && now.st_ino == st.st_ino && now.st_dev == st.st_dev) {
+                    current = candidate;
+                    break;
+                }
+            }
+            if (!current.empty() && ::rename(tmpPath.c_str(), (current + ext).c_str()) == 0) {
+                ::unlink(current.c_str());
+            } else {
+                ::unlink(tmpPath.c_str());
+            }
+        }
     }
     
-    core::Bool FileSink::openFile() noexcept
+    core::Bool FileSink::ownsRotator() const noexcept
+    {
+        return m_rotator.joinable() && ::getpid() == m_rotatorPid;
+    }
+    
+    core::Bool FileSink::ownsCompressor() const noexcept
     {
-        using OpenMode = core::File::OpenMode;
+        return m_compressor.joinable() && ::getpid() == m_compressorPid;
+    }
+    
+    core::Int64 FileSink::nextBoundary(core::Int64 since) const noexcept
+    {
+        time_t t = static_cast<time_t>(since);
+        struct tm local;
+        if (::localtime_r(&t, &local) == nullptr) {
+            return since + 3600;
+        }
         
-        // Open with O_APPEND for atomic multi-process writes
-        // O_APPEND ensures kernel-level atomic positioning + write operations
-        // Single write() syscall with complete log line (< PIPE_BUF) guarantees atomicity
-        // No O_SYNC needed - buffered I/O is fine as long as writes are not interrupted
-        core::UInt32 flags = static_cast<core::UInt32>(OpenMode::WriteOnly) |
-                              static_cast<core::UInt32>(OpenMode::Create) |
-                              static_cast<core::UInt32>(OpenMode::Append) |
-                              static_cast<core::UInt32>(OpenMode::CloseOnExec);
+        local.tm_sec = 0;
+        local.tm_min = 0;
+        if (m_rotationConfig.interval == RotationInterval::kHourly) {
+            local.tm_hour += 1;
+        } else {
+            local.tm_hour = 0;
+            local.tm_mday += 1;
+        }
+        local.tm_isdst = -1;    // Let mktime() pick the offset on the other side of a DST switch
         
-        if (!m_file.open(m_filePath, flags, 0644)) {
+        time_t next = ::mktime(&local);
+        return next > t ? static_cast<core::Int64>(next) : since + 3600;
+    }
+    
+    core::Bool FileSink::openFile() noexcept
+    {
+        if (!m_file->open(m_filePath, openFlags(), 0644)) {
             return false;
         }
         
+        // Separate description for flock(): batches from all processes exclude each other
+        if (m_bufferConfig.bufferSize > 0 && m_bufferConfig.multiProcess) {
+            m_lockFd = ::open(m_filePath.c_str(), O_RDONLY | O_CLOEXEC);
+        }
+        
+        // core::File does not expose its descriptor: the ring writes through its own
+        if (m_bufferConfig.ioEngine == FileIoEngine::kIoUring) {
+            m_ringFd = ::open(m_filePath.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+        }
+        
+        // fallocate/ftruncate need a writable descriptor, fadvise works on any
+        if (m_spaceConfig.preallocate || m_spaceConfig.dropCacheBytes > 0) {
+            m_spaceFd = ::open(m_filePath.c_str(), O_WRONLY | O_CLOEXEC);
+            preallocate(m_spaceFd);
+            m_dropFrom = 0;
+            m_dropMark = 0;
+        }
+        
         // Get current file size
         struct stat st;
-        if (m_file.fstat(&st)) {
+        core::Int64 lastWrite = realtimeSec();
+        if (m_file->fstat(&st)) {
             m_currentSize = st.st_size;
+            if (m_currentSize > 0) {
+                lastWrite = static_cast<core::Int64>(st.st_mtime);
+            }
+        }
+        
+        // A file from before a restart keeps its period: rotated on the first record past the boundary
+        if (m_rotationConfig.interval != RotationInterval::kNone) {
+            m_nextRotateSec = nextBoundary(lastWrite);
         }
         
         return true;
@@ -221,12 +1272,46 @@ namespace log
     
     void FileSink::closeFile() noexcept
     {
-        m_file.close();
+        waitWrites();
+        if (m_ringFd >= 0) {
+            ::close(m_ringFd);
+            m_ringFd = -1;
+        }
+        if (m_lockFd >= 0) {
+            ::close(m_lockFd);
+            m_lockFd = -1;
+        }
+        if (m_spaceFd >= 0) {
+            trimFile(m_spaceFd);
+            if (m_spaceConfig.dropCacheBytes > 0) {
+                ::posix_fadvise(m_spaceFd, 0, 0, POSIX_FADV_DONTNEED);
+            }
+            ::close(m_spaceFd);
+            m_spaceFd = -1;
+        }
+        m_file->close();
     }
     
     void FileSink::checkRotation() noexcept
     {
-        if (m_maxSize > 0 && m_currentSize >= m_maxSize) {
+        if (m_maxSize > 0 && m_currentSize >= m_maxSize && !rotateInBackground()) {
+            rotate();
+        }
+    }
+    
+    void FileSink::checkInterval() noexcept
+    {
+        const core::Int64 now = realtimeSec();
+        if (now < m_nextRotateSec) {
+            return;
+        }
+        
+        if (m_currentSize == 0) {
+            // Nothing logged during the period: no empty backup
+            m_nextRotateSec = nextBoundary(now);
+            return;
+        }
+        if (!rotateInBackground()) {
             rotate();
         }
     }
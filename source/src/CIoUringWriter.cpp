@@ -0,0 +1,329 @@
+/**
+ * @file        CIoUringWriter.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Minimal io_uring submission engine for append-only log files
+ * @date        2026-10-16
+ */
+
+#include "CIoUringWriter.hpp"
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define LAP_LOG_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+namespace lap
+{
+namespace log
+{
+#if LAP_LOG_HAS_IO_URING
+    namespace
+    {
+        // Ring indices are written by the kernel (CQ tail, SQ head) and by us (CQ head, SQ tail)
+        inline core::UInt32 loadAcquire(const core::UInt32* p) noexcept
+        {
+            return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+        }
+
+        inline void storeRelease(core::UInt32* p, core::UInt32 v) noexcept
+        {
+            __atomic_store_n(p, v, __ATOMIC_RELEASE);
+        }
+
+        template <typename T>
+        inline T* at(void* base, core::UInt32 offset) noexcept
+        {
+            return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+        }
+    }
+#endif
+
+    IoUringWriter::IoUringWriter() noexcept
+        : m_ringFd(-1)
+        , m_pid(0)
+        , m_sqRing(nullptr)
+        , m_sqRingSize(0)
+        , m_cqRing(nullptr)
+        , m_cqRingSize(0)
+        , m_sqes(nullptr)
+        , m_sqesSize(0)
+        , m_sqHead(nullptr)
+        , m_sqTail(nullptr)
+        , m_sqArray(nullptr)
+        , m_sqMask(0)
+        , m_sqEntries(0)
+        , m_cqHead(nullptr)
+        , m_cqTail(nullptr)
+        , m_cqes(nullptr)
+        , m_cqMask(0)
+        , m_localTail(0)
+        , m_queued(0)
+        , m_lastSqe(nullptr)
+        , m_inflight(0)
+        , m_fixed(false)
+        , m_enterCount(0)
+    {
+    }
+
+    IoUringWriter::~IoUringWriter() noexcept
+    {
+        close();
+    }
+
+    core::Bool IoUringWriter::isSupported() noexcept
+    {
+#if LAP_LOG_HAS_IO_URING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+#if LAP_LOG_HAS_IO_URING
+    core::Bool IoUringWriter::init(core::UInt32 entries, void* buffer, core::Size size) noexcept
+    {
+        close();
+
+        struct io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        const long fd = ::syscall(__NR_io_uring_setup, entries, &params);
+        if (fd < 0) {
+            return false;
+        }
+        m_ringFd = static_cast<core::Int32>(fd);
+        m_pid = ::getpid();
+
+        m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(core::UInt32);
+        m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        const core::Bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single && m_cqRingSize > m_sqRingSize) {
+            m_sqRingSize = m_cqRingSize;
+        }
+
+        m_sqRing = ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          m_ringFd, IORING_OFF_SQ_RING);
+        if (m_sqRing == MAP_FAILED) {
+            m_sqRing = nullptr;
+            const int err = errno;
+            close();
+            errno = err;
+            return false;
+        }
+
+        if (single) {
+            m_cqRing = m_sqRing;
+        } else {
+            m_cqRing = ::mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                              m_ringFd, IORING_OFF_CQ_RING);
+            if (m_cqRing == MAP_FAILED) {
+                m_cqRing = nullptr;
+                const int err = errno;
+                close();
+                errno = err;
+                return false;
+            }
+        }
+
+        m_sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+        void* sqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            m_ringFd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            const int err = errno;
+            close();
+            errno = err;
+            return false;
+        }
+        m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+        m_sqHead    = at<core::UInt32>(m_sqRing, params.sq_off.head);
+        m_sqTail    = at<core::UInt32>(m_sqRing, params.sq_off.tail);
+        m_sqArray   = at<core::UInt32>(m_sqRing, params.sq_off.array);
+        m_sqMask    = *at<core::UInt32>(m_sqRing, params.sq_off.ring_mask);
+        m_sqEntries = params.sq_entries;
+        m_cqHead    = at<core::UInt32>(m_cqRing, params.cq_off.head);
+        m_cqTail    = at<core::UInt32>(m_cqRing, params.cq_off.tail);
+        m_cqes      = at<io_uring_cqe>(m_cqRing, params.cq_off.cqes);
+        m_cqMask    = *at<core::UInt32>(m_cqRing, params.cq_off.ring_mask);
+        m_localTail = *m_sqTail;
+
+        // Pinned once; refused under a small RLIMIT_MEMLOCK, plain writes still work
+        struct iovec region = { buffer, size };
+        m_fixed = buffer != nullptr && size > 0 &&
+                  ::syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_BUFFERS, &region, 1) == 0;
+        return true;
+    }
+
+    void IoUringWriter::close() noexcept
+    {
+        if (m_sqes != nullptr) {
+            ::munmap(m_sqes, m_sqesSize);
+        }
+        if (m_cqRing != nullptr && m_cqRing != m_sqRing) {
+            ::munmap(m_cqRing, m_cqRingSize);
+        }
+        if (m_sqRing != nullptr) {
+            ::munmap(m_sqRing, m_sqRingSize);
+        }
+        if (m_ringFd >= 0) {
+            ::close(m_ringFd);     // Also unregisters the buffer
+        }
+
+        m_ringFd = -1;
+        m_sqRing = nullptr;
+        m_cqRing = nullptr;
+        m_sqes = nullptr;
+        m_queued = 0;
+        m_lastSqe = nullptr;
+        m_inflight = 0;
+        m_fixed = false;
+    }
+
+    core::Bool IoUringWriter::isReady() const noexcept
+    {
+        return m_ringFd >= 0 && ::getpid() == m_pid;
+    }
+
+    io_uring_sqe* IoUringWriter::nextSqe() noexcept
+    {
+        if (m_localTail - loadAcquire(m_sqHead) >= m_sqEntries) {
+            // Queue full: this part of the chain goes now, the rest is drained behind it
+            if (!submit() || m_localTail - loadAcquire(m_sqHead) >= m_sqEntries) {
+                return nullptr;
+            }
+        }
+
+        io_uring_sqe* sqe = &m_sqes[m_localTail & m_sqMask];
+        std::memset(sqe, 0, sizeof(*sqe));
+        m_sqArray[m_localTail & m_sqMask] = m_localTail & m_sqMask;
+
+        if (m_lastSqe != nullptr) {
+            m_lastSqe->flags |= IOSQE_IO_LINK;
+        } else if (m_inflight > 0) {
+            sqe->flags |= IOSQE_IO_DRAIN;
+        }
+
+        m_lastSqe = sqe;
+        ++m_localTail;
+        ++m_queued;
+        return sqe;
+    }
+
+    core::Bool IoUringWriter::queueWrite(core::Int32 fd, const void* data, core::UInt32 len, core::UInt64 userData) noexcept
+    {
+        io_uring_sqe* sqe = nextSqe();
+        if (sqe == nullptr) {
+            return false;
+        }
+        sqe->opcode     = m_fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+        sqe->fd         = fd;
+        sqe->addr       = reinterpret_cast<core::UInt64>(data);
+        sqe->len        = len;
+        sqe->off        = 0;    // Ignored for O_APPEND files: the kernel appends at i_size
+        sqe->buf_index  = 0;
+        sqe->user_data  = userData;
+        return true;
+    }
+
+    core::Bool IoUringWriter::queueFsync(core::Int32 fd, core::Bool dataOnly, core::UInt64 userData) noexcept
+    {
+        io_uring_sqe* sqe = nextSqe();
+        if (sqe == nullptr) {
+            return false;
+        }
+        sqe->opcode     = IORING_OP_FSYNC;
+        sqe->fd         = fd;
+        sqe->fsync_flags = dataOnly ? IORING_FSYNC_DATASYNC : 0;
+        sqe->user_data  = userData;
+        return true;
+    }
+
+    core::Bool IoUringWriter::submit() noexcept
+    {
+        if (m_queued == 0) {
+            return true;
+        }
+
+        storeRelease(m_sqTail, m_localTail);
+        const core::Int32 submitted = enter(m_queued, 0, 0);
+        if (submitted < 0) {
+            return false;
+        }
+
+        // A request rejected during preparation ends the submission early; the rest is retried next time
+        m_queued -= static_cast<core::UInt32>(submitted);
+        m_inflight += static_cast<core::UInt32>(submitted);
+        if (m_queued == 0) {
+            m_lastSqe = nullptr;
+        }
+        return true;
+    }
+
+    core::UInt32 IoUringWriter::reap(Completion* out, core::UInt32 max, core::UInt32 waitFor) noexcept
+    {
+        // One wakeup for the whole wait instead of one per linked request
+        core::UInt32 head = *m_cqHead;
+        waitFor = waitFor < m_inflight ? waitFor : m_inflight;
+        if (waitFor > 0 && loadAcquire(m_cqTail) - head < waitFor) {
+            enter(0, waitFor, IORING_ENTER_GETEVENTS);
+        }
+
+        const core::UInt32 tail = loadAcquire(m_cqTail);
+        core::UInt32 count = 0;
+        for (; head != tail && count < max; ++head, ++count) {
+            const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+            out[count].userData = cqe.user_data;
+            out[count].result = cqe.res;
+        }
+        storeRelease(m_cqHead, head);
+        m_inflight -= count < m_inflight ? count : m_inflight;
+        return count;
+    }
+
+    void IoUringWriter::waitIdle() const noexcept
+    {
+        // min_complete counts completions still sitting in the CQ ring, so this returns once all are there
+        if (m_ringFd >= 0 && m_inflight > 0) {
+            enter(0, m_inflight, IORING_ENTER_GETEVENTS);
+        }
+    }
+
+    core::Int32 IoUringWriter::enter(core::UInt32 toSubmit, core::UInt32 minComplete, core::UInt32 flags) const noexcept
+    {
+        for (;;) {
+            ++m_enterCount;
+            const long ret = ::syscall(__NR_io_uring_enter, m_ringFd, toSubmit, minComplete, flags, nullptr, 0);
+            if (ret >= 0 || errno != EINTR) {
+                return static_cast<core::Int32>(ret);
+            }
+        }
+    }
+#else
+    core::Bool IoUringWriter::init(core::UInt32, void*, core::Size) noexcept
+    {
+        errno = ENOSYS;
+        return false;
+    }
+
+    void IoUringWriter::close() noexcept {}
+    core::Bool IoUringWriter::isReady() const noexcept { return false; }
+    io_uring_sqe* IoUringWriter::nextSqe() noexcept { return nullptr; }
+    core::Bool IoUringWriter::queueWrite(core::Int32, const void*, core::UInt32, core::UInt64) noexcept { return false; }
+    core::Bool IoUringWriter::queueFsync(core::Int32, core::Bool, core::UInt64) noexcept { return false; }
+    core::Bool IoUringWriter::submit() noexcept { errno = ENOSYS; return false; }
+    core::UInt32 IoUringWriter::reap(Completion*, core::UInt32, core::UInt32) noexcept { return 0; }
+    void IoUringWriter::waitIdle() const noexcept {}
+    core::Int32 IoUringWriter::enter(core::UInt32, core::UInt32, core::UInt32) const noexcept { return -1; }
+#endif
+
+} // namespace log
+} // namespace lap
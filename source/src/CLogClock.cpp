@@ -0,0 +1,130 @@
+/**
+ * @file        CLogClock.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Record timestamp clock
+ * @date        2026-10-16
+ */
+
+#include "CLogClock.hpp"
+#include <atomic>
+#include <ctime>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <cpuid.h>
+#include <x86intrin.h>
+#define LAP_LOG_HAS_TSC 1
+#else
+#define LAP_LOG_HAS_TSC 0
+#endif
+
+namespace lap
+{
+namespace log
+{
+    namespace
+    {
+        constexpr core::UInt64 kCalibrationNs = 10 * 1000 * 1000;    // TSC measured against CLOCK_MONOTONIC for 10 ms
+
+        // Written by setSource() before the source is published (release), read after it (acquire)
+        ::std::atomic< core::UInt8 >    s_source{ static_cast< core::UInt8 >( ClockSource::kRealtime ) };
+        ::std::atomic< core::UInt64 >   s_monoToWallNs{ 0 };    // wall - monotonic at anchoring
+        ::std::atomic< core::UInt64 >   s_tscBase{ 0 };         // TSC value at anchoring
+        ::std::atomic< core::UInt64 >   s_tscWallBaseNs{ 0 };   // Wall time at s_tscBase
+        ::std::atomic< core::UInt64 >   s_tscMult{ 0 };         // ns per tick, 32.32 fixed point
+
+        inline core::UInt64 readClock( clockid_t id ) noexcept
+        {
+            struct timespec ts;
+            ::clock_gettime( id, &ts );
+            return static_cast< core::UInt64 >( ts.tv_sec ) * 1000000000ULL + static_cast< core::UInt64 >( ts.tv_nsec );
+        }
+
+#if LAP_LOG_HAS_TSC
+        inline core::Bool hasInvariantTsc() noexcept
+        {
+            unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+            if ( !__get_cpuid( 0x80000000, &eax, &ebx, &ecx, &edx ) || eax < 0x80000007 ) {
+                return false;
+            }
+            if ( !__get_cpuid( 0x80000007, &eax, &ebx, &ecx, &edx ) ) {
+                return false;
+            }
+            return ( edx & ( 1u << 8 ) ) != 0;
+        }
+
+        core::Bool calibrateTsc() noexcept
+        {
+            if ( !hasInvariantTsc() ) {
+                return false;
+            }
+
+            const core::UInt64 tsc0     = __rdtsc();
+            const core::UInt64 mono0    = readClock( CLOCK_MONOTONIC );
+            core::UInt64 mono1          = mono0;
+            while ( mono1 - mono0 < kCalibrationNs ) {
+                mono1 = readClock( CLOCK_MONOTONIC );
+            }
+            const core::UInt64 tsc1     = __rdtsc();
+            const core::UInt64 wall1    = readClock( CLOCK_REALTIME );
+
+            if ( tsc1 <= tsc0 ) {
+                return false;
+            }
+
+            const unsigned __int128 mult = ( static_cast< unsigned __int128 >( mono1 - mono0 ) << 32 ) / ( tsc1 - tsc0 );
+            s_tscMult.store( static_cast< core::UInt64 >( mult ), ::std::memory_order_relaxed );
+            s_tscBase.store( tsc1, ::std::memory_order_relaxed );
+            s_tscWallBaseNs.store( wall1, ::std::memory_order_relaxed );
+            return true;
+        }
+#endif
+    }
+
+    core::UInt64 LogClock::now() noexcept
+    {
+        switch ( static_cast< ClockSource >( s_source.load( ::std::memory_order_acquire ) ) ) {
+        case ClockSource::kRealtimeCoarse:
+            return readClock( CLOCK_REALTIME_COARSE );
+        case ClockSource::kMonotonic:
+            return readClock( CLOCK_MONOTONIC ) + s_monoToWallNs.load( ::std::memory_order_relaxed );
+#if LAP_LOG_HAS_TSC
+        case ClockSource::kTsc: {
+            const core::UInt64 ticks = __rdtsc() - s_tscBase.load( ::std::memory_order_relaxed );
+            const unsigned __int128 ns = static_cast< unsigned __int128 >( ticks ) * s_tscMult.load( ::std::memory_order_relaxed );
+            return s_tscWallBaseNs.load( ::std::memory_order_relaxed ) + static_cast< core::UInt64 >( ns >> 32 );
+        }
+#endif
+        case ClockSource::kRealtime:
+        default:
+            return readClock( CLOCK_REALTIME );
+        }
+    }
+
+    ClockSource LogClock::setSource( ClockSource source ) noexcept
+    {
+#if LAP_LOG_HAS_TSC
+        if ( source == ClockSource::kTsc && !calibrateTsc() ) {
+            source = ClockSource::kMonotonic;
+        }
+#else
+        if ( source == ClockSource::kTsc ) {
+            source = ClockSource::kMonotonic;
+        }
+#endif
+        if ( source == ClockSource::kMonotonic ) {
+            const core::UInt64 wall = readClock( CLOCK_REALTIME );
+            const core::UInt64 mono = readClock( CLOCK_MONOTONIC );
+            s_monoToWallNs.store( wall - mono, ::std::memory_order_relaxed );
+        }
+
+        s_source.store( static_cast< core::UInt8 >( source ), ::std::memory_order_release );
+        return source;
+    }
+
+    ClockSource LogClock::getSource() noexcept
+    {
+        return static_cast< ClockSource >( s_source.load( ::std::memory_order_acquire ) );
+    }
+
+} // namespace log
+} // namespace lap
@@ -0,0 +1,404 @@
+/**
+ * @file        CLogCollector.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Local log collector implementation
+ * @date        2026-10-16
+ */
+
+#include "CLogCollector.hpp"
+#include "CShmRingSink.hpp"
+#include "CSinkManager.hpp"
+#include "CModeledMessage.hpp"
+#include "CLogClock.hpp"
+#include "CThreadId.hpp"
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace lap
+{
+namespace log
+{
+    namespace
+    {
+        constexpr core::StringView  kDropReportContextId{ "LOGC" };
+        constexpr core::Size        kMaxRecordsPerPass  = 4096;     // Per ring: one busy client cannot starve the others
+        constexpr core::Size        kMaxMessageLen      = 0xFFFF;   // LogEntry::messageLen
+
+        inline core::UInt64 nowMs() noexcept
+        {
+            return static_cast<core::UInt64>(::std::chrono::duration_cast<::std::chrono::milliseconds>(
+                ::std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        inline core::UInt64 alignRecord(core::UInt64 size) noexcept
+        {
+            return (size + ShmRingSink::kRecordAlign - 1) & ~static_cast<core::UInt64>(ShmRingSink::kRecordAlign - 1);
+        }
+    }
+
+    LogCollector::LogCollector(SinkManager& sinkManager, const Config& config) noexcept
+        : m_sinkManager(sinkManager)
+        , m_config(config)
+        , m_lastScanMs(0)
+        , m_records(0)
+        , m_dropped(0)
+        , m_tornBytes(0)
+        , m_retired(0)
+        , m_ringCount(0)
+    {
+        // Largest text record: header + context + 64 KiB message, in LogEntry units to keep the alignment
+        m_entry.resize((sizeof(LogEntry) + 255 + kMaxMessageLen) / sizeof(LogEntry) + 1);
+        scan();
+    }
+
+    LogCollector::~LogCollector() noexcept
+    {
+        // Rings stay: a restarted collector continues from the tail stored in them
+        for (auto& ring : m_rings) {
+            detach(ring, false);
+        }
+    }
+
+    LogCollector::Stats LogCollector::getStats() const noexcept
+    {
+        Stats stats;
+        stats.records   = m_records.load(::std::memory_order_relaxed);
+        stats.dropped   = m_dropped.load(::std::memory_order_relaxed);
+        stats.tornBytes = m_tornBytes.load(::std::memory_order_relaxed);
+        stats.retired   = m_retired.load(::std::memory_order_relaxed);
+        stats.rings     = m_ringCount.load(::std::memory_order_relaxed);
+        return stats;
+    }
+
+    void LogCollector::scan() noexcept
+    {
+        m_lastScanMs = nowMs();
+
+        DIR* dir = ::opendir(m_config.directory.c_str());
+        if (dir == nullptr) {
+            return;
+        }
+
+        const core::Size prefixLen = ::std::strlen(ShmRingSink::kCollectPrefix);
+        while (struct dirent* ent = ::readdir(dir)) {
+            const core::Size len = ::std::strlen(ent->d_name);
+            if (len <= prefixLen + 5 ||
+                ::std::strncmp(ent->d_name, ShmRingSink::kCollectPrefix, prefixLen) != 0 ||
+                ::std::strcmp(ent->d_name + len - 5, ".ring") != 0) {
+                continue;
+            }
+
+            core::String path = m_config.directory + "/" + ent->d_name;
+            struct stat st;
+            if (::stat(path.c_str(), &st) != 0) {
+                continue;
+            }
+
+            core::Bool known = false;
+            for (const auto& ring : m_rings) {
+                if (ring.device == st.st_dev && ring.inode == st.st_ino) {
+                    known = true;
+                    break;
+                }
+            }
+
+            Ring ring;
+            if (!known && attach(path, ring)) {
+                m_rings.push_back(::std::move(ring));
+            }
+        }
+        ::closedir(dir);
+
+        m_ringCount.store(m_rings.size(), ::std::memory_order_relaxed);
+    }
+
+    core::Bool LogCollector::attach(const core::String& path, Ring& ring) noexcept
+    {
+        const int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+
+        // Ring header, see doc/design/ShmRing_Format.md; the magic is written last by the client
+        core::UInt8 h[ShmRingSink::kHeaderSize];
+        struct stat st;
+        core::UInt16 headerSize = 0;
+        core::UInt64 capacity = 0;
+        core::UInt32 flags = 0;
+        const core::Bool valid =
+            ::fstat(fd, &st) == 0 &&
+            ::pread(fd, h, sizeof(h), 0) == static_cast<ssize_t>(sizeof(h)) &&
+            ::std::memcmp(h, "LAPR", 4) == 0 &&
+            h[4] == ShmRingSink::kFormatVersion &&
+            h[5] == ((__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) ? 1 : 2);
+        if (valid) {
+            ::std::memcpy(&headerSize, h + 6, sizeof(headerSize));
+            ::std::memcpy(&capacity, h + 8, sizeof(capacity));
+            ::std::memcpy(&flags, h + ShmRingSink::kFlagsOffset, sizeof(flags));
+        }
+        if (!valid || headerSize != ShmRingSink::kHeaderSize || (flags & ShmRingSink::kRingCollected) == 0 ||
+            capacity < ShmRingSink::kMinCapacity || (capacity & (capacity - 1)) != 0 ||
+            static_cast<core::UInt64>(st.st_size) < ShmRingSink::kHeaderSize + capacity) {
+            ::close(fd);
+            return false;
+        }
+
+        // Another collector owns it
+        if (::flock(fd, LOCK_EX | LOCK_NB) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        const core::Size mapSize = static_cast<core::Size>(ShmRingSink::kHeaderSize + capacity);
+        void* map = ::mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (map == MAP_FAILED) {
+            fprintf(stderr, "[LightAP] LogCollector: Cannot map %s: %s\n", path.c_str(), ::std::strerror(errno));
+            ::close(fd);
+            return false;
+        }
+
+        core::UInt8* base = static_cast<core::UInt8*>(map);
+        ring.path           = path;
+        ring.device         = st.st_dev;
+        ring.inode          = st.st_ino;
+        ring.fd             = fd;
+        ring.map            = base;
+        ring.mapSize        = mapSize;
+        ring.data           = base + ShmRingSink::kHeaderSize;
+        ring.capacity       = static_cast<core::Size>(capacity);
+        ::std::memcpy(&ring.pid, h + 16, sizeof(ring.pid));
+        ring.head           = reinterpret_cast<::std::atomic<core::UInt64>*>(base + ShmRingSink::kHeadOffset);
+        ring.tail           = reinterpret_cast<::std::atomic<core::UInt64>*>(base + ShmRingSink::kTailOffset);
+        ring.dropped        = reinterpret_cast<::std::atomic<core::UInt64>*>(base + ShmRingSink::kDroppedOffset);
+        ring.flags          = reinterpret_cast<::std::atomic<core::UInt32>*>(base + ShmRingSink::kFlagsOffset);
+        ring.reportedDrops  = 0;
+        ring.checkedAliveMs = 0;
+        ring.gone           = false;
+        return true;
+    }
+
+    void LogCollector::detach(Ring& ring, core::Bool remove) noexcept
+    {
+        if (ring.map == nullptr) {
+            return;
+        }
+        ::munmap(ring.map, ring.mapSize);
+        ring.map = nullptr;
+
+        // Unlinked under the lock, and only if the name still belongs to this ring
+        struct stat st;
+        if (remove && ::stat(ring.path.c_str(), &st) == 0 && st.st_dev == ring.device && st.st_ino == ring.inode) {
+            ::unlink(ring.path.c_str());
+        }
+        ::close(ring.fd);
+    }
+
+    core::Size LogCollector::poll() noexcept
+    {
+        const core::UInt64 now = nowMs();
+        if (now - m_lastScanMs >= m_config.scanIntervalMs) {
+            scan();
+        }
+
+        core::Size forwarded = 0;
+        for (core::Size i = 0; i < m_rings.size(); ) {
+            Ring& ring = m_rings[i];
+
+            // Decided before the head is read: whatever is uncommitted below it then will never commit
+            const core::Bool gone = clientGone(ring, now);
+            forwarded += drain(ring);
+            reportDrops(ring);
+
+            if (gone && ring.tail->load(::std::memory_order_relaxed) == ring.head->load(::std::memory_order_acquire)) {
+                detach(ring, true);
+                m_rings.erase(m_rings.begin() + static_cast<::std::ptrdiff_t>(i));
+                m_retired.fetch_add(1, ::std::memory_order_relaxed);
+                continue;
+            }
+            ++i;
+        }
+
+        m_ringCount.store(m_rings.size(), ::std::memory_order_relaxed);
+        return forwarded;
+    }
+
+    void LogCollector::run(const ::std::atomic<core::Bool>& stop) noexcept
+    {
+        core::Bool dirty = false;
+        while (!stop.load(::std::memory_order_acquire)) {
+            if (poll() > 0) {
+                dirty = true;
+                continue;
+            }
+            // Rings empty: hand the batched lines to the files, then wait
+            if (dirty) {
+                m_sinkManager.flushAll();
+                dirty = false;
+            }
+            ::std::this_thread::sleep_for(::std::chrono::milliseconds(m_config.idleWaitMs));
+        }
+
+        while (poll() > 0) {
+        }
+        m_sinkManager.flushAll();
+    }
+
+    core::Bool LogCollector::clientGone(Ring& ring, core::UInt64 now) noexcept
+    {
+        if (ring.gone) {
+            return true;
+        }
+        if ((ring.flags->load(::std::memory_order_acquire) & ShmRingSink::kRingClosed) != 0) {
+            ring.gone = true;
+        } else if (now - ring.checkedAliveMs >= m_config.scanIntervalMs) {
+            ring.checkedAliveMs = now;
+            ring.gone = ::kill(static_cast<pid_t>(ring.pid), 0) != 0 && errno == ESRCH;
+        }
+        return ring.gone;
+    }
+
+    core::Size LogCollector::drain(Ring& ring) noexcept
+    {
+        const core::UInt64 mask = ring.capacity - 1;
+        const core::UInt64 head = ring.head->load(::std::memory_order_acquire);
+        core::UInt64 tail = ring.tail->load(::std::memory_order_relaxed);
+        core::UInt64 published = tail;
+        core::Size count = 0;
+
+        while (tail < head && count < kMaxRecordsPerPass) {
+            // Size and commit never straddle the ring end
+            const core::UInt8* record = ring.data + (tail & mask);
+            const core::UInt32 commit = __atomic_load_n(reinterpret_cast<const core::UInt32*>(record + 4), __ATOMIC_ACQUIRE);
+            core::UInt32 size = 0;
+            ::std::memcpy(&size, record, sizeof(size));
+
+            if (commit == ShmRingSink::commitTag(tail) && size >= ShmRingSink::kRecordHeaderSize &&
+                size <= ring.capacity / 4) {
+                forward(ring, tail, size);
+                tail += alignRecord(size);
+                ++count;
+            } else if (ring.gone) {
+                // Reserved by a client that died before committing: resynchronise like the recovery tool
+                tail += ShmRingSink::kRecordAlign;
+                m_tornBytes.fetch_add(ShmRingSink::kRecordAlign, ::std::memory_order_relaxed);
+            } else {
+                break;      // Still being written
+            }
+
+            // Give producers their space back without waiting for the end of the pass
+            if (tail - published >= ring.capacity / 4) {
+                ring.tail->store(tail, ::std::memory_order_release);
+                published = tail;
+            }
+        }
+
+        if (tail != published) {
+            ring.tail->store(tail, ::std::memory_order_release);
+        }
+        m_records.fetch_add(count, ::std::memory_order_relaxed);
+        return count;
+    }
+
+    void LogCollector::copyOut(const Ring& ring, core::UInt64 pos, void* dst, core::Size len) noexcept
+    {
+        if (len == 0) {
+            return;
+        }
+        const core::Size offset = static_cast<core::Size>(pos & (ring.capacity - 1));
+        const core::Size first = len < ring.capacity - offset ? len : ring.capacity - offset;
+        ::std::memcpy(dst, ring.data + offset, first);
+        if (first < len) {
+            ::std::memcpy(static_cast<core::UInt8*>(dst) + first, ring.data, len - first);
+        }
+    }
+
+    void LogCollector::forward(const Ring& ring, core::UInt64 pos, core::UInt32 size) noexcept
+    {
+        // [size:4][commit:4][timestamp:8][tid:4][messageId:4][level:1][kind:1][contextLen:1][flags:1][pad:4]
+        core::UInt8 header[ShmRingSink::kRecordHeaderSize];
+        copyOut(ring, pos, header, sizeof(header));
+
+        core::UInt64 timestamp = 0;
+        core::UInt32 threadId = 0;
+        core::UInt32 messageId = 0;
+        ::std::memcpy(&timestamp, header + 8, sizeof(timestamp));
+        ::std::memcpy(&threadId, header + 16, sizeof(threadId));
+        ::std::memcpy(&messageId, header + 20, sizeof(messageId));
+        const LogLevelType level = header[24];
+        const core::UInt8 kind = header[25];
+        const core::Size contextLen = header[26];
+        if (ShmRingSink::kRecordHeaderSize + contextLen > size) {
+            return;
+        }
+
+        const core::UInt64 contextPos = pos + ShmRingSink::kRecordHeaderSize;
+        core::Size payloadSize = size - ShmRingSink::kRecordHeaderSize - contextLen;
+
+        if (kind == static_cast<core::UInt8>(ShmRingSink::RecordKind::kModeled)) {
+            char context[256];
+            core::UInt8 payload[ModeledRecord::kMaxPayloadSize];
+            payloadSize = payloadSize < sizeof(payload) ? payloadSize : sizeof(payload);
+            copyOut(ring, contextPos, context, contextLen);
+            copyOut(ring, contextPos + contextLen, payload, payloadSize);
+            const ModeledRecord record(timestamp, threadId, messageId, level, payload, payloadSize);
+            m_sinkManager.write(record, core::StringView(context, contextLen));
+            return;
+        }
+
+        // Text and deferred records: the same entry the async worker hands to the sinks
+        payloadSize = payloadSize < kMaxMessageLen ? payloadSize : kMaxMessageLen;
+        LogEntry* entry     = m_entry.data();
+        entry->timestamp    = timestamp;
+        entry->threadId     = threadId;
+        entry->level        = level;
+        entry->format       = (kind == static_cast<core::UInt8>(ShmRingSink::RecordKind::kArgs))
+                              ? RecordFormat::kArgs : RecordFormat::kText;
+        entry->contextIdLen = static_cast<core::UInt16>(contextLen);
+        entry->messageLen   = static_cast<core::UInt16>(payloadSize);
+        copyOut(ring, contextPos, entry + 1, contextLen + payloadSize);
+        m_sinkManager.write(*entry);
+    }
+
+    void LogCollector::reportDrops(Ring& ring) noexcept
+    {
+        const core::UInt64 dropped = ring.dropped->load(::std::memory_order_relaxed);
+        const core::UInt64 delta = dropped - ring.reportedDrops;
+        if (delta == 0) {
+            return;
+        }
+        ring.reportedDrops = dropped;
+        m_dropped.fetch_add(delta, ::std::memory_order_relaxed);
+
+        char message[128];
+        int len = ::std::snprintf(message, sizeof(message), "%llu records dropped by process %u (collector ring full)",
+                                  static_cast<unsigned long long>(delta), static_cast<unsigned>(ring.pid));
+        len = (len < 0) ? 0 : (static_cast<core::Size>(len) >= sizeof(message) ? sizeof(message) - 1 : len);
+
+        alignas(LogEntry) char storage[sizeof(LogEntry) + sizeof(message) + kDropReportContextId.size()];
+        LogEntry* entry     = new (storage) LogEntry;
+        entry->timestamp    = LogClock::now();
+        entry->threadId     = ThreadId::current();
+        entry->level        = static_cast<LogLevelType>(LogLevel::kWarn);
+        entry->contextIdLen = static_cast<core::UInt16>(kDropReportContextId.size());
+        entry->messageLen   = static_cast<core::UInt16>(len);
+
+        char* data = reinterpret_cast<char*>(entry + 1);
+        ::std::memcpy(data, kDropReportContextId.data(), kDropReportContextId.size());
+        ::std::memcpy(data + kDropReportContextId.size(), message, static_cast<core::Size>(len));
+
+        m_sinkManager.write(*entry);
+    }
+
+} // namespace log
+} // namespace lap
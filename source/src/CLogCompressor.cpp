@@ -0,0 +1,287 @@
+/**
+ * @file        CLogCompressor.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Streaming gzip/zstd compression of rotated log files
+ * @date        2026-10-16
+ */
+
+#include "CLogCompressor.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if LAP_LOG_HAS_ZLIB
+#include <zlib.h>
+#endif
+#if LAP_LOG_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace lap
+{
+namespace log
+{
+    namespace
+    {
+        // Longest single sleep of the rate limiter, keeps cancellation responsive
+        constexpr core::UInt64 MAX_THROTTLE_SLEEP_NS = 100ULL * 1000 * 1000;
+
+        inline core::UInt64 monotonicNs() noexcept
+        {
+            struct timespec ts;
+            ::clock_gettime( CLOCK_MONOTONIC, &ts );
+            return static_cast< core::UInt64 >( ts.tv_sec ) * 1000000000ULL + static_cast< core::UInt64 >( ts.tv_nsec );
+        }
+
+        inline core::Bool stopped( const ::std::atomic< core::Bool >* stop ) noexcept
+        {
+            return stop != nullptr && stop->load( ::std::memory_order_relaxed );
+        }
+
+        core::Bool writeAll( int fd, const core::UInt8* data, core::Size len ) noexcept
+        {
+            while ( len > 0 ) {
+                const ssize_t written = ::write( fd, data, len );
+                if ( written < 0 && errno == EINTR ) {
+                    continue;
+                }
+                if ( written <= 0 ) {
+                    return false;
+                }
+                data += written;
+                len -= static_cast< core::Size >( written );
+            }
+            return true;
+        }
+
+        /**
+         * @brief Hold input consumption to bytesPerSec since start
+         * @return false if stop was raised while waiting
+         */
+        core::Bool throttle( core::UInt64 start, core::UInt64 consumed, core::Size bytesPerSec,
+                             const ::std::atomic< core::Bool >* stop ) noexcept
+        {
+            if ( bytesPerSec == 0 ) {
+                return !stopped( stop );
+            }
+
+            const core::UInt64 due = start + consumed * 1000000000ULL / bytesPerSec;
+            for ( core::UInt64 now = monotonicNs(); now < due; now = monotonicNs() ) {
+                if ( stopped( stop ) ) {
+                    return false;
+                }
+                const core::UInt64 wait = ( due - now ) < MAX_THROTTLE_SLEEP_NS ? ( due - now ) : MAX_THROTTLE_SLEEP_NS;
+                const struct timespec pause = { static_cast< time_t >( wait / 1000000000ULL ),
+                                                static_cast< long >( wait % 1000000000ULL ) };
+                ::nanosleep( &pause, nullptr );
+            }
+            return !stopped( stop );
+        }
+
+        /**
+         * @brief read() -> encode -> write() loop shared by the codecs
+         * @tparam Encoder encode( in, inLen, finish, out, outCapacity, sink ) -> Bool
+         */
+        template < typename Encoder >
+        core::Bool pump( int srcFd, int dstFd, Encoder& encoder, core::Size bytesPerSec,
+                         const ::std::atomic< core::Bool >* stop ) noexcept
+        {
+            core::UInt8 in[ LogCompressor::kChunkSize ];
+            core::UInt8 out[ LogCompressor::kChunkSize ];
+            const core::UInt64 start = monotonicNs();
+            core::UInt64 consumed = 0;
+
+            for ( ;; ) {
+                const ssize_t got = ::read( srcFd, in, sizeof( in ) );
+                if ( got < 0 && errno == EINTR ) {
+                    continue;
+                }
+                if ( got < 0 ) {
+                    return false;
+                }
+
+                const core::Bool finish = ( got == 0 );
+                auto sink = [dstFd]( const core::UInt8* data, core::Size len ) noexcept {
+                    return writeAll( dstFd, data, len );
+                };
+                if ( !encoder.encode( in, static_cast< core::Size >( got ), finish, out, sizeof( out ), sink ) ) {
+                    return false;
+                }
+                if ( finish ) {
+                    return true;
+                }
+
+                consumed += static_cast< core::UInt64 >( got );
+                if ( !throttle( start, consumed, bytesPerSec, stop ) ) {
+                    return false;
+                }
+            }
+        }
+
+#if LAP_LOG_HAS_ZLIB
+        class GzipEncoder
+        {
+        public:
+            explicit GzipEncoder( core::Int32 level ) noexcept
+            {
+                std::memset( &m_stream, 0, sizeof( m_stream ) );
+                // windowBits 15 + 16: gzip header and trailer instead of zlib's
+                m_ready = ::deflateInit2( &m_stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY ) == Z_OK;
+            }
+
+            ~GzipEncoder() noexcept
+            {
+                if ( m_ready ) {
+                    ::deflateEnd( &m_stream );
+                }
+            }
+
+            core::Bool ready() const noexcept { return m_ready; }
+
+            template < typename Sink >
+            core::Bool encode( core::UInt8* in, core::Size inLen, core::Bool finish,
+                               core::UInt8* out, core::Size outCapacity, Sink& sink ) noexcept
+            {
+                m_stream.next_in    = in;
+                m_stream.avail_in   = static_cast< uInt >( inLen );
+                int result;
+                do {
+                    m_stream.next_out   = out;
+                    m_stream.avail_out  = static_cast< uInt >( outCapacity );
+                    result = ::deflate( &m_stream, finish ? Z_FINISH : Z_NO_FLUSH );
+                    if ( result == Z_STREAM_ERROR ) {
+                        return false;
+                    }
+                    if ( !sink( out, outCapacity - m_stream.avail_out ) ) {
+                        return false;
+                    }
+                } while ( m_stream.avail_out == 0 || ( finish && result != Z_STREAM_END ) );
+                return true;
+            }
+
+        private:
+            z_stream    m_stream;
+            core::Bool  m_ready;
+        };
+#endif
+
+#if LAP_LOG_HAS_ZSTD
+        class ZstdEncoder
+        {
+        public:
+            explicit ZstdEncoder( core::Int32 level ) noexcept
+                : m_context( ::ZSTD_createCCtx() )
+            {
+                if ( m_context != nullptr &&
+                     ::ZSTD_isError( ::ZSTD_CCtx_setParameter( m_context, ZSTD_c_compressionLevel, level ) ) ) {
+                    ::ZSTD_freeCCtx( m_context );
+                    m_context = nullptr;
+                }
+            }
+
+            ~ZstdEncoder() noexcept
+            {
+                ::ZSTD_freeCCtx( m_context );
+            }
+
+            core::Bool ready() const noexcept { return m_context != nullptr; }
+
+            template < typename Sink >
+            core::Bool encode( core::UInt8* in, core::Size inLen, core::Bool finish,
+                               core::UInt8* out, core::Size outCapacity, Sink& sink ) noexcept
+            {
+                ZSTD_inBuffer input = { in, inLen, 0 };
+                for ( ;; ) {
+                    ZSTD_outBuffer output = { out, outCapacity, 0 };
+                    const size_t remaining = ::ZSTD_compressStream2( m_context, &output, &input,
+                                                                     finish ? ZSTD_e_end : ZSTD_e_continue );
+                    if ( ::ZSTD_isError( remaining ) ) {
+                        return false;
+                    }
+                    if ( !sink( out, output.pos ) ) {
+                        return false;
+                    }
+                    // continue: done once the input is consumed; end: once the frame is flushed
+                    if ( finish ? remaining == 0 : input.pos == input.size ) {
+                        return true;
+                    }
+                }
+            }
+
+        private:
+            ZSTD_CCtx*  m_context;
+        };
+#endif
+    }
+
+    const char* LogCompressor::suffix( CompressionType type ) noexcept
+    {
+        switch ( type ) {
+            case CompressionType::kGzip:    return ".gz";
+            case CompressionType::kZstd:    return ".zst";
+            default:                        return "";
+        }
+    }
+
+    core::Bool LogCompressor::isAvailable( CompressionType type ) noexcept
+    {
+        switch ( type ) {
+#if LAP_LOG_HAS_ZLIB
+            case CompressionType::kGzip:    return true;
+#endif
+#if LAP_LOG_HAS_ZSTD
+            case CompressionType::kZstd:    return true;
+#endif
+            default:                        return false;
+        }
+    }
+
+    core::Bool LogCompressor::compressFile( core::Int32 srcFd, const core::String& dstPath, CompressionType type,
+                                            core::Int32 level, core::Size bytesPerSec,
+                                            const ::std::atomic< core::Bool >* stop ) noexcept
+    {
+        if ( !isAvailable( type ) ) {
+            return false;
+        }
+
+        const int dstFd = ::open( dstPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644 );
+        if ( dstFd < 0 ) {
+            fprintf( stderr, "[LightAP] LogCompressor: Cannot create %s: %s\n", dstPath.c_str(), std::strerror( errno ) );
+            return false;
+        }
+
+        core::Bool ok = false;
+        (void)level;        // Unused when neither codec is compiled in
+        (void)bytesPerSec;
+        (void)stop;
+#if LAP_LOG_HAS_ZLIB
+        if ( type == CompressionType::kGzip ) {
+            GzipEncoder encoder( level > 0 ? level : kDefaultGzipLevel );
+            ok = encoder.ready() && pump( srcFd, dstFd, encoder, bytesPerSec, stop );
+        }
+#endif
+#if LAP_LOG_HAS_ZSTD
+        if ( type == CompressionType::kZstd ) {
+            ZstdEncoder encoder( level > 0 ? level : kDefaultZstdLevel );
+            ok = encoder.ready() && pump( srcFd, dstFd, encoder, bytesPerSec, stop );
+        }
+#endif
+
+        // Rotated files keep their age for retention tools and `ls -t`
+        struct stat st;
+        if ( ok && ::fstat( srcFd, &st ) == 0 ) {
+            const struct timespec times[2] = { st.st_atim, st.st_mtim };
+            ::futimens( dstFd, times );
+        }
+
+        if ( ::close( dstFd ) != 0 ) {
+            ok = false;
+        }
+        return ok;
+    }
+
+} // namespace log
+} // namespace lap
@@ -4,8 +4,11 @@
 #include "CLogManager.hpp"
 #include "CConsoleSink.hpp"
 #include "CFileSink.hpp"
+#include "CBinaryFileSink.hpp"
+#include "CShmRingSink.hpp"
 #include "CSyslogSink.hpp"
 #include "CDLTSink.hpp"
+#include "CCrashHandler.hpp"
 
 namespace lap
 {
@@ -17,6 +20,9 @@ namespace log
     {
         resetLogConfig();
 
+        // Keep every Logger's effective level in sync with the sinks
+        m_sinkManager.setLevelListener( &LogManager::onSinkLevelChanged, this );
+
         initialize();
     }
 
@@ -67,6 +73,16 @@ namespace log
     {
         if ( !m_bInitialized )  return;
 
+        // The emergency path must not reach the queue or sinks past this point
+        CrashHandler::uninstall();
+        CrashHandler::attach( nullptr, nullptr );
+
+        // Drain queued records into the sinks before loggers go away
+        if ( m_asyncQueue ) {
+            m_asyncQueue->stop();
+            m_asyncQueue.reset();
+        }
+
         core::LockGuard lock( m_mtxContextMap );
         m_mapLogContext.clear();
 
@@ -96,6 +112,10 @@ namespace log
             core::LockGuard lock( m_mtxContextMap );
             // create new logger
             auto&& _it = m_mapLogContext.emplace( ctxID, core::MakeUnique< Logger >( ctxID, ctxDesc, level, status ) );
+            _it.first->second->updateEffectiveLevel( m_sinkManager.getMaxLevel() );
+
+            // Sinks with per-context state (DLT context IDs) get description and level as registered
+            m_sinkManager.registerContext( ctxID, ctxDesc, level, status );
 
             // return default logger
             return *( _it.first->second );
@@ -139,10 +159,32 @@ namespace log
         m_logConfig.iWithEcuId                      = 1;
         m_logConfig.isLogMarker                     = false;
         m_logConfig.isVerboseMode                   = true;
+        m_logConfig.isWithThreadId                  = false;
+        m_logConfig.consoleConfig                   = ConsoleConfig(); // stderr, one writev() per record
         
         // FileSink rotation defaults
         m_logConfig.logFileMaxSize                  = 10 * 1024 * 1024;  // 10MB
         m_logConfig.logFileMaxBackups               = 5;                 // 5 backup files
+        m_logConfig.fileBufferConfig                = FileBufferConfig(); // One write() per record
+        m_logConfig.fileRotationConfig              = FileRotationConfig(); // Size only, inline under the directory lock
+        m_logConfig.fileSyncConfig                  = FileSyncConfig(); // Kernel writeback, fsync on close
+        m_logConfig.fileSpaceConfig                 = FileSpaceConfig(); // Files grow on demand, page cache untouched
+        m_logConfig.maxMessageSize                  = LogStream::DEFAULT_MAX_MESSAGE_SIZE;
+        m_logConfig.isDeferredFormat                = false;
+
+        // Async queue defaults (disabled: synchronous dispatch)
+        m_logConfig.isAsyncEnabled                  = false;
+        m_logConfig.asyncConfig                     = AsyncLogQueue::Config();
+
+        // Fatal signals keep their default disposition
+        m_logConfig.isCrashHandlerEnabled           = false;
+
+        // printf compatible "%.6f" / "%.12f" output
+        m_logConfig.floatConfig                     = NumberFormat::FloatConfig();
+
+        // vDSO CLOCK_REALTIME, printed with millisecond digits
+        m_logConfig.clockSource                     = ClockSource::kRealtime;
+        m_logConfig.timestampPrecision              = TimestampPrecision::kMilli;
     }
 
     core::Bool LogManager::loadFromCoreConfig() noexcept
@@ -212,6 +254,8 @@ namespace log
             bool bv = false;
             if ( getBool( "logMarker", bv ) ) m_logConfig.isLogMarker = bv;
             if ( getBool( "verboseMode", bv ) ) m_logConfig.isVerboseMode = bv;
+            if ( getBool( "withThreadId", bv ) ) m_logConfig.isWithThreadId = bv;
+            if ( getBool( "deferredFormat", bv ) ) m_logConfig.isDeferredFormat = bv;
 
             if ( getUInt( "logFileMaxSize", uv ) && uv > 0 ) {
                 m_logConfig.logFileMaxSize = static_cast<core::Size>( uv );
@@ -219,6 +263,136 @@ namespace log
             if ( getUInt( "logFileMaxBackups", uv ) && uv > 0 ) {
                 m_logConfig.logFileMaxBackups = static_cast<core::UInt32>( uv );
             }
+            if ( getUInt( "maxMessageSize", uv ) && uv > 0 ) {
+                m_logConfig.maxMessageSize = static_cast<core::Size>( uv );
+            }
+
+            // "console": { "stream": "stderr|stdout", "bufferSize": 0, "flushIntervalMs": 100, "forceColor": false }
+            if (logObj.contains("console") && logObj["console"].is_object()) {
+                parseConsoleConfig(logObj["console"], m_logConfig.consoleConfig);
+            }
+
+            // "fileBuffer": { "bufferSize": 65536, "flushIntervalMs": 1000, "multiProcess": false,
+            //                "ioEngine": "write|io_uring" }
+            if (logObj.contains("fileBuffer") && logObj["fileBuffer"].is_object()) {
+                parseFileBufferConfig(logObj["fileBuffer"], m_logConfig.fileBufferConfig);
+            }
+
+            // "fileRotation": { "rotateInterval": "none|hourly|daily", "rotateInBackground": false,
+            //                  "compression": "none|gzip|zstd", "compressionLevel": 0, "compressBytesPerSec": 8388608 }
+            if (logObj.contains("fileRotation") && logObj["fileRotation"].is_object()) {
+                parseFileRotationConfig(logObj["fileRotation"], m_logConfig.fileRotationConfig);
+            }
+
+            // "fileSync": { "syncPolicy": "none|periodic|error|bytes", "syncIntervalMs": 1000, "syncEveryBytes": 1048576 }
+            if (logObj.contains("fileSync") && logObj["fileSync"].is_object()) {
+                parseFileSyncConfig(logObj["fileSync"], m_logConfig.fileSyncConfig);
+            }
+
+            // "fileSpace": { "preallocate": false, "preallocateBytes": 0, "dropCacheBytes": 0 }
+            if (logObj.contains("fileSpace") && logObj["fileSpace"].is_object()) {
+                parseFileSpaceConfig(logObj["fileSpace"], m_logConfig.fileSpaceConfig);
+            }
+
+            if (logObj.contains("asyncQueue") && logObj["asyncQueue"].is_object()) {
+                const auto& aq = logObj["asyncQueue"];
+                if (aq.contains("enable") && aq["enable"].is_boolean()) {
+                    m_logConfig.isAsyncEnabled = aq["enable"].get< bool >();
+                }
+                if (aq.contains("ringSize") && aq["ringSize"].is_number_unsigned()) {
+                    m_logConfig.asyncConfig.ringSize = aq["ringSize"].get< core::Size >();
+                }
+                if (aq.contains("batchSize") && aq["batchSize"].is_number_unsigned()) {
+                    m_logConfig.asyncConfig.batchSize = aq["batchSize"].get< core::Size >();
+                }
+                if (aq.contains("flushTimeoutMs") && aq["flushTimeoutMs"].is_number_unsigned()) {
+                    m_logConfig.asyncConfig.flushTimeoutMs = aq["flushTimeoutMs"].get< core::UInt32 >();
+                }
+                if (aq.contains("idleWaitMs") && aq["idleWaitMs"].is_number_unsigned()) {
+                    m_logConfig.asyncConfig.idleWaitMs = aq["idleWaitMs"].get< core::UInt32 >();
+                }
+                if (aq.contains("sampleRate") && aq["sampleRate"].is_number_unsigned()) {
+                    m_logConfig.asyncConfig.sampleRate = aq["sampleRate"].get< core::UInt32 >();
+                }
+                if (aq.contains("pressurePercent") && aq["pressurePercent"].is_number_unsigned()) {
+                    m_logConfig.asyncConfig.pressurePercent = aq["pressurePercent"].get< core::UInt32 >();
+                }
+                // "overflowPolicy": { "INFO": "dropNewest", "DEBUG": "sample", ... }
+                if (aq.contains("overflowPolicy") && aq["overflowPolicy"].is_object()) {
+                    for (auto it = aq["overflowPolicy"].begin(); it != aq["overflowPolicy"].end(); ++it) {
+                        if (!it.value().is_string()) continue;
+                        auto v = it.value().get< ::std::string >();
+                        OverflowPolicy policy;
+                        if ( v == "block" ) policy = OverflowPolicy::kBlock;
+                        else if ( v == "dropNewest" ) policy = OverflowPolicy::kDropNewest;
+                        else if ( v == "dropOldest" ) policy = OverflowPolicy::kDropOldest;
+                        else if ( v == "sample" ) policy = OverflowPolicy::kSample;
+                        else {
+                            fprintf( stderr, "[LightAP] LogManager: Unknown overflow policy '%s' in config, ignored.\n", v.c_str() );
+                            continue;
+                        }
+                        // formatLevel() falls back to kFatal: never let a typo relax FATAL
+                        LogLevel level = formatLevel( core::StringView{ it.key().c_str() } );
+                        if ( level == LogLevel::kFatal && it.key() != "Fatal" && it.key() != "FATAL" ) {
+                            fprintf( stderr, "[LightAP] LogManager: Unknown overflow policy level '%s' in config, ignored.\n", it.key().c_str() );
+                            continue;
+                        }
+                        m_logConfig.asyncConfig.setPolicy( level, policy );
+                    }
+                }
+            }
+
+            // "crashHandler": { "enable": true }
+            if (logObj.contains("crashHandler") && logObj["crashHandler"].is_object()) {
+                const auto& ch = logObj["crashHandler"];
+                if (ch.contains("enable") && ch["enable"].is_boolean()) {
+                    m_logConfig.isCrashHandlerEnabled = ch["enable"].get< bool >();
+                }
+            }
+
+            // "floatFormat": { "mode": "fixed" | "scientific" | "shortest", "floatPrecision": 6, "doublePrecision": 12 }
+            if (logObj.contains("floatFormat") && logObj["floatFormat"].is_object()) {
+                const auto& ff = logObj["floatFormat"];
+                if (ff.contains("mode") && ff["mode"].is_string()) {
+                    auto v = ff["mode"].get< ::std::string >();
+                    if ( v == "fixed" ) m_logConfig.floatConfig.format = FloatFormat::kFixed;
+                    else if ( v == "scientific" ) m_logConfig.floatConfig.format = FloatFormat::kScientific;
+                    else if ( v == "shortest" ) m_logConfig.floatConfig.format = FloatFormat::kShortest;
+                    else {
+                        fprintf( stderr, "[LightAP] LogManager: Unknown float format '%s' in config, ignored.\n", v.c_str() );
+                    }
+                }
+                if (ff.contains("floatPrecision") && ff["floatPrecision"].is_number_unsigned()) {
+                    m_logConfig.floatConfig.floatPrecision = ff["floatPrecision"].get< core::Int32 >();
+                }
+                if (ff.contains("doublePrecision") && ff["doublePrecision"].is_number_unsigned()) {
+                    m_logConfig.floatConfig.doublePrecision = ff["doublePrecision"].get< core::Int32 >();
+                }
+            }
+
+            // "timestamp": { "clock": "realtime" | "realtimeCoarse" | "monotonic" | "tsc", "precision": "ms" | "us" | "ns" }
+            if (logObj.contains("timestamp") && logObj["timestamp"].is_object()) {
+                const auto& ts = logObj["timestamp"];
+                if (ts.contains("clock") && ts["clock"].is_string()) {
+                    auto v = ts["clock"].get< ::std::string >();
+                    if ( v == "realtime" ) m_logConfig.clockSource = ClockSource::kRealtime;
+                    else if ( v == "realtimeCoarse" ) m_logConfig.clockSource = ClockSource::kRealtimeCoarse;
+                    else if ( v == "monotonic" ) m_logConfig.clockSource = ClockSource::kMonotonic;
+                    else if ( v == "tsc" ) m_logConfig.clockSource = ClockSource::kTsc;
+                    else {
+                        fprintf( stderr, "[LightAP] LogManager: Unknown timestamp clock '%s' in config, ignored.\n", v.c_str() );
+                    }
+                }
+                if (ts.contains("precision") && ts["precision"].is_string()) {
+                    auto v = ts["precision"].get< ::std::string >();
+                    if ( v == "ms" ) m_logConfig.timestampPrecision = TimestampPrecision::kMilli;
+                    else if ( v == "us" ) m_logConfig.timestampPrecision = TimestampPrecision::kMicro;
+                    else if ( v == "ns" ) m_logConfig.timestampPrecision = TimestampPrecision::kNano;
+                    else {
+                        fprintf( stderr, "[LightAP] LogManager: Unknown timestamp precision '%s' in config, ignored.\n", v.c_str() );
+                    }
+                }
+            }
 
             if (logObj.contains("sinks") && logObj["sinks"].is_array()) {
                 m_sinkConfigs.clear();
@@ -286,10 +460,100 @@ namespace log
             logObj["withEcuId"] = static_cast<int>(m_logConfig.iWithEcuId);
             logObj["logMarker"] = m_logConfig.isLogMarker;
             logObj["verboseMode"] = m_logConfig.isVerboseMode;
+            logObj["withThreadId"] = m_logConfig.isWithThreadId;
             
             // Save file rotation config
             logObj["logFileMaxSize"] = m_logConfig.logFileMaxSize;
             logObj["logFileMaxBackups"] = m_logConfig.logFileMaxBackups;
+            logObj["maxMessageSize"] = m_logConfig.maxMessageSize;
+            logObj["deferredFormat"] = m_logConfig.isDeferredFormat;
+            
+            // Save console output config
+            nlohmann::json consoleObj;
+            consoleObj["stream"] = m_logConfig.consoleConfig.stream == ConsoleStream::kStdout ? "stdout" : "stderr";
+            consoleObj["bufferSize"] = m_logConfig.consoleConfig.bufferSize;
+            consoleObj["flushIntervalMs"] = m_logConfig.consoleConfig.flushIntervalMs;
+            consoleObj["forceColor"] = m_logConfig.consoleConfig.forceColor;
+            logObj["console"] = consoleObj;
+            
+            // Save file write batching config
+            nlohmann::json fileBufferObj;
+            fileBufferObj["bufferSize"] = m_logConfig.fileBufferConfig.bufferSize;
+            fileBufferObj["flushIntervalMs"] = m_logConfig.fileBufferConfig.flushIntervalMs;
+            fileBufferObj["multiProcess"] = m_logConfig.fileBufferConfig.multiProcess;
+            fileBufferObj["ioEngine"] = m_logConfig.fileBufferConfig.ioEngine == FileIoEngine::kIoUring ? "io_uring" : "write";
+            logObj["fileBuffer"] = fileBufferObj;
+            
+            // Save file rotation policy
+            nlohmann::json fileRotationObj;
+            switch (m_logConfig.fileRotationConfig.interval) {
+                case RotationInterval::kHourly: fileRotationObj["rotateInterval"] = "hourly"; break;
+                case RotationInterval::kDaily:  fileRotationObj["rotateInterval"] = "daily"; break;
+                default:                        fileRotationObj["rotateInterval"] = "none"; break;
+            }
+            fileRotationObj["rotateInBackground"] = m_logConfig.fileRotationConfig.background;
+            fileRotationObj["compression"] = std::string(toString(m_logConfig.fileRotationConfig.compression).data());
+            fileRotationObj["compressionLevel"] = m_logConfig.fileRotationConfig.compressionLevel;
+            fileRotationObj["compressBytesPerSec"] = m_logConfig.fileRotationConfig.compressBytesPerSec;
+            logObj["fileRotation"] = fileRotationObj;
+            
+            // Save file durability policy
+            nlohmann::json fileSyncObj;
+            switch (m_logConfig.fileSyncConfig.policy) {
+                case FileSyncPolicy::kPeriodic:     fileSyncObj["syncPolicy"] = "periodic"; break;
+                case FileSyncPolicy::kOnError:      fileSyncObj["syncPolicy"] = "error"; break;
+                case FileSyncPolicy::kEveryBytes:   fileSyncObj["syncPolicy"] = "bytes"; break;
+                default:                            fileSyncObj["syncPolicy"] = "none"; break;
+            }
+            fileSyncObj["syncIntervalMs"] = m_logConfig.fileSyncConfig.intervalMs;
+            fileSyncObj["syncEveryBytes"] = m_logConfig.fileSyncConfig.everyBytes;
+            logObj["fileSync"] = fileSyncObj;
+            
+            // Save file space management
+            nlohmann::json fileSpaceObj;
+            fileSpaceObj["preallocate"] = m_logConfig.fileSpaceConfig.preallocate;
+            fileSpaceObj["preallocateBytes"] = m_logConfig.fileSpaceConfig.preallocateBytes;
+            fileSpaceObj["dropCacheBytes"] = m_logConfig.fileSpaceConfig.dropCacheBytes;
+            logObj["fileSpace"] = fileSpaceObj;
+            
+            // Save async queue config
+            nlohmann::json asyncObj;
+            asyncObj["enable"] = m_logConfig.isAsyncEnabled;
+            asyncObj["ringSize"] = m_logConfig.asyncConfig.ringSize;
+            asyncObj["batchSize"] = m_logConfig.asyncConfig.batchSize;
+            asyncObj["flushTimeoutMs"] = m_logConfig.asyncConfig.flushTimeoutMs;
+            asyncObj["idleWaitMs"] = m_logConfig.asyncConfig.idleWaitMs;
+            asyncObj["sampleRate"] = m_logConfig.asyncConfig.sampleRate;
+            asyncObj["pressurePercent"] = m_logConfig.asyncConfig.pressurePercent;
+            nlohmann::json policyObj;
+            for (core::Size i = static_cast<core::Size>(LogLevel::kFatal); i < AsyncLogQueue::kLevelCount; ++i) {
+                auto levelName = toString(static_cast<LogLevel>(i));
+                auto policyName = toString(m_logConfig.asyncConfig.levelPolicy[i]);
+                policyObj[std::string(levelName.data(), levelName.size())] = std::string(policyName.data(), policyName.size());
+            }
+            asyncObj["overflowPolicy"] = policyObj;
+            logObj["asyncQueue"] = asyncObj;
+            
+            // Save crash handler config
+            nlohmann::json crashObj;
+            crashObj["enable"] = m_logConfig.isCrashHandlerEnabled;
+            logObj["crashHandler"] = crashObj;
+            
+            // Save numeric output config
+            nlohmann::json floatObj;
+            auto formatName = toString(m_logConfig.floatConfig.format);
+            floatObj["mode"] = std::string(formatName.data(), formatName.size());
+            floatObj["floatPrecision"] = m_logConfig.floatConfig.floatPrecision;
+            floatObj["doublePrecision"] = m_logConfig.floatConfig.doublePrecision;
+            logObj["floatFormat"] = floatObj;
+            
+            // Save record timestamp config
+            nlohmann::json timestampObj;
+            auto clockName = toString(m_logConfig.clockSource);
+            auto precisionName = toString(m_logConfig.timestampPrecision);
+            timestampObj["clock"] = std::string(clockName.data(), clockName.size());
+            timestampObj["precision"] = std::string(precisionName.data(), precisionName.size());
+            logObj["timestamp"] = timestampObj;
             
             // Save sink configurations if any
             if (!m_sinkConfigs.empty()) {
@@ -317,12 +581,49 @@ namespace log
 
         assert( m_defaultLogCtx != nullptr && "The default log context creation failed!!!" );
 
+        NumberFormat::setFloatConfig( m_logConfig.floatConfig );
+        LogStream::SetMaxMessageSize( m_logConfig.maxMessageSize );
+        LogStream::SetDeferredFormat( m_logConfig.isDeferredFormat );
+        if ( LogClock::setSource( m_logConfig.clockSource ) != m_logConfig.clockSource ) {
+            fprintf( stderr, "[LightAP] LogManager: No invariant TSC, record timestamps use the monotonic clock\n" );
+        }
+        TimestampFormat::setPrecision( m_logConfig.timestampPrecision );
+
         // Initialize SinkManager based on log mode configuration
         initializeSinks();
+        m_defaultLogCtx->updateEffectiveLevel( m_sinkManager.getMaxLevel() );
+
+        // Start async backend if configured (falls back to synchronous writes on failure)
+        if ( m_logConfig.isAsyncEnabled ) {
+            m_asyncQueue = core::MakeUnique< AsyncLogQueue >( m_sinkManager, m_logConfig.asyncConfig );
+            if ( !m_asyncQueue->start() ) {
+                fprintf( stderr, "[LightAP] LogManager: async queue failed to start, using synchronous mode\n" );
+                m_asyncQueue.reset();
+            }
+        }
+
+        // Emergency path (LogFatalSignalSafe) is always available, the signal handlers are opt-in
+        CrashHandler::attach( &m_sinkManager, m_asyncQueue.get() );
+        if ( m_logConfig.isCrashHandlerEnabled && !CrashHandler::install() ) {
+            fprintf( stderr, "[LightAP] LogManager: crash handler not installed\n" );
+        }
 
         return true;
     }
 
+    void LogManager::onSinkLevelChanged( void* context, LogLevel maxLevel ) noexcept
+    {
+        auto* self = static_cast< LogManager* >( context );
+
+        core::LockGuard lock( self->m_mtxContextMap );
+        for ( auto& ctx : self->m_mapLogContext ) {
+            ctx.second->updateEffectiveLevel( maxLevel );
+        }
+        if ( self->m_defaultLogCtx ) {
+            self->m_defaultLogCtx->updateEffectiveLevel( maxLevel );
+        }
+    }
+
     void LogManager::initializeSinks() noexcept
     {
         // Get default log level as fallback
@@ -343,7 +644,8 @@ namespace log
             
             // Add Console sink if enabled
             if (static_cast<bool>(static_cast<core::UInt8>(logMode) & static_cast<core::UInt8>(LogMode::kConsole))) {
-                auto consoleSink = core::MakeUnique<ConsoleSink>(true, defaultMinLevel);
+                auto consoleSink = core::MakeUnique<ConsoleSink>(true, defaultMinLevel, m_logConfig.consoleConfig);
+                consoleSink->setWithThreadId(m_logConfig.isWithThreadId);
                 m_sinkManager.addSink(core::Move(consoleSink));
             }
             
@@ -355,8 +657,13 @@ namespace log
                         m_logConfig.logFileMaxSize,
                         m_logConfig.logFileMaxBackups,
                         defaultMinLevel,
-                        core::StringView(m_logConfig.strApplicationId)
+                        core::StringView(m_logConfig.strApplicationId),
+                        m_logConfig.fileBufferConfig,
+                        m_logConfig.fileRotationConfig,
+                        m_logConfig.fileSyncConfig,
+                        m_logConfig.fileSpaceConfig
                     );
+                    fileSink->setWithThreadId(m_logConfig.isWithThreadId);
                     m_sinkManager.addSink(core::Move(fileSink));
                 }
             }
@@ -404,6 +711,9 @@ namespace log
                 sinkLevel = formatLevel(core::StringView(lv.c_str()));
             }
             
+            // Per-sink "withThreadId" overrides the log level setting
+            bool withThreadId = sinkConfig.contains("withThreadId") && sinkConfig["withThreadId"].is_boolean() ? sinkConfig["withThreadId"].get<bool>() : m_logConfig.isWithThreadId;
+            
             if (type == "file") {
                 // File sink configuration
                 if (!sinkConfig.contains("path") || !sinkConfig["path"].is_string() || sinkConfig["path"].get<std::string>().empty()) {
@@ -413,20 +723,99 @@ namespace log
                 auto pathStr = sinkConfig["path"].get<std::string>();
                 size_t maxSize = sinkConfig.contains("maxSize") && sinkConfig["maxSize"].is_number_unsigned() ? sinkConfig["maxSize"].get<size_t>() : m_logConfig.logFileMaxSize;
                 core::UInt32 backupCount = sinkConfig.contains("backupCount") && sinkConfig["backupCount"].is_number_unsigned() ? sinkConfig["backupCount"].get<core::UInt32>() : m_logConfig.logFileMaxBackups;
+                // Per-sink "bufferSize"/"flushIntervalMs"/"multiProcess"/"ioEngine" override the "fileBuffer" block
+                FileBufferConfig bufferConfig = m_logConfig.fileBufferConfig;
+                parseFileBufferConfig(sinkConfig, bufferConfig);
+                // Per-sink "rotateInterval"/"rotateInBackground"/"compression*" override the "fileRotation" block
+                FileRotationConfig rotationConfig = m_logConfig.fileRotationConfig;
+                parseFileRotationConfig(sinkConfig, rotationConfig);
+                // Per-sink "syncPolicy"/"syncIntervalMs"/"syncEveryBytes" override the "fileSync" block
+                FileSyncConfig syncConfig = m_logConfig.fileSyncConfig;
+                parseFileSyncConfig(sinkConfig, syncConfig);
+                // Per-sink "preallocate"/"preallocateBytes"/"dropCacheBytes" override the "fileSpace" block
+                FileSpaceConfig spaceConfig = m_logConfig.fileSpaceConfig;
+                parseFileSpaceConfig(sinkConfig, spaceConfig);
                 
                 auto fileSink = core::MakeUnique<FileSink>(
                     core::StringView(pathStr.c_str()),
                     maxSize,
                     backupCount,
                     sinkLevel,
-                    core::StringView(m_logConfig.strApplicationId)
+                    core::StringView(m_logConfig.strApplicationId),
+                    bufferConfig,
+                    rotationConfig,
+                    syncConfig,
+                    spaceConfig
                 );
+                fileSink->setWithThreadId(withThreadId);
                 m_sinkManager.addSink(core::Move(fileSink));
                 
+            } else if (type == "binary") {
+                // Binary file sink configuration, decoded offline by tools/decode_binary_log.py
+                if (!sinkConfig.contains("path") || !sinkConfig["path"].is_string() || sinkConfig["path"].get<std::string>().empty()) {
+                    fprintf(stderr, "[LightAP] LogManager: Binary sink missing 'path', skipped\n");
+                    return;
+                }
+                auto pathStr = sinkConfig["path"].get<std::string>();
+                size_t maxSize = sinkConfig.contains("maxSize") && sinkConfig["maxSize"].is_number_unsigned() ? sinkConfig["maxSize"].get<size_t>() : m_logConfig.logFileMaxSize;
+                core::UInt32 backupCount = sinkConfig.contains("backupCount") && sinkConfig["backupCount"].is_number_unsigned() ? sinkConfig["backupCount"].get<core::UInt32>() : m_logConfig.logFileMaxBackups;
+                size_t preallocSize = sinkConfig.contains("preallocSize") && sinkConfig["preallocSize"].is_number_unsigned() ? sinkConfig["preallocSize"].get<size_t>() : BinaryFileSink::kDefaultPreallocSize;
+                
+                auto binarySink = core::MakeUnique<BinaryFileSink>(
+                    core::StringView(pathStr.c_str()),
+                    maxSize,
+                    backupCount,
+                    sinkLevel,
+                    core::StringView(m_logConfig.strApplicationId),
+                    preallocSize
+                );
+                binarySink->setWithThreadId(withThreadId);
+                m_sinkManager.addSink(core::Move(binarySink));
+                
+            } else if (type == "shm") {
+                // Shared memory flight recorder, recovered after a crash by tools/recover_shm_ring.py
+                std::string pathStr = sinkConfig.contains("path") && sinkConfig["path"].is_string() ? sinkConfig["path"].get<std::string>() : std::string();
+                if (pathStr.empty()) {
+                    pathStr = ShmRingSink::defaultPath(core::StringView(m_logConfig.strApplicationId));
+                }
+                size_t ringSize = sinkConfig.contains("size") && sinkConfig["size"].is_number_unsigned() ? sinkConfig["size"].get<size_t>() : ShmRingSink::kDefaultCapacity;
+                bool keepOnExit = sinkConfig.contains("keepOnExit") && sinkConfig["keepOnExit"].is_boolean() ? sinkConfig["keepOnExit"].get<bool>() : false;
+                
+                auto ringSink = core::MakeUnique<ShmRingSink>(
+                    core::StringView(pathStr.c_str()),
+                    ringSize,
+                    sinkLevel,
+                    core::StringView(m_logConfig.strApplicationId),
+                    keepOnExit
+                );
+                ringSink->setWithThreadId(withThreadId);
+                m_sinkManager.addSink(core::Move(ringSink));
+
+            } else if (type == "collector") {
+                // Per-process ring drained by a LogCollector process that owns the files
+                std::string directory = sinkConfig.contains("directory") && sinkConfig["directory"].is_string() ? sinkConfig["directory"].get<std::string>() : std::string("/dev/shm");
+                size_t ringSize = sinkConfig.contains("size") && sinkConfig["size"].is_number_unsigned() ? sinkConfig["size"].get<size_t>() : ShmRingSink::kDefaultCapacity;
+                core::String pathStr = ShmRingSink::collectPath(core::StringView(directory.c_str()), core::StringView(m_logConfig.strApplicationId));
+
+                auto ringSink = core::MakeUnique<ShmRingSink>(
+                    core::StringView(pathStr.c_str()),
+                    ringSize,
+                    sinkLevel,
+                    core::StringView(m_logConfig.strApplicationId),
+                    false,
+                    true
+                );
+                ringSink->setWithThreadId(withThreadId);
+                m_sinkManager.addSink(core::Move(ringSink));
+
             } else if (type == "console") {
                 // Console sink configuration
                 bool colorized = sinkConfig.contains("colorized") && sinkConfig["colorized"].is_boolean() ? sinkConfig["colorized"].get<bool>() : true;
-                auto consoleSink = core::MakeUnique<ConsoleSink>(colorized, sinkLevel);
+                // Per-sink "stream"/"bufferSize"/"flushIntervalMs"/"forceColor" override the "console" block
+                ConsoleConfig consoleConfig = m_logConfig.consoleConfig;
+                parseConsoleConfig(sinkConfig, consoleConfig);
+                auto consoleSink = core::MakeUnique<ConsoleSink>(colorized, sinkLevel, consoleConfig);
+                consoleSink->setWithThreadId(withThreadId);
                 m_sinkManager.addSink(core::Move(consoleSink));
                 
             } else if (type == "syslog") {
@@ -466,6 +855,126 @@ namespace log
         }
     }
 
+    void LogManager::parseConsoleConfig(const nlohmann::json& obj, ConsoleConfig& config) noexcept
+    {
+        if (obj.contains("stream") && obj["stream"].is_string()) {
+            const auto stream = obj["stream"].get< std::string >();
+            if (stream == "stdout") {
+                config.stream = ConsoleStream::kStdout;
+            } else if (stream == "stderr") {
+                config.stream = ConsoleStream::kStderr;
+            } else {
+                fprintf(stderr, "[LightAP] LogManager: Unknown console stream '%s', ignored\n", stream.c_str());
+            }
+        }
+        if (obj.contains("bufferSize") && obj["bufferSize"].is_number_unsigned()) {
+            config.bufferSize = obj["bufferSize"].get< core::Size >();
+        }
+        if (obj.contains("flushIntervalMs") && obj["flushIntervalMs"].is_number_unsigned()) {
+            config.flushIntervalMs = obj["flushIntervalMs"].get< core::UInt32 >();
+        }
+        if (obj.contains("forceColor") && obj["forceColor"].is_boolean()) {
+            config.forceColor = obj["forceColor"].get< bool >();
+        }
+    }
+
+    void LogManager::parseFileBufferConfig(const nlohmann::json& obj, FileBufferConfig& config) noexcept
+    {
+        if (obj.contains("bufferSize") && obj["bufferSize"].is_number_unsigned()) {
+            config.bufferSize = obj["bufferSize"].get< core::Size >();
+        }
+        if (obj.contains("flushIntervalMs") && obj["flushIntervalMs"].is_number_unsigned()) {
+            config.flushIntervalMs = obj["flushIntervalMs"].get< core::UInt32 >();
+        }
+        if (obj.contains("multiProcess") && obj["multiProcess"].is_boolean()) {
+            config.multiProcess = obj["multiProcess"].get< bool >();
+        }
+        if (obj.contains("ioEngine") && obj["ioEngine"].is_string()) {
+            const auto engine = obj["ioEngine"].get< std::string >();
+            if (engine == "io_uring") {
+                config.ioEngine = FileIoEngine::kIoUring;
+            } else if (engine == "write") {
+                config.ioEngine = FileIoEngine::kWrite;
+            } else {
+                fprintf(stderr, "[LightAP] LogManager: Unknown ioEngine '%s', ignored\n", engine.c_str());
+            }
+        }
+    }
+
+    void LogManager::parseFileRotationConfig(const nlohmann::json& obj, FileRotationConfig& config) noexcept
+    {
+        if (obj.contains("rotateInterval") && obj["rotateInterval"].is_string()) {
+            const auto interval = obj["rotateInterval"].get< std::string >();
+            if (interval == "hourly") {
+                config.interval = RotationInterval::kHourly;
+            } else if (interval == "daily") {
+                config.interval = RotationInterval::kDaily;
+            } else if (interval == "none") {
+                config.interval = RotationInterval::kNone;
+            } else {
+                fprintf(stderr, "[LightAP] LogManager: Unknown rotateInterval '%s', ignored\n", interval.c_str());
+            }
+        }
+        if (obj.contains("rotateInBackground") && obj["rotateInBackground"].is_boolean()) {
+            config.background = obj["rotateInBackground"].get< bool >();
+        }
+        if (obj.contains("compression") && obj["compression"].is_string()) {
+            const auto compression = obj["compression"].get< std::string >();
+            if (compression == "gzip") {
+                config.compression = CompressionType::kGzip;
+            } else if (compression == "zstd") {
+                config.compression = CompressionType::kZstd;
+            } else if (compression == "none") {
+                config.compression = CompressionType::kNone;
+            } else {
+                fprintf(stderr, "[LightAP] LogManager: Unknown compression '%s', ignored\n", compression.c_str());
+            }
+        }
+        if (obj.contains("compressionLevel") && obj["compressionLevel"].is_number_integer()) {
+            config.compressionLevel = obj["compressionLevel"].get< core::Int32 >();
+        }
+        if (obj.contains("compressBytesPerSec") && obj["compressBytesPerSec"].is_number_unsigned()) {
+            config.compressBytesPerSec = obj["compressBytesPerSec"].get< core::Size >();
+        }
+    }
+
+    void LogManager::parseFileSyncConfig(const nlohmann::json& obj, FileSyncConfig& config) noexcept
+    {
+        if (obj.contains("syncPolicy") && obj["syncPolicy"].is_string()) {
+            const auto policy = obj["syncPolicy"].get< std::string >();
+            if (policy == "periodic") {
+                config.policy = FileSyncPolicy::kPeriodic;
+            } else if (policy == "error") {
+                config.policy = FileSyncPolicy::kOnError;
+            } else if (policy == "bytes") {
+                config.policy = FileSyncPolicy::kEveryBytes;
+            } else if (policy == "none") {
+                config.policy = FileSyncPolicy::kNone;
+            } else {
+                fprintf(stderr, "[LightAP] LogManager: Unknown syncPolicy '%s', ignored\n", policy.c_str());
+            }
+        }
+        if (obj.contains("syncIntervalMs") && obj["syncIntervalMs"].is_number_unsigned()) {
+            config.intervalMs = obj["syncIntervalMs"].get< core::UInt32 >();
+        }
+        if (obj.contains("syncEveryBytes") && obj["syncEveryBytes"].is_number_unsigned()) {
+            config.everyBytes = obj["syncEveryBytes"].get< core::Size >();
+        }
+    }
+
+    void LogManager::parseFileSpaceConfig(const nlohmann::json& obj, FileSpaceConfig& config) noexcept
+    {
+        if (obj.contains("preallocate") && obj["preallocate"].is_boolean()) {
+            config.preallocate = obj["preallocate"].get< bool >();
+        }
+        if (obj.contains("preallocateBytes") && obj["preallocateBytes"].is_number_unsigned()) {
+            config.preallocateBytes = obj["preallocateBytes"].get< core::Size >();
+        }
+        if (obj.contains("dropCacheBytes") && obj["dropCacheBytes"].is_number_unsigned()) {
+            config.dropCacheBytes = obj["dropCacheBytes"].get< core::Size >();
+        }
+    }
+
     core::StringView LogManager::formatId( core::StringView strId ) const noexcept
     {
         if ( strId.empty() )        return "XXXX";
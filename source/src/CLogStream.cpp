@@ -1,35 +1,21 @@
 #include <stdarg.h>
 #include <ctime>
+#include <atomic>
+#include <new>
 #include <lap/core/CPath.hpp>
-#include <lap/core/CTime.hpp>
 #include <lap/core/CCrypto.hpp>
 #include "CLogStream.hpp"
 #include "CLogger.hpp"
 #include "CLogManager.hpp"
 #include "CSinkManager.hpp"
+#include "CAsyncLogQueue.hpp"
+#include "CNumberFormat.hpp"
+#include "CArgEncoding.hpp"
 
 namespace lap
 {
 namespace log
 {
-    LogStream::LogStream( LogLevel level, const Logger& logger ) noexcept
-        : m_logLevel( static_cast< LogLevelType >( level ) )
-        , m_logger( logger )
-        , m_bufferPos( 0 )
-        , m_encodeEnabled( false )
-    {
-        // Initialize buffer to empty
-        m_logBuffer[0] = '\0';
-    }
-
-    LogStream::~LogStream() noexcept
-    {
-        // Flush any remaining content
-        if ( m_bufferPos > 0 ) {
-            flushBuffer();
-        }
-    }
-
     void LogStream::Flush() noexcept
     {
         if ( m_bufferPos > 0 ) {
@@ -40,14 +26,92 @@ namespace log
         }
     }
 
-    void LogStream::checkAndFlush(size_t additionalSize) noexcept
+    namespace
     {
-        // If adding this would exceed buffer, flush now
-        if ( m_bufferPos + additionalSize >= MAX_LOG_SIZE ) {
-            flushBuffer();
-            m_bufferPos = 0;
-            m_logBuffer[0] = '\0';
+        ::std::atomic< size_t > s_maxMessageSize{ LogStream::DEFAULT_MAX_MESSAGE_SIZE };
+
+        /**
+         * @brief Per-thread spill buffer for messages outgrowing the inline buffer
+         * @details Allocated once per thread at the hard cap and reused for every
+         *          long message; a nested stream on the same thread (logging from
+         *          inside an operator<<) falls back to a heap buffer
+         */
+        struct SpillArena
+        {
+            char*   buffer{ nullptr };
+            size_t  size{ 0 };
+            bool    inUse{ false };
+
+            ~SpillArena() noexcept  { delete[] buffer; }
+        };
+
+        thread_local SpillArena t_spillArena;
+    }
+
+    ::std::atomic< bool > LogStream::s_deferredFormat{ false };
+
+    void LogStream::SetMaxMessageSize( size_t size ) noexcept
+    {
+        if ( size < MAX_LOG_SIZE - 1 )      size = MAX_LOG_SIZE - 1;
+        if ( size > MAX_MESSAGE_SIZE_LIMIT ) size = MAX_MESSAGE_SIZE_LIMIT;
+        s_maxMessageSize.store( size, ::std::memory_order_relaxed );
+    }
+
+    size_t LogStream::GetMaxMessageSize() noexcept
+    {
+        return s_maxMessageSize.load( ::std::memory_order_relaxed );
+    }
+
+    bool LogStream::grow(size_t additionalSize) noexcept
+    {
+        // Spill once, straight to the hard cap (+1 for the terminating NUL)
+        const size_t capacity = s_maxMessageSize.load( ::std::memory_order_relaxed ) + 1;
+        if ( m_logBuffer != m_inlineBuffer || capacity <= m_capacity ) {
+            return false;
+        }
+
+        char* spill = nullptr;
+        auto& arena = t_spillArena;
+        if ( !arena.inUse ) {
+            if ( arena.size < capacity ) {
+                char* buffer = new ( ::std::nothrow ) char[capacity];
+                if ( buffer ) {
+                    delete[] arena.buffer;
+                    arena.buffer = buffer;
+                    arena.size = capacity;
+                }
+            }
+            if ( arena.size >= capacity ) {
+                arena.inUse = true;
+                spill = arena.buffer;
+                m_spillFromArena = true;
+            }
         }
+        if ( !spill ) {
+            spill = new ( ::std::nothrow ) char[capacity];
+            if ( !spill ) {
+                return false;
+            }
+            m_spillFromArena = false;
+        }
+
+        std::memcpy( spill, m_logBuffer, m_bufferPos + 1 );
+        m_logBuffer = spill;
+        m_capacity = capacity;
+
+        return m_bufferPos + additionalSize < m_capacity;
+    }
+
+    void LogStream::releaseSpill() noexcept
+    {
+        if ( m_spillFromArena ) {
+            t_spillArena.inUse = false;
+        } else {
+            delete[] m_logBuffer;
+        }
+        m_logBuffer = m_inlineBuffer;
+        m_capacity = MAX_LOG_SIZE;
+        m_spillFromArena = false;
     }
 
     void LogStream::flushBuffer() noexcept
@@ -62,48 +126,67 @@ namespace log
             return;
         }
         
-        auto& sinkMgr = logMgr.getSinkManager();
-        
-        // Check if any sink needs this log level
-        if ( !sinkMgr.shouldLog(static_cast<LogLevel>(m_logLevel)) ) {
-            return;
-        }
+        // No sink check here: Logger gated on the effective level, dispatch filters per sink
         
         // Check if base64 encoding is enabled for this LogStream
         if ( m_encodeEnabled ) {
+            // Base64 covers the text: a deferred record is rendered here first
+            core::String rendered;
+            const char* text = m_logBuffer;
+            size_t textLen = m_bufferPos;
+            if ( m_deferred ) {
+                rendered.resize( GetMaxMessageSize() );
+                rendered.resize( ArgFormat::formatArgs( &rendered[0], rendered.size(),
+                                                        reinterpret_cast<const core::UInt8*>(m_logBuffer), m_bufferPos ) );
+                text = rendered.data();
+                textLen = rendered.size();
+            }
+
             // Encode the log message using Core's base64 encoder
             core::String encoded = core::Crypto::Util::base64Encode(
-                reinterpret_cast<const core::UInt8*>(m_logBuffer), 
-                m_bufferPos
+                reinterpret_cast<const core::UInt8*>(text), 
+                textLen
             );
             
-            // Create a temporary buffer to hold the encoded message
-            char encodedBuffer[MAX_LOG_SIZE * 2];  // Base64 can expand up to 4/3 of original
-            size_t encodedLen = encoded.size();
-            if ( encodedLen >= sizeof(encodedBuffer) ) {
-                encodedLen = sizeof(encodedBuffer) - 1;
-            }
-            std::memcpy(encodedBuffer, encoded.data(), encodedLen);
-            encodedBuffer[encodedLen] = '\0';
-            
-            // Temporarily replace buffer for sink writing
-            char* originalBuffer = const_cast<char*>(m_logBuffer);
+            // Temporarily point the stream at the encoded text for SinkManager
+            char* originalBuffer = m_logBuffer;
             size_t originalPos = m_bufferPos;
+            m_logBuffer = const_cast<char*>(encoded.data());
+            m_bufferPos = encoded.size() < MAX_MESSAGE_SIZE_LIMIT ? encoded.size() : MAX_MESSAGE_SIZE_LIMIT;
             
-            // Copy encoded data back to m_logBuffer for SinkManager
-            std::memcpy(originalBuffer, encodedBuffer, encodedLen);
-            const_cast<size_t&>(m_bufferPos) = encodedLen;
-            originalBuffer[encodedLen] = '\0';
+            const bool originalDeferred = m_deferred;
+            m_deferred = false;
             
             // Write to sinks (SinkManager will access m_logBuffer as friend)
-            sinkMgr.write(*this);
+            submit(logMgr);
             
             // Restore original state (though buffer will be cleared after this)
-            const_cast<size_t&>(m_bufferPos) = originalPos;
+            m_logBuffer = originalBuffer;
+            m_bufferPos = originalPos;
+            m_deferred = originalDeferred;
         } else {
             // Write to sinks without encoding (SinkManager will access m_logBuffer as friend)
-            sinkMgr.write(*this);
+            submit(logMgr);
+        }
+    }
+
+    void LogStream::submit( LogManager& logMgr ) noexcept
+    {
+        auto* asyncQueue = logMgr.getAsyncQueue();
+        if ( asyncQueue && asyncQueue->isRunning() ) {
+            // Async: copy the record into this thread's ring, the worker writes the sinks
+            if ( asyncQueue->push( m_timestamp, m_threadId, m_logLevel, m_logger.getContextId(),
+                                   core::StringView( m_logBuffer, m_bufferPos ), getFormat() ) ) {
+                // Fatal records must reach the sinks before a likely abort
+                if ( m_logLevel == static_cast< LogLevelType >( LogLevel::kFatal ) ) {
+                    asyncQueue->flush();
+                }
+                return;
+            }
+            // Rejected (oversized, stopping or still full after timeout): write synchronously
         }
+
+        logMgr.getSinkManager().write(*this);
     }
 
     LogStream& LogStream::WithLocation( core::StringView file, core::Int32 line ) noexcept
@@ -114,8 +197,11 @@ namespace log
         
         int len = std::snprintf( temp, sizeof(temp), "[%.*s:%d] ", 
                                 static_cast<int>(basename.size()), basename.data(), line );
-        if ( len > 0 ) {
-            checkAndFlush(len);
+        if ( len > static_cast<int>(sizeof(temp)) - 1 ) len = sizeof(temp) - 1;
+        if ( m_deferred ) {
+            return len > 0 ? putArg( core::StringView( temp, len ), 1 + sizeof( core::UInt16 ) + len ) : *this;
+        }
+        if ( len > 0 && reserve(len) ) {
             std::memcpy( m_logBuffer + m_bufferPos, temp, len );
             m_bufferPos += len;
             m_logBuffer[m_bufferPos] = '\0';
@@ -133,9 +219,23 @@ namespace log
     // Stream Operators - Direct write to logBuffer
     //=============================================================================
 
+    template < typename T >
+    LogStream& LogStream::putArg( const T& value, size_t encodedSize ) noexcept
+    {
+        // At the hard cap the encoder cuts strings and drops other values, as the text path does
+        reserve( encodedSize );
+        ArgEncoder encoder( reinterpret_cast< core::UInt8* >( m_logBuffer + m_bufferPos ), available() );
+        encoder.put( core::StringView(), value );
+        m_bufferPos += encoder.size();
+        return *this;
+    }
+
     LogStream& LogStream::operator<< ( core::Bool value ) noexcept
     {
-        checkAndFlush(estimateSize(value));
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value ) );
+
+        if ( !reserve(estimateSize(value)) ) return *this;
         m_logBuffer[m_bufferPos++] = value ? '1' : '0';
         m_logBuffer[m_bufferPos] = '\0';
         return *this;
@@ -143,169 +243,220 @@ namespace log
 
     LogStream& LogStream::operator<< ( core::UInt8 value ) noexcept
     {
-        checkAndFlush(estimateSize(value));
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "%u", static_cast<unsigned>(value) );
-        if ( written > 0 ) m_bufferPos += written;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value ) );
+
+        if ( !reserve(estimateSize(value)) ) return *this;
+        m_bufferPos += NumberFormat::formatUInt( m_logBuffer + m_bufferPos, value );
+        m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( core::UInt16 value ) noexcept
     {
-        checkAndFlush(estimateSize(value));
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "%u", value );
-        if ( written > 0 ) m_bufferPos += written;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value ) );
+
+        if ( !reserve(estimateSize(value)) ) return *this;
+        m_bufferPos += NumberFormat::formatUInt( m_logBuffer + m_bufferPos, value );
+        m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( core::UInt32 value ) noexcept
     {
-        checkAndFlush(estimateSize(value));
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "%u", value );
-        if ( written > 0 ) m_bufferPos += written;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value ) );
+
+        if ( !reserve(estimateSize(value)) ) return *this;
+        m_bufferPos += NumberFormat::formatUInt( m_logBuffer + m_bufferPos, value );
+        m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( core::UInt64 value ) noexcept
     {
-        checkAndFlush(estimateSize(value));
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "%lu", value );
-        if ( written > 0 ) m_bufferPos += written;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value ) );
+
+        if ( !reserve(estimateSize(value)) ) return *this;
+        m_bufferPos += NumberFormat::formatUInt( m_logBuffer + m_bufferPos, value );
+        m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( core::Int8 value ) noexcept
     {
-        checkAndFlush(estimateSize(value));
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "%d", static_cast<int>(value) );
-        if ( written > 0 ) m_bufferPos += written;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value ) );
+
+        if ( !reserve(estimateSize(value)) ) return *this;
+        m_bufferPos += NumberFormat::formatInt( m_logBuffer + m_bufferPos, value );
+        m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( core::Int16 value ) noexcept
     {
-        checkAndFlush(estimateSize(value));
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "%d", value );
-        if ( written > 0 ) m_bufferPos += written;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value ) );
+
+        if ( !reserve(estimateSize(value)) ) return *this;
+        m_bufferPos += NumberFormat::formatInt( m_logBuffer + m_bufferPos, value );
+        m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( core::Int32 value ) noexcept
     {
-        checkAndFlush(estimateSize(value));
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "%d", value );
-        if ( written > 0 ) m_bufferPos += written;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value ) );
+
+        if ( !reserve(estimateSize(value)) ) return *this;
+        m_bufferPos += NumberFormat::formatInt( m_logBuffer + m_bufferPos, value );
+        m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( core::Int64 value ) noexcept
     {
-        checkAndFlush(estimateSize(value));
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "%ld", value );
-        if ( written > 0 ) m_bufferPos += written;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value ) );
+
+        if ( !reserve(estimateSize(value)) ) return *this;
+        m_bufferPos += NumberFormat::formatInt( m_logBuffer + m_bufferPos, value );
+        m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( core::Float value ) noexcept
     {
-        checkAndFlush(estimateSize(value));
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "%.6f", value );
-        if ( written > 0 ) m_bufferPos += written;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value ) );
+
+        // Length depends on magnitude and precision: format first, then spill if it does not fit
+        char scratch[NumberFormat::kMaxRealChars];
+        const size_t len = NumberFormat::formatFloat( scratch, sizeof( scratch ), value );
+        if ( !reserve(len) ) return *this;
+        std::memcpy( m_logBuffer + m_bufferPos, scratch, len );
+        m_bufferPos += len;
+        m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( core::Double value ) noexcept
     {
-        checkAndFlush(estimateSize(value));
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "%.12f", value );
-        if ( written > 0 ) m_bufferPos += written;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value ) );
+
+        // Length depends on magnitude and precision: format first, then spill if it does not fit
+        char scratch[NumberFormat::kMaxRealChars];
+        const size_t len = NumberFormat::formatDouble( scratch, sizeof( scratch ), value );
+        if ( !reserve(len) ) return *this;
+        std::memcpy( m_logBuffer + m_bufferPos, scratch, len );
+        m_bufferPos += len;
+        m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( const LogHex8 &value ) noexcept
     {
-        checkAndFlush(8);
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "0x%02X", value.value );
-        if ( written > 0 ) m_bufferPos += written;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value.value ) );
+
+        if ( !reserve(8) ) return *this;
+        m_bufferPos += NumberFormat::formatHex( m_logBuffer + m_bufferPos, value.value, sizeof( value.value ) );
+        m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( const LogHex16 &value ) noexcept
     {
-        checkAndFlush(16);
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "0x%04X", value.value );
-        if ( written > 0 ) m_bufferPos += written;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value.value ) );
+
+        if ( !reserve(16) ) return *this;
+        m_bufferPos += NumberFormat::formatHex( m_logBuffer + m_bufferPos, value.value, sizeof( value.value ) );
+        m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( const LogHex32 &value ) noexcept
     {
-        checkAndFlush(16);
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "0x%08X", value.value );
-        if ( written > 0 ) m_bufferPos += written;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value.value ) );
+
+        if ( !reserve(16) ) return *this;
+        m_bufferPos += NumberFormat::formatHex( m_logBuffer + m_bufferPos, value.value, sizeof( value.value ) );
+        m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( const LogHex64 &value ) noexcept
     {
-        checkAndFlush(24);
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "0x%016lX", value.value );
-        if ( written > 0 ) m_bufferPos += written;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value.value ) );
+
+        if ( !reserve(24) ) return *this;
+        m_bufferPos += NumberFormat::formatHex( m_logBuffer + m_bufferPos, value.value, sizeof( value.value ) );
+        m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( const LogBin8 &value ) noexcept
     {
-        checkAndFlush(16);
-        m_logBuffer[m_bufferPos++] = '0';
-        m_logBuffer[m_bufferPos++] = 'b';
-        for (int i = 7; i >= 0; i--) {
-            m_logBuffer[m_bufferPos++] = ((value.value >> i) & 1) ? '1' : '0';
-        }
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value.value ) );
+
+        if ( !reserve(NumberFormat::binLength( sizeof( value.value ), value.grouped )) ) return *this;
+        m_bufferPos += NumberFormat::formatBin( m_logBuffer + m_bufferPos, value.value, sizeof( value.value ), value.grouped );
         m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( const LogBin16 &value ) noexcept
     {
-        UNUSED( value );
-        checkAndFlush(9);
-        const char* str = "0b(bin16)";
-        std::memcpy( m_logBuffer + m_bufferPos, str, 9 );
-        m_bufferPos += 9;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value.value ) );
+
+        if ( !reserve(NumberFormat::binLength( sizeof( value.value ), value.grouped )) ) return *this;
+        m_bufferPos += NumberFormat::formatBin( m_logBuffer + m_bufferPos, value.value, sizeof( value.value ), value.grouped );
         m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( const LogBin32 &value ) noexcept
     {
-        UNUSED( value );
-        checkAndFlush(9);
-        const char* str = "0b(bin32)";
-        std::memcpy( m_logBuffer + m_bufferPos, str, 9 );
-        m_bufferPos += 9;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value.value ) );
+
+        if ( !reserve(NumberFormat::binLength( sizeof( value.value ), value.grouped )) ) return *this;
+        m_bufferPos += NumberFormat::formatBin( m_logBuffer + m_bufferPos, value.value, sizeof( value.value ), value.grouped );
         m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( const LogBin64 &value ) noexcept
     {
-        UNUSED( value );
-        checkAndFlush(9);
-        const char* str = "0b(bin64)";
-        std::memcpy( m_logBuffer + m_bufferPos, str, 9 );
-        m_bufferPos += 9;
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( value.value ) );
+
+        if ( !reserve(NumberFormat::binLength( sizeof( value.value ), value.grouped )) ) return *this;
+        m_bufferPos += NumberFormat::formatBin( m_logBuffer + m_bufferPos, value.value, sizeof( value.value ), value.grouped );
         m_logBuffer[m_bufferPos] = '\0';
         return *this;
     }
 
     LogStream& LogStream::operator<< ( const core::StringView value ) noexcept
     {
+        if ( !m_enabled ) return *this;
+        if ( m_deferred ) return putArg( value, 1 + sizeof( core::UInt16 ) + value.size() );
+
         size_t len = value.size();
         if ( len > 0 ) {
-            checkAndFlush(len);
-            // Truncate if still too large
-            if ( m_bufferPos + len >= MAX_LOG_SIZE ) {
-                len = MAX_LOG_SIZE - m_bufferPos - 1;
+            // Truncate at the hard cap, never split the record
+            if ( !reserve(len) ) {
+                len = available();
             }
             std::memcpy( m_logBuffer + m_bufferPos, value.data(), len );
             m_bufferPos += len;
@@ -321,13 +472,15 @@ namespace log
 
     LogStream& LogStream::operator<< ( const char *const value ) noexcept
     {
+        if ( !m_enabled ) return *this;
+
         if ( value ) {
             size_t len = std::strlen(value);
+            if ( m_deferred ) return putArg( core::StringView( value, len ), 1 + sizeof( core::UInt16 ) + len );
             if ( len > 0 ) {
-                checkAndFlush(len);
-                // Truncate if still too large
-                if ( m_bufferPos + len >= MAX_LOG_SIZE ) {
-                    len = MAX_LOG_SIZE - m_bufferPos - 1;
+                // Truncate at the hard cap, never split the record
+                if ( !reserve(len) ) {
+                    len = available();
                 }
                 std::memcpy( m_logBuffer + m_bufferPos, value, len );
                 m_bufferPos += len;
@@ -339,25 +492,52 @@ namespace log
 
     LogStream& LogStream::operator<< ( core::Span< const core::Byte > data ) noexcept
     {
-        checkAndFlush(20);
-        int written = std::snprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, "[binary:%zu]", data.size() );
+        if ( !m_enabled ) return *this;
+
+        if ( m_deferred ) {
+            char temp[32];
+            int len = std::snprintf( temp, sizeof(temp), "[binary:%zu]", data.size() );
+            return len > 0 ? putArg( core::StringView( temp, len ), 1 + sizeof( core::UInt16 ) + len ) : *this;
+        }
+
+        if ( !reserve(20) ) return *this;
+        int written = std::snprintf( m_logBuffer + m_bufferPos, m_capacity - m_bufferPos, "[binary:%zu]", data.size() );
         if ( written > 0 ) m_bufferPos += written;
         return *this;
     }
 
     LogStream& LogStream::logFormat( const core::Char *fmt, ... ) noexcept
     {
+        if ( !m_enabled ) return *this;
+
 #ifdef LAP_DEBUG
+        if ( m_deferred ) {
+            // printf-style output is text already: store it as one string value
+            char temp[512];
+            va_list args;
+            va_start( args, fmt );
+            int len = std::vsnprintf( temp, sizeof(temp), fmt, args );
+            va_end( args );
+            if ( len > static_cast<int>(sizeof(temp)) - 1 ) len = sizeof(temp) - 1;
+            return len > 0 ? putArg( core::StringView( temp, len ), 1 + sizeof( core::UInt16 ) + len ) : *this;
+        }
+
         va_list args;
+        va_list retry;
         va_start( args, fmt );
+        va_copy( retry, args );
         
-        checkAndFlush(100);  // Estimate
-        int written = std::vsnprintf( m_logBuffer + m_bufferPos, MAX_LOG_SIZE - m_bufferPos, fmt, args );
+        reserve(100);  // Estimate
+        int written = std::vsnprintf( m_logBuffer + m_bufferPos, m_capacity - m_bufferPos, fmt, args );
+        if ( written > 0 && static_cast<size_t>(written) > available() && reserve(written) ) {
+            written = std::vsnprintf( m_logBuffer + m_bufferPos, m_capacity - m_bufferPos, fmt, retry );
+        }
         
+        va_end( retry );
         va_end( args );
         
         if ( written > 0 ) {
-            m_bufferPos += written;
+            m_bufferPos += ( static_cast<size_t>(written) < available() ) ? written : available();
         }
 #else
         UNUSED( fmt );
@@ -371,12 +551,16 @@ namespace log
 
     LogStream& operator<< ( LogStream &out, LogLevel value ) noexcept
     {
+        if ( out.m_deferred ) return out.putArg( value, 1 + sizeof( LogLevelType ) );
         out << toString( value );
         return out;
     }
 
     LogStream& operator<< ( LogStream &out, const lap::core::ErrorCode &ec ) noexcept
     {
+        if ( out.m_deferred ) {
+            return out.putArg( ec, 1 + sizeof( core::Int64 ) + sizeof( core::UInt16 ) + core::StringView( ec.Domain().Name() ).size() );
+        }
         out << ec.Domain().Name() << ":" << ec.Value();
         return out;
     }
@@ -8,55 +8,25 @@
 #include "CLogger.hpp"
 #include "CLogStream.hpp"
 #include "CLogManager.hpp"
+#include "CSinkManager.hpp"
+#include "CAsyncLogQueue.hpp"
+#include "CCrashHandler.hpp"
 
 namespace lap
 {
 namespace log
 {
-    LogStream Logger::LogFatal() const noexcept
-    {
-        return { LogLevel::kFatal, *this };
-    }
-
-    LogStream Logger::LogError() const noexcept
-    {
-        return { LogLevel::kError, *this };
-    }
-
-    LogStream Logger::LogWarn() const noexcept
-    {
-        return { LogLevel::kWarn, *this };
-    }
-
-    LogStream Logger::LogInfo() const noexcept
-    {
-        return { LogLevel::kInfo, *this };
-    }
-
-    LogStream Logger::LogDebug() const noexcept
-    {
-        return { LogLevel::kDebug, *this };
-    }
-
-    LogStream Logger::LogVerbose() const noexcept
-    {
-        return { LogLevel::kVerbose, *this };
-    }
-
-    LogStream Logger::LogOff() const noexcept
-    {
-        return { LogLevel::kOff, *this };
-    }
-
     bool Logger::IsEnabled( LogLevel logLevel ) const noexcept
     {
         // Simple level check - no DLT dependency
         return static_cast<core::UInt8>(logLevel) <= static_cast<core::UInt8>(m_logLevel);
     }
 
-    LogStream Logger::WithLevel( LogLevel logLevel ) const noexcept
+    void Logger::LogFatalSignalSafe( core::StringView message ) const noexcept
     {
-        return { logLevel, *this };
+        if ( ShouldLog( LogLevel::kFatal ) ) {
+            CrashHandler::logFatal( getContextId(), message );
+        }
     }
 
     Logger::Logger( core::StringView ctxId, core::StringView ctxDesc, LogLevel level, TraceStatus status ) noexcept
@@ -64,6 +34,7 @@ namespace log
         , m_strContextDesc( ctxDesc.data() )
         , m_logLevel( level )
         , m_traceStatus( status )
+        , m_effectiveLevel( static_cast< LogLevelType >( level ) )
     {
         // No DLT registration here - handled by CDLTSink
     }
@@ -73,6 +44,41 @@ namespace log
         // No DLT unregistration needed
     }
 
+    void Logger::updateEffectiveLevel( LogLevel sinkMaxLevel ) noexcept
+    {
+        LogLevelType level = static_cast< LogLevelType >( m_logLevel );
+        if ( static_cast< LogLevelType >( sinkMaxLevel ) < level ) {
+            level = static_cast< LogLevelType >( sinkMaxLevel );
+        }
+        m_effectiveLevel.store( level, ::std::memory_order_relaxed );
+    }
+
+    void Logger::submit( const ModeledRecord& record ) const noexcept
+    {
+        auto& logMgr = LogManager::getInstance();
+        if ( !logMgr.isInitialized() ) {
+            return;
+        }
+
+        auto* asyncQueue = logMgr.getAsyncQueue();
+        if ( asyncQueue && asyncQueue->isRunning() ) {
+            // Message ID and encoded arguments only: the worker rebuilds the record, and
+            // renders text just for the sinks without ISink::writeModeled()
+            core::UInt8 packed[ ModeledRecord::kMaxPackedSize ];
+            const core::Size size = record.pack( packed );
+            if ( asyncQueue->push( record.getTimestamp(), record.getThreadId(), record.getLevel(), getContextId(),
+                                   core::StringView( reinterpret_cast< const core::Char* >( packed ), size ),
+                                   RecordFormat::kModeled ) ) {
+                if ( record.getLevel() == static_cast< LogLevelType >( LogLevel::kFatal ) ) {
+                    asyncQueue->flush();
+                }
+                return;
+            }
+        }
+
+        logMgr.getSinkManager().write( record, getContextId() );
+    }
+
     Logger& CreateLogger( lap::core::StringView ctxId, lap::core::StringView ctxDescription, LogLevel ctxDefLogLevel ) noexcept
     {
         return LogManager::getInstance().registerLogger( ctxId, ctxDescription, ctxDefLogLevel );
@@ -91,11 +97,5 @@ namespace log
     //     ;
     // }
 
-    // no-verbose
-    template <typename MsgId, typename... Params>
-    void Log( const MsgId &id, const Params &... args ) noexcept
-    {
-        ;
-    }
 } // namespace log
 } // namespace lap
\ No newline at end of file
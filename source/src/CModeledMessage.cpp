@@ -0,0 +1,93 @@
+/**
+ * @file        CModeledMessage.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Modeled (non-verbose) messages: text rendering for text sinks
+ * @date        2026-10-16
+ */
+
+#include "CModeledMessage.hpp"
+#include "CNumberFormat.hpp"
+
+namespace lap
+{
+namespace log
+{
+    namespace
+    {
+        inline core::Bool needsQuotes( core::StringView value ) noexcept
+        {
+            for ( core::Char c : value ) {
+                if ( c == ',' || c == '"' ) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Copy "\"value\"" with inner quotes escaped, cut at capacity
+        core::Size putQuoted( core::Char* out, core::Size capacity, core::StringView value ) noexcept
+        {
+            core::Size len = 0;
+            if ( len < capacity ) out[len++] = '"';
+            for ( core::Char c : value ) {
+                if ( c == '"' ) {
+                    if ( len + 2 > capacity ) break;
+                    out[len++] = '\\';
+                } else if ( len + 1 > capacity ) {
+                    break;
+                }
+                out[len++] = c;
+            }
+            if ( len < capacity ) out[len++] = '"';
+            return len;
+        }
+    }
+
+    core::StringView ModeledRecord::getText() const noexcept
+    {
+        if ( m_textSize > 0 ) {
+            return core::StringView( m_text, m_textSize );
+        }
+
+        core::Char* p = m_text;
+        core::Char* const end = m_text + kMaxTextSize;
+
+        ::std::memcpy( p, "[MsgId:", 7 );
+        p += 7;
+        p += NumberFormat::formatUInt( p, m_messageId );
+        *p++ = ']';
+
+        ArgDecoder decoder( m_payload, m_encoder.size() );
+        ArgView arg;
+        core::Bool first = true;
+        while ( p < end && decoder.next( arg ) ) {
+            // " name=" or ", name="
+            const core::Size sepLen = first ? 1 : 2;
+            if ( static_cast< core::Size >( end - p ) < sepLen + arg.name.size() + 1 ) {
+                break;
+            }
+            if ( !first ) {
+                *p++ = ',';
+            }
+            *p++ = ' ';
+            if ( !arg.name.empty() ) {
+                ::std::memcpy( p, arg.name.data(), arg.name.size() );
+                p += arg.name.size();
+                *p++ = '=';
+            }
+            first = false;
+
+            const core::Size room = static_cast< core::Size >( end - p );
+            if ( arg.type == ArgType::kString && needsQuotes( arg.text ) ) {
+                p += putQuoted( p, room, arg.text );
+            } else {
+                p += ArgFormat::formatValue( p, room, arg );
+            }
+        }
+
+        m_textSize = static_cast< core::Size >( p - m_text );
+        return core::StringView( m_text, m_textSize );
+    }
+
+} // namespace log
+} // namespace lap
@@ -0,0 +1,117 @@
+/**
+ * @file        CNumberFormat.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Floating point formatting and configuration
+ * @date        2026-10-16
+ */
+
+#include "CNumberFormat.hpp"
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+namespace lap
+{
+namespace log
+{
+    namespace
+    {
+        ::std::atomic< core::UInt8 >    s_floatFormat{ static_cast< core::UInt8 >( FloatFormat::kFixed ) };
+        ::std::atomic< core::Int32 >    s_floatPrecision{ 6 };
+        ::std::atomic< core::Int32 >    s_doublePrecision{ 12 };
+
+        // Longest fixed output: '-' + 309 integer digits of DBL_MAX + '.' + kMaxPrecision
+        constexpr core::Size kScratchSize = NumberFormat::kMaxRealChars;
+
+        inline core::Int32 clampPrecision( core::Int32 precision ) noexcept
+        {
+            return precision < 0 ? 0 : ( precision > NumberFormat::kMaxPrecision ? NumberFormat::kMaxPrecision : precision );
+        }
+
+        template < typename T >
+        core::Size formatReal( core::Char* out, core::Size capacity, T value, FloatFormat format, core::Int32 precision ) noexcept
+        {
+            core::Char scratch[ kScratchSize ];
+            core::Size len = 0;
+
+#if defined( __cpp_lib_to_chars ) && __cpp_lib_to_chars >= 201611L
+            ::std::to_chars_result result;
+            switch ( format ) {
+                case FloatFormat::kScientific:
+                    result = ::std::to_chars( scratch, scratch + kScratchSize, static_cast< core::Double >( value ),
+                                              ::std::chars_format::scientific, precision );
+                    break;
+                case FloatFormat::kShortest:
+                    result = ::std::to_chars( scratch, scratch + kScratchSize, value );
+                    break;
+                case FloatFormat::kFixed:
+                default:
+                    result = ::std::to_chars( scratch, scratch + kScratchSize, static_cast< core::Double >( value ),
+                                              ::std::chars_format::fixed, precision );
+                    break;
+            }
+            if ( result.ec != ::std::errc() ) {
+                return 0;
+            }
+            len = static_cast< core::Size >( result.ptr - scratch );
+#else
+            // Toolchain without floating point to_chars: printf equivalents
+            int written;
+            switch ( format ) {
+                case FloatFormat::kScientific:
+                    written = ::std::snprintf( scratch, kScratchSize, "%.*e", precision, static_cast< core::Double >( value ) );
+                    break;
+                case FloatFormat::kShortest:
+                    written = ::std::snprintf( scratch, kScratchSize, "%.*g", sizeof( T ) == sizeof( core::Float ) ? 9 : 17,
+                                               static_cast< core::Double >( value ) );
+                    break;
+                case FloatFormat::kFixed:
+                default:
+                    written = ::std::snprintf( scratch, kScratchSize, "%.*f", precision, static_cast< core::Double >( value ) );
+                    break;
+            }
+            if ( written <= 0 ) {
+                return 0;
+            }
+            len = static_cast< core::Size >( written ) < kScratchSize ? static_cast< core::Size >( written ) : kScratchSize - 1;
+#endif
+
+            if ( len > capacity ) {
+                len = capacity;
+            }
+            ::std::memcpy( out, scratch, len );
+            return len;
+        }
+    }
+
+    core::Size NumberFormat::formatDouble( core::Char* out, core::Size capacity, core::Double value ) noexcept
+    {
+        const auto format = static_cast< FloatFormat >( s_floatFormat.load( ::std::memory_order_relaxed ) );
+        return formatReal( out, capacity, value, format, s_doublePrecision.load( ::std::memory_order_relaxed ) );
+    }
+
+    core::Size NumberFormat::formatFloat( core::Char* out, core::Size capacity, core::Float value ) noexcept
+    {
+        const auto format = static_cast< FloatFormat >( s_floatFormat.load( ::std::memory_order_relaxed ) );
+        return formatReal( out, capacity, value, format, s_floatPrecision.load( ::std::memory_order_relaxed ) );
+    }
+
+    void NumberFormat::setFloatConfig( const FloatConfig& config ) noexcept
+    {
+        s_floatPrecision.store( clampPrecision( config.floatPrecision ), ::std::memory_order_relaxed );
+        s_doublePrecision.store( clampPrecision( config.doublePrecision ), ::std::memory_order_relaxed );
+        s_floatFormat.store( static_cast< core::UInt8 >( config.format ), ::std::memory_order_relaxed );
+    }
+
+    NumberFormat::FloatConfig NumberFormat::getFloatConfig() noexcept
+    {
+        FloatConfig config;
+        config.format           = static_cast< FloatFormat >( s_floatFormat.load( ::std::memory_order_relaxed ) );
+        config.floatPrecision   = s_floatPrecision.load( ::std::memory_order_relaxed );
+        config.doublePrecision  = s_doublePrecision.load( ::std::memory_order_relaxed );
+        return config;
+    }
+
+} // namespace log
+} // namespace lap
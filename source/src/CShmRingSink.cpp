@@ -0,0 +1,302 @@
+/**
+ * @file        CShmRingSink.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Shared memory ring buffer sink implementation
+ * @date        2026-10-16
+ */
+
+#include "CShmRingSink.hpp"
+#include "CModeledMessage.hpp"
+#include "CNumberFormat.hpp"
+#include "CTimestampFormat.hpp"
+#include "CLogClock.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace lap
+{
+namespace log
+{
+    static_assert(std::atomic<core::UInt64>::is_always_lock_free, "Ring head must be lock-free in shared memory");
+
+    namespace
+    {
+        inline core::Size roundUpPow2(core::Size value) noexcept
+        {
+            core::Size pow2 = ShmRingSink::kMinCapacity;
+            while (pow2 < value) {
+                pow2 <<= 1;
+            }
+            return pow2;
+        }
+    }
+
+    core::String ShmRingSink::defaultPath(core::StringView appId)
+    {
+        core::String path("/dev/shm/lightap-");
+        path.append(appId.data(), appId.size() > 4 ? 4 : appId.size());
+        path += "-" + std::to_string(::getpid()) + ".ring";
+        return path;
+    }
+
+    core::String ShmRingSink::collectPath(core::StringView directory, core::StringView appId)
+    {
+        core::String path(directory.data(), directory.size());
+        path += "/";
+        path += kCollectPrefix;
+        path.append(appId.data(), appId.size() > 4 ? 4 : appId.size());
+        path += "-" + std::to_string(::getpid()) + ".ring";
+        return path;
+    }
+
+    ShmRingSink::ShmRingSink(
+        core::StringView path,
+        core::Size capacity,
+        LogLevel minLevel,
+        core::StringView appId,
+        core::Bool keepOnExit,
+        core::Bool collected
+    ) noexcept
+        : m_path(path.data(), path.size())
+        , m_capacity(roundUpPow2(capacity))
+        , m_enabled(true)
+        , m_withThreadId(false)
+        , m_keepOnExit(keepOnExit || collected)
+        , m_collected(collected)
+        , m_minLevel(minLevel)
+        , m_map(nullptr)
+        , m_data(nullptr)
+        , m_head(nullptr)
+        , m_tail(nullptr)
+        , m_dropped(nullptr)
+        , m_flags(nullptr)
+    {
+        const core::Size total = kHeaderSize + m_capacity;
+
+        // A ring left behind by an earlier process with this name is replaced
+        int fd = ::open(m_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            fprintf(stderr, "[LightAP] ShmRingSink: Cannot open %s: %s\n", m_path.c_str(), std::strerror(errno));
+            return;
+        }
+
+        // Reserve the tmpfs pages up front: a full /dev/shm fails here, not as SIGBUS on a store
+        const int err = ::posix_fallocate(fd, 0, static_cast<off_t>(total));
+        void* map = (err == 0)
+            ? ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+            : MAP_FAILED;
+        ::close(fd);    // The mapping keeps the file referenced
+        if (map == MAP_FAILED) {
+            fprintf(stderr, "[LightAP] ShmRingSink: Cannot map %zu bytes of %s: %s\n",
+                    total, m_path.c_str(), std::strerror(err != 0 ? err : errno));
+            ::unlink(m_path.c_str());
+            return;
+        }
+        m_map = static_cast<core::UInt8*>(map);
+        m_data = m_map + kHeaderSize;
+
+        // Ring header, see doc/design/ShmRing_Format.md
+        char appIdBytes[4] = { 0, 0, 0, 0 };
+        std::memcpy(appIdBytes, appId.data(), appId.size() > 4 ? 4 : appId.size());
+        const core::UInt16 headerSize = static_cast<core::UInt16>(kHeaderSize);
+        const core::UInt64 capacity64 = m_capacity;
+        const core::UInt32 pid = static_cast<core::UInt32>(::getpid());
+        const core::UInt64 created = LogClock::now();
+        const NumberFormat::FloatConfig floatConfig = NumberFormat::getFloatConfig();
+
+        core::Int32 utcOffset = 0;
+        struct tm tmInfo;
+        const time_t now = ::time(nullptr);
+        if (::localtime_r(&now, &tmInfo) != nullptr) {
+            utcOffset = static_cast<core::Int32>(tmInfo.tm_gmtoff);
+        }
+
+        core::UInt8* h = m_map;
+        h[4] = kFormatVersion;
+        h[5] = (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) ? 1 : 2;
+        std::memcpy(h + 6, &headerSize, sizeof(headerSize));
+        std::memcpy(h + 8, &capacity64, sizeof(capacity64));
+        std::memcpy(h + 16, &pid, sizeof(pid));
+        std::memcpy(h + 20, appIdBytes, sizeof(appIdBytes));
+        std::memcpy(h + 24, &created, sizeof(created));
+        h[32] = static_cast<core::UInt8>(TimestampFormat::getPrecision());
+        h[33] = static_cast<core::UInt8>(floatConfig.format);
+        h[34] = static_cast<core::UInt8>(floatConfig.floatPrecision);
+        h[35] = static_cast<core::UInt8>(floatConfig.doublePrecision);
+        std::memcpy(h + 36, &utcOffset, sizeof(utcOffset));
+        m_head = new (h + kHeadOffset) std::atomic<core::UInt64>(0);
+        m_tail = new (h + kTailOffset) std::atomic<core::UInt64>(0);
+        m_dropped = new (h + kDroppedOffset) std::atomic<core::UInt64>(0);
+        m_flags = new (h + kFlagsOffset) std::atomic<core::UInt32>(collected ? kRingCollected : 0);
+
+        // Magic last: a tool never sees a half written header as valid
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(h, "LAPR", 4);
+    }
+
+    ShmRingSink::~ShmRingSink() noexcept
+    {
+        if (m_map != nullptr) {
+            // The collector drains what is left, then removes the file; a fork() child's copy does not close it
+            core::UInt32 owner = 0;
+            std::memcpy(&owner, m_map + 16, sizeof(owner));
+            if (owner == static_cast<core::UInt32>(::getpid())) {
+                m_flags->fetch_or(kRingClosed, std::memory_order_release);
+            }
+            ::munmap(m_map, kHeaderSize + m_capacity);
+            m_map = nullptr;
+            if (!m_keepOnExit) {
+                ::unlink(m_path.c_str());
+            }
+        }
+    }
+
+    void ShmRingSink::write(
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        core::StringView message
+    ) noexcept
+    {
+        append(RecordKind::kText, timestamp, threadId, level, contextId, 0, message.data(), message.size());
+    }
+
+    core::Bool ShmRingSink::writeEmergency(
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        core::StringView message
+    ) noexcept
+    {
+        append(RecordKind::kText, timestamp, threadId, level, contextId, 0, message.data(), message.size());
+        return isEnabled();
+    }
+
+    core::Bool ShmRingSink::writeModeled(
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        const ModeledRecord& record
+    ) noexcept
+    {
+        append(RecordKind::kModeled, timestamp, threadId, level, contextId, record.getMessageId(),
+               record.getPayload(), record.getPayloadSize());
+        return true;
+    }
+
+    core::Bool ShmRingSink::writeArgs(
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        const core::UInt8* args,
+        core::Size size
+    ) noexcept
+    {
+        append(RecordKind::kArgs, timestamp, threadId, level, contextId, 0, args, size);
+        return true;
+    }
+
+    void ShmRingSink::append(
+        RecordKind kind,
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType level,
+        core::StringView contextId,
+        core::UInt32 messageId,
+        const void* payload,
+        core::Size size
+    ) noexcept
+    {
+        if (!isEnabled()) {
+            return;
+        }
+
+        // A record never takes more than a quarter of the ring: longer payloads are cut
+        const core::Size contextLen = contextId.size() > 255 ? 255 : contextId.size();
+        const core::Size maxPayload = m_capacity / 4 - kRecordHeaderSize - contextLen;
+        if (size > maxPayload) {
+            size = maxPayload;
+        }
+        const core::UInt32 recordSize = static_cast<core::UInt32>(kRecordHeaderSize + contextLen + size);
+        const core::UInt64 reserved = (recordSize + kRecordAlign - 1) & ~static_cast<core::UInt64>(kRecordAlign - 1);
+
+        core::UInt64 pos;
+        if (m_collected) {
+            // Never past what the collector has consumed: a full ring drops the record instead.
+            // Acquire on the tail: the collector has finished reading the space it released
+            pos = m_head->load(std::memory_order_relaxed);
+            do {
+                if (pos + reserved - m_tail->load(std::memory_order_acquire) > m_capacity) {
+                    m_dropped->fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            } while (!m_head->compare_exchange_weak(pos, pos + reserved, std::memory_order_relaxed));
+        } else {
+            // Producers only contend on this one atomic add
+            pos = m_head->fetch_add(reserved, std::memory_order_relaxed);
+        }
+
+        // [size:4][commit:4][timestamp:8][tid:4][messageId:4][level:1][kind:1][contextLen:1][flags:1][pad:4]
+        core::UInt8 header[kRecordHeaderSize];
+        const core::UInt32 uncommitted = 0;
+        std::memcpy(header, &recordSize, 4);
+        std::memcpy(header + 4, &uncommitted, 4);
+        std::memcpy(header + 8, &timestamp, 8);
+        std::memcpy(header + 16, &threadId, 4);
+        std::memcpy(header + 20, &messageId, 4);
+        header[24] = level;
+        header[25] = static_cast<core::UInt8>(kind);
+        header[26] = static_cast<core::UInt8>(contextLen);
+        header[27] = m_withThreadId ? kRecordHasThreadId : 0;
+        std::memset(header + 28, 0, 4);
+
+        // Size and commit share the first 8 bytes, which never straddle the ring end
+        core::UInt32* commit = reinterpret_cast<core::UInt32*>(m_data + ((pos + 4) & (m_capacity - 1)));
+        __atomic_store_n(commit, uncommitted, __ATOMIC_RELAXED);
+        copyIn(pos, header, kRecordHeaderSize);
+        copyIn(pos + kRecordHeaderSize, contextId.data(), contextLen);
+        copyIn(pos + kRecordHeaderSize + contextLen, payload, size);
+        __atomic_store_n(commit, commitTag(pos), __ATOMIC_RELEASE);
+    }
+
+    void ShmRingSink::copyIn(core::UInt64 pos, const void* src, core::Size len) noexcept
+    {
+        if (len == 0) {
+            return;
+        }
+        const core::Size offset = static_cast<core::Size>(pos & (m_capacity - 1));
+        const core::Size first = len < m_capacity - offset ? len : m_capacity - offset;
+        std::memcpy(m_data + offset, src, first);
+        if (first < len) {
+            std::memcpy(m_data, static_cast<const core::UInt8*>(src) + first, len - first);
+        }
+    }
+
+    void ShmRingSink::flush() noexcept
+    {
+        // Nothing to do: records are in shared memory as soon as they are committed
+    }
+
+    core::Bool ShmRingSink::shouldLog(LogLevel level) const noexcept
+    {
+        if (!isEnabled()) {
+            return false;
+        }
+
+        // Lower numeric value = higher priority
+        using LevelType = typename std::underlying_type<LogLevel>::type;
+        return static_cast<LevelType>(level) <= static_cast<LevelType>(m_minLevel);
+    }
+
+} // namespace log
+} // namespace lap
@@ -8,13 +8,181 @@
 #include "CSinkManager.hpp"
 #include "CLogStream.hpp"
 #include "CLogger.hpp"
-#include <lap/core/CTime.hpp>
+#include "CArgEncoding.hpp"
+#include "CModeledMessage.hpp"
 #include <lap/core/CAlgorithm.hpp>
+#include <chrono>
+#include <cstdio>
+#include <new>
+#include <thread>
+#include <unistd.h>
 
 namespace lap
 {
 namespace log
 {
+    namespace
+    {
+        /**
+         * @brief Per-thread buffer deferred records are rendered into
+         * @details Allocated on first use at the record hard cap, in practice only
+         *          by the async worker (or by producers when writing synchronously)
+         */
+        struct RenderBuffer
+        {
+            core::Char*     text{ nullptr };
+            core::Size      size{ 0 };
+            
+            ~RenderBuffer() noexcept    { delete[] text; }
+        };
+        
+        thread_local RenderBuffer t_renderBuffer;
+        
+        // Deferred records rendered from a signal handler are cut at this size (stack buffer)
+        constexpr core::Size kEmergencyRenderSize = 4096;
+    }
+    
+    /**
+     * @brief Reader slot of SinkManager read-side sections, one cache line per thread
+     * @details Slots live in a process-wide list shared by all managers, are never freed
+     *          and are reused after their thread exited. epoch is 0 outside a read-side
+     *          section, otherwise the global epoch seen when the outermost section began.
+     */
+    struct alignas(64) SinkReader
+    {
+        std::atomic<core::UInt64>   epoch{ 0 };
+        std::atomic<core::Bool>     inUse{ true };
+        core::UInt32                depth{ 0 };         ///< Nesting, owner thread only
+        SinkReader*                 next{ nullptr };
+    };
+    
+    namespace
+    {
+        std::atomic<core::UInt64>   s_epoch{ 1 };
+        std::atomic<SinkReader*>    s_readers{ nullptr };
+        
+        /**
+         * @brief Per-thread reader slot cache, releases the slot at thread exit
+         */
+        struct ReaderSlot
+        {
+            SinkReader*             reader{ nullptr };
+            core::Bool              exited{ false };
+            
+            ~ReaderSlot() noexcept
+            {
+                if (reader) {
+                    reader->inUse.store(false, std::memory_order_release);
+                    reader = nullptr;
+                }
+                exited = true;
+            }
+        };
+        
+        thread_local ReaderSlot t_readerSlot;
+        
+        /**
+         * @brief This thread's reader slot, claimed on first use
+         * @return nullptr if none could be allocated or the thread is exiting
+         */
+        SinkReader* acquireReader() noexcept
+        {
+            ReaderSlot& slot = t_readerSlot;
+            if (slot.reader || slot.exited) {
+                return slot.reader;
+            }
+            
+            // Reuse a slot released by an exited thread, else append a new one
+            for (SinkReader* reader = s_readers.load(std::memory_order_acquire); reader; reader = reader->next) {
+                core::Bool free = false;
+                if (!reader->inUse.load(std::memory_order_relaxed)
+                    && reader->inUse.compare_exchange_strong(free, true, std::memory_order_acquire)) {
+                    slot.reader = reader;
+                    return reader;
+                }
+            }
+            
+            SinkReader* reader = new (std::nothrow) SinkReader();
+            if (!reader) {
+                return nullptr;
+            }
+            reader->next = s_readers.load(std::memory_order_relaxed);
+            while (!s_readers.compare_exchange_weak(reader->next, reader,
+                                                    std::memory_order_release, std::memory_order_relaxed)) {
+            }
+            slot.reader = reader;
+            return reader;
+        }
+    }
+    
+    SinkManager::ReadGuard::ReadGuard(const SinkManager& manager) noexcept
+        : m_manager(manager)
+        , m_reader(acquireReader())
+    {
+        if (m_reader) {
+            // Inner sections are covered by the outermost one's epoch
+            if (m_reader->depth++ == 0) {
+                m_reader->epoch.store(s_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+            }
+        } else {
+            m_manager.m_pinnedReaders.fetch_add(1, std::memory_order_seq_cst);
+        }
+        m_list = m_manager.m_snapshot.load(std::memory_order_seq_cst);
+    }
+    
+    SinkManager::ReadGuard::~ReadGuard() noexcept
+    {
+        if (m_reader) {
+            if (--m_reader->depth == 0) {
+                m_reader->epoch.store(0, std::memory_order_release);
+            }
+        } else {
+            m_manager.m_pinnedReaders.fetch_sub(1, std::memory_order_release);
+        }
+    }
+    
+    SinkManager::PinGuard::PinGuard(const SinkManager& manager) noexcept
+        : m_manager(manager)
+    {
+        m_manager.m_pinnedReaders.fetch_add(1, std::memory_order_seq_cst);
+        m_list = m_manager.m_snapshot.load(std::memory_order_seq_cst);
+    }
+    
+    SinkManager::PinGuard::~PinGuard() noexcept
+    {
+        m_manager.m_pinnedReaders.fetch_sub(1, std::memory_order_release);
+    }
+    
+    SinkManager::SinkManager() noexcept
+        : m_snapshot(new SinkList())
+        , m_globalMinLevel(LogLevel::kVerbose) // Default: allow all levels (most permissive)
+        , m_maxLevel(static_cast<LogLevelType>(LogLevel::kOff))
+    {
+    }
+    
+    SinkManager::~SinkManager() noexcept
+    {
+        if (m_flusher.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(m_flusherMutex);
+                m_flusherStop = true;
+            }
+            m_flusherCv.notify_all();
+            // A fork() child has the handle but not the thread
+            if (::getpid() == m_flusherPid) {
+                m_flusher.join();
+            } else {
+                m_flusher.detach();
+            }
+        }
+        
+        // No readers may be active when the manager itself goes away
+        for (const SinkList* list : m_retired) {
+            delete list;
+        }
+        delete m_snapshot.load(std::memory_order_acquire);
+    }
+    
     void SinkManager::addSink(core::UniqueHandle<ISink> sink) noexcept
     {
         if (!sink) {
@@ -22,106 +190,386 @@ namespace log
         }
         
         core::LockGuard lock(m_mutex);
-        m_sinks.push_back(core::Move(sink));
+        
+        try {
+            auto slot = std::make_shared<SinkSlot>();
+            if (!sink->isThreadSafe()) {
+                slot->serial = core::MakeUnique<core::Mutex>();
+            }
+            slot->flushIntervalMs = sink->getFlushIntervalMs();
+            sink->setChangeListener(&SinkManager::onSinkChanged, this);
+            slot->sink = core::Move(sink);
+            
+            auto* list = new SinkList(*m_snapshot.load(std::memory_order_relaxed));
+            list->push_back(core::Move(slot));
+            publish(list);
+            updateMaxLevel();
+            updateFlushTimer();
+        } catch (const std::exception& e) {
+            fprintf(stderr, "[LightAP] SinkManager: addSink failed: %s\n", e.what());
+        }
     }
     
     core::Bool SinkManager::removeSink(core::StringView name) noexcept
     {
         core::LockGuard lock(m_mutex);
         
-        auto it = core::FindIf(m_sinks.begin(), m_sinks.end(),
-            [name](const core::UniqueHandle<ISink>& sink) {
-                return sink && sink->getName() == name;
+        const SinkList& current = *m_snapshot.load(std::memory_order_relaxed);
+        auto it = core::FindIf(current.begin(), current.end(),
+            [name](const std::shared_ptr<SinkSlot>& slot) {
+                return slot->sink && slot->sink->getName() == name;
             });
         
-        if (it != m_sinks.end()) {
-            m_sinks.erase(it);
-            return true;
+        if (it == current.end()) {
+            return false;
+        }
+        
+        try {
+            auto* list = new SinkList(current);
+            list->erase(list->begin() + (it - current.begin()));
+            publish(list);
+            updateMaxLevel();
+            updateFlushTimer();
+        } catch (const std::exception& e) {
+            fprintf(stderr, "[LightAP] SinkManager: removeSink failed: %s\n", e.what());
+            return false;
         }
         
-        return false;
+        return true;
     }
     
     ISink* SinkManager::getSink(core::StringView name) noexcept
     {
-        core::LockGuard lock(m_mutex);
+        ReadGuard guard(*this);
         
-        auto it = core::FindIf(m_sinks.begin(), m_sinks.end(),
-            [name](const core::UniqueHandle<ISink>& sink) {
-                return sink && sink->getName() == name;
-            });
+        for (const auto& slot : guard.sinks()) {
+            if (slot->sink && slot->sink->getName() == name) {
+                return slot->sink.get();
+            }
+        }
         
-        return (it != m_sinks.end()) ? it->get() : nullptr;
+        return nullptr;
+    }
+    
+    core::Size SinkManager::getSinkCount() const noexcept
+    {
+        ReadGuard guard(*this);
+        return guard.sinks().size();
     }
     
     void SinkManager::write(const LogStream& stream) noexcept
     {
-        core::LockGuard lock(m_mutex);
+        // Timestamp was taken when the record was created, not at dispatch
+        core::UInt64 timestamp = stream.getTimestamp();
+        core::UInt32 threadId = stream.getThreadId();
+        
+        // Get direct references (zero-copy from LogStream buffer)
+        core::StringView contextId = stream.getLogger().getContextId();
+        
+        ReadGuard guard(*this);
+        if (stream.getFormat() == RecordFormat::kArgs) {
+            dispatchArgs(guard.sinks(), timestamp, threadId, stream.getLevel(), contextId,
+                         reinterpret_cast<const core::UInt8*>(stream.getBuffer()), stream.getBufferSize());
+            return;
+        }
+        
+        core::StringView message(stream.getBuffer(), stream.getBufferSize());
+        dispatch(guard.sinks(), timestamp, threadId, stream.getLevel(), contextId, message);
+    }
+    
+    void SinkManager::write(const LogEntry& entry) noexcept
+    {
+        if (entry.format == RecordFormat::kModeled) {
+            // Rebuilt on the worker's stack, then dispatched as if written synchronously
+            core::StringView packed = entry.getMessage();
+            const core::UInt8* bytes = reinterpret_cast<const core::UInt8*>(packed.data());
+            core::UInt32 messageId;
+            if (ModeledRecord::unpackId(bytes, packed.size(), messageId)) {
+                ModeledRecord record(entry.timestamp, entry.threadId, messageId, entry.level,
+                                     bytes + sizeof(messageId), packed.size() - sizeof(messageId));
+                write(record, entry.getContextId());
+            }
+            return;
+        }
+        
+        ReadGuard guard(*this);
         
-        // Convert LogLevelType to LogLevel
-        LogLevel level;
-        LogLevelType levelValue = stream.getLevel();
+        // Entry payload is referenced in place (zero-copy from the async ring)
+        if (entry.format == RecordFormat::kArgs) {
+            core::StringView payload = entry.getMessage();
+            dispatchArgs(guard.sinks(), entry.timestamp, entry.threadId, entry.level, entry.getContextId(),
+                         reinterpret_cast<const core::UInt8*>(payload.data()), payload.size());
+            return;
+        }
+        dispatch(guard.sinks(), entry.timestamp, entry.threadId, entry.level, entry.getContextId(), entry.getMessage());
+    }
+    
+    void SinkManager::write(const ModeledRecord& record, core::StringView contextId) noexcept
+    {
+        LogLevel level = toLogLevel(record.getLevel());
+        if (level > m_globalMinLevel.load(std::memory_order_relaxed)) {
+            return;
+        }
+        
+        ReadGuard guard(*this);
+        
+        for (const auto& slot : guard.sinks()) {
+            ISink* sink = slot->sink.get();
+            if (sink && sink->isEnabled() && sink->shouldLog(level)) {
+                if (slot->serial) {
+                    core::LockGuard lock(*slot->serial);
+                    if (!sink->writeModeled(record.getTimestamp(), record.getThreadId(), record.getLevel(), contextId, record)) {
+                        sink->write(record.getTimestamp(), record.getThreadId(), record.getLevel(), contextId, record.getText());
+                    }
+                } else {
+                    if (!sink->writeModeled(record.getTimestamp(), record.getThreadId(), record.getLevel(), contextId, record)) {
+                        sink->write(record.getTimestamp(), record.getThreadId(), record.getLevel(), contextId, record.getText());
+                    }
+                }
+            }
+        }
+    }
+    
+    LogLevel SinkManager::toLogLevel(LogLevelType levelValue) noexcept
+    {
         switch (levelValue) {
-            case 0x01:  level = LogLevel::kFatal; break;    // Fatal
-            case 0x02:  level = LogLevel::kError; break;    // Error
-            case 0x03:  level = LogLevel::kWarn; break;     // Warn
-            case 0x04:  level = LogLevel::kInfo; break;     // Info
-            case 0x05:  level = LogLevel::kDebug; break;    // Debug
-            case 0x06:  level = LogLevel::kVerbose; break;  // Verbose
-            default:    level = LogLevel::kVerbose; break;
+            case 0x01:  return LogLevel::kFatal;    // Fatal
+            case 0x02:  return LogLevel::kError;    // Error
+            case 0x03:  return LogLevel::kWarn;     // Warn
+            case 0x04:  return LogLevel::kInfo;     // Info
+            case 0x05:  return LogLevel::kDebug;    // Debug
+            case 0x06:  return LogLevel::kVerbose;  // Verbose
+            default:    return LogLevel::kVerbose;
         }
+    }
+    
+    void SinkManager::dispatch(
+        const SinkList& sinks,
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType levelValue,
+        core::StringView contextId,
+        core::StringView message
+    ) noexcept
+    {
+        LogLevel level = toLogLevel(levelValue);
         
         // Global level filter - early return if below global minimum
-        if (level > m_globalMinLevel) {
+        if (level > m_globalMinLevel.load(std::memory_order_relaxed)) {
             return;
         }
         
-        // Get timestamp
-        auto now = core::Time::nowSystem();
-        core::UInt64 timestamp = core::Time::toUnixMillis(now) * 1000;  // Convert to microseconds
-        core::UInt32 threadId = 0;  // TODO: Get actual thread ID
+        // Write to all enabled sinks - pass the caller's buffer directly (zero-copy)
+        // Each sink is responsible for its own formatting if needed
+        for (const auto& slot : sinks) {
+            ISink* sink = slot->sink.get();
+            if (sink && sink->isEnabled() && sink->shouldLog(level)) {
+                if (slot->serial) {
+                    core::LockGuard lock(*slot->serial);
+                    sink->write(timestamp, threadId, levelValue, contextId, message);
+                } else {
+                    sink->write(timestamp, threadId, levelValue, contextId, message);
+                }
+            }
+        }
+    }
+    
+    void SinkManager::dispatchArgs(
+        const SinkList& sinks,
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType levelValue,
+        core::StringView contextId,
+        const core::UInt8* args,
+        core::Size size
+    ) noexcept
+    {
+        LogLevel level = toLogLevel(levelValue);
+        if (level > m_globalMinLevel.load(std::memory_order_relaxed)) {
+            return;
+        }
         
-        // Get direct references (zero-copy from LogStream buffer)
-        core::StringView contextId = stream.getLogger().getContextId();
-        core::StringView message(stream.getBuffer(), stream.getBufferSize());
+        // Rendered at most once per record, on the first sink that wants text
+        core::StringView text;
+        core::Bool rendered = false;
+        core::Char fallback[LogStream::MAX_LOG_SIZE];
+        auto render = [&]() noexcept -> core::StringView {
+            if (!rendered) {
+                auto& buffer = t_renderBuffer;
+                const core::Size capacity = LogStream::GetMaxMessageSize();
+                if (buffer.size < capacity) {
+                    core::Char* grown = new (std::nothrow) core::Char[capacity];
+                    if (grown) {
+                        delete[] buffer.text;
+                        buffer.text = grown;
+                        buffer.size = capacity;
+                    }
+                }
+                core::Char* out = buffer.size >= capacity ? buffer.text : fallback;
+                const core::Size room = buffer.size >= capacity ? capacity : sizeof(fallback);
+                text = core::StringView(out, ArgFormat::formatArgs(out, room, args, size));
+                rendered = true;
+            }
+            return text;
+        };
         
-        // Write to all enabled sinks - pass LogStream buffer directly (zero-copy)
-        // Each sink is responsible for its own formatting if needed
-        for (auto& sink : m_sinks) {
+        for (const auto& slot : sinks) {
+            ISink* sink = slot->sink.get();
             if (sink && sink->isEnabled() && sink->shouldLog(level)) {
-                sink->write(timestamp, threadId, levelValue, contextId, message);
+                if (slot->serial) {
+                    core::LockGuard lock(*slot->serial);
+                    if (!sink->writeArgs(timestamp, threadId, levelValue, contextId, args, size)) {
+                        sink->write(timestamp, threadId, levelValue, contextId, render());
+                    }
+                } else {
+                    if (!sink->writeArgs(timestamp, threadId, levelValue, contextId, args, size)) {
+                        sink->write(timestamp, threadId, levelValue, contextId, render());
+                    }
+                }
+            }
+        }
+    }
+    
+    void SinkManager::registerContext(
+        core::StringView contextId,
+        core::StringView contextDesc,
+        LogLevel level,
+        TraceStatus status
+    ) noexcept
+    {
+        ReadGuard guard(*this);
+        
+        for (const auto& slot : guard.sinks()) {
+            ISink* sink = slot->sink.get();
+            if (!sink) {
+                continue;
+            }
+            if (slot->serial) {
+                core::LockGuard lock(*slot->serial);
+                sink->registerContext(contextId, contextDesc, level, status);
+            } else {
+                sink->registerContext(contextId, contextDesc, level, status);
             }
         }
     }
     
     void SinkManager::flushAll() noexcept
     {
-        core::LockGuard lock(m_mutex);
+        ReadGuard guard(*this);
         
-        for (auto& sink : m_sinks) {
+        for (const auto& slot : guard.sinks()) {
+            ISink* sink = slot->sink.get();
             if (sink && sink->isEnabled()) {
-                sink->flush();
+                if (slot->serial) {
+                    core::LockGuard lock(*slot->serial);
+                    sink->flush();
+                } else {
+                    sink->flush();
+                }
+            }
+        }
+    }
+    
+    void SinkManager::writeEmergency(
+        core::UInt64 timestamp,
+        core::UInt32 threadId,
+        LogLevelType levelValue,
+        core::StringView contextId,
+        core::StringView message,
+        RecordFormat format,
+        core::Bool crashing
+    ) noexcept
+    {
+        LogLevel level = toLogLevel(levelValue);
+        if (level > m_globalMinLevel.load(std::memory_order_relaxed)) {
+            return;
+        }
+        
+        // No thread-local slot and no blocking sink lock, the interrupted thread may
+        // be inside either; the pin keeps removeSink() from reclaiming the snapshot
+        PinGuard guard(*this);
+        const SinkList& sinks = guard.sinks();
+        
+        core::Char text[kEmergencyRenderSize];
+        if (format == RecordFormat::kArgs) {
+            message = core::StringView(text, ArgFormat::formatArgs(text, sizeof(text),
+                reinterpret_cast<const core::UInt8*>(message.data()), message.size()));
+        } else if (format == RecordFormat::kModeled) {
+            // Text rendering only, the same as a text sink gets
+            const core::UInt8* bytes = reinterpret_cast<const core::UInt8*>(message.data());
+            core::UInt32 messageId;
+            if (!ModeledRecord::unpackId(bytes, message.size(), messageId)) {
+                return;
+            }
+            ModeledRecord record(timestamp, threadId, messageId, levelValue,
+                                 bytes + sizeof(messageId), message.size() - sizeof(messageId));
+            const core::StringView rendered = record.getText();
+            std::memcpy(text, rendered.data(), rendered.size());
+            message = core::StringView(text, rendered.size());
+        }
+        
+        for (const auto& slot : sinks) {
+            ISink* sink = slot->sink.get();
+            if (!sink || !sink->isEnabled() || !sink->shouldLog(level)) {
+                continue;
+            }
+            if (crashing || !slot->serial) {
+                sink->writeEmergency(timestamp, threadId, levelValue, contextId, message);
+            } else if (slot->serial->try_lock()) {
+                sink->writeEmergency(timestamp, threadId, levelValue, contextId, message);
+                slot->serial->unlock();
+            } else {
+                // Another thread (or the interrupted one) owns the batch
+                sink->writeEmergencyUnbatched(timestamp, threadId, levelValue, contextId, message);
             }
         }
     }
     
+    void SinkManager::flushEmergency(core::Bool crashing) noexcept
+    {
+        PinGuard guard(*this);
+        const SinkList& sinks = guard.sinks();
+        
+        for (const auto& slot : sinks) {
+            ISink* sink = slot->sink.get();
+            if (!sink || !sink->isEnabled()) {
+                continue;
+            }
+            if (crashing || !slot->serial) {
+                sink->flushEmergency();
+            } else if (slot->serial->try_lock()) {
+                sink->flushEmergency();
+                slot->serial->unlock();
+            }
+            // Lock held: the batch is left to its owner, who writes it out later
+        }
+    }
+    
     void SinkManager::clearAll() noexcept
     {
         core::LockGuard lock(m_mutex);
-        m_sinks.clear();
+        
+        try {
+            publish(new SinkList());
+            updateMaxLevel();
+            updateFlushTimer();
+        } catch (const std::exception& e) {
+            fprintf(stderr, "[LightAP] SinkManager: clearAll failed: %s\n", e.what());
+        }
     }
     
     core::Bool SinkManager::shouldLog(LogLevel level) const noexcept
     {
-        core::LockGuard lock(m_mutex);
-        
         // Check global minimum level first
-        if (level > m_globalMinLevel) {
+        if (level > m_globalMinLevel.load(std::memory_order_relaxed)) {
             return false;
         }
         
+        ReadGuard guard(*this);
+        
         // Check if any sink will output this level
-        for (const auto& sink : m_sinks) {
+        for (const auto& slot : guard.sinks()) {
+            const ISink* sink = slot->sink.get();
             if (sink && sink->isEnabled() && sink->shouldLog(level)) {
                 return true;
             }
@@ -130,5 +578,168 @@ namespace log
         return false;
     }
     
+    void SinkManager::setGlobalMinLevel(LogLevel level) noexcept
+    {
+        core::LockGuard lock(m_mutex);
+        m_globalMinLevel.store(level, std::memory_order_relaxed);
+        updateMaxLevel();
+    }
+    
+    void SinkManager::refreshLevels() noexcept
+    {
+        core::LockGuard lock(m_mutex);
+        updateMaxLevel();
+    }
+    
+    void SinkManager::onSinkChanged(void* context) noexcept
+    {
+        auto* self = static_cast<SinkManager*>(context);
+        core::LockGuard lock(self->m_mutex);
+        self->updateMaxLevel();
+    }
+    
+    void SinkManager::setLevelListener(LevelListener listener, void* context) noexcept
+    {
+        core::LockGuard lock(m_mutex);
+        m_levelListener = listener;
+        m_levelListenerContext = context;
+    }
+    
+    void SinkManager::updateMaxLevel() noexcept
+    {
+        // Most permissive level accepted by any enabled sink
+        LogLevelType maxLevel = static_cast<LogLevelType>(LogLevel::kOff);
+        for (const auto& slot : *m_snapshot.load(std::memory_order_relaxed)) {
+            const ISink* sink = slot->sink.get();
+            if (!sink || !sink->isEnabled()) {
+                continue;
+            }
+            for (LogLevelType level = static_cast<LogLevelType>(LogLevel::kVerbose); level > maxLevel; --level) {
+                if (sink->shouldLog(static_cast<LogLevel>(level))) {
+                    maxLevel = level;
+                    break;
+                }
+            }
+        }
+        
+        const LogLevelType globalLevel = static_cast<LogLevelType>(m_globalMinLevel.load(std::memory_order_relaxed));
+        if (globalLevel < maxLevel) {
+            maxLevel = globalLevel;
+        }
+        
+        if (m_maxLevel.exchange(maxLevel, std::memory_order_relaxed) != maxLevel && m_levelListener) {
+            m_levelListener(m_levelListenerContext, static_cast<LogLevel>(maxLevel));
+        }
+    }
+    
+    void SinkManager::updateFlushTimer() noexcept
+    {
+        // A quarter of the shortest interval: records go out at most one tick late
+        core::UInt32 tick = 0;
+        for (const auto& slot : *m_snapshot.load(std::memory_order_relaxed)) {
+            if (slot->flushIntervalMs > 0) {
+                const core::UInt32 slotTick = slot->flushIntervalMs >= 4 ? slot->flushIntervalMs / 4 : 1;
+                if (tick == 0 || slotTick < tick) {
+                    tick = slotTick;
+                }
+            }
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(m_flusherMutex);
+            m_flushTickMs = tick;
+        }
+        m_flusherCv.notify_all();
+        
+        if (tick > 0 && !m_flusher.joinable()) {
+            try {
+                m_flusher = std::thread(&SinkManager::flusherLoop, this);
+                m_flusherPid = ::getpid();
+            } catch (const std::exception& e) {
+                fprintf(stderr, "[LightAP] SinkManager: flush timer not started (%s), batches age until the next write\n",
+                        e.what());
+            }
+        }
+    }
+    
+    void SinkManager::flusherLoop() noexcept
+    {
+        std::unique_lock<std::mutex> lock(m_flusherMutex);
+        while (!m_flusherStop) {
+            if (m_flushTickMs == 0) {
+                m_flusherCv.wait(lock);
+                continue;
+            }
+            const core::UInt32 tick = m_flushTickMs;
+            if (m_flusherCv.wait_for(lock, std::chrono::milliseconds(tick)) != std::cv_status::timeout) {
+                continue;   // Stop requested or tick changed
+            }
+            lock.unlock();
+            
+            {
+                ReadGuard guard(*this);
+                for (const auto& slot : guard.sinks()) {
+                    ISink* sink = slot->sink.get();
+                    if (slot->flushIntervalMs == 0 || !sink || !sink->isEnabled()) {
+                        continue;
+                    }
+                    if (slot->serial) {
+                        core::LockGuard serial(*slot->serial);
+                        sink->flushExpired(tick);
+                    } else {
+                        sink->flushExpired(tick);
+                    }
+                }
+            }
+            
+            lock.lock();
+        }
+    }
+    
+    void SinkManager::publish(SinkList* list) noexcept
+    {
+        const SinkList* previous = m_snapshot.exchange(list, std::memory_order_seq_cst);
+        
+        // A sink reconfiguring the manager from inside write() would wait for itself
+        const ReaderSlot& slot = t_readerSlot;
+        if (slot.reader && slot.reader->depth > 0) {
+            try {
+                m_retired.push_back(previous);
+            } catch (const std::exception& e) {
+                fprintf(stderr, "[LightAP] SinkManager: cannot retire sink list (%s), leaked\n", e.what());
+            }
+            return;
+        }
+        
+        // Removed sinks are destroyed (files closed) only after the last writer
+        // that could reference them returned
+        waitForReaders();
+        for (const SinkList* retired : m_retired) {
+            delete retired;
+        }
+        m_retired.clear();
+        delete previous;
+    }
+    
+    void SinkManager::waitForReaders() const noexcept
+    {
+        // Readers store their epoch before loading the snapshot, so one that still
+        // sees a replaced list shows an epoch older than target or is pinned
+        const core::UInt64 target = s_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+        
+        for (const SinkReader* reader = s_readers.load(std::memory_order_acquire); reader; reader = reader->next) {
+            for (;;) {
+                const core::UInt64 epoch = reader->epoch.load(std::memory_order_seq_cst);
+                if (epoch == 0 || epoch >= target) {
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+        while (m_pinnedReaders.load(std::memory_order_seq_cst) != 0) {
+            std::this_thread::yield();
+        }
+    }
+    
 } // namespace log
 } // namespace lap
@@ -0,0 +1,31 @@
+/**
+ * @file        CThreadId.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Cached kernel thread ID for log records
+ * @date        2026-10-16
+ */
+
+#include "CThreadId.hpp"
+#include <mutex>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace lap
+{
+namespace log
+{
+    core::UInt32 ThreadId::lookup() noexcept
+    {
+        // The forking thread keeps its thread_local in the child: drop the parent's TID there
+        static ::std::once_flag s_atforkOnce;
+        ::std::call_once( s_atforkOnce, []() {
+            ::pthread_atfork( nullptr, nullptr, []() { s_tid = 0; } );
+        } );
+
+        s_tid = static_cast< core::UInt32 >( ::syscall( SYS_gettid ) );
+        return s_tid;
+    }
+
+} // namespace log
+} // namespace lap
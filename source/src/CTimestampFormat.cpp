@@ -0,0 +1,180 @@
+/**
+ * @file        CTimestampFormat.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Cached wall clock formatting for sink line prefixes
+ * @date        2026-10-16
+ */
+
+#include "CTimestampFormat.hpp"
+#include <atomic>
+#include <cstring>
+#include <ctime>
+
+namespace lap
+{
+namespace log
+{
+    namespace
+    {
+        constexpr core::Size kSecondChars = 19;     // "YYYY-MM-DD HH:MM:SS"
+        constexpr core::Size kTimeOffset  = 11;     // "HH:MM:SS" starts after "YYYY-MM-DD "
+
+        ::std::atomic< core::UInt8 > s_precision{ static_cast< core::UInt8 >( TimestampPrecision::kMilli ) };
+
+        // Seconds east of UTC as of the last localtime_r(), read by the signal-safe formatters
+        ::std::atomic< core::Int32 > s_utcOffset{ 0 };
+
+        /**
+         * @brief Text of the last second formatted by this thread
+         */
+        struct SecondCache
+        {
+            time_t          second{ static_cast< time_t >( -1 ) };
+            core::Char      text[ kSecondChars ];
+        };
+
+        thread_local SecondCache t_secondCache;
+
+        inline void put2( core::Char* out, core::Int32 value ) noexcept
+        {
+            out[0] = static_cast< core::Char >( '0' + value / 10 );
+            out[1] = static_cast< core::Char >( '0' + value % 10 );
+        }
+
+        // Write '.' and the leading digits of the nanosecond part, return the characters written
+        inline core::Size putFraction( core::Char* out, core::UInt64 timestamp ) noexcept
+        {
+            const core::UInt32 digits = s_precision.load( ::std::memory_order_relaxed );
+            core::UInt32 fraction = static_cast< core::UInt32 >( timestamp % 1000000000ULL );
+            for ( core::UInt32 i = digits; i < 9; ++i ) {
+                fraction /= 10;
+            }
+
+            out[0] = '.';
+            for ( core::UInt32 i = digits; i > 0; --i ) {
+                out[i] = static_cast< core::Char >( '0' + fraction % 10 );
+                fraction /= 10;
+            }
+            return 1 + digits;
+        }
+
+        const core::Char* localSecond( core::UInt64 timestamp ) noexcept
+        {
+            SecondCache& cache = t_secondCache;
+            const time_t second = static_cast< time_t >( timestamp / 1000000000ULL );
+
+            if ( second != cache.second ) {
+                struct tm tmInfo;
+                if ( localtime_r( &second, &tmInfo ) == nullptr ) {
+                    ::std::memset( &tmInfo, 0, sizeof( tmInfo ) );
+                } else {
+                    s_utcOffset.store( static_cast< core::Int32 >( tmInfo.tm_gmtoff ), ::std::memory_order_relaxed );
+                }
+
+                // Four year digits cover 0000..9999
+                const core::Int32 year = ( tmInfo.tm_year + 1900 ) % 10000;
+                core::Char* p = cache.text;
+                put2( p, year / 100 );
+                put2( p + 2, year % 100 );
+                p[4] = '-';
+                put2( p + 5, tmInfo.tm_mon + 1 );
+                p[7] = '-';
+                put2( p + 8, tmInfo.tm_mday );
+                p[10] = ' ';
+                put2( p + 11, tmInfo.tm_hour );
+                p[13] = ':';
+                put2( p + 14, tmInfo.tm_min );
+                p[16] = ':';
+                put2( p + 17, tmInfo.tm_sec );
+
+                cache.second = second;
+            }
+
+            return cache.text;
+        }
+
+        // "YYYY-MM-DD HH:MM:SS" without localtime_r(): civil date from days since epoch
+        void civilSecond( core::Char* out, core::UInt64 timestamp ) noexcept
+        {
+            const core::Int64 local = static_cast< core::Int64 >( timestamp / 1000000000ULL ) +
+                                      s_utcOffset.load( ::std::memory_order_relaxed );
+            core::Int64 days        = local / 86400;
+            core::Int64 secOfDay    = local % 86400;
+            if ( secOfDay < 0 ) {
+                secOfDay += 86400;
+                --days;
+            }
+
+            // H. Hinnant, civil_from_days()
+            days += 719468;
+            const core::Int64 era   = ( days >= 0 ? days : days - 146096 ) / 146097;
+            const core::Int64 doe   = days - era * 146097;
+            const core::Int64 yoe   = ( doe - doe / 1460 + doe / 36524 - doe / 146096 ) / 365;
+            const core::Int64 doy   = doe - ( 365 * yoe + yoe / 4 - yoe / 100 );
+            const core::Int64 mp    = ( 5 * doy + 2 ) / 153;
+            const core::Int32 day   = static_cast< core::Int32 >( doy - ( 153 * mp + 2 ) / 5 + 1 );
+            const core::Int32 month = static_cast< core::Int32 >( mp < 10 ? mp + 3 : mp - 9 );
+            const core::Int32 year  = static_cast< core::Int32 >( ( yoe + era * 400 + ( month <= 2 ? 1 : 0 ) ) % 10000 );
+
+            put2( out, year / 100 );
+            put2( out + 2, year % 100 );
+            out[4] = '-';
+            put2( out + 5, month );
+            out[7] = '-';
+            put2( out + 8, day );
+            out[10] = ' ';
+            put2( out + 11, static_cast< core::Int32 >( secOfDay / 3600 ) );
+            out[13] = ':';
+            put2( out + 14, static_cast< core::Int32 >( secOfDay / 60 % 60 ) );
+            out[16] = ':';
+            put2( out + 17, static_cast< core::Int32 >( secOfDay % 60 ) );
+        }
+    }
+
+    core::Size TimestampFormat::formatDateTime( core::Char* out, core::UInt64 timestamp ) noexcept
+    {
+        ::std::memcpy( out, localSecond( timestamp ), kSecondChars );
+        return kSecondChars + putFraction( out + kSecondChars, timestamp );
+    }
+
+    core::Size TimestampFormat::formatTime( core::Char* out, core::UInt64 timestamp ) noexcept
+    {
+        ::std::memcpy( out, localSecond( timestamp ) + kTimeOffset, kSecondChars - kTimeOffset );
+        return kSecondChars - kTimeOffset + putFraction( out + kSecondChars - kTimeOffset, timestamp );
+    }
+
+    core::Size TimestampFormat::formatDateTimeSignalSafe( core::Char* out, core::UInt64 timestamp ) noexcept
+    {
+        civilSecond( out, timestamp );
+        return kSecondChars + putFraction( out + kSecondChars, timestamp );
+    }
+
+    core::Size TimestampFormat::formatTimeSignalSafe( core::Char* out, core::UInt64 timestamp ) noexcept
+    {
+        core::Char text[ kSecondChars ];
+        civilSecond( text, timestamp );
+        ::std::memcpy( out, text + kTimeOffset, kSecondChars - kTimeOffset );
+        return kSecondChars - kTimeOffset + putFraction( out + kSecondChars - kTimeOffset, timestamp );
+    }
+
+    void TimestampFormat::refreshUtcOffset() noexcept
+    {
+        struct tm tmInfo;
+        const time_t now = ::time( nullptr );
+        if ( localtime_r( &now, &tmInfo ) != nullptr ) {
+            s_utcOffset.store( static_cast< core::Int32 >( tmInfo.tm_gmtoff ), ::std::memory_order_relaxed );
+        }
+    }
+
+    void TimestampFormat::setPrecision( TimestampPrecision precision ) noexcept
+    {
+        s_precision.store( static_cast< core::UInt8 >( precision ), ::std::memory_order_relaxed );
+    }
+
+    TimestampPrecision TimestampFormat::getPrecision() noexcept
+    {
+        return static_cast< TimestampPrecision >( s_precision.load( ::std::memory_order_relaxed ) );
+    }
+
+} // namespace log
+} // namespace lap
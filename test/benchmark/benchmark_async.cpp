@@ -0,0 +1,203 @@
+/**
+ * @file        benchmark_async.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Async queue throughput benchmark
+ * @date        2026-10-16
+ *
+ * @details     Tests:
+ *              - Producer-side enqueue throughput (1/2/4/8 threads)
+ *              - End-to-end throughput into a file sink (enqueue + drain)
+ *              - Synchronous SinkManager baseline for comparison
+ *              Target from doc/TODO.md: 1M+ logs/sec
+ */
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <iomanip>
+#include <cstring>
+#include <new>
+#include <unistd.h>
+#include "CSinkManager.hpp"
+#include "CAsyncLogQueue.hpp"
+#include "CFileSink.hpp"
+#include <lap/core/CInitialization.hpp>
+
+using namespace lap::log;
+using namespace lap::core;
+using namespace std::chrono;
+
+static constexpr uint64_t TARGET_LOGS_PER_SEC = 1000000;
+
+void printHeader(const String& title) {
+    std::cout << "\n" << std::string(70, '=') << std::endl;
+    std::cout << "  " << title << std::endl;
+    std::cout << std::string(70, '=') << std::endl;
+}
+
+void printResult(const String& test, uint64_t count, double durationMs, uint64_t throughput) {
+    std::cout << std::left << std::setw(34) << test
+              << std::right << std::setw(9) << count << " logs"
+              << std::setw(10) << std::fixed << std::setprecision(2) << durationMs << " ms"
+              << std::setw(12) << throughput << " logs/sec"
+              << (throughput >= TARGET_LOGS_PER_SEC ? "  [>=1M]" : "")
+              << std::endl;
+}
+
+static uint64_t nowNanos() {
+    return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Run numThreads producers pushing logsPerThread records each
+ * @return {producer time, end-to-end time} in milliseconds
+ */
+static std::pair<double, double> runAsync(AsyncLogQueue& queue, int numThreads, int logsPerThread) {
+    const String message = "Async throughput benchmark message with moderate length";
+    std::vector<std::thread> threads;
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&]() {
+            ready++;
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            for (int i = 0; i < logsPerThread; ++i) {
+                queue.push(nowNanos(), 0, 0x04, "ASYN", message);
+            }
+        });
+    }
+
+    while (ready.load() < numThreads) {
+        std::this_thread::yield();
+    }
+
+    auto start = high_resolution_clock::now();
+    go = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto produced = high_resolution_clock::now();
+    queue.flush();
+    auto drained = high_resolution_clock::now();
+
+    return {
+        duration_cast<microseconds>(produced - start).count() / 1000.0,
+        duration_cast<microseconds>(drained - start).count() / 1000.0
+    };
+}
+
+/**
+ * @brief Producer-side throughput: what the logging threads observe
+ */
+void benchmarkProducerThroughput() {
+    printHeader("Async Producer Throughput (file sink, 256KB ring/thread)");
+
+    const char* testFile = "/tmp/lap_benchmark_async.log";
+    const std::vector<int> threadCounts = {1, 2, 4, 8};
+    const int LOGS_PER_THREAD = 250000;
+
+    for (int numThreads : threadCounts) {
+        ::unlink(testFile);
+
+        SinkManager manager;
+        manager.addSink(std::make_unique<FileSink>(testFile, 0, 1, LogLevel::kVerbose));
+
+        AsyncLogQueue queue(manager);
+        queue.start();
+
+        auto times = runAsync(queue, numThreads, LOGS_PER_THREAD);
+        uint64_t total = static_cast<uint64_t>(numThreads) * LOGS_PER_THREAD;
+
+        String name = std::to_string(numThreads) + " producer(s)";
+        printResult(name + " enqueue", total, times.first,
+                    static_cast<uint64_t>(total * 1000.0 / times.first));
+        printResult(name + " end-to-end", total, times.second,
+                    static_cast<uint64_t>(total * 1000.0 / times.second));
+
+        queue.stop();
+        auto stats = queue.getStats();
+        std::cout << "    enqueued=" << stats.enqueuedCount
+                  << " processed=" << stats.processedCount
+                  << " rejected=" << stats.rejectedCount << std::endl;
+    }
+
+    ::unlink(testFile);
+}
+
+/**
+ * @brief Synchronous baseline: every thread writes through SinkManager's mutex
+ */
+void benchmarkSyncBaseline() {
+    printHeader("Synchronous Baseline (SinkManager::write, file sink)");
+
+    const char* testFile = "/tmp/lap_benchmark_async_sync.log";
+    const std::vector<int> threadCounts = {1, 4, 8};
+    const int LOGS_PER_THREAD = 50000;
+    const String message = "Async throughput benchmark message with moderate length";
+
+    for (int numThreads : threadCounts) {
+        ::unlink(testFile);
+
+        SinkManager manager;
+        manager.addSink(std::make_unique<FileSink>(testFile, 0, 1, LogLevel::kVerbose));
+
+        // Reuse the LogEntry layout so both paths dispatch identical records
+        alignas(64) char storage[sizeof(LogEntry) + 128];
+        LogEntry* entry = new (storage) LogEntry();
+        entry->level = 0x04;
+        entry->contextIdLen = 4;
+        entry->messageLen = static_cast<UInt16>(message.size());
+        std::memcpy(storage + sizeof(LogEntry), "SYNC", 4);
+        std::memcpy(storage + sizeof(LogEntry) + 4, message.data(), message.size());
+
+        std::vector<std::thread> threads;
+        auto start = high_resolution_clock::now();
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&manager, entry]() {
+                for (int i = 0; i < LOGS_PER_THREAD; ++i) {
+                    manager.write(*entry);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto end = high_resolution_clock::now();
+
+        double ms = duration_cast<microseconds>(end - start).count() / 1000.0;
+        uint64_t total = static_cast<uint64_t>(numThreads) * LOGS_PER_THREAD;
+        printResult(std::to_string(numThreads) + " thread(s) sync", total, ms,
+                    static_cast<uint64_t>(total * 1000.0 / ms));
+    }
+
+    ::unlink(testFile);
+}
+
+int main() {
+    // Initialize Core module
+    auto initResult = Initialize();
+    if (!initResult.HasValue()) {
+        return 1;
+    }
+
+    std::cout << "\n╔════════════════════════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║           LightAP Log System - Async Queue Benchmark           ║" << std::endl;
+    std::cout << "╚════════════════════════════════════════════════════════════════╝" << std::endl;
+
+    benchmarkProducerThroughput();
+    benchmarkSyncBaseline();
+
+    std::cout << "\n" << std::string(70, '=') << std::endl;
+    std::cout << "  Benchmark completed successfully!" << std::endl;
+    std::cout << std::string(70, '=') << std::endl;
+
+    // Deinitialize Core module
+    Deinitialize();
+
+    return 0;
+}
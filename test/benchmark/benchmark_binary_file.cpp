@@ -0,0 +1,149 @@
+/**
+ * @file        benchmark_binary_file.cpp
+ * @brief       BinaryFileSink vs FileSink: bytes on disk and cost per record
+ * @date        2026-10-16
+ *
+ * @details     The same records written through a FileSink (unbuffered and with a
+ *              64 KiB batch buffer) and through a BinaryFileSink:
+ *              - text:     LogStream record formatted on the caller
+ *              - deferred: LogStream record captured as encoded arguments
+ *              - modeled:  Logger::Log( MsgId{}, name, value, ... )
+ *              Finally a short run goes to both sinks at once; decoding the binary
+ *              file must reproduce the text file:
+ *                tools/decode_binary_log.py /tmp/lap_bench_verify.lapb | diff - /tmp/lap_bench_verify.log
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <CLog.hpp>
+#include "CSinkManager.hpp"
+#include "CFileSink.hpp"
+#include "CBinaryFileSink.hpp"
+#include "CModeledMessage.hpp"
+#include <lap/core/CInitialization.hpp>
+
+using namespace lap::log;
+using namespace lap::core;
+using namespace std::chrono;
+
+static constexpr int ITERATIONS = 200000;
+static constexpr int VERIFY_RECORDS = 1000;
+
+namespace bench {
+    struct RequestDone : MessageId<2000, LogLevel::kWarn> {};
+}
+
+static Size fileSize(const std::string& path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 ? static_cast<Size>(st.st_size) : 0;
+}
+
+static void removeFiles(const std::string& path) {
+    std::remove(path.c_str());
+    std::remove((path + ".1").c_str());
+}
+
+static std::unique_ptr<ISink> makeSink(int kind, const std::string& path) {
+    switch (kind) {
+        case 0:  return std::make_unique<FileSink>(path, 0, 1, LogLevel::kVerbose, "BNCH");
+        case 1: {
+            FileBufferConfig buffered;
+            buffered.bufferSize = 64 * 1024;
+            return std::make_unique<FileSink>(path, 0, 1, LogLevel::kVerbose, "BNCH", buffered);
+        }
+        default: return std::make_unique<BinaryFileSink>(path, 0, 1, LogLevel::kVerbose, "BNCH");
+    }
+}
+
+int main() {
+    // Initialize Core module
+    auto initResult = Initialize();
+    if (!initResult.HasValue()) {
+        return 1;
+    }
+
+    auto& mgr = LogManager::getInstance();
+    mgr.initialize();
+    auto& sinkMgr = mgr.getSinkManager();
+    auto& logger = CreateLogger("BINF", "Binary File Test", LogLevel::kVerbose);
+
+    auto text = [&](int i) {
+        logger.LogWarn() << "Request " << static_cast<UInt32>(i) << " processed in "
+                         << static_cast<UInt32>(i % 500) << " us, status=OK";
+    };
+    auto modeled = [&](int i) {
+        logger.Log(bench::RequestDone{}, "id", static_cast<UInt32>(i), "us", static_cast<UInt32>(i % 500), "status", "OK");
+    };
+
+    const char* sinkNames[] = { "file (unbuffered)", "file (64 KiB buffer)", "binary (mmap)" };
+    const char* paths[] = { "/tmp/lap_bench_text.log", "/tmp/lap_bench_buffered.log", "/tmp/lap_bench_binary.lapb" };
+
+    std::cout << "\n=== Benchmark: BinaryFileSink vs FileSink (" << ITERATIONS << " records) ===" << std::endl;
+    std::cout << "  " << std::left << std::setw(12) << "workload" << std::setw(24) << "sink"
+              << std::right << std::setw(14) << "ns/record" << std::setw(16) << "bytes/record" << std::setw(10) << "ratio" << std::endl;
+
+    for (int workload = 0; workload < 3; ++workload) {
+        const char* workloadName = workload == 0 ? "text" : (workload == 1 ? "deferred" : "modeled");
+        LogStream::SetDeferredFormat(workload == 1);
+        double textBytes = 0.0;
+
+        for (int kind = 0; kind < 3; ++kind) {
+            removeFiles(paths[kind]);
+            sinkMgr.clearAll();
+            sinkMgr.addSink(makeSink(kind, paths[kind]));
+
+            auto start = high_resolution_clock::now();
+            for (int i = 0; i < ITERATIONS; ++i) {
+                if (workload == 2) {
+                    modeled(i);
+                } else {
+                    text(i);
+                }
+            }
+            auto end = high_resolution_clock::now();
+            sinkMgr.clearAll();     // Flushes, and truncates the binary file to its used size
+
+            const double ns = static_cast<double>(duration_cast<nanoseconds>(end - start).count()) / ITERATIONS;
+            const double bytes = static_cast<double>(fileSize(paths[kind])) / ITERATIONS;
+            if (kind == 0) {
+                textBytes = bytes;
+            }
+            std::cout << "  " << std::left << std::setw(12) << workloadName << std::setw(24) << sinkNames[kind]
+                      << std::right << std::fixed << std::setprecision(1) << std::setw(14) << ns
+                      << std::setw(16) << bytes << std::setw(9) << textBytes / bytes << "x" << std::endl;
+            removeFiles(paths[kind]);
+        }
+    }
+
+    // Both sinks see the same records: the decoded binary file equals the text file
+    const std::string verifyText = "/tmp/lap_bench_verify.log";
+    const std::string verifyBinary = "/tmp/lap_bench_verify.lapb";
+    removeFiles(verifyText);
+    removeFiles(verifyBinary);
+    sinkMgr.clearAll();
+    sinkMgr.addSink(makeSink(0, verifyText));
+    sinkMgr.addSink(makeSink(2, verifyBinary));
+    for (int i = 0; i < VERIFY_RECORDS; ++i) {
+        LogStream::SetDeferredFormat(i % 3 == 1);
+        if (i % 3 == 2) {
+            modeled(i);
+        } else {
+            text(i);
+        }
+    }
+    sinkMgr.clearAll();
+    LogStream::SetDeferredFormat(false);
+    std::cout << "\n  Verify: tools/decode_binary_log.py " << verifyBinary << " | diff - " << verifyText << std::endl;
+
+    mgr.uninitialize();
+
+    // Deinitialize Core module
+    Deinitialize();
+
+    return 0;
+}
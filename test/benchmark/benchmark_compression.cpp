@@ -0,0 +1,156 @@
+/**
+ * @file        benchmark_compression.cpp
+ * @brief       Compressed rotated files: disk bytes saved and CPU cost per codec
+ * @date        2026-10-16
+ *
+ * @details     1. One 16 MiB log file compressed with each available codec/level
+ *                 (unthrottled): ratio and CPU time per MiB of input
+ *              2. FileSink rotating 1 MiB files with and without gzip compression:
+ *                 bytes left on disk and writer latency (the compressor runs on an
+ *                 idle priority thread, writers must not notice it)
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "CFileSink.hpp"
+#include "CLogCompressor.hpp"
+
+using namespace lap::log;
+using namespace lap::core;
+using namespace std::chrono;
+
+static constexpr Size SAMPLE_BYTES = 16 * 1024 * 1024;
+static constexpr Size ROTATE_SIZE = 1024 * 1024;
+static constexpr UInt32 BACKUPS = 16;
+static const char* SAMPLE_PATH = "/tmp/lap_bench_compress_sample.log";
+static const char* SINK_PATH = "/tmp/lap_bench_compress.log";
+
+static Size fileSize(const std::string& path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 ? static_cast<Size>(st.st_size) : 0;
+}
+
+static double threadCpuMs() {
+    struct timespec ts;
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) * 1000.0 + static_cast<double>(ts.tv_nsec) / 1e6;
+}
+
+static std::string record(int i) {
+    static const char* const kStates[] = { "OK", "RETRY", "TIMEOUT", "OK", "OK" };
+    return "Request " + std::to_string(i) + " from 10.0." + std::to_string(i % 7) + "." + std::to_string(i % 251) +
+           " processed in " + std::to_string((i * 37) % 1000) + " us, status=" + kStates[i % 5];
+}
+
+static void removeSinkFiles() {
+    std::remove(SINK_PATH);
+    for (UInt32 i = 1; i <= BACKUPS + 1; ++i) {
+        const std::string base = std::string(SINK_PATH) + "." + std::to_string(i);
+        std::remove(base.c_str());
+        std::remove((base + ".gz").c_str());
+        std::remove((base + ".zst").c_str());
+    }
+}
+
+static Size sinkBytesOnDisk() {
+    Size total = fileSize(SINK_PATH);
+    for (UInt32 i = 1; i <= BACKUPS; ++i) {
+        const std::string base = std::string(SINK_PATH) + "." + std::to_string(i);
+        total += fileSize(base) + fileSize(base + ".gz") + fileSize(base + ".zst");
+    }
+    return total;
+}
+
+static void runCodec(CompressionType type, Int32 level) {
+    if (!LogCompressor::isAvailable(type)) {
+        std::cout << "  " << std::left << std::setw(8) << toString(type).data() << "(not built in)" << std::endl;
+        return;
+    }
+    const int fd = ::open(SAMPLE_PATH, O_RDONLY | O_CLOEXEC);
+    const std::string out = std::string(SAMPLE_PATH) + LogCompressor::suffix(type);
+    const double cpuStart = threadCpuMs();
+    const auto start = steady_clock::now();
+    const bool ok = LogCompressor::compressFile(fd, out, type, level, 0, nullptr);
+    const double wallMs = static_cast<double>(duration_cast<microseconds>(steady_clock::now() - start).count()) / 1000.0;
+    const double cpuMs = threadCpuMs() - cpuStart;
+    ::close(fd);
+
+    const double inMiB = static_cast<double>(fileSize(SAMPLE_PATH)) / (1024.0 * 1024.0);
+    const Size outBytes = fileSize(out);
+    std::cout << "  " << std::left << std::setw(8) << toString(type).data() << std::right << std::setw(6) << level
+              << std::fixed << std::setprecision(2)
+              << std::setw(12) << static_cast<double>(outBytes) / (1024.0 * 1024.0)
+              << std::setw(9) << static_cast<double>(fileSize(SAMPLE_PATH)) / static_cast<double>(outBytes ? outBytes : 1) << "x"
+              << std::setw(14) << cpuMs / inMiB
+              << std::setw(12) << inMiB / (wallMs / 1000.0)
+              << (ok ? "" : "  FAILED") << std::endl;
+    std::remove(out.c_str());
+}
+
+static void runSink(const char* name, CompressionType type) {
+    removeSinkFiles();
+    FileRotationConfig rotation;
+    rotation.background = true;
+    rotation.compression = type;
+    std::vector<UInt64> latencies;
+    Size written = 0;
+    {
+        FileSink sink(SINK_PATH, ROTATE_SIZE, BACKUPS, LogLevel::kVerbose, "BNCH", FileBufferConfig(), rotation);
+        for (int i = 0; written < SAMPLE_BYTES; ++i) {
+            const std::string msg = record(i);
+            const auto start = steady_clock::now();
+            sink.write(0, 0, static_cast<LogLevelType>(LogLevel::kInfo), "CMPR", msg);
+            latencies.push_back(static_cast<UInt64>(duration_cast<nanoseconds>(steady_clock::now() - start).count()));
+            written += msg.size() + 40;
+        }
+        sink.waitRotation();
+        sink.waitCompression();
+    }
+
+    const Size p99Index = latencies.size() * 99 / 100;
+    std::nth_element(latencies.begin(), latencies.begin() + static_cast<std::ptrdiff_t>(p99Index), latencies.end());
+    std::cout << "  " << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << static_cast<double>(sinkBytesOnDisk()) / (1024.0 * 1024.0)
+              << std::setw(12) << static_cast<double>(latencies[p99Index]) / 1000.0 << std::endl;
+    removeSinkFiles();
+}
+
+int main() {
+    // Sample file: the same kind of lines FileSink writes
+    std::remove(SAMPLE_PATH);
+    {
+        FileSink sample(SAMPLE_PATH, 0, 1, LogLevel::kVerbose, "BNCH");
+        for (int i = 0; fileSize(SAMPLE_PATH) < SAMPLE_BYTES; ++i) {
+            sample.write(static_cast<UInt64>(i) * 1000000ULL, 0, static_cast<LogLevelType>(LogLevel::kInfo), "CMPR", record(i));
+        }
+    }
+
+    std::cout << "\n=== Benchmark: rotated file compression (" << SAMPLE_BYTES / (1024 * 1024) << " MiB log file) ===" << std::endl;
+    std::cout << "  " << std::left << std::setw(8) << "codec" << std::right << std::setw(6) << "level"
+              << std::setw(12) << "out MiB" << std::setw(10) << "ratio" << std::setw(14) << "CPU ms/MiB"
+              << std::setw(12) << "MiB/s" << std::endl;
+    runCodec(CompressionType::kGzip, 1);
+    runCodec(CompressionType::kGzip, 6);
+    runCodec(CompressionType::kZstd, 1);
+    runCodec(CompressionType::kZstd, 3);
+    std::remove(SAMPLE_PATH);
+
+    std::cout << "\n=== FileSink: " << BACKUPS << " x " << ROTATE_SIZE / (1024 * 1024) << " MiB backups, "
+              << SAMPLE_BYTES / (1024 * 1024) << " MiB written ===" << std::endl;
+    std::cout << "  " << std::left << std::setw(22) << "compression" << std::right << std::setw(12) << "disk MiB"
+              << std::setw(12) << "p99 us" << std::endl;
+    runSink("none", CompressionType::kNone);
+    runSink("gzip (8 MiB/s budget)", CompressionType::kGzip);
+    runSink("zstd (8 MiB/s budget)", CompressionType::kZstd);
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file        benchmark_deferred.cpp
+ * @brief       Deferred LogStream formatting vs formatting on the caller
+ * @date        2026-10-16
+ *
+ * @details     Same record logged into sinks that discard it:
+ *              - Eager: operator<< formats text on the calling thread (default)
+ *              - Deferred, binary sink: operator<< only encodes (tag + memcpy), the sink
+ *                takes the encoding as is; this is the producer cost the async queue sees
+ *              - Deferred, text sink: encoding plus rendering on the same thread, the
+ *                total work when nothing is offloaded
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <CLog.hpp>
+#include "CSinkManager.hpp"
+#include <lap/core/CInitialization.hpp>
+
+using namespace lap::log;
+using namespace lap::core;
+using namespace std::chrono;
+
+static constexpr int ITERATIONS = 1000000;
+
+static volatile Size g_sink = 0;
+
+class NullTextSink : public ISink {
+public:
+    void write(UInt64 timestamp, UInt32 threadId, LogLevelType level,
+               StringView contextId, StringView message) noexcept override {
+        UNUSED(timestamp);
+        UNUSED(threadId);
+        UNUSED(level);
+        UNUSED(contextId);
+        g_sink = message.size();
+    }
+
+    void flush() noexcept override {}
+    Bool isEnabled() const noexcept override { return true; }
+    StringView getName() const noexcept override { return "Null"; }
+    void setLevel(LogLevel level) noexcept override { UNUSED(level); }
+    Bool shouldLog(LogLevel level) const noexcept override { return level <= LogLevel::kWarn; }
+    Bool isThreadSafe() const noexcept override { return true; }
+};
+
+class NullArgsSink : public NullTextSink {
+public:
+    Bool writeArgs(UInt64 timestamp, UInt32 threadId, LogLevelType level,
+                   StringView contextId, const UInt8* args, Size size) noexcept override {
+        UNUSED(timestamp);
+        UNUSED(threadId);
+        UNUSED(level);
+        UNUSED(contextId);
+        UNUSED(args);
+        g_sink = size;
+        return true;
+    }
+};
+
+template < typename Fn >
+static double measure(const char* name, Fn&& fn) {
+    for (int i = 0; i < ITERATIONS / 100; ++i) {
+        fn(i);
+    }
+
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        fn(i);
+    }
+    auto end = high_resolution_clock::now();
+
+    double ns = static_cast<double>(duration_cast<nanoseconds>(end - start).count()) / ITERATIONS;
+    std::cout << "  " << std::left << std::setw(44) << name
+              << std::right << std::fixed << std::setprecision(2) << std::setw(10) << ns << " ns/record" << std::endl;
+    return ns;
+}
+
+int main() {
+    // Initialize Core module
+    auto initResult = Initialize();
+    if (!initResult.HasValue()) {
+        return 1;
+    }
+
+    auto& mgr = LogManager::getInstance();
+    mgr.initialize();
+    auto& sinkMgr = mgr.getSinkManager();
+    sinkMgr.clearAll();
+    sinkMgr.addSink(std::make_unique<NullTextSink>());
+
+    auto& logger = CreateLogger("DEFR", "Deferred Format Test", LogLevel::kVerbose);
+    const double celsius = 97.25;
+    auto record = [&](int i) {
+        logger.LogWarn() << "sensor=" << static_cast<UInt32>(i) << ", celsius=" << celsius
+                         << ", offset=" << static_cast<Int64>(-i) << ", state=" << LogHex16{ 0x3C3C }
+                         << ", mask=" << LogBin8{ 0xA5, true } << ", level=" << LogLevel::kWarn;
+    };
+
+    std::cout << "\n=== Benchmark: Deferred vs Eager LogStream Formatting (" << ITERATIONS << " records) ===" << std::endl;
+
+    LogStream::SetDeferredFormat(false);
+    double eager = measure("eager, text sink", record);
+
+    LogStream::SetDeferredFormat(true);
+    measure("deferred, text sink (render on caller)", record);
+
+    sinkMgr.clearAll();
+    sinkMgr.addSink(std::make_unique<NullArgsSink>());
+    double deferred = measure("deferred, binary sink (producer cost)", record);
+    std::cout << "  Producer: deferred is " << std::setprecision(1) << eager / deferred << "x cheaper than eager" << std::endl;
+
+    LogStream::SetDeferredFormat(false);
+    mgr.uninitialize();
+
+    // Deinitialize Core module
+    Deinitialize();
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file        benchmark_disabled_log.cpp
+ * @brief       Cost of log statements whose level is disabled
+ * @date        2026-10-16
+ *
+ * @details     Every disabled statement should cost one atomic load and a branch.
+ *              Measured forms (DEBUG disabled by the global level):
+ *              - Logger::ShouldLog() alone
+ *              - logger.LogDebug() << ... (inert LogStream, arguments still evaluated)
+ *              - if (logger.ShouldLog()) logger.LogDebug() << ...
+ *              - LAP_LOG_DEBUG(ctx) << ... (includes the CreateLogger() registry lookup)
+ *              - Enabled ERROR statement into a null sink for reference
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <CLog.hpp>
+#include "CSinkManager.hpp"
+#include <lap/core/CInitialization.hpp>
+
+using namespace lap::log;
+using namespace lap::core;
+using namespace std::chrono;
+
+static constexpr int ITERATIONS = 10000000;
+
+static volatile int g_sink = 0;
+
+class NullSink : public ISink {
+public:
+    void write(UInt64 timestamp, UInt32 threadId, LogLevelType level,
+               StringView contextId, StringView message) noexcept override {
+        UNUSED(timestamp);
+        UNUSED(threadId);
+        UNUSED(level);
+        UNUSED(contextId);
+        g_sink = static_cast<int>(message.size());
+    }
+
+    void flush() noexcept override {}
+    Bool isEnabled() const noexcept override { return true; }
+    StringView getName() const noexcept override { return "Null"; }
+    void setLevel(LogLevel level) noexcept override { UNUSED(level); }
+    Bool shouldLog(LogLevel level) const noexcept override { return level <= LogLevel::kError; }
+    Bool isThreadSafe() const noexcept override { return true; }
+};
+
+template < typename Fn >
+static void measure(const char* name, int iterations, Fn&& fn) {
+    // Warm-up
+    for (int i = 0; i < iterations / 100; ++i) {
+        fn(i);
+    }
+
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn(i);
+    }
+    auto end = high_resolution_clock::now();
+
+    double ns = static_cast<double>(duration_cast<nanoseconds>(end - start).count()) / iterations;
+    std::cout << "  " << std::left << std::setw(44) << name
+              << std::right << std::fixed << std::setprecision(2) << std::setw(10) << ns << " ns/stmt" << std::endl;
+}
+
+int main() {
+    // Initialize Core module
+    auto initResult = Initialize();
+    if (!initResult.HasValue()) {
+        return 1;
+    }
+
+    auto& mgr = LogManager::getInstance();
+    mgr.initialize();
+    auto& sinkMgr = mgr.getSinkManager();
+    sinkMgr.setGlobalMinLevel(LogLevel::kWarn);
+
+    auto& logger = CreateLogger("DSBL", "Disabled Statement Test", LogLevel::kVerbose);
+    const double pi = 3.14159;
+
+    std::cout << "\n=== Benchmark: Disabled Log Statement Cost ===" << std::endl;
+    std::cout << "  effective max level: " << toString(sinkMgr.getMaxLevel()).data()
+              << ", DEBUG enabled: " << (logger.ShouldLog(LogLevel::kDebug) ? "yes" : "no") << std::endl;
+
+    measure("ShouldLog(kDebug)", ITERATIONS, [&](int i) {
+        if (logger.ShouldLog(LogLevel::kDebug)) {
+            g_sink = i;
+        }
+    });
+
+    measure("logger.LogDebug() << str << int << double", ITERATIONS, [&](int i) {
+        logger.LogDebug() << "value=" << i << " pi=" << pi;
+    });
+
+    measure("if (ShouldLog) logger.LogDebug() << ...", ITERATIONS, [&](int i) {
+        if (logger.ShouldLog(LogLevel::kDebug)) {
+            logger.LogDebug() << "value=" << i << " pi=" << pi;
+        }
+    });
+
+    measure("LAP_LOG_DEBUG(\"DSBL\") << ...", ITERATIONS / 10, [&](int i) {
+        LAP_LOG_DEBUG("DSBL") << "value=" << i << " pi=" << pi;
+    });
+
+    // Reference: an enabled statement dispatched to a sink that discards it
+    sinkMgr.clearAll();
+    sinkMgr.addSink(std::make_unique<NullSink>());
+    measure("enabled LogError() << ... (null sink)", ITERATIONS / 10, [&](int i) {
+        logger.LogError() << "value=" << i << " pi=" << pi;
+    });
+
+    mgr.uninitialize();
+
+    // Deinitialize Core module
+    Deinitialize();
+
+    return 0;
+}
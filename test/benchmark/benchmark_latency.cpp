@@ -9,6 +9,9 @@
  *              - Percentile latency (P50, P90, P99, P99.9)
  *              - Latency under load
  *              - Worst-case latency
+ *              - Record timestamp clock read cost per ClockSource
+ *              - Record thread ID lookup cost
+ *              - FileSink with preallocated files and page cache dropping
  */
 
 #include <iostream>
@@ -18,10 +21,18 @@
 #include <iomanip>
 #include <numeric>
 #include <cmath>
+#include <thread>
 #include "CSinkManager.hpp"
 #include "CFileSink.hpp"
 #include "CConsoleSink.hpp"
 #include "CSyslogSink.hpp"
+#include "CLogClock.hpp"
+#include "CThreadId.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #include <lap/core/CInitialization.hpp>
 
 using namespace lap::log;
@@ -41,7 +52,7 @@ static LogEntry* createLogEntry(
     LogEntry* entry = new (mem) LogEntry();
     
     auto now = system_clock::now();
-    entry->timestamp = duration_cast<microseconds>(now.time_since_epoch()).count();
+    entry->timestamp = duration_cast<nanoseconds>(now.time_since_epoch()).count();
     entry->threadId = static_cast<UInt32>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
     entry->level = level;
     entry->contextIdLen = static_cast<UInt16>(contextId.size());
@@ -314,6 +325,160 @@ void benchmarkLatencyUnderLoad() {
     ::unlink(testFile);
 }
 
+/**
+ * @brief Pages of a file resident in the page cache, in bytes (mincore)
+ */
+static size_t residentBytes(const String& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return 0;
+    struct stat st;
+    size_t resident = 0;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t length = static_cast<size_t>(st.st_size);
+        void* map = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        if (map != MAP_FAILED) {
+            std::vector<unsigned char> pages((length + page - 1) / page);
+            if (::mincore(map, length, pages.data()) == 0) {
+                for (unsigned char p : pages) {
+                    resident += (p & 1) ? page : 0;
+                }
+            }
+            ::munmap(map, length);
+        }
+    }
+    ::close(fd);
+    return resident;
+}
+
+/**
+ * @brief FileSink write latency with preallocated files and dropped page cache
+ */
+void benchmarkFileSinkPreallocation() {
+    printHeader("File Sink Preallocation (32 MiB files, 4 backups)");
+    
+    const char* testFile = "/tmp/lap_benchmark_prealloc.log";
+    const Size MAX_SIZE = 32 * 1024 * 1024;
+    const UInt32 BACKUPS = 4;
+    const int NUM_SAMPLES = 1000000;
+    const String message = "Preallocation test message with moderate length to simulate real usage";
+    auto cleanup = [&]() {
+        ::unlink(testFile);
+        for (UInt32 i = 1; i <= BACKUPS + 1; ++i) {
+            ::unlink((String(testFile) + "." + std::to_string(i)).c_str());
+        }
+    };
+    
+    struct Mode {
+        const char* name;
+        FileSpaceConfig config;
+    };
+    std::vector<Mode> modes(3);
+    modes[0].name = "Grow on demand";
+    modes[1].name = "Preallocated";
+    modes[1].config.preallocate = true;
+    modes[2].name = "Preallocated + drop cache every 4 MiB";
+    modes[2].config.preallocate = true;
+    modes[2].config.dropCacheBytes = 4 * 1024 * 1024;
+    
+    for (const auto& mode : modes) {
+        cleanup();
+        std::vector<double> latencies;
+        latencies.reserve(NUM_SAMPLES);
+        size_t cached = 0;
+        {
+            FileSink sink(testFile, MAX_SIZE, BACKUPS, LogLevel::kVerbose, "BNCH", FileBufferConfig(),
+                          FileRotationConfig(), FileSyncConfig(), mode.config);
+            for (int i = 0; i < NUM_SAMPLES; ++i) {
+                auto start = high_resolution_clock::now();
+                sink.write(static_cast<UInt64>(i), 0, static_cast<lap::log::LogLevelType>(0x04), "PREA", message);
+                auto end = high_resolution_clock::now();
+                latencies.push_back(duration_cast<nanoseconds>(end - start).count() / 1000.0);
+            }
+            sink.waitRotation();
+            cached = residentBytes(testFile);
+            for (UInt32 i = 1; i <= BACKUPS; ++i) {
+                cached += residentBytes(String(testFile) + "." + std::to_string(i));
+            }
+        }
+        
+        printLatencyStats(mode.name, latencies);
+        std::cout << "  Cached: " << std::setprecision(1) << static_cast<double>(cached) / (1024.0 * 1024.0)
+                  << " MiB of log pages in the page cache" << std::endl;
+    }
+    
+    cleanup();
+}
+
+/**
+ * @brief Cost of one record timestamp read (paid in every enabled LogStream constructor)
+ */
+void benchmarkClockReadCost() {
+    printHeader("Record Timestamp Clock Read Cost");
+    
+    const int READS = 5000000;
+    volatile uint64_t sink = 0;
+    
+    auto measure = [&](const char* name, auto&& readClock) {
+        auto start = high_resolution_clock::now();
+        for (int i = 0; i < READS; ++i) {
+            sink = readClock();
+        }
+        auto end = high_resolution_clock::now();
+        double ns = static_cast<double>(duration_cast<nanoseconds>(end - start).count()) / READS;
+        std::cout << std::left << std::setw(40) << name
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(10) << ns << " ns/read"
+                  << std::endl;
+    };
+    
+    // Previous per-record path: system_clock truncated to milliseconds
+    measure("system_clock (ms, previous)", []() {
+        return static_cast<uint64_t>(duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count()) * 1000;
+    });
+    
+    const ClockSource sources[] = { ClockSource::kRealtime, ClockSource::kRealtimeCoarse,
+                                    ClockSource::kMonotonic, ClockSource::kTsc };
+    for (ClockSource source : sources) {
+        ClockSource used = LogClock::setSource(source);
+        String name = "LogClock " + String(toString(source));
+        if (used != source) {
+            name += " (-> " + String(toString(used)) + ")";
+        }
+        measure(name.c_str(), []() { return LogClock::now(); });
+    }
+    LogClock::setSource(ClockSource::kRealtime);
+    UNUSED(sink);
+}
+
+/**
+ * @brief Cost of the thread ID stored in every enabled LogStream
+ */
+void benchmarkThreadIdCost() {
+    printHeader("Record Thread ID Lookup Cost");
+    
+    const int READS = 5000000;
+    volatile uint64_t sink = 0;
+    
+    auto measure = [&](const char* name, auto&& readId) {
+        auto start = high_resolution_clock::now();
+        for (int i = 0; i < READS; ++i) {
+            sink = readId();
+        }
+        auto end = high_resolution_clock::now();
+        double ns = static_cast<double>(duration_cast<nanoseconds>(end - start).count()) / READS;
+        std::cout << std::left << std::setw(40) << name
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(10) << ns << " ns/record"
+                  << std::endl;
+    };
+    
+    measure("ThreadId::current (cached)", []() { return ThreadId::current(); });
+    measure("syscall(SYS_gettid) per record", []() { return static_cast<uint64_t>(::syscall(SYS_gettid)); });
+    measure("hash(std::this_thread::get_id())", []() {
+        return static_cast<uint64_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    });
+    UNUSED(sink);
+}
+
 int main() {
     // Initialize Core module
     auto initResult = Initialize();
@@ -330,6 +495,9 @@ int main() {
         benchmarkLatencyWithFlush();
         benchmarkSinkLatencyComparison();
         benchmarkLatencyUnderLoad();
+        benchmarkClockReadCost();
+        benchmarkThreadIdCost();
+        benchmarkFileSinkPreallocation();
         
         std::cout << "\n" << std::string(70, '=') << std::endl;
         std::cout << "  Latency benchmark completed!" << std::endl;
@@ -9,6 +9,7 @@
  *              - Memory usage growth
  *              - Memory leak detection
  *              - Peak memory usage
+ *              - LogStream message sizes (64B/200B/1KB/4KB): latency and memory
  */
 
 #include <iostream>
@@ -21,6 +22,7 @@
 #include "CSinkManager.hpp"
 #include "CFileSink.hpp"
 #include "CConsoleSink.hpp"
+#include "CLog.hpp"
 #include <lap/core/CInitialization.hpp>
 
 using namespace lap::log;
@@ -51,7 +53,7 @@ size_t getCurrentMemoryUsage() {
  * @brief Helper function to create a log entry
  */
 static LogEntry* createLogEntry(
-    DltLogLevelType level,
+    LogLevelType level,
     StringView contextId,
     StringView message
 ) {
@@ -60,7 +62,7 @@ static LogEntry* createLogEntry(
     LogEntry* entry = new (mem) LogEntry();
     
     auto now = system_clock::now();
-    entry->timestamp = duration_cast<microseconds>(now.time_since_epoch()).count();
+    entry->timestamp = duration_cast<nanoseconds>(now.time_since_epoch()).count();
     entry->threadId = static_cast<UInt32>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
     entry->level = level;
     entry->contextIdLen = static_cast<UInt16>(contextId.size());
@@ -300,6 +302,89 @@ void benchmarkPeakMemory() {
     ::unlink(testFile);
 }
 
+/**
+ * @brief Sink counting records and bytes, no I/O
+ */
+class CountingSink : public ISink {
+public:
+    void write(UInt64 timestamp, UInt32 threadId, LogLevelType level,
+               StringView contextId, StringView message) noexcept override {
+        UNUSED(timestamp);
+        UNUSED(threadId);
+        UNUSED(level);
+        UNUSED(contextId);
+        ++records;
+        bytes += message.size();
+    }
+
+    void flush() noexcept override {}
+    Bool isEnabled() const noexcept override { return true; }
+    StringView getName() const noexcept override { return "Counting"; }
+    void setLevel(LogLevel level) noexcept override { UNUSED(level); }
+    Bool shouldLog(LogLevel level) const noexcept override { UNUSED(level); return true; }
+
+    uint64_t records{0};
+    uint64_t bytes{0};
+};
+
+/**
+ * @brief LogStream cost per message size
+ * @details Messages up to MAX_LOG_SIZE stay in the inline buffer; longer ones
+ *          spill into the per-thread arena. Each message must reach the sinks
+ *          as exactly one record.
+ */
+void benchmarkMessageSizes() {
+    printHeader("LogStream Message Sizes (inline buffer + thread arena)");
+
+    auto& logMgr = LogManager::getInstance();
+    auto& sinkMgr = logMgr.getSinkManager();
+    sinkMgr.clearAll();
+    auto sink = std::make_unique<CountingSink>();
+    CountingSink* counter = sink.get();
+    sinkMgr.addSink(std::move(sink));
+    sinkMgr.setGlobalMinLevel(LogLevel::kVerbose);
+
+    auto& logger = CreateLogger("MSGS", "Message size benchmark", LogLevel::kVerbose);
+    const int ITERATIONS = 200000;
+
+    std::cout << "LogStream object: " << sizeof(LogStream) << " bytes (inline buffer "
+              << LogStream::MAX_LOG_SIZE << "), cap " << LogStream::GetMaxMessageSize() << " bytes" << std::endl;
+    std::cout << std::left;
+    std::cout << std::setw(12) << "Size"
+              << std::setw(16) << "ns/message"
+              << std::setw(18) << "records/message"
+              << std::setw(22) << "RSS delta (KB)"
+              << "Core alloc delta" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    for (size_t size : {64u, 200u, 1024u, 4096u}) {
+        const String message(size, 'M');
+        const uint64_t recordsBefore = counter->records;
+        const size_t rssBefore = getCurrentMemoryUsage();
+        const auto coreBefore = Memory::getMemoryStats();
+
+        auto start = high_resolution_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            logger.LogError() << StringView(message);
+        }
+        auto end = high_resolution_clock::now();
+
+        const size_t rssAfter = getCurrentMemoryUsage();
+        const auto coreAfter = Memory::getMemoryStats();
+        double ns = static_cast<double>(duration_cast<nanoseconds>(end - start).count()) / ITERATIONS;
+        double recordsPerMessage = static_cast<double>(counter->records - recordsBefore) / ITERATIONS;
+
+        std::cout << std::setw(12) << (std::to_string(size) + "B")
+                  << std::setw(16) << std::fixed << std::setprecision(1) << ns
+                  << std::setw(18) << std::setprecision(2) << recordsPerMessage
+                  << std::setw(22) << (static_cast<long>(rssAfter) - static_cast<long>(rssBefore))
+                  << (static_cast<long>(coreAfter.currentAllocSize) - static_cast<long>(coreBefore.currentAllocSize))
+                  << " B" << std::endl;
+    }
+
+    sinkMgr.clearAll();
+}
+
 /**
  * @brief Core memory tracking stats
  */
@@ -336,6 +421,7 @@ int main() {
         benchmarkMemoryGrowth();
         benchmarkMemoryLeak();
         benchmarkPeakMemory();
+        benchmarkMessageSizes();
         benchmarkCoreMemoryTracking();
         
         std::cout << "\n" << std::string(70, '=') << std::endl;
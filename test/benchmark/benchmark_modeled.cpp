@@ -0,0 +1,140 @@
+/**
+ * @file        benchmark_modeled.cpp
+ * @brief       Modeled (non-verbose) messages vs verbose text records
+ * @date        2026-10-16
+ *
+ * @details     Same content logged three ways into sinks that discard it:
+ *              - Verbose: LogWarn() << "version=" << ... (text formatted on the caller)
+ *              - Modeled, text sink: Log(MsgId{}, ...) rendered to "[MsgId:NNNN] k=v"
+ *              - Modeled, binary sink: Log(MsgId{}, ...) consumed as encoded values,
+ *                the DLT non-verbose path (no text formatting anywhere)
+ *              Plus the DLT bytes on the wire for one record in verbose and
+ *              non-verbose form.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <CLog.hpp>
+#include "CSinkManager.hpp"
+#include "CModeledMessage.hpp"
+#include <lap/core/CInitialization.hpp>
+
+using namespace lap::log;
+using namespace lap::core;
+using namespace std::chrono;
+
+static constexpr int ITERATIONS = 1000000;
+
+static volatile Size g_sink = 0;
+
+struct SampleMessage : MessageId<4711, LogLevel::kWarn> {};
+
+class NullTextSink : public ISink {
+public:
+    void write(UInt64 timestamp, UInt32 threadId, LogLevelType level,
+               StringView contextId, StringView message) noexcept override {
+        UNUSED(timestamp);
+        UNUSED(threadId);
+        UNUSED(level);
+        UNUSED(contextId);
+        g_sink = message.size();
+    }
+
+    void flush() noexcept override {}
+    Bool isEnabled() const noexcept override { return true; }
+    StringView getName() const noexcept override { return "Null"; }
+    void setLevel(LogLevel level) noexcept override { UNUSED(level); }
+    Bool shouldLog(LogLevel level) const noexcept override { return level <= LogLevel::kWarn; }
+    Bool isThreadSafe() const noexcept override { return true; }
+};
+
+class NullBinarySink : public NullTextSink {
+public:
+    Bool writeModeled(UInt64 timestamp, UInt32 threadId, LogLevelType level,
+                      StringView contextId, const ModeledRecord& record) noexcept override {
+        UNUSED(timestamp);
+        UNUSED(threadId);
+        UNUSED(level);
+        UNUSED(contextId);
+        g_sink = record.getPayloadSize();
+        return true;
+    }
+};
+
+template < typename Fn >
+static double measure(const char* name, Fn&& fn) {
+    for (int i = 0; i < ITERATIONS / 100; ++i) {
+        fn(i);
+    }
+
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        fn(i);
+    }
+    auto end = high_resolution_clock::now();
+
+    double ns = static_cast<double>(duration_cast<nanoseconds>(end - start).count()) / ITERATIONS;
+    std::cout << "  " << std::left << std::setw(44) << name
+              << std::right << std::fixed << std::setprecision(2) << std::setw(10) << ns << " ns/record" << std::endl;
+    return ns;
+}
+
+int main() {
+    // Initialize Core module
+    auto initResult = Initialize();
+    if (!initResult.HasValue()) {
+        return 1;
+    }
+
+    auto& mgr = LogManager::getInstance();
+    mgr.initialize();
+    auto& sinkMgr = mgr.getSinkManager();
+    sinkMgr.clearAll();
+    sinkMgr.addSink(std::make_unique<NullTextSink>());
+
+    auto& logger = CreateLogger("MODL", "Modeled Message Test", LogLevel::kVerbose);
+    const double celsius = 97.25;
+
+    std::cout << "\n=== Benchmark: Modeled vs Verbose Messages (" << ITERATIONS << " records) ===" << std::endl;
+
+    double verbose = measure("verbose LogWarn() << k=v text", [&](int i) {
+        logger.LogWarn() << "version=" << "1.0.0" << ", sensor=" << static_cast<UInt32>(i)
+                         << ", celsius=" << celsius << ", state=" << LogHex8{ 0x3C };
+    });
+
+    measure("modeled Log(), text sink", [&](int i) {
+        logger.Log(SampleMessage{}, "version", "1.0.0", "sensor", static_cast<UInt32>(i),
+                   "celsius", celsius, "state", LogHex8{ 0x3C });
+    });
+
+    sinkMgr.clearAll();
+    sinkMgr.addSink(std::make_unique<NullBinarySink>());
+    double binary = measure("modeled Log(), binary sink (non-verbose)", [&](int i) {
+        logger.Log(SampleMessage{}, "version", "1.0.0", "sensor", static_cast<UInt32>(i),
+                   "celsius", celsius, "state", LogHex8{ 0x3C });
+    });
+    std::cout << "  CPU: binary is " << std::setprecision(1) << verbose / binary << "x cheaper than verbose" << std::endl;
+
+    // DLT payload of one record. Verbose: one string argument (4 type info + 2 length + text + NUL).
+    // Non-verbose: 4 byte message ID, then raw values (strings keep length + NUL).
+    ModeledRecord record(SampleMessage::id, SampleMessage::level);
+    record.encoder().put("version", "1.0.0");
+    record.encoder().put("sensor", static_cast<UInt32>(123456));
+    record.encoder().put("celsius", celsius);
+    record.encoder().put("state", LogHex8{ 0x3C });
+    const Size textBytes = record.getText().size() - 13;    // Without "[MsgId:4711] "
+    const Size verboseBytes = 4 + 2 + textBytes + 1;
+    const Size nonVerboseBytes = 4 + (2 + 5 + 1) + 4 + 8 + 1;
+    std::cout << "  DLT payload: verbose " << verboseBytes << " B, non-verbose " << nonVerboseBytes
+              << " B (" << std::setprecision(1) << static_cast<double>(verboseBytes) / nonVerboseBytes << "x smaller)"
+              << std::endl;
+
+    mgr.uninitialize();
+
+    // Deinitialize Core module
+    Deinitialize();
+
+    return 0;
+}
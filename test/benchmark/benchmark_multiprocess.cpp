@@ -3,20 +3,31 @@
  * @author      ddkv587
  * @brief       Multi-process file sink benchmark to test concurrent writes
  * @date        2025-10-29
- * @details     Tests multiple processes writing to the same log file simultaneously
+ * @details     Several processes log into one rotating log file, two ways:
+ *              1. Shared file: every process opens the file with its own FileSink
+ *                 (O_APPEND, flock for flushes and rotation)
+ *              2. Collector: every process writes into its own shared memory ring,
+ *                 one LogCollector (here a thread of the parent) owns the FileSink
+ *              Both are checked for lost, duplicated and corrupted lines across all backups.
  */
 
 #include "CLogManager.hpp"
-#include <lap/core/CInstanceSpecifier.hpp>
+#include "CLogCollector.hpp"
+#include "CSinkManager.hpp"
+#include "CFileSink.hpp"
 #include <lap/core/CInitialization.hpp>
+#include <lap/core/CConfig.hpp>
 #include <iostream>
 #include <chrono>
 #include <atomic>
+#include <cstdlib>
 #include <sys/wait.h>
 #include <unistd.h>
 #include <sys/stat.h>
 #include <fstream>
 #include <set>
+#include <string>
+#include <thread>
 #include <vector>
 
 using namespace lap::log;
@@ -25,250 +36,268 @@ using namespace std::chrono;
 // Configuration
 constexpr int NUM_PROCESSES = 4;
 constexpr int LOGS_PER_PROCESS = 10000;
+constexpr int WARMUP_LOGS = 100;
+constexpr size_t ROTATE_SIZE = 256 * 1024;
+constexpr unsigned BACKUPS = 64;
+constexpr size_t RING_SIZE = 1024 * 1024;
 constexpr const char* LOG_FILE = "/tmp/multiprocess_test.log";
 constexpr const char* CONFIG_FILE = "/tmp/multiprocess_config.json";
 
-// Create config file for multi-process test
-void createConfigFile() {
+// Create config file for multi-process test: "sink" is the JSON of the one sink each child uses
+void createConfigFile(const std::string& sink) {
     std::ofstream config(CONFIG_FILE);
     config << R"({
-    "logConfig": {
+    "log": {
         "applicationId": "MPRC",
         "applicationDescription": "Multi-Process Test",
         "contextId": "MAIN",
         "contextDescription": "Main Context",
         "logTraceDefaultLogLevel": "Info",
-        "logTraceFilePath": ")" << LOG_FILE << R"(",
-        "logTraceLogMode": ["file"],
         "withSessionId": 0,
         "withTimeStamp": 1,
         "withEcuId": 0,
         "logMarker": false,
-        "verboseMode": false
+        "verboseMode": false,
+        "sinks": [ )" << sink << R"( ]
     }
 })";
     config.close();
 }
 
+void removeLogFiles() {
+    unlink(LOG_FILE);
+    for (unsigned i = 1; i <= BACKUPS + 1; ++i) {
+        unlink((std::string(LOG_FILE) + "." + std::to_string(i)).c_str());
+    }
+}
+
 // Child process function
 void childProcess(int processId) {
     // Initialize logger
+    lap::core::ConfigManager::getInstance().initialize(lap::core::String(CONFIG_FILE), false);
     auto& logMgr = LogManager::getInstance();
-    lap::core::InstanceSpecifier spec(CONFIG_FILE);
-    logMgr.initialize(spec);
+    logMgr.initialize();
     auto& logger = logMgr.logger("PROC");
-    
+
     // Warmup
-    for (int i = 0; i < 100; ++i) {
+    for (int i = 0; i < WARMUP_LOGS; ++i) {
         logger.LogInfo() << "Warmup " << processId << " #" << i;
     }
-    
+
     // Start benchmark
     auto start = high_resolution_clock::now();
-    
+
     for (int i = 0; i < LOGS_PER_PROCESS; ++i) {
         logger.LogInfo() << "[P" << processId << "] Message #" << i << " from process " << processId;
     }
-    
-    // Logger will flush on destruction (end of process)
-    
+
     auto end = high_resolution_clock::now();
-    auto duration = duration_cast<milliseconds>(end - start).count();
-    
+    auto duration = duration_cast<microseconds>(end - start).count();
+
     // Clean shutdown to avoid static destruction races in child
     logMgr.uninitialize();
 
     // Print process stats to stdout (will be collected by parent)
-    std::cout << "Process " << processId << ": " 
-              << LOGS_PER_PROCESS << " logs in " 
-              << duration << "ms ("
-              << (LOGS_PER_PROCESS * 1000 / duration) << " logs/sec)"
+    std::cout << "  Process " << processId << ": "
+              << LOGS_PER_PROCESS << " logs in "
+              << duration / 1000.0 << " ms ("
+              << (LOGS_PER_PROCESS * 1000000LL / (duration > 0 ? duration : 1)) << " logs/sec)"
               << std::endl;
 }
 
 // Verify log file integrity
 struct VerificationResult {
     size_t totalLines = 0;
+    size_t files = 0;
     size_t uniqueMessages = 0;
     size_t duplicates = 0;
     size_t corrupted = 0;
-    bool integrityOk = true;
+    size_t bytes = 0;
 };
 
-VerificationResult verifyLogFile() {
+VerificationResult verifyLogFiles() {
     VerificationResult result;
     std::set<std::string> uniqueMessages;
-    std::ifstream logFile(LOG_FILE);
-    std::string line;
-    
-    while (std::getline(logFile, line)) {
-        result.totalLines++;
-        
-        // Check for corruption (incomplete lines, wrong format)
-        if (line.empty() || line.size() < 10) {
-            result.corrupted++;
-            result.integrityOk = false;
+
+    // Current file and every backup: lines may end up in any of them
+    for (unsigned i = 0; i <= BACKUPS; ++i) {
+        const std::string path = i == 0 ? std::string(LOG_FILE) : std::string(LOG_FILE) + "." + std::to_string(i);
+        std::ifstream logFile(path);
+        if (!logFile) {
             continue;
         }
-        
-        // Extract message content for uniqueness check
-        size_t msgStart = line.find("] Message #");
-        if (msgStart != std::string::npos) {
-            std::string msgContent = line.substr(msgStart);
-            
-            if (uniqueMessages.count(msgContent) > 0) {
-                result.duplicates++;
-                result.integrityOk = false;
-            } else {
-                uniqueMessages.insert(msgContent);
+        result.files++;
+
+        std::string line;
+        while (std::getline(logFile, line)) {
+            result.totalLines++;
+            result.bytes += line.size() + 1;
+
+            // Check for corruption (incomplete lines, wrong format)
+            if (line.empty() || line.size() < 10 || line[0] != '[') {
+                result.corrupted++;
+                continue;
+            }
+
+            // Extract message content for uniqueness check
+            size_t msgStart = line.find("] Message #");
+            if (msgStart != std::string::npos) {
+                std::string msgContent = line.substr(line.rfind("[P", msgStart));
+
+                if (!uniqueMessages.insert(msgContent).second) {
+                    result.duplicates++;
+                }
             }
         }
     }
-    
+
     result.uniqueMessages = uniqueMessages.size();
-    
+
     return result;
 }
 
-int main() {
-    // Initialize Core module
-    auto initResult = lap::core::Initialize();
-    if (!initResult.HasValue()) {
-        return 1;
+struct ModeResult {
+    long long durationUs = 0;
+    unsigned long long dropped = 0;
+    VerificationResult verification;
+    bool ok = false;
+};
+
+// Fork the writers and wait for them; collector mode drains their rings meanwhile
+ModeResult runMode(bool collected) {
+    ModeResult result;
+    removeLogFiles();
+
+    const std::string ringDir = "/dev/shm/lap_mp_bench_" + std::to_string(getpid());
+    if (collected) {
+        mkdir(ringDir.c_str(), 0700);
+        createConfigFile(R"({ "type": "collector", "directory": ")" + ringDir + R"(", "size": )" + std::to_string(RING_SIZE) + " }");
+    } else {
+        createConfigFile(R"({ "type": "file", "path": ")" + std::string(LOG_FILE) + R"(", "maxSize": )" +
+                         std::to_string(ROTATE_SIZE) + R"(, "backupCount": )" + std::to_string(BACKUPS) +
+                         R"(, "multiProcess": true })");
     }
-    
-    std::cout << "==============================================\n";
-    std::cout << "  Multi-Process FileSink Benchmark\n";
-    std::cout << "==============================================\n\n";
-    
-    // Clean up old files
-    unlink(LOG_FILE);
-    
-    // Create config
-    createConfigFile();
-    
-    std::cout << "Configuration:\n";
-    std::cout << "  Processes:       " << NUM_PROCESSES << "\n";
-    std::cout << "  Logs/process:    " << LOGS_PER_PROCESS << "\n";
-    std::cout << "  Total logs:      " << (NUM_PROCESSES * LOGS_PER_PROCESS) << "\n";
-    std::cout << "  Log file:        " << LOG_FILE << "\n\n";
-    
-    std::cout << "Starting processes...\n";
-    
+
+    // Collector: the only process that opens the log file
+    SinkManager sinkManager;
+    std::atomic<lap::core::Bool> stop{ false };
+    std::unique_ptr<LogCollector> collector;
+    std::thread collectorThread;
+    if (collected) {
+        sinkManager.addSink(std::make_unique<FileSink>(LOG_FILE, ROTATE_SIZE, BACKUPS, LogLevel::kInfo, "MPRC"));
+        LogCollector::Config config;
+        config.directory = ringDir.c_str();
+        config.scanIntervalMs = 10;
+        collector = std::make_unique<LogCollector>(sinkManager, config);
+        collectorThread = std::thread([&] { collector->run(stop); });
+    }
+
     auto startTime = high_resolution_clock::now();
-    
-    // Fork child processes
+
+    // Fork child processes (nothing buffered in stdout may be inherited)
+    std::cout.flush();
     std::vector<pid_t> pids;
     for (int i = 0; i < NUM_PROCESSES; ++i) {
         pid_t pid = fork();
-        
+
         if (pid == 0) {
             // Child process
             childProcess(i);
-            exit(0);
+            _exit(0);
         } else if (pid > 0) {
-            // Parent process
             pids.push_back(pid);
-            std::cout << "  Launched process " << i << " (PID: " << pid << ")\n";
         } else {
             std::cerr << "Failed to fork process " << i << std::endl;
-            return 1;
+            exit(1);
         }
     }
-    
-    std::cout << "\nWaiting for processes to complete...\n\n";
-    
+
     // Wait for all children
     for (size_t i = 0; i < pids.size(); ++i) {
         int status;
         waitpid(pids[i], &status, 0);
     }
-    
-    auto endTime = high_resolution_clock::now();
-    auto totalDuration = duration_cast<milliseconds>(endTime - startTime).count();
-    
-    std::cout << "\n==============================================\n";
-    std::cout << "  Benchmark Results\n";
-    std::cout << "==============================================\n\n";
-    
-    std::cout << "Timing:\n";
-    std::cout << "  Total duration:  " << totalDuration << " ms\n";
-    std::cout << "  Throughput:      " 
-              << ((NUM_PROCESSES * LOGS_PER_PROCESS * 1000) / totalDuration) 
-              << " logs/sec (aggregate)\n\n";
-    
-    // Verify log file
-    std::cout << "Verifying log file integrity...\n";
-    auto verification = verifyLogFile();
-    
-    std::cout << "\nFile Statistics:\n";
-    std::cout << "  Total lines:     " << verification.totalLines << "\n";
-    std::cout << "  Expected lines:  " << (NUM_PROCESSES * (LOGS_PER_PROCESS + 100)) << " (including warmup)\n";
-    std::cout << "  Unique messages: " << verification.uniqueMessages << "\n";
-    std::cout << "  Duplicates:      " << verification.duplicates << "\n";
-    std::cout << "  Corrupted lines: " << verification.corrupted << "\n";
-    
-    // Get file size
-    struct stat st;
-    if (stat(LOG_FILE, &st) == 0) {
-        std::cout << "  File size:       " << st.st_size << " bytes (" 
-                  << (st.st_size / 1024.0) << " KB)\n";
-    }
-    
-    std::cout << "\n==============================================\n";
-    std::cout << "  Integrity Check\n";
-    std::cout << "==============================================\n\n";
-    
-    if (verification.integrityOk) {
-        std::cout << "✅ PASSED: No data corruption detected\n";
-        std::cout << "✅ All log messages written correctly\n";
-    } else {
-        std::cout << "❌ FAILED: Data corruption detected!\n";
-        if (verification.duplicates > 0) {
-            std::cout << "   - " << verification.duplicates << " duplicate messages\n";
-        }
-        if (verification.corrupted > 0) {
-            std::cout << "   - " << verification.corrupted << " corrupted lines\n";
-        }
-        
-        size_t expectedMessages = NUM_PROCESSES * LOGS_PER_PROCESS;
-        size_t actualMessages = verification.uniqueMessages;
-        if (actualMessages < expectedMessages) {
-            std::cout << "   - Missing " << (expectedMessages - actualMessages) << " messages\n";
+
+    // Collector: done once every ring is drained and retired
+    if (collected) {
+        while (collector->getStats().retired < static_cast<lap::core::UInt64>(NUM_PROCESSES)) {
+            std::this_thread::sleep_for(milliseconds(1));
         }
+        stop.store(true);
+        collectorThread.join();
+        result.dropped = collector->getStats().dropped;
+        collector.reset();
+        sinkManager.clearAll();
+        rmdir(ringDir.c_str());
     }
-    
-    std::cout << "\n==============================================\n";
-    std::cout << "  Analysis\n";
-    std::cout << "==============================================\n\n";
-    
-    if (!verification.integrityOk) {
-        std::cout << "⚠️  Multi-process file writing has issues!\n\n";
-        std::cout << "Common causes:\n";
-        std::cout << "1. Missing file locking (flock/fcntl)\n";
-        std::cout << "2. Concurrent fopen() calls overwriting file position\n";
-        std::cout << "3. Buffer interleaving when multiple processes write\n";
-        std::cout << "4. File rotation conflicts between processes\n\n";
-        
-        std::cout << "Recommendations:\n";
-        std::cout << "1. Add advisory file locking (flock) in FileSink\n";
-        std::cout << "2. Use O_APPEND flag for atomic writes\n";
-        std::cout << "3. Consider per-process log files with log rotation\n";
-        std::cout << "4. Use a centralized logging daemon for multi-process\n";
-    } else {
-        std::cout << "✅ File sink is multi-process safe!\n";
-        std::cout << "   Performance: " 
-                  << ((NUM_PROCESSES * LOGS_PER_PROCESS * 1000) / totalDuration) 
-                  << " logs/sec aggregate\n";
+
+    result.durationUs = duration_cast<microseconds>(high_resolution_clock::now() - startTime).count();
+    result.verification = verifyLogFiles();
+
+    const size_t expected = NUM_PROCESSES * LOGS_PER_PROCESS;
+    result.ok = result.verification.duplicates == 0 && result.verification.corrupted == 0 &&
+                result.verification.uniqueMessages + result.dropped >= expected;
+    return result;
+}
+
+void printResult(const char* name, const ModeResult& r) {
+    const size_t expected = NUM_PROCESSES * LOGS_PER_PROCESS;
+    const auto& v = r.verification;
+    std::cout << "\n" << name << ":\n";
+    std::cout << "  Total duration:  " << r.durationUs / 1000.0 << " ms\n";
+    std::cout << "  Throughput:      "
+              << (expected * 1000000LL / (r.durationUs > 0 ? r.durationUs : 1))
+              << " logs/sec (aggregate, until written)\n";
+    std::cout << "  Files:           " << v.files << " (" << v.bytes / 1024 << " KB)\n";
+    std::cout << "  Total lines:     " << v.totalLines << " (expected " << NUM_PROCESSES * (LOGS_PER_PROCESS + WARMUP_LOGS)
+              << " including warmup)\n";
+    std::cout << "  Unique messages: " << v.uniqueMessages << "\n";
+    std::cout << "  Duplicates:      " << v.duplicates << "\n";
+    std::cout << "  Corrupted lines: " << v.corrupted << "\n";
+    if (v.uniqueMessages < expected) {
+        std::cout << "  Missing:         " << (expected - v.uniqueMessages) << "\n";
     }
-    
+    std::cout << "  Reported drops:  " << r.dropped << " (ring full)\n";
+    std::cout << "  " << (r.ok ? "✅ PASSED" : "❌ FAILED") << "\n";
+}
+
+int main() {
+    // Initialize Core module
+    auto initResult = lap::core::Initialize();
+    if (!initResult.HasValue()) {
+        return 1;
+    }
+
+    std::cout << "==============================================\n";
+    std::cout << "  Multi-Process FileSink Benchmark\n";
+    std::cout << "==============================================\n\n";
+
+    std::cout << "Configuration:\n";
+    std::cout << "  Processes:       " << NUM_PROCESSES << "\n";
+    std::cout << "  Logs/process:    " << LOGS_PER_PROCESS << "\n";
+    std::cout << "  Total logs:      " << (NUM_PROCESSES * LOGS_PER_PROCESS) << "\n";
+    std::cout << "  Log file:        " << LOG_FILE << " (" << ROTATE_SIZE / 1024 << " KB, "
+              << BACKUPS << " backups)\n";
+    std::cout << "  Collector ring:  " << RING_SIZE / 1024 << " KB per process\n";
+
+    std::cout << "\n[1] Shared file (every process rotates under flock)\n";
+    const ModeResult shared = runMode(false);
+    std::cout << "\n[2] Collector (per-process shared memory rings, one file owner)\n";
+    const ModeResult collected = runMode(true);
+
+    std::cout << "\n==============================================\n";
+    std::cout << "  Benchmark Results\n";
+    std::cout << "==============================================\n";
+    printResult("Shared file", shared);
+    printResult("Collector", collected);
     std::cout << "\n==============================================\n";
-    
+
     // Clean up
     unlink(CONFIG_FILE);
-    
+    removeLogFiles();
+
     // Deinitialize Core module
     lap::core::Deinitialize();
-    
-    return verification.integrityOk ? 0 : 1;
+
+    return shared.ok && collected.ok ? 0 : 1;
 }
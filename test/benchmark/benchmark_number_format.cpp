@@ -0,0 +1,164 @@
+/**
+ * @file        benchmark_number_format.cpp
+ * @brief       Numeric formatting kernels vs std::snprintf
+ * @date        2026-10-16
+ *
+ * @details     One micro-benchmark per LogStream numeric type:
+ *              UInt8..UInt64, Int8..Int64, Float, Double, LogHex8..LogHex64,
+ *              LogBin8..LogBin64.
+ *              Each row prints ns/value for snprintf with the format LogStream
+ *              used before (a per-bit loop for LogBin) and for the NumberFormat
+ *              kernel that replaced it.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include "CNumberFormat.hpp"
+
+using namespace lap::log;
+using namespace std::chrono;
+
+static constexpr int ITERATIONS = 2000000;
+
+static volatile size_t g_sink = 0;
+
+/**
+ * @brief Deterministic inputs spread over the full value range of the type
+ */
+static std::vector<uint64_t> makeInputs() {
+    std::vector<uint64_t> values(1024);
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < values.size(); ++i) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        values[i] = x >> (i % 64);
+    }
+    return values;
+}
+
+template < typename Fn >
+static double measure(const std::vector<uint64_t>& inputs, Fn&& fn) {
+    char buffer[400];
+    size_t total = 0;
+
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        size_t len = fn(buffer, inputs[i & 1023]);
+        // Treat the whole buffer as read so no store of the kernel is elided
+        asm volatile("" : : "r"(buffer) : "memory");
+        total += len;
+    }
+    auto end = high_resolution_clock::now();
+
+    g_sink = total;
+    return static_cast<double>(duration_cast<nanoseconds>(end - start).count()) / ITERATIONS;
+}
+
+template < typename SnprintfFn, typename KernelFn >
+static void compare(const char* name, const std::vector<uint64_t>& inputs, SnprintfFn&& reference, KernelFn&& kernel) {
+    double refNs = measure(inputs, reference);
+    double newNs = measure(inputs, kernel);
+
+    std::cout << "  " << std::left << std::setw(10) << name
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << refNs << " ns"
+              << std::setw(10) << newNs << " ns"
+              << std::setw(9) << refNs / newNs << "x" << std::endl;
+}
+
+int main() {
+    const auto inputs = makeInputs();
+    const size_t cap = 400;
+
+    std::cout << "\n=== Benchmark: Numeric Formatting (" << ITERATIONS << " values per row) ===" << std::endl;
+    std::cout << "  " << std::left << std::setw(10) << "type"
+              << std::right << std::setw(13) << "snprintf" << std::setw(13) << "kernel"
+              << std::setw(10) << "speedup" << std::endl;
+
+    compare("UInt8", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "%u", static_cast<unsigned>(static_cast<uint8_t>(v)))); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatUInt(b, static_cast<uint8_t>(v)); });
+    compare("UInt16", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "%u", static_cast<unsigned>(static_cast<uint16_t>(v)))); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatUInt(b, static_cast<uint16_t>(v)); });
+    compare("UInt32", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "%u", static_cast<uint32_t>(v))); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatUInt(b, static_cast<uint32_t>(v)); });
+    compare("UInt64", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "%lu", v)); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatUInt(b, v); });
+
+    compare("Int8", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "%d", static_cast<int>(static_cast<int8_t>(v)))); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatInt(b, static_cast<int8_t>(v)); });
+    compare("Int16", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "%d", static_cast<int>(static_cast<int16_t>(v)))); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatInt(b, static_cast<int16_t>(v)); });
+    compare("Int32", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "%d", static_cast<int32_t>(v))); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatInt(b, static_cast<int32_t>(v)); });
+    compare("Int64", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "%ld", static_cast<int64_t>(v))); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatInt(b, static_cast<int64_t>(v)); });
+
+    // Floating point inputs: magnitudes from 1e-3 to 1e6
+    auto toReal = [](uint64_t v) { return static_cast<double>(v % 1000000007ULL) / static_cast<double>(1 + (v >> 54)); };
+    compare("Float", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "%.6f", static_cast<double>(static_cast<float>(toReal(v))))); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatFloat(b, cap, static_cast<float>(toReal(v))); });
+    compare("Double", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "%.12f", toReal(v))); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatDouble(b, cap, toReal(v)); });
+
+    compare("LogHex8", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "0x%02X", static_cast<unsigned>(static_cast<uint8_t>(v)))); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatHex(b, static_cast<uint8_t>(v), 1); });
+    compare("LogHex16", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "0x%04X", static_cast<unsigned>(static_cast<uint16_t>(v)))); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatHex(b, static_cast<uint16_t>(v), 2); });
+    compare("LogHex32", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "0x%08X", static_cast<uint32_t>(v))); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatHex(b, static_cast<uint32_t>(v), 4); });
+    compare("LogHex64", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "0x%016lX", v)); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatHex(b, v, 8); });
+
+    // Binary: reference is the per-bit loop LogBin8 used before
+    auto bitLoop = [](char* b, uint64_t v, int bits) {
+        size_t pos = 0;
+        b[pos++] = '0';
+        b[pos++] = 'b';
+        for (int i = bits - 1; i >= 0; i--) {
+            b[pos++] = ((v >> i) & 1) ? '1' : '0';
+        }
+        return pos;
+    };
+    compare("LogBin8", inputs,
+        [&](char* b, uint64_t v) { return bitLoop(b, v, 8); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatBin(b, static_cast<uint8_t>(v), 1, false); });
+    compare("LogBin16", inputs,
+        [&](char* b, uint64_t v) { return bitLoop(b, v, 16); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatBin(b, static_cast<uint16_t>(v), 2, false); });
+    compare("LogBin32", inputs,
+        [&](char* b, uint64_t v) { return bitLoop(b, v, 32); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatBin(b, static_cast<uint32_t>(v), 4, false); });
+    compare("LogBin64", inputs,
+        [&](char* b, uint64_t v) { return bitLoop(b, v, 64); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatBin(b, v, 8, false); });
+    compare("LogBin64/g", inputs,
+        [&](char* b, uint64_t v) { return bitLoop(b, v, 64); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatBin(b, v, 8, true); });
+
+    // Alternative float modes (not printf compatible, opt-in via "floatFormat")
+    NumberFormat::FloatConfig config;
+    config.format = FloatFormat::kShortest;
+    NumberFormat::setFloatConfig(config);
+    compare("Double/sh", inputs,
+        [&](char* b, uint64_t v) { return static_cast<size_t>(std::snprintf(b, cap, "%.17g", toReal(v))); },
+        [&](char* b, uint64_t v) { return NumberFormat::formatDouble(b, cap, toReal(v)); });
+
+    return 0;
+}
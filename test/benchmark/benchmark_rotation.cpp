@@ -0,0 +1,159 @@
+/**
+ * @file        benchmark_rotation.cpp
+ * @brief       FileSink write latency across rotation boundaries: inline vs background rotation
+ * @date        2026-10-16
+ *
+ * @details     Every write() is timed. Small files (256 KiB, 10 backups) make the
+ *              rotation boundary frequent enough to show up in the tail:
+ *              - rotation writes: the records whose write() switched files
+ *              - 4 threads: writers share the sink through SinkManager, so a
+ *                thread rotating inline stalls everyone queued behind the sink lock
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CSinkManager.hpp"
+#include "CFileSink.hpp"
+
+using namespace lap::log;
+using namespace lap::core;
+using namespace std::chrono;
+
+static constexpr int RECORDS = 200000;
+static constexpr int THREADS = 4;
+static constexpr Size MAX_SIZE = 256 * 1024;
+static constexpr UInt32 BACKUPS = 10;
+static const char* PATH = "/tmp/lap_bench_rotation.log";
+
+static void removeFiles() {
+    std::remove(PATH);
+    for (UInt32 i = 1; i <= BACKUPS; ++i) {
+        std::remove((std::string(PATH) + "." + std::to_string(i)).c_str());
+    }
+}
+
+static std::unique_ptr<FileSink> makeSink(bool background, bool buffered) {
+    FileBufferConfig buffer;
+    if (buffered) {
+        buffer.bufferSize = 64 * 1024;
+    }
+    FileRotationConfig rotation;
+    rotation.background = background;
+    return std::make_unique<FileSink>(PATH, MAX_SIZE, BACKUPS, LogLevel::kVerbose, "BNCH", buffer, rotation);
+}
+
+static double percentile(std::vector<UInt64>& samples, double p) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    const Size index = std::min(samples.size() - 1, static_cast<Size>(p / 100.0 * static_cast<double>(samples.size())));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index), samples.end());
+    return static_cast<double>(samples[index]) / 1000.0;
+}
+
+static void report(const char* name, std::vector<UInt64>& all, std::vector<UInt64>& rotations) {
+    const double maxUs = all.empty() ? 0.0 : static_cast<double>(*std::max_element(all.begin(), all.end())) / 1000.0;
+    const double rotP50 = percentile(rotations, 50.0);
+    const double rotMax = rotations.empty() ? 0.0 : static_cast<double>(*std::max_element(rotations.begin(), rotations.end())) / 1000.0;
+    std::cout << "  " << std::left << std::setw(30) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(9) << percentile(all, 50.0)
+              << std::setw(9) << percentile(all, 99.0)
+              << std::setw(10) << percentile(all, 99.9)
+              << std::setw(10) << maxUs
+              << std::setw(7) << rotations.size()
+              << std::setw(11) << rotP50
+              << std::setw(11) << rotMax << std::endl;
+}
+
+// One thread, direct sink: the rotating write itself
+static void runSingle(const char* name, bool background, bool buffered) {
+    removeFiles();
+    auto sink = makeSink(background, buffered);
+    std::vector<UInt64> all;
+    std::vector<UInt64> rotations;
+    all.reserve(RECORDS);
+
+    for (int i = 0; i < RECORDS; ++i) {
+        const std::string msg = "Request " + std::to_string(i) + " processed in " + std::to_string(i % 500) + " us, status=OK";
+        const Size before = sink->getCurrentSize();
+        const auto start = steady_clock::now();
+        sink->write(0, 0, static_cast<LogLevelType>(LogLevel::kInfo), "ROT", msg);
+        const UInt64 ns = static_cast<UInt64>(duration_cast<nanoseconds>(steady_clock::now() - start).count());
+        all.push_back(ns);
+        if (sink->getCurrentSize() < before) {
+            rotations.push_back(ns);
+        }
+    }
+    sink.reset();
+    report(name, all, rotations);
+    removeFiles();
+}
+
+// Several threads through SinkManager: everyone behind the rotating writer waits
+static void runShared(const char* name, bool background) {
+    removeFiles();
+    SinkManager sinks;
+    sinks.addSink(makeSink(background, false));
+
+    std::vector<std::vector<UInt64>> perThread(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&sinks, &perThread, t]() {
+            auto& samples = perThread[t];
+            samples.reserve(RECORDS / THREADS);
+            for (int i = 0; i < RECORDS / THREADS; ++i) {
+                const std::string msg = "Thread " + std::to_string(t) + " request " + std::to_string(i) + " status=OK";
+                alignas(LogEntry) char storage[sizeof(LogEntry) + 128];
+                LogEntry* entry = new (storage) LogEntry();
+                entry->timestamp = 0;
+                entry->threadId = static_cast<UInt32>(t);
+                entry->level = static_cast<LogLevelType>(LogLevel::kInfo);
+                entry->contextIdLen = 3;
+                entry->messageLen = static_cast<UInt16>(msg.size());
+                std::memcpy(storage + sizeof(LogEntry), "ROT", 3);
+                std::memcpy(storage + sizeof(LogEntry) + 3, msg.data(), msg.size());
+                const auto start = steady_clock::now();
+                sinks.write(*entry);
+                samples.push_back(static_cast<UInt64>(duration_cast<nanoseconds>(steady_clock::now() - start).count()));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    sinks.clearAll();
+
+    std::vector<UInt64> all;
+    for (auto& samples : perThread) {
+        all.insert(all.end(), samples.begin(), samples.end());
+    }
+    std::vector<UInt64> none;
+    report(name, all, none);
+    removeFiles();
+}
+
+int main() {
+    std::cout << "\n=== Benchmark: FileSink rotation (" << RECORDS << " records, "
+              << MAX_SIZE / 1024 << " KiB files, " << BACKUPS << " backups) ===" << std::endl;
+    std::cout << "  " << std::left << std::setw(30) << "mode (latency in us)" << std::right
+              << std::setw(9) << "p50" << std::setw(9) << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "max"
+              << std::setw(7) << "rot" << std::setw(11) << "rot p50" << std::setw(11) << "rot max" << std::endl;
+
+    runSingle("inline", false, false);
+    runSingle("background", true, false);
+    runSingle("inline, 64 KiB buffer", false, true);
+    runSingle("background, 64 KiB buffer", true, true);
+    runShared("inline, 4 threads", false);
+    runShared("background, 4 threads", true);
+
+    return 0;
+}
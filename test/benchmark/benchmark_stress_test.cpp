@@ -4,8 +4,12 @@
 #include <vector>
 #include <atomic>
 #include <iomanip>
+#include <cstring>
+#include <new>
 #include "CLogManager.hpp"
 #include "CLogger.hpp"
+#include "CSinkManager.hpp"
+#include "CAsyncLogQueue.hpp"
 #include <lap/core/CInitialization.hpp>
 
 using namespace lap::log;
@@ -278,6 +282,188 @@ void benchmark_sustained_load() {
     printMemoryStats("After Cleanup");
 }
 
+// 慢速计数 Sink：模拟慢速 I/O，按级别统计收到的日志
+class SlowCountingSink : public ISink {
+public:
+    void write(UInt64 timestamp, UInt32 threadId, LogLevelType level,
+               StringView contextId, StringView message) noexcept override {
+        UNUSED(timestamp);
+        UNUSED(threadId);
+        UNUSED(message);
+        if (level < AsyncLogQueue::kLevelCount) {
+            received[level]++;
+        }
+        if (contextId == "LOGQ") {
+            dropReports++;
+        }
+        if (++writes % 64 == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    void flush() noexcept override {}
+    Bool isEnabled() const noexcept override { return true; }
+    StringView getName() const noexcept override { return "SlowCounting"; }
+    void setLevel(LogLevel level) noexcept override { UNUSED(level); }
+    Bool shouldLog(LogLevel level) const noexcept override { UNUSED(level); return true; }
+
+    std::atomic<uint64_t> received[AsyncLogQueue::kLevelCount]{};
+    std::atomic<uint64_t> dropReports{0};
+    uint64_t writes{0};
+};
+
+// 测试场景6：异步队列溢出 (8 线程 VERBOSE/DEBUG/INFO 洪泛 + ERROR 不可丢失)
+bool benchmark_async_overflow() {
+    std::cout << "\n========== Benchmark: Async Queue Overflow (8 flooders + ERROR) ==========\n";
+
+    SinkManager manager;
+    auto sinkHolder = std::make_unique<SlowCountingSink>();
+    auto* sink = sinkHolder.get();
+    manager.addSink(std::move(sinkHolder));
+
+    AsyncLogQueue::Config config;
+    config.ringSize = 64 * 1024;    // Small rings saturate quickly
+    AsyncLogQueue queue(manager, config);
+    queue.start();
+
+    const int numFlooders = 8;
+    const int floodPerThread = 200000;
+    const int numErrors = 20000;
+    const std::string payload = "Flood message that fills the async ring under pressure";
+
+    std::vector<std::thread> threads;
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (int t = 0; t < numFlooders; ++t) {
+        threads.emplace_back([&queue, &payload, t, floodPerThread]() {
+            const LogLevelType levels[] = {
+                static_cast<LogLevelType>(LogLevel::kVerbose),
+                static_cast<LogLevelType>(LogLevel::kDebug),
+                static_cast<LogLevelType>(LogLevel::kInfo),
+                static_cast<LogLevelType>(LogLevel::kWarn)
+            };
+            for (int i = 0; i < floodPerThread; ++i) {
+                queue.push(0, 0, levels[(t + i) % 4], "FLOD", payload);
+            }
+        });
+    }
+
+    // ERROR 生产者：与洪泛线程竞争，记录自身的最大阻塞时间
+    int64_t maxErrorWaitUs = 0;
+    int errorsRejected = 0;
+    threads.emplace_back([&queue, &maxErrorWaitUs, &errorsRejected, numErrors]() {
+        for (int i = 0; i < numErrors; ++i) {
+            auto t0 = std::chrono::steady_clock::now();
+            if (!queue.push(0, 0, static_cast<LogLevelType>(LogLevel::kError), "ERRS",
+                            "Error record #" + std::to_string(i))) {
+                errorsRejected++;   // Would be written synchronously by LogStream
+            }
+            auto waited = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - t0).count();
+            maxErrorWaitUs = std::max<int64_t>(maxErrorWaitUs, waited);
+        }
+    });
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto produced = std::chrono::high_resolution_clock::now();
+    queue.stop();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    auto stats = queue.getStats();
+    auto produceMs = std::chrono::duration_cast<std::chrono::milliseconds>(produced - start).count();
+    auto totalMs = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    uint64_t errorsReceived = sink->received[static_cast<size_t>(LogLevel::kError)].load();
+
+    std::cout << "Produced " << (numFlooders * floodPerThread + numErrors) << " records in " << produceMs
+              << "ms (drained after " << totalMs << "ms)\n"
+              << "Dispatched: " << stats.processedCount << ", dropped: " << stats.droppedTotal
+              << ", drop reports: " << sink->dropReports.load() << "\n";
+    for (size_t level = static_cast<size_t>(LogLevel::kFatal); level < AsyncLogQueue::kLevelCount; ++level) {
+        std::cout << "  " << std::left << std::setw(8) << toString(static_cast<LogLevel>(level)).data()
+                  << " policy=" << std::setw(11) << toString(config.levelPolicy[level]).data()
+                  << " received=" << std::setw(9) << sink->received[level].load()
+                  << " dropped=" << stats.droppedCount[level] << "\n";
+    }
+    std::cout << "Max ERROR push latency: " << maxErrorWaitUs << " μs\n";
+
+    // 每条 ERROR 必须到达 sink（被拒绝的由调用方同步写出）
+    bool ok = (stats.droppedCount[static_cast<size_t>(LogLevel::kError)] == 0) &&
+              (errorsReceived + errorsRejected == static_cast<uint64_t>(numErrors));
+    std::cout << "ERROR records: sent=" << numErrors << " received=" << errorsReceived
+              << " sync-fallback=" << errorsRejected << " -> " << (ok ? "PASS" : "FAIL") << "\n";
+    return ok;
+}
+
+// 空 Sink：只计数，自身线程安全，用于测量 SinkManager 分发开销
+class NullSink : public ISink {
+public:
+    void write(UInt64 timestamp, UInt32 threadId, LogLevelType level,
+               StringView contextId, StringView message) noexcept override {
+        UNUSED(timestamp);
+        UNUSED(threadId);
+        UNUSED(level);
+        UNUSED(contextId);
+        UNUSED(message);
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void flush() noexcept override {}
+    Bool isEnabled() const noexcept override { return true; }
+    StringView getName() const noexcept override { return "Null"; }
+    void setLevel(LogLevel level) noexcept override { UNUSED(level); }
+    Bool shouldLog(LogLevel level) const noexcept override { UNUSED(level); return true; }
+    Bool isThreadSafe() const noexcept override { return true; }
+
+    std::atomic<uint64_t> count{0};
+};
+
+// 测试场景7：SinkManager 分发竞争 (1/10/50 线程，线程安全的空 Sink)
+void benchmark_sink_dispatch() {
+    std::cout << "\n========== Benchmark: SinkManager Dispatch (1/10/50 threads) ==========\n";
+
+    const int totalLogs = 2000000;
+    const std::string message = "Sink dispatch benchmark message";
+
+    alignas(64) char storage[sizeof(LogEntry) + 64];
+    LogEntry* entry = new (storage) LogEntry();
+    entry->level = static_cast<LogLevelType>(LogLevel::kInfo);
+    entry->contextIdLen = 4;
+    entry->messageLen = static_cast<UInt16>(message.size());
+    std::memcpy(storage + sizeof(LogEntry), "DISP", 4);
+    std::memcpy(storage + sizeof(LogEntry) + 4, message.data(), message.size());
+
+    for (int numThreads : {1, 10, 50}) {
+        SinkManager manager;
+        manager.addSink(std::make_unique<NullSink>());
+        manager.addSink(std::make_unique<NullSink>());
+
+        const int logsPerThread = totalLogs / numThreads;
+        std::vector<std::thread> threads;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&manager, entry, logsPerThread]() {
+                for (int i = 0; i < logsPerThread; ++i) {
+                    if (manager.shouldLog(LogLevel::kInfo)) {
+                        manager.write(*entry);
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        double ms = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+        uint64_t dispatched = static_cast<uint64_t>(logsPerThread) * numThreads;
+        std::cout << std::setw(3) << numThreads << " threads: " << dispatched << " logs in "
+                  << std::fixed << std::setprecision(1) << ms << "ms, "
+                  << std::setprecision(0) << (dispatched * 1000.0 / ms) << " logs/sec\n";
+    }
+}
+
 int main(int argc, char** argv) {
     std::cout << "========================================\n"
               << "Log System Stress Test & Memory Monitor\n"
@@ -292,6 +478,7 @@ int main(int argc, char** argv) {
     printMemoryStats("Initial");
     
     // 选择要运行的测试
+    bool failed = false;
     if (argc > 1) {
         std::string test = argv[1];
         if (test == "10k") {
@@ -304,14 +491,20 @@ int main(int argc, char** argv) {
             benchmark_high_concurrency();
         } else if (test == "sustained") {
             benchmark_sustained_load();
+        } else if (test == "overflow") {
+            failed = !benchmark_async_overflow();
+        } else if (test == "dispatch") {
+            benchmark_sink_dispatch();
         } else if (test == "all") {
             benchmark_single_thread_10k();
             benchmark_single_thread_100k();
             benchmark_multi_thread_100k();
             benchmark_high_concurrency();
             benchmark_sustained_load();
+            failed = !benchmark_async_overflow();
+            benchmark_sink_dispatch();
         } else {
-            std::cerr << "Usage: " << argv[0] << " [10k|100k|multi|concurrent|sustained|all]\n";
+            std::cerr << "Usage: " << argv[0] << " [10k|100k|multi|concurrent|sustained|overflow|dispatch|all]\n";
             return 1;
         }
     } else {
@@ -321,6 +514,8 @@ int main(int argc, char** argv) {
         benchmark_multi_thread_100k();
         benchmark_high_concurrency();
         benchmark_sustained_load();
+        failed = !benchmark_async_overflow();
+        benchmark_sink_dispatch();
     }
     
     printMemoryStats("Final");
@@ -332,5 +527,5 @@ int main(int argc, char** argv) {
     // Deinitialize Core module
     Deinitialize();
     
-    return 0;
+    return failed ? 1 : 0;
 }
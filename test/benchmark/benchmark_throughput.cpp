@@ -9,6 +9,12 @@
  *              - Multi-threaded write throughput
  *              - Different sink types comparison
  *              - Different log message sizes
+ *              - FileSink unbuffered vs batched writes, write(2) vs io_uring engine
+ *                (CPU and syscalls per million records)
+ *              - FileSink durability policies (throughput and fdatasync calls), with a
+ *                synchronous writer and behind the async queue (idle flushes)
+ *              - ConsoleSink into a pipe: fprintf per record vs writev per record
+ *                vs batched writes
  */
 
 #include <iostream>
@@ -17,12 +23,17 @@
 #include <vector>
 #include <atomic>
 #include <iomanip>
+#include <cstdio>
+#include <sys/resource.h>
+#include <unistd.h>
 #include "CLogManager.hpp"
 #include "CLogger.hpp"
 #include "CSinkManager.hpp"
 #include "CConsoleSink.hpp"
 #include "CFileSink.hpp"
 #include "CSyslogSink.hpp"
+#include "CAsyncLogQueue.hpp"
+#include "CTimestampFormat.hpp"
 #include <lap/core/CInitialization.hpp>
 
 using namespace lap::log;
@@ -45,7 +56,7 @@ static LogEntry* createLogEntry(
     LogEntry* entry = new (mem) LogEntry();
     
     auto now = system_clock::now();
-    entry->timestamp = duration_cast<microseconds>(now.time_since_epoch()).count();
+    entry->timestamp = duration_cast<nanoseconds>(now.time_since_epoch()).count();
     entry->threadId = static_cast<UInt32>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
     entry->level = level;
     entry->contextIdLen = static_cast<UInt16>(contextId.size());
@@ -252,6 +263,258 @@ void benchmarkSinkTypeComparison() {
     }
 }
 
+/**
+ * @brief User + system CPU time of the process (includes io_uring workers), in ms
+ */
+static double processCpuMs() {
+    struct rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0 +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+}
+
+/**
+ * @brief FileSink write batching: one write() per record vs coalesced flushes vs io_uring
+ */
+void benchmarkFileSinkBuffering() {
+    printHeader("File Sink Buffering (Single Thread)");
+    
+    const char* testFile = "/tmp/lap_benchmark_buffered.log";
+    const String message = "Medium length message with some details and context information";
+    const int COUNT = 200000;
+    
+    struct Mode {
+        const char* name;
+        FileBufferConfig config;
+    };
+    std::vector<Mode> modes(5);
+    modes[0].name = "Unbuffered (write per record)";
+    modes[1].name = "Buffered 64KB (PIPE_BUF chunks)";
+    modes[1].config.bufferSize = 64 * 1024;
+    modes[2].name = "Buffered 64KB (flock, one write)";
+    modes[2].config.bufferSize = 64 * 1024;
+    modes[2].config.multiProcess = true;
+    modes[3].name = "Buffered 64KB (io_uring)";
+    modes[3].config.bufferSize = 64 * 1024;
+    modes[3].config.ioEngine = FileIoEngine::kIoUring;
+    modes[4].name = "Buffered 4KB (io_uring)";
+    modes[4].config.bufferSize = 4 * 1024;
+    modes[4].config.ioEngine = FileIoEngine::kIoUring;
+    
+    uint64_t baseline = 0;
+    for (const auto& mode : modes) {
+        ::unlink(testFile);
+        FileSink sink(testFile, 0, 1, LogLevel::kVerbose, "BNCH", mode.config);
+        
+        const double cpuStart = processCpuMs();
+        auto start = high_resolution_clock::now();
+        for (int i = 0; i < COUNT; ++i) {
+            sink.write(static_cast<UInt64>(i), 0, static_cast<lap::log::LogLevelType>(0x04), "BUF", message);
+        }
+        sink.flush();
+        auto end = high_resolution_clock::now();
+        const double cpuMs = processCpuMs() - cpuStart;
+        const FileIoStats io = sink.getIoStats();
+        
+        auto durationUs = duration_cast<microseconds>(end - start).count();
+        uint64_t throughput = (COUNT * 1000000ULL) / static_cast<uint64_t>(durationUs > 0 ? durationUs : 1);
+        if (baseline == 0) {
+            baseline = throughput;
+        }
+        printResult(mode.name, COUNT, durationUs / 1000.0, throughput);
+        std::cout << "    speedup vs unbuffered: " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(throughput) / static_cast<double>(baseline) << "x" << std::endl;
+        const double perMillion = 1000000.0 / COUNT;
+        std::cout << "    per 1M records: CPU " << std::setprecision(1) << cpuMs * perMillion << " ms, "
+                  << std::setprecision(0) << static_cast<double>(io.writeCalls) * perMillion << " write(2), "
+                  << static_cast<double>(io.ringEnters) * perMillion << " io_uring_enter(2)" << std::endl;
+    }
+    
+    ::unlink(testFile);
+}
+
+/**
+ * @brief ConsoleSink into a pipe (as under docker/systemd): stdio vs writev vs batches
+ *
+ * stderr is pointed at a pipe drained by a reader thread for each mode, so
+ * nothing reaches the terminal and the cost of the reading side is included.
+ */
+void benchmarkConsoleThroughput() {
+    printHeader("Console Sink Throughput (stderr redirected to a pipe)");
+    
+    const String message = "Medium length message with some details and context information";
+    const int COUNT = 200000;
+    const int THREADS = 4;
+    
+    struct Mode {
+        const char* name;
+        bool stdio;             // Reference: the former fprintf(stderr) per record
+        ConsoleConfig config;
+        int threads;
+    };
+    std::vector<Mode> modes(5);
+    modes[0] = { "fprintf(stderr) per record", true, ConsoleConfig(), 1 };
+    modes[1] = { "ConsoleSink writev per record", false, ConsoleConfig(), 1 };
+    modes[2] = { "ConsoleSink batched 64KB", false, ConsoleConfig(), 1 };
+    modes[2].config.bufferSize = 64 * 1024;
+    modes[3] = { "ConsoleSink writev, 4 threads", false, ConsoleConfig(), THREADS };
+    modes[4] = { "ConsoleSink batched 64KB, 4 threads", false, ConsoleConfig(), THREADS };
+    modes[4].config.bufferSize = 64 * 1024;
+    
+    uint64_t baseline = 0;
+    for (const auto& mode : modes) {
+        int pipeFds[2];
+        if (::pipe(pipeFds) != 0) {
+            std::cerr << "pipe() failed, console benchmark skipped" << std::endl;
+            return;
+        }
+        std::atomic<uint64_t> bytesRead{0};
+        std::thread reader([&bytesRead, fd = pipeFds[0]] {
+            char buffer[64 * 1024];
+            ssize_t n;
+            while ((n = ::read(fd, buffer, sizeof(buffer))) > 0) {
+                bytesRead += static_cast<uint64_t>(n);
+            }
+        });
+        
+        std::cout.flush();
+        std::fflush(stderr);
+        const int savedStderr = ::dup(STDERR_FILENO);
+        ::dup2(pipeFds[1], STDERR_FILENO);
+        
+        const double cpuStart = processCpuMs();
+        auto start = high_resolution_clock::now();
+        if (mode.stdio) {
+            char timeBuffer[TimestampFormat::kMaxTimeChars + 1];
+            for (int i = 0; i < COUNT; ++i) {
+                timeBuffer[TimestampFormat::formatTime(timeBuffer, static_cast<UInt64>(i))] = '\0';
+                fprintf(stderr, "%s%s[%s] [%s] [%.*s]%.*s%s %.*s\n", "", "", timeBuffer, "INFO ",
+                        3, "CON", 0, "", "", static_cast<int>(message.size()), message.data());
+            }
+        } else {
+            SinkManager manager;
+            manager.addSink(std::make_unique<ConsoleSink>(true, LogLevel::kVerbose, mode.config));
+            std::vector<std::thread> threads;
+            for (int t = 0; t < mode.threads; ++t) {
+                threads.emplace_back([&manager, &message, perThread = COUNT / mode.threads] {
+                    auto* entry = createLogEntry(static_cast<lap::log::LogLevelType>(0x04), "CON", message.c_str());
+                    for (int i = 0; i < perThread; ++i) {
+                        manager.write(*entry);
+                    }
+                    ::operator delete(entry);
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            manager.flushAll();
+        }
+        auto end = high_resolution_clock::now();
+        
+        // Restore stderr; closing the last write end lets the reader finish
+        ::dup2(savedStderr, STDERR_FILENO);
+        ::close(savedStderr);
+        ::close(pipeFds[1]);
+        reader.join();
+        ::close(pipeFds[0]);
+        const double cpuMs = processCpuMs() - cpuStart;
+        
+        auto durationUs = duration_cast<microseconds>(end - start).count();
+        uint64_t throughput = (COUNT * 1000000ULL) / static_cast<uint64_t>(durationUs > 0 ? durationUs : 1);
+        if (baseline == 0) {
+            baseline = throughput;
+        }
+        printResult(mode.name, COUNT, durationUs / 1000.0, throughput);
+        const double perMillion = 1000000.0 / COUNT;
+        const uint64_t writes = mode.config.bufferSize == 0 ? COUNT : bytesRead.load() / mode.config.bufferSize + 1;
+        std::cout << "    speedup vs fprintf: " << std::fixed << std::setprecision(2)
+                  << static_cast<double>(throughput) / static_cast<double>(baseline) << "x, "
+                  << "per 1M records: CPU " << std::setprecision(1) << cpuMs * perMillion << " ms, ~"
+                  << std::setprecision(0) << static_cast<double>(writes) * perMillion << " write(2)" << std::endl;
+    }
+}
+
+/**
+ * @brief FileSink durability: what each sync policy costs a single writer
+ */
+void benchmarkFileSinkDurability() {
+    printHeader("File Sink Durability (Single Thread, 64KB buffer)");
+    
+    const char* testFile = "/tmp/lap_benchmark_durability.log";
+    const String message = "Medium length message with some details and context information";
+    const int COUNT = 200000;
+    
+    struct Mode {
+        const char* name;
+        FileSyncConfig config;
+        int errorEvery;     // Every Nth record is an ERROR, 0 = none
+    };
+    std::vector<Mode> modes(6);
+    modes[0].name = "none";
+    modes[1].name = "periodic 1000 ms";
+    modes[1].config.policy = FileSyncPolicy::kPeriodic;
+    modes[2].name = "periodic 100 ms";
+    modes[2].config.policy = FileSyncPolicy::kPeriodic;
+    modes[2].config.intervalMs = 100;
+    modes[3].name = "error (1% ERROR records)";
+    modes[3].config.policy = FileSyncPolicy::kOnError;
+    modes[3].errorEvery = 100;
+    modes[4].name = "bytes 1 MiB";
+    modes[4].config.policy = FileSyncPolicy::kEveryBytes;
+    modes[5].name = "bytes 64 KiB";
+    modes[5].config.policy = FileSyncPolicy::kEveryBytes;
+    modes[5].config.everyBytes = 64 * 1024;
+    
+    // Async: the producer pauses every PAUSE_EVERY records, the worker goes idle and
+    // calls flushAll() each time, as it does between bursts in an application
+    const int PAUSE_EVERY = 1000;
+    
+    FileBufferConfig buffer;
+    buffer.bufferSize = 64 * 1024;
+    for (const auto& mode : modes) {
+        for (int async = 0; async < 2; ++async) {
+            ::unlink(testFile);
+            SinkManager manager;
+            manager.addSink(std::make_unique<FileSink>(testFile, 0, 1, LogLevel::kVerbose, "BNCH", buffer,
+                                                       FileRotationConfig(), mode.config));
+            FileSink* sink = static_cast<FileSink*>(manager.getSink("File"));
+            AsyncLogQueue queue(manager);
+            if (async && !queue.start()) {
+                continue;
+            }
+            
+            auto start = high_resolution_clock::now();
+            for (int i = 0; i < COUNT; ++i) {
+                const bool error = mode.errorEvery > 0 && i % mode.errorEvery == 0;
+                const auto level = static_cast<lap::log::LogLevelType>(error ? 0x02 : 0x04);
+                if (async) {
+                    queue.push(static_cast<UInt64>(i), 0, level, "DUR", message);
+                    if (i % PAUSE_EVERY == PAUSE_EVERY - 1) {
+                        std::this_thread::sleep_for(microseconds(200));
+                    }
+                } else {
+                    sink->write(static_cast<UInt64>(i), 0, level, "DUR", message);
+                }
+            }
+            if (async) {
+                queue.flush();
+            }
+            sink->sync();
+            auto end = high_resolution_clock::now();
+            if (async) {
+                queue.stop();
+            }
+            
+            auto durationUs = duration_cast<microseconds>(end - start).count();
+            uint64_t throughput = (COUNT * 1000000ULL) / static_cast<uint64_t>(durationUs > 0 ? durationUs : 1);
+            printResult(String(mode.name) + (async ? " (async)" : ""), COUNT, durationUs / 1000.0, throughput);
+            std::cout << "    fdatasync calls: " << sink->getIoStats().syncCalls << std::endl;
+        }
+    }
+    
+    ::unlink(testFile);
+}
+
 /**
  * @brief Sustained throughput test
  */
@@ -316,6 +579,9 @@ int main() {
         benchmarkFileSinkThroughput();
         benchmarkMultiThreadedThroughput();
         benchmarkSinkTypeComparison();
+        benchmarkFileSinkBuffering();
+        benchmarkFileSinkDurability();
+        benchmarkConsoleThroughput();
         benchmarkSustainedThroughput();
         
         std::cout << "\n" << std::string(70, '=') << std::endl;
@@ -0,0 +1,117 @@
+/**
+ * @file        benchmark_timestamp.cpp
+ * @brief       Per-record timestamp formatting cost: localtime_r + snprintf vs TimestampFormat
+ * @date        2026-10-16
+ *
+ * @details     Rows:
+ *              - FileSink date/time prefix "YYYY-MM-DD HH:MM:SS.mmm"
+ *              - ConsoleSink time prefix "HH:MM:SS.mmm"
+ *              - FileSink prefix with nanosecond digits
+ *              Each row is measured at 1 us between records (cache hit on
+ *              almost every record, the high-rate case) and at 1 s between
+ *              records (cache miss on every record, the worst case).
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
+#include "CTimestampFormat.hpp"
+
+using namespace lap::log;
+using namespace std::chrono;
+
+static constexpr int ITERATIONS = 2000000;
+
+static volatile size_t g_sink = 0;
+
+static size_t referenceDateTime(char* out, uint64_t ns) {
+    time_t seconds = static_cast<time_t>(ns / 1000000000);
+    struct tm tmInfo;
+    localtime_r(&seconds, &tmInfo);
+    return static_cast<size_t>(std::snprintf(out, 64, "%04d-%02d-%02d %02d:%02d:%02d.%03u",
+        tmInfo.tm_year + 1900, tmInfo.tm_mon + 1, tmInfo.tm_mday,
+        tmInfo.tm_hour, tmInfo.tm_min, tmInfo.tm_sec,
+        static_cast<unsigned>(ns % 1000000000 / 1000000)));
+}
+
+static size_t referenceDateTimeNanos(char* out, uint64_t ns) {
+    time_t seconds = static_cast<time_t>(ns / 1000000000);
+    struct tm tmInfo;
+    localtime_r(&seconds, &tmInfo);
+    return static_cast<size_t>(std::snprintf(out, 64, "%04d-%02d-%02d %02d:%02d:%02d.%09u",
+        tmInfo.tm_year + 1900, tmInfo.tm_mon + 1, tmInfo.tm_mday,
+        tmInfo.tm_hour, tmInfo.tm_min, tmInfo.tm_sec,
+        static_cast<unsigned>(ns % 1000000000)));
+}
+
+static size_t referenceTime(char* out, uint64_t ns) {
+    time_t seconds = static_cast<time_t>(ns / 1000000000);
+    struct tm tmInfo;
+    localtime_r(&seconds, &tmInfo);
+    return static_cast<size_t>(std::snprintf(out, 16, "%02d:%02d:%02d.%03u",
+        tmInfo.tm_hour, tmInfo.tm_min, tmInfo.tm_sec,
+        static_cast<unsigned>(ns % 1000000000 / 1000000)));
+}
+
+template < typename Fn >
+static double measure(uint64_t stepNs, Fn&& fn) {
+    char buffer[64];
+    size_t total = 0;
+    uint64_t ns = static_cast<uint64_t>(duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count());
+
+    auto start = high_resolution_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        total += fn(buffer, ns);
+        asm volatile("" : : "r"(buffer) : "memory");
+        ns += stepNs;
+    }
+    auto end = high_resolution_clock::now();
+
+    g_sink = total;
+    return static_cast<double>(duration_cast<nanoseconds>(end - start).count()) / ITERATIONS;
+}
+
+template < typename RefFn, typename CachedFn >
+static void compare(const char* name, uint64_t stepNs, RefFn&& reference, CachedFn&& cached) {
+    double refNs = measure(stepNs, reference);
+    double newNs = measure(stepNs, cached);
+
+    std::cout << "  " << std::left << std::setw(22) << name
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << refNs << " ns"
+              << std::setw(10) << newNs << " ns"
+              << std::setw(9) << refNs / newNs << "x" << std::endl;
+}
+
+int main() {
+    tzset();
+
+    std::cout << "\n=== Benchmark: Timestamp Formatting (" << ITERATIONS << " records per row) ===" << std::endl;
+    std::cout << "  " << std::left << std::setw(22) << "prefix / record gap"
+              << std::right << std::setw(13) << "localtime_r" << std::setw(13) << "cached"
+              << std::setw(10) << "speedup" << std::endl;
+
+    compare("date+time / 1us", 1000,
+        [](char* b, uint64_t ns) { return referenceDateTime(b, ns); },
+        [](char* b, uint64_t ns) { return TimestampFormat::formatDateTime(b, ns); });
+    compare("time / 1us", 1000,
+        [](char* b, uint64_t ns) { return referenceTime(b, ns); },
+        [](char* b, uint64_t ns) { return TimestampFormat::formatTime(b, ns); });
+    compare("date+time / 1s", 1000000000,
+        [](char* b, uint64_t ns) { return referenceDateTime(b, ns); },
+        [](char* b, uint64_t ns) { return TimestampFormat::formatDateTime(b, ns); });
+    compare("time / 1s", 1000000000,
+        [](char* b, uint64_t ns) { return referenceTime(b, ns); },
+        [](char* b, uint64_t ns) { return TimestampFormat::formatTime(b, ns); });
+
+    // Nanosecond digits ("precision": "ns")
+    TimestampFormat::setPrecision(TimestampPrecision::kNano);
+    compare("date+time ns / 1us", 1000,
+        [](char* b, uint64_t ns) { return referenceDateTimeNanos(b, ns); },
+        [](char* b, uint64_t ns) { return TimestampFormat::formatDateTime(b, ns); });
+
+    return 0;
+}
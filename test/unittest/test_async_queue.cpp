@@ -0,0 +1,391 @@
+/**
+ * @file        test_async_queue.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       AsyncLogQueue (per-thread SPSC rings + sink worker) tests
+ * @date        2026-10-16
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <string>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include "CAsyncLogQueue.hpp"
+#include "CSinkManager.hpp"
+#include "CArgEncoding.hpp"
+
+using namespace lap::log;
+using namespace lap::core;
+
+namespace
+{
+    // Sink that records every message it receives
+    class CaptureSink : public ISink
+    {
+    public:
+        void write(UInt64 timestamp, UInt32 threadId, LogLevelType level,
+                   StringView contextId, StringView message) noexcept override
+        {
+            UNUSED(timestamp);
+            UNUSED(threadId);
+            UNUSED(level);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_contexts.emplace_back(contextId.data(), contextId.size());
+            m_messages.emplace_back(message.data(), message.size());
+        }
+
+        void flush() noexcept override {}
+        Bool isEnabled() const noexcept override { return true; }
+        StringView getName() const noexcept override { return "Capture"; }
+        void setLevel(LogLevel level) noexcept override { UNUSED(level); }
+        Bool shouldLog(LogLevel level) const noexcept override { UNUSED(level); return true; }
+
+        std::vector<std::string> messages() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_messages;
+        }
+
+        std::vector<std::string> contexts() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_contexts;
+        }
+
+    private:
+        mutable std::mutex          m_mutex;
+        std::vector<std::string>    m_messages;
+        std::vector<std::string>    m_contexts;
+    };
+
+    // Capture sink that holds the worker inside write() until opened
+    class GatedSink : public CaptureSink
+    {
+    public:
+        void write(UInt64 timestamp, UInt32 threadId, LogLevelType level,
+                   StringView contextId, StringView message) noexcept override
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_gateMutex);
+                m_gateCv.wait(lock, [this]() { return m_open; });
+            }
+            CaptureSink::write(timestamp, threadId, level, contextId, message);
+        }
+
+        void open()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_gateMutex);
+                m_open = true;
+            }
+            m_gateCv.notify_all();
+        }
+
+    private:
+        std::mutex              m_gateMutex;
+        std::condition_variable m_gateCv;
+        bool                    m_open{ false };
+    };
+
+    template <typename SinkType = CaptureSink>
+    struct QueueFixture
+    {
+        SinkManager     manager;
+        SinkType*       sink{ nullptr };
+
+        QueueFixture()
+        {
+            auto capture = std::make_unique<SinkType>();
+            sink = capture.get();
+            manager.addSink(std::move(capture));
+        }
+    };
+}
+
+TEST(AsyncLogQueue, StartStop) {
+    QueueFixture<> fx;
+    AsyncLogQueue queue(fx.manager);
+
+    EXPECT_FALSE(queue.isRunning());
+    EXPECT_FALSE(queue.push(0, 0, 0x04, "CTX", "not running"));
+
+    ASSERT_TRUE(queue.start());
+    EXPECT_TRUE(queue.isRunning());
+
+    queue.stop();
+    EXPECT_FALSE(queue.isRunning());
+    EXPECT_TRUE(fx.sink->messages().empty());
+}
+
+TEST(AsyncLogQueue, SingleProducerOrder) {
+    QueueFixture<> fx;
+    AsyncLogQueue queue(fx.manager);
+    ASSERT_TRUE(queue.start());
+
+    const int NUM_LOGS = 1000;
+    for (int i = 0; i < NUM_LOGS; ++i) {
+        std::string msg = "message #" + std::to_string(i);
+        ASSERT_TRUE(queue.push(0, 0, 0x04, "ORDR", msg));
+    }
+
+    EXPECT_TRUE(queue.flush());
+
+    auto messages = fx.sink->messages();
+    ASSERT_EQ(messages.size(), static_cast<size_t>(NUM_LOGS));
+    for (int i = 0; i < NUM_LOGS; ++i) {
+        EXPECT_EQ(messages[i], "message #" + std::to_string(i));
+    }
+    EXPECT_EQ(fx.sink->contexts().front(), "ORDR");
+
+    auto stats = queue.getStats();
+    EXPECT_EQ(stats.enqueuedCount, static_cast<UInt64>(NUM_LOGS));
+    EXPECT_EQ(stats.processedCount, static_cast<UInt64>(NUM_LOGS));
+    EXPECT_EQ(stats.rejectedCount, 0u);
+
+    queue.stop();
+}
+
+TEST(AsyncLogQueue, MultiProducerPerThreadOrder) {
+    QueueFixture<> fx;
+    AsyncLogQueue::Config config;
+    config.ringSize = 8192;     // Small rings: producers must wait for the worker
+    config.setPolicy(OverflowPolicy::kBlock);
+    AsyncLogQueue queue(fx.manager, config);
+    ASSERT_TRUE(queue.start());
+
+    const int NUM_THREADS = 8;
+    const int LOGS_PER_THREAD = 5000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&queue, t]() {
+            for (int i = 0; i < LOGS_PER_THREAD; ++i) {
+                std::string msg = std::to_string(t) + ":" + std::to_string(i);
+                queue.push(0, 0, 0x04, "MTHR", msg);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // stop() must drain everything, including rings of exited threads
+    queue.stop();
+
+    auto messages = fx.sink->messages();
+    ASSERT_EQ(messages.size(), static_cast<size_t>(NUM_THREADS * LOGS_PER_THREAD));
+
+    // Records of one producer keep their order
+    std::vector<int> next(NUM_THREADS, 0);
+    for (const auto& msg : messages) {
+        auto sep = msg.find(':');
+        int t = std::stoi(msg.substr(0, sep));
+        int i = std::stoi(msg.substr(sep + 1));
+        EXPECT_EQ(i, next[t]);
+        next[t] = i + 1;
+    }
+}
+
+TEST(AsyncLogQueue, StopRacingProducersLosesNothing) {
+    // Every record is either queued before the final drain or rejected and written directly
+    for (int round = 0; round < 10; ++round) {
+        QueueFixture<> fx;
+        AsyncLogQueue::Config config;
+        config.setPolicy(OverflowPolicy::kBlock);     // No overflow drops, full rings reject
+        AsyncLogQueue queue(fx.manager, config);
+        ASSERT_TRUE(queue.start());
+
+        const int NUM_THREADS = 4;
+        std::atomic<bool> stop{ false };
+        std::atomic<int> produced{ 0 };
+        std::vector<std::thread> threads;
+        for (int t = 0; t < NUM_THREADS; ++t) {
+            threads.emplace_back([&]() {
+                alignas(64) char storage[sizeof(LogEntry) + 16];
+                LogEntry* entry = new (storage) LogEntry();
+                entry->level = 0x04;
+                entry->contextIdLen = 4;
+                entry->messageLen = 4;
+                std::memcpy(storage + sizeof(LogEntry), "STOPsync", 8);
+
+                // Keeps producing a little past stop() to hit the shutdown window
+                int afterStop = 0;
+                while (afterStop < 100) {
+                    if (!queue.push(0, 0, 0x04, "STOP", "ring")) {
+                        fx.manager.write(*entry);
+                    }
+                    produced.fetch_add(1, std::memory_order_relaxed);
+                    if (stop.load(std::memory_order_relaxed)) {
+                        ++afterStop;
+                    }
+                }
+            });
+        }
+
+        while (produced.load(std::memory_order_relaxed) < 1000) {
+            std::this_thread::yield();
+        }
+        queue.stop();
+        stop = true;
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        ASSERT_EQ(fx.sink->messages().size(), static_cast<size_t>(produced.load()));
+    }
+}
+
+TEST(AsyncLogQueue, WrapAroundKeepsPayload) {
+    QueueFixture<> fx;
+    AsyncLogQueue::Config config;
+    config.ringSize = 4096;
+    config.setPolicy(OverflowPolicy::kBlock);
+    AsyncLogQueue queue(fx.manager, config);
+    ASSERT_TRUE(queue.start());
+
+    // Varying record sizes force padding records at the ring end
+    std::vector<std::string> expected;
+    for (int i = 0; i < 500; ++i) {
+        std::string msg(static_cast<size_t>(1 + (i * 37) % 900), static_cast<char>('a' + i % 26));
+        expected.push_back(msg);
+        ASSERT_TRUE(queue.push(0, 0, 0x04, "WRAP", msg));
+    }
+
+    EXPECT_TRUE(queue.flush());
+    EXPECT_EQ(fx.sink->messages(), expected);
+
+    queue.stop();
+}
+
+TEST(AsyncLogQueue, OversizedRecordRejected) {
+    QueueFixture<> fx;
+    AsyncLogQueue::Config config;
+    config.ringSize = 4096;
+    AsyncLogQueue queue(fx.manager, config);
+    ASSERT_TRUE(queue.start());
+
+    // Larger than half of the ring: caller has to write synchronously
+    std::string huge(3000, 'X');
+    EXPECT_FALSE(queue.push(0, 0, 0x04, "HUGE", huge));
+    EXPECT_EQ(queue.getStats().rejectedCount, 1u);
+
+    queue.stop();
+}
+
+TEST(AsyncLogQueue, DefaultPolicies) {
+    AsyncLogQueue::Config config;
+    EXPECT_EQ(config.policyFor(static_cast<LogLevelType>(LogLevel::kFatal)), OverflowPolicy::kBlock);
+    EXPECT_EQ(config.policyFor(static_cast<LogLevelType>(LogLevel::kError)), OverflowPolicy::kBlock);
+    EXPECT_NE(config.policyFor(static_cast<LogLevelType>(LogLevel::kInfo)), OverflowPolicy::kBlock);
+    EXPECT_NE(config.policyFor(static_cast<LogLevelType>(LogLevel::kVerbose)), OverflowPolicy::kBlock);
+    // Unknown levels are never dropped
+    EXPECT_EQ(config.policyFor(0x7F), OverflowPolicy::kBlock);
+}
+
+TEST(AsyncLogQueue, DropNewestKeepsErrors) {
+    QueueFixture<GatedSink> fx;
+    AsyncLogQueue::Config config;
+    config.ringSize = 4096;
+    config.setPolicy(LogLevel::kInfo, OverflowPolicy::kDropNewest);
+    AsyncLogQueue queue(fx.manager, config);
+    ASSERT_TRUE(queue.start());
+
+    const LogLevelType info  = static_cast<LogLevelType>(LogLevel::kInfo);
+    const LogLevelType error = static_cast<LogLevelType>(LogLevel::kError);
+    const std::string payload(200, 'i');
+
+    // Worker is stuck in the sink: the ring fills and INFO starts dropping
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_TRUE(queue.push(0, 0, info, "DROP", payload));
+    }
+    EXPECT_GT(queue.getDroppedCount(LogLevel::kInfo), 0u);
+
+    // ERROR blocks for room instead of dropping
+    std::thread opener([&fx]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        fx.sink->open();
+    });
+    const int NUM_ERRORS = 50;
+    for (int i = 0; i < NUM_ERRORS; ++i) {
+        EXPECT_TRUE(queue.push(0, 0, error, "DROP", "error #" + std::to_string(i)));
+    }
+    opener.join();
+
+    queue.stop();
+
+    auto messages = fx.sink->messages();
+    int errors = 0;
+    for (const auto& msg : messages) {
+        if (msg.rfind("error #", 0) == 0) {
+            ++errors;
+        }
+    }
+    EXPECT_EQ(errors, NUM_ERRORS);
+    EXPECT_EQ(queue.getDroppedCount(LogLevel::kError), 0u);
+
+    auto stats = queue.getStats();
+    EXPECT_EQ(stats.droppedTotal, stats.droppedCount[static_cast<Size>(LogLevel::kInfo)]);
+    EXPECT_EQ(stats.processedCount + stats.droppedTotal, 200u + NUM_ERRORS);
+
+    // Synthetic summary record once the queue drained
+    auto contexts = fx.sink->contexts();
+    bool reported = false;
+    for (size_t i = 0; i < messages.size(); ++i) {
+        if (contexts[i] == "LOGQ") {
+            EXPECT_NE(messages[i].find(" messages dropped"), std::string::npos);
+            EXPECT_NE(messages[i].find("Info="), std::string::npos);
+            reported = true;
+        }
+    }
+    EXPECT_TRUE(reported);
+}
+
+TEST(AsyncLogQueue, SampleUnderPressure) {
+    QueueFixture<> fx;
+    AsyncLogQueue::Config config;
+    config.sampleRate = 8;
+    config.pressurePercent = 0;     // Always under pressure
+    config.setPolicy(LogLevel::kDebug, OverflowPolicy::kSample);
+    AsyncLogQueue queue(fx.manager, config);
+    ASSERT_TRUE(queue.start());
+
+    const LogLevelType debug = static_cast<LogLevelType>(LogLevel::kDebug);
+    for (int i = 0; i < 80; ++i) {
+        EXPECT_TRUE(queue.push(0, 0, debug, "SMPL", "sample #" + std::to_string(i)));
+    }
+    EXPECT_TRUE(queue.flush());
+
+    auto messages = fx.sink->messages();
+    ASSERT_GE(messages.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(messages[i], "sample #" + std::to_string(i * 8));
+    }
+    EXPECT_EQ(queue.getDroppedCount(LogLevel::kDebug), 70u);
+
+    queue.stop();
+}
+
+TEST(AsyncLogQueue, DeferredRecordsRenderedByWorker) {
+    QueueFixture<> fx;
+    AsyncLogQueue queue(fx.manager);
+    ASSERT_TRUE(queue.start());
+
+    UInt8 buffer[64];
+    ArgEncoder encoder(buffer, sizeof(buffer));
+    encoder.put("", "pid=");
+    encoder.put("", static_cast<Int32>(-42));
+    encoder.put("", LogHex8{ 0xAB });
+    ASSERT_TRUE(queue.push(0, 0, 0x04, "DEFR",
+                           StringView(reinterpret_cast<const char*>(encoder.data()), encoder.size()),
+                           RecordFormat::kArgs));
+    ASSERT_TRUE(queue.push(0, 0, 0x04, "DEFR", "text"));
+    ASSERT_TRUE(queue.flush());
+
+    const std::vector<std::string> expected = { "pid=-420xAB", "text" };
+    EXPECT_EQ(fx.sink->messages(), expected);
+    queue.stop();
+}
@@ -0,0 +1,392 @@
+/**
+ * @file        test_binary_file_sink.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Binary log file sink unit tests
+ * @date        2026-10-16
+ */
+
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "CBinaryFileSink.hpp"
+#include "CModeledMessage.hpp"
+#include "CArgEncoding.hpp"
+
+using namespace lap::log;
+using namespace lap::core;
+
+namespace {
+    struct Record {
+        UInt8 kind;
+        UInt8 level;
+        UInt64 timestamp;
+        UInt32 context;
+        Bool hasThreadId;
+        UInt32 threadId;
+        UInt32 messageId;
+        Bool templated;            // Stored as template and values, kind is the plain kind
+        UInt32 templateIndex;      // Also of kTemplate records
+        std::string payload;       // Context ID for kContext, template for kTemplate records
+        size_t size;               // Bytes on disk incl. length prefix
+    };
+
+    std::vector<UInt8> readFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<UInt8>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    UInt64 readVarint(const std::vector<UInt8>& data, size_t& pos) {
+        UInt64 value = 0;
+        for (int shift = 0; pos < data.size(); shift += 7) {
+            UInt8 byte = data[pos++];
+            value |= static_cast<UInt64>(byte & 0x7F) << shift;
+            if (byte < 0x80) break;
+        }
+        return value;
+    }
+
+    Int64 unzigzag(UInt64 value) {
+        return static_cast<Int64>(value >> 1) ^ -static_cast<Int64>(value & 1);
+    }
+
+    template <typename T>
+    void appendValue(std::string& out, T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    // Payload of a templated record: template with the values put back
+    std::string expand(UInt8 kind, const std::string& shape, const std::vector<UInt8>& data, size_t pos) {
+        std::string out;
+        const auto* s = reinterpret_cast<const UInt8*>(shape.data());
+        size_t i = 0;
+        if (kind == static_cast<UInt8>(BinaryFileSink::RecordKind::kText)) {
+            for (; i < shape.size(); ++i) {
+                if (s[i] == 0) {
+                    out += std::to_string(readVarint(data, pos));
+                } else {
+                    out += static_cast<char>(s[i]);
+                }
+            }
+            return out;
+        }
+        while (i < shape.size()) {
+            const UInt8 tag = s[i];
+            const size_t start = i++;
+            if (tag & kArgNamed) i += 1 + s[i];
+            out.append(shape, start, i - start);
+            const ArgType type = static_cast<ArgType>(tag & kArgTypeMask);
+            if (type == ArgType::kString || type == ArgType::kErrorCode) {
+                if (type == ArgType::kErrorCode) appendValue(out, unzigzag(readVarint(data, pos)));
+                UInt16 len;
+                std::memcpy(&len, s + i, sizeof(len));
+                out.append(shape, i, sizeof(len) + len);
+                i += sizeof(len) + len;
+                continue;
+            }
+            switch (type) {
+                case ArgType::kUInt8:  appendValue(out, static_cast<UInt8>(readVarint(data, pos))); break;
+                case ArgType::kUInt16: appendValue(out, static_cast<UInt16>(readVarint(data, pos))); break;
+                case ArgType::kUInt32: appendValue(out, static_cast<UInt32>(readVarint(data, pos))); break;
+                case ArgType::kUInt64: appendValue(out, static_cast<UInt64>(readVarint(data, pos))); break;
+                case ArgType::kInt8:   appendValue(out, static_cast<Int8>(unzigzag(readVarint(data, pos)))); break;
+                case ArgType::kInt16:  appendValue(out, static_cast<Int16>(unzigzag(readVarint(data, pos)))); break;
+                case ArgType::kInt32:  appendValue(out, static_cast<Int32>(unzigzag(readVarint(data, pos)))); break;
+                case ArgType::kInt64:  appendValue(out, unzigzag(readVarint(data, pos))); break;
+                default: {
+                    const size_t width = ArgView::valueSize(type);
+                    out.append(data.begin() + pos, data.begin() + pos + width);
+                    pos += width;
+                    break;
+                }
+            }
+        }
+        return out;
+    }
+
+    // Minimal reader of doc/design/BinaryLog_Format.md
+    std::vector<Record> parse(const std::vector<UInt8>& data) {
+        std::vector<Record> records;
+        std::vector<std::string> templates;
+        if (data.size() < BinaryFileSink::kHeaderSize) return records;
+        // Default TimestampPrecision::kMilli: deltas count milliseconds
+        const UInt64 unit = 1000000;
+        UInt64 tick;
+        std::memcpy(&tick, data.data() + 16, sizeof(tick));
+        tick /= unit;
+        size_t pos = BinaryFileSink::kHeaderSize;
+        while (pos < data.size()) {
+            const size_t start = pos;
+            const UInt64 len = readVarint(data, pos);
+            if (len == 0) break;
+            const size_t end = pos + len;
+            Record r{};
+            const UInt8 first = data[pos++];
+            r.kind = (first >> 4) & 0x07;
+            r.level = first & 0x0F;
+            if (r.kind == static_cast<UInt8>(BinaryFileSink::RecordKind::kContext)) {
+                r.context = static_cast<UInt32>(readVarint(data, pos));
+            } else if (r.kind == static_cast<UInt8>(BinaryFileSink::RecordKind::kTemplate)) {
+                r.templateIndex = static_cast<UInt32>(readVarint(data, pos));
+                EXPECT_EQ(r.templateIndex, templates.size());
+                templates.emplace_back(data.begin() + pos, data.begin() + end);
+            } else {
+                r.templated = r.kind >= static_cast<UInt8>(BinaryFileSink::RecordKind::kTemplatedText);
+                if (r.templated) r.kind -= 4;
+                const UInt64 zz = readVarint(data, pos);
+                tick += static_cast<UInt64>(static_cast<Int64>(zz >> 1) ^ -static_cast<Int64>(zz & 1));
+                r.timestamp = tick * unit;
+                r.context = static_cast<UInt32>(readVarint(data, pos));
+                r.hasThreadId = (first & BinaryFileSink::kRecordHasThreadId) != 0;
+                if (r.hasThreadId) r.threadId = static_cast<UInt32>(readVarint(data, pos));
+                if (r.kind == static_cast<UInt8>(BinaryFileSink::RecordKind::kModeled)) {
+                    r.messageId = static_cast<UInt32>(readVarint(data, pos));
+                }
+                if (r.templated) {
+                    r.templateIndex = static_cast<UInt32>(readVarint(data, pos));
+                    EXPECT_LT(r.templateIndex, templates.size()) << "template defined later or in another file";
+                    if (r.templateIndex >= templates.size()) break;
+                    r.payload = expand(r.kind, templates[r.templateIndex], data, pos);
+                }
+            }
+            if (!r.templated) r.payload.assign(data.begin() + pos, data.begin() + end);
+            r.size = end - start;
+            pos = end;
+            records.push_back(r);
+        }
+        return records;
+    }
+
+    constexpr UInt8 kContextKind = static_cast<UInt8>(BinaryFileSink::RecordKind::kContext);
+    constexpr UInt8 kTextKind = static_cast<UInt8>(BinaryFileSink::RecordKind::kText);
+    constexpr UInt8 kTemplateKind = static_cast<UInt8>(BinaryFileSink::RecordKind::kTemplate);
+}
+
+class BinaryFileSinkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = "/tmp/lap_binary_sink_" + std::to_string(::getpid()) + ".lapb";
+        cleanup();
+    }
+
+    void TearDown() override {
+        cleanup();
+    }
+
+    void cleanup() {
+        std::remove(path_.c_str());
+        for (int i = 1; i <= 3; ++i) {
+            std::remove((path_ + "." + std::to_string(i)).c_str());
+        }
+    }
+
+    std::string path_;
+};
+
+TEST_F(BinaryFileSinkTest, TextRecordsWithInternedContexts) {
+    const UInt64 t0 = 1760000000000000000ULL;
+    Size used = 0;
+    {
+        BinaryFileSink sink(path_, 0, 3, LogLevel::kVerbose, "APP1");
+        ASSERT_TRUE(sink.isEnabled());
+        sink.write(t0, 11, static_cast<LogLevelType>(LogLevel::kInfo), "CTXA", "first");
+        sink.write(t0 + 2000000, 11, static_cast<LogLevelType>(LogLevel::kError), "CTXB", "second");
+        sink.write(t0 + 1000999, 12, static_cast<LogLevelType>(LogLevel::kWarn), "CTXA", "earlier");  // Other thread, older
+        used = sink.getCurrentSize();
+    }
+
+    // Closed file is truncated to what was written
+    const auto data = readFile(path_);
+    ASSERT_EQ(data.size(), used);
+    ASSERT_GE(data.size(), BinaryFileSink::kHeaderSize);
+    EXPECT_EQ(std::memcmp(data.data(), "LAPB", 4), 0);
+    EXPECT_EQ(data[4], BinaryFileSink::kFormatVersion);
+    EXPECT_EQ(std::memcmp(data.data() + 8, "APP1", 4), 0);
+
+    const auto records = parse(data);
+    ASSERT_EQ(records.size(), 5u);
+    EXPECT_EQ(records[0].kind, kContextKind);
+    EXPECT_EQ(records[0].payload, "CTXA");
+    EXPECT_EQ(records[1].kind, kTextKind);
+    EXPECT_EQ(records[1].context, 0u);
+    EXPECT_EQ(records[1].timestamp, t0);
+    EXPECT_EQ(records[1].level, static_cast<UInt8>(LogLevel::kInfo));
+    EXPECT_EQ(records[1].payload, "first");
+    EXPECT_FALSE(records[1].hasThreadId);
+    EXPECT_EQ(records[2].kind, kContextKind);
+    EXPECT_EQ(records[2].context, 1u);
+    EXPECT_EQ(records[2].payload, "CTXB");
+    EXPECT_EQ(records[3].context, 1u);
+    EXPECT_EQ(records[3].timestamp, t0 + 2000000);
+    EXPECT_EQ(records[4].context, 0u);                  // Context record written once
+    EXPECT_EQ(records[4].timestamp, t0 + 1000000);      // Negative delta, kept in milliseconds
+    EXPECT_EQ(records[4].payload, "earlier");
+
+    // [len:1][kind|level:1][dt:1][context:1] + text instead of the ~50 byte text line prefix
+    EXPECT_EQ(records[3].size, 4u + 6u);
+    EXPECT_EQ(records[4].size, 4u + 7u);
+}
+
+TEST_F(BinaryFileSinkTest, ArgsAndModeledKeepTheirEncoding) {
+    UInt8 args[64];
+    ArgEncoder encoder(args, sizeof(args));
+    encoder.put("", "count=");
+    encoder.put("", static_cast<Int32>(42));
+
+    ModeledRecord modeled(1001, LogLevel::kWarn);
+    modeled.encoder().put("sensor", static_cast<UInt16>(3));
+
+    {
+        BinaryFileSink sink(path_);
+        sink.setWithThreadId(true);
+        EXPECT_TRUE(sink.writeArgs(100, 77, static_cast<LogLevelType>(LogLevel::kDebug), "DFMT", args, encoder.size()));
+        EXPECT_TRUE(sink.writeModeled(modeled.getTimestamp(), modeled.getThreadId(), modeled.getLevel(), "MODL", modeled));
+    }
+
+    const auto records = parse(readFile(path_));
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_EQ(records[1].kind, static_cast<UInt8>(BinaryFileSink::RecordKind::kArgs));
+    EXPECT_TRUE(records[1].hasThreadId);
+    EXPECT_EQ(records[1].threadId, 77u);
+    EXPECT_EQ(records[1].payload, std::string(reinterpret_cast<const char*>(args), encoder.size()));
+
+    EXPECT_EQ(records[3].kind, static_cast<UInt8>(BinaryFileSink::RecordKind::kModeled));
+    EXPECT_EQ(records[3].messageId, 1001u);
+    EXPECT_EQ(records[3].level, static_cast<UInt8>(LogLevel::kWarn));
+    EXPECT_EQ(records[3].timestamp, modeled.getTimestamp() / 1000000 * 1000000);
+    EXPECT_EQ(records[3].payload,
+              std::string(reinterpret_cast<const char*>(modeled.getPayload()), modeled.getPayloadSize()));
+}
+
+TEST_F(BinaryFileSinkTest, RepeatedPayloadsAreTemplated) {
+    const std::vector<std::string> texts = {
+        "Request 123 processed in 45 us, status=OK",
+        "id 0, padded 007, 0.05 s",
+        "max 9999999999999999999, too long 18446744073709551615 and 12345678901234567890123",
+        "no numbers at all",
+        "",
+    };
+
+    UInt8 args[128];
+    ArgEncoder encoder(args, sizeof(args));
+    encoder.put("", "delta=");
+    encoder.put("", static_cast<Int32>(-5));
+    encoder.put("", static_cast<Int64>(INT64_MIN));
+    encoder.put("", static_cast<UInt64>(UINT64_MAX));
+    encoder.put("", static_cast<UInt8>(200));
+    encoder.put("", 2.5);
+    encoder.put("", LogHex16{ 0xBEEF });
+    encoder.put("", true);
+
+    ModeledRecord modeled(2000, LogLevel::kWarn);
+    modeled.encoder().put("id", static_cast<UInt32>(123456));
+    modeled.encoder().put("status", "OK");
+
+    {
+        BinaryFileSink sink(path_);
+        for (int round = 0; round < 3; ++round) {
+            for (const auto& text : texts) {
+                sink.write(1000, 1, static_cast<LogLevelType>(LogLevel::kInfo), "TMPL", text);
+            }
+            EXPECT_TRUE(sink.writeArgs(1000, 1, static_cast<LogLevelType>(LogLevel::kInfo), "TMPL", args, encoder.size()));
+            EXPECT_TRUE(sink.writeModeled(1000, 1, modeled.getLevel(), "TMPL", modeled));
+        }
+        // A NUL byte has no place in a text template
+        const std::string withNul("a\0b 1", 6);
+        sink.write(1000, 1, static_cast<LogLevelType>(LogLevel::kInfo), "TMPL", withNul);
+        sink.write(1000, 1, static_cast<LogLevelType>(LogLevel::kInfo), "TMPL", withNul);
+    }
+
+    const auto records = parse(readFile(path_));
+    std::vector<Record> logged;
+    size_t templateRecords = 0;
+    for (const auto& r : records) {
+        if (r.kind == kTemplateKind) {
+            ++templateRecords;
+        } else if (r.kind != kContextKind) {
+            logged.push_back(r);
+        }
+    }
+    // One template per distinct payload, written on its second occurrence
+    EXPECT_EQ(templateRecords, texts.size() + 2);
+    ASSERT_EQ(logged.size(), 3 * (texts.size() + 2) + 2);
+
+    const std::string argsPayload(reinterpret_cast<const char*>(args), encoder.size());
+    const std::string modeledPayload(reinterpret_cast<const char*>(modeled.getPayload()), modeled.getPayloadSize());
+    for (size_t round = 0; round < 3; ++round) {
+        const size_t base = round * (texts.size() + 2);
+        for (size_t i = 0; i < texts.size(); ++i) {
+            EXPECT_EQ(logged[base + i].kind, kTextKind);
+            EXPECT_EQ(logged[base + i].templated, round > 0) << texts[i];
+            EXPECT_EQ(logged[base + i].payload, texts[i]);
+        }
+        EXPECT_EQ(logged[base + texts.size()].kind, static_cast<UInt8>(BinaryFileSink::RecordKind::kArgs));
+        EXPECT_EQ(logged[base + texts.size()].templated, round > 0);
+        EXPECT_EQ(logged[base + texts.size()].payload, argsPayload);
+        EXPECT_EQ(logged[base + texts.size() + 1].kind, static_cast<UInt8>(BinaryFileSink::RecordKind::kModeled));
+        EXPECT_EQ(logged[base + texts.size() + 1].templated, round > 0);
+        EXPECT_EQ(logged[base + texts.size() + 1].messageId, 2000u);
+        EXPECT_EQ(logged[base + texts.size() + 1].payload, modeledPayload);
+    }
+    EXPECT_FALSE(logged[logged.size() - 1].templated);
+    EXPECT_EQ(logged[logged.size() - 1].payload, std::string("a\0b 1", 6));
+
+    // [len][kind|level][dt][context][template][123: 1 byte][45: 1 byte]
+    EXPECT_EQ(logged[texts.size() + 2].size, 7u);
+    // ...[message ID: 2 bytes][template][123456: 3 bytes]
+    EXPECT_EQ(logged[2 * (texts.size() + 2) - 1].size, 4u + 2u + 1u + 3u);
+}
+
+TEST_F(BinaryFileSinkTest, RotationKeepsFilesSelfContained) {
+    auto message = [](int i) { return std::string(100, 'x') + " #" + std::to_string(i); };
+    const int count = 1500;
+    {
+        BinaryFileSink sink(path_, 4096, 3, LogLevel::kVerbose, "APP1", 4096);
+        for (int i = 0; i < count; ++i) {
+            sink.write(1000 + i, 1, static_cast<LogLevelType>(LogLevel::kInfo), "ROT", message(i));
+        }
+        EXPECT_LE(sink.getCurrentSize(), 4096u);
+    }
+
+    // Each file defines its own contexts and templates; the newest records are all there
+    int next = count;
+    for (const std::string& file : { path_, path_ + ".1" }) {
+        const auto data = readFile(file);
+        ASSERT_LE(data.size(), 4096u) << file;
+        const auto records = parse(data);
+        ASSERT_GE(records.size(), 2u) << file;
+        EXPECT_EQ(records[0].kind, kContextKind) << file;
+        EXPECT_EQ(records[0].payload, "ROT") << file;
+
+        std::vector<std::string> payloads;
+        for (const auto& r : records) {
+            if (r.kind == kTextKind) payloads.push_back(r.payload);
+        }
+        ASSERT_FALSE(payloads.empty()) << file;
+        for (auto it = payloads.rbegin(); it != payloads.rend(); ++it) {
+            EXPECT_EQ(*it, message(--next)) << file;
+        }
+    }
+}
+
+TEST_F(BinaryFileSinkTest, ExistingFileIsRotatedOut) {
+    {
+        BinaryFileSink sink(path_);
+        sink.write(1, 1, static_cast<LogLevelType>(LogLevel::kInfo), "RUN1", "one");
+    }
+    {
+        BinaryFileSink sink(path_);
+        sink.write(2, 1, static_cast<LogLevelType>(LogLevel::kInfo), "RUN2", "two");
+    }
+
+    const auto previous = parse(readFile(path_ + ".1"));
+    const auto current = parse(readFile(path_));
+    ASSERT_EQ(previous.size(), 2u);
+    ASSERT_EQ(current.size(), 2u);
+    EXPECT_EQ(previous[1].payload, "one");
+    EXPECT_EQ(current[1].payload, "two");
+}
@@ -7,10 +7,16 @@
 #include <gtest/gtest.h>
 #include <string>
 #include <cstring>
+#include <memory>
+#include <vector>
 #include "CLogManager.hpp"
 #include "CLogger.hpp"
 #include "CLogStream.hpp"
 #include "CFileSink.hpp"
+#include "CNumberFormat.hpp"
+#include "CTimestampFormat.hpp"
+#include <ctime>
+#include <thread>
 #include <lap/core/CConfig.hpp>
 
 using namespace lap::log;
@@ -50,7 +56,7 @@ TEST_F(BoundaryValueTest, ExceedMaxLogSize) {
     // Create a message larger than MAX_LOG_SIZE (300 bytes > 200)
     std::string longMsg(300, 'B');
     
-    // Should be truncated to MAX_LOG_SIZE
+    // Spills from the inline buffer to the thread arena, emitted as one record
     logger.LogInfo() << longMsg.c_str();
     
     // Verify no crash or memory corruption
@@ -299,3 +305,456 @@ TEST_F(BoundaryValueTest, OffByOneScenarios) {
     
     SUCCEED();
 }
+
+// Integer and hex kernels must match the printf output they replaced
+TEST_F(BoundaryValueTest, NumberFormatMatchesPrintf) {
+    char out[32];
+    char ref[32];
+
+    const uint64_t unsignedValues[] = {
+        0, 1, 9, 10, 99, 100, 999, 1000, 9999, 10000, 65535, 99999999, 100000000,
+        4294967295ULL, 4294967296ULL, 1234567890123456789ULL, 10000000000000000000ULL,
+        18446744073709551615ULL
+    };
+    for (uint64_t v : unsignedValues) {
+        size_t len = NumberFormat::formatUInt(out, v);
+        std::snprintf(ref, sizeof(ref), "%lu", v);
+        EXPECT_EQ(std::string(out, len), std::string(ref));
+    }
+
+    const int64_t signedValues[] = {
+        0, -1, 1, -9, -10, 127, -128, 32767, -32768, 2147483647, -2147483647 - 1,
+        -1234567890123LL, 9223372036854775807LL, -9223372036854775807LL - 1
+    };
+    for (int64_t v : signedValues) {
+        size_t len = NumberFormat::formatInt(out, v);
+        std::snprintf(ref, sizeof(ref), "%ld", v);
+        EXPECT_EQ(std::string(out, len), std::string(ref));
+    }
+
+    // Pseudo-random sweep over all digit counts
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < 10000; ++i) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        uint64_t v = x >> (i % 64);
+        size_t len = NumberFormat::formatUInt(out, v);
+        std::snprintf(ref, sizeof(ref), "%lu", v);
+        ASSERT_EQ(std::string(out, len), std::string(ref));
+
+        len = NumberFormat::formatHex(out, v, 8);
+        std::snprintf(ref, sizeof(ref), "0x%016lX", v);
+        ASSERT_EQ(std::string(out, len), std::string(ref));
+
+        len = NumberFormat::formatHex(out, v & 0xFFFFFFFF, 4);
+        std::snprintf(ref, sizeof(ref), "0x%08X", static_cast<uint32_t>(v));
+        ASSERT_EQ(std::string(out, len), std::string(ref));
+
+        len = NumberFormat::formatHex(out, v & 0xFFFF, 2);
+        std::snprintf(ref, sizeof(ref), "0x%04X", static_cast<uint16_t>(v));
+        ASSERT_EQ(std::string(out, len), std::string(ref));
+
+        len = NumberFormat::formatHex(out, v & 0xFF, 1);
+        std::snprintf(ref, sizeof(ref), "0x%02X", static_cast<uint8_t>(v));
+        ASSERT_EQ(std::string(out, len), std::string(ref));
+    }
+}
+
+// Default float output stays "%.6f" / "%.12f"; other modes are selectable
+TEST_F(BoundaryValueTest, FloatFormatModes) {
+    char out[400];
+    char ref[400];
+    const auto saved = NumberFormat::getFloatConfig();
+
+    const double doubles[] = { 0.0, -0.0, 1.0, -1.5, 3.14159265358979, 0.1, 1e-7, 123456789.123456789,
+                               1e20, -2.5e-300, 1.7976931348623157e308 };
+    for (double v : doubles) {
+        size_t len = NumberFormat::formatDouble(out, sizeof(out), v);
+        std::snprintf(ref, sizeof(ref), "%.12f", v);
+        EXPECT_EQ(std::string(out, len), std::string(ref));
+    }
+    const float floats[] = { 0.0f, 1.0f, -2.75f, 0.1f, 3.4028235e38f, 1e-10f };
+    for (float v : floats) {
+        size_t len = NumberFormat::formatFloat(out, sizeof(out), v);
+        std::snprintf(ref, sizeof(ref), "%.6f", static_cast<double>(v));
+        EXPECT_EQ(std::string(out, len), std::string(ref));
+    }
+
+    // Truncated to the given capacity
+    EXPECT_EQ(NumberFormat::formatDouble(out, 5, 123456.0), 5u);
+    EXPECT_EQ(std::string(out, 5), "12345");
+
+    NumberFormat::FloatConfig config;
+    config.format = FloatFormat::kShortest;
+    NumberFormat::setFloatConfig(config);
+    size_t len = NumberFormat::formatDouble(out, sizeof(out), 0.1);
+    EXPECT_EQ(std::string(out, len), "0.1");
+    len = NumberFormat::formatFloat(out, sizeof(out), 0.1f);
+    EXPECT_EQ(std::string(out, len), "0.1");
+    len = NumberFormat::formatDouble(out, sizeof(out), 1e300);
+    EXPECT_EQ(std::string(out, len), "1e+300");
+
+    config.format = FloatFormat::kScientific;
+    config.doublePrecision = 3;
+    NumberFormat::setFloatConfig(config);
+    len = NumberFormat::formatDouble(out, sizeof(out), 12345.678);
+    EXPECT_EQ(std::string(out, len), "1.235e+04");
+
+    config.format = FloatFormat::kFixed;
+    config.doublePrecision = 1000;
+    NumberFormat::setFloatConfig(config);
+    EXPECT_EQ(NumberFormat::getFloatConfig().doublePrecision, NumberFormat::kMaxPrecision);
+
+    NumberFormat::setFloatConfig(saved);
+}
+
+// LogStream numeric operators produce the printf-compatible text
+TEST_F(BoundaryValueTest, StreamNumericOutput) {
+    auto &logger = LogManager::getInstance().registerLogger("BNDRY", "NumOut", LogLevel::kInfo);
+
+    auto&& stream = logger.WithLevel(LogLevel::kError);
+    ASSERT_TRUE(stream.IsEnabled());
+    stream << static_cast<uint8_t>(255) << " " << static_cast<int8_t>(-128) << " "
+           << static_cast<uint16_t>(65535) << " " << static_cast<int16_t>(-32768) << " "
+           << static_cast<uint32_t>(4294967295U) << " " << static_cast<int32_t>(-2147483647 - 1) << " "
+           << static_cast<uint64_t>(18446744073709551615ULL) << " "
+           << static_cast<int64_t>(-9223372036854775807LL - 1) << " "
+           << 1.5f << " " << -0.25 << " "
+           << HexFormat(static_cast<uint8_t>(0xA)) << " " << HexFormat(static_cast<uint16_t>(0xBEEF)) << " "
+           << HexFormat(static_cast<uint32_t>(0x1234ABCD)) << " " << HexFormat(static_cast<uint64_t>(0xFULL));
+
+    EXPECT_EQ(std::string(stream.getBuffer(), stream.getBufferSize()),
+              "255 -128 65535 -32768 4294967295 -2147483648 18446744073709551615 -9223372036854775808 "
+              "1.500000 -0.250000000000 0x0A 0xBEEF 0x1234ABCD 0x000000000000000F");
+}
+
+// Binary output of every width, plain and nibble grouped
+TEST_F(BoundaryValueTest, BinaryFormatAllWidths) {
+    auto reference = [](uint64_t value, int bits, bool grouped) {
+        std::string text = "0b";
+        for (int i = bits - 1; i >= 0; --i) {
+            text += ((value >> i) & 1) ? '1' : '0';
+            if (grouped && i > 0 && i % 4 == 0) {
+                text += '_';
+            }
+        }
+        return text;
+    };
+
+    char out[NumberFormat::kMaxBinChars];
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (int i = 0; i < 2000; ++i) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        const uint64_t v = (i == 0) ? 0 : (i == 1 ? ~0ULL : x);
+        for (size_t bytes : {1u, 2u, 4u, 8u}) {
+            const uint64_t masked = bytes == 8 ? v : v & ((1ULL << (bytes * 8)) - 1);
+            for (bool grouped : {false, true}) {
+                size_t len = NumberFormat::formatBin(out, masked, bytes, grouped);
+                ASSERT_EQ(len, NumberFormat::binLength(bytes, grouped));
+                ASSERT_EQ(std::string(out, len), reference(masked, static_cast<int>(bytes * 8), grouped));
+            }
+        }
+    }
+    EXPECT_EQ(NumberFormat::binLength(8, true), NumberFormat::kMaxBinChars);
+
+    auto &logger = LogManager::getInstance().registerLogger("BNDRY", "BinOut", LogLevel::kInfo);
+    auto&& stream = logger.WithLevel(LogLevel::kError);
+    ASSERT_TRUE(stream.IsEnabled());
+    stream << BinFormat(static_cast<uint8_t>(0xA5)) << " "
+           << BinFormat(static_cast<int8_t>(-1), true) << " "
+           << BinFormat(static_cast<uint16_t>(0x8001)) << " "
+           << BinFormat(static_cast<uint16_t>(0x1234), true) << " "
+           << BinFormat(static_cast<uint32_t>(0xDEADBEEF), true) << " "
+           << BinFormat(static_cast<int64_t>(1), true);
+
+    EXPECT_EQ(std::string(stream.getBuffer(), stream.getBufferSize()),
+              "0b10100101 0b1111_1111 0b1000000000000001 0b0001_0010_0011_0100 "
+              "0b1101_1110_1010_1101_1011_1110_1110_1111 "
+              "0b0000_0000_0000_0000_0000_0000_0000_0000_0000_0000_0000_0000_0000_0000_0000_0001");
+}
+
+// BinFormat output that does not fit the inline buffer spills, the record is not split
+TEST_F(BoundaryValueTest, BinaryFormatNearLimit) {
+    auto &logger = LogManager::getInstance().registerLogger("BNDRY", "BinLim", LogLevel::kInfo);
+    auto&& stream = logger.WithLevel(LogLevel::kError);
+    stream << std::string(LogStream::MAX_LOG_SIZE - 40, 'x').c_str();
+    stream << BinFormat(static_cast<uint64_t>(0xFFFFFFFFFFFFFFFFULL), true);
+
+    EXPECT_EQ(stream.getBufferSize(), LogStream::MAX_LOG_SIZE - 40 + NumberFormat::kMaxBinChars);
+    EXPECT_EQ(std::string(stream.getBuffer() + LogStream::MAX_LOG_SIZE - 40, 7), "0b1111_");
+}
+
+// Floating point output is never cut at the inline buffer end: it spills like any other text
+TEST_F(BoundaryValueTest, FloatFormatNearLimit) {
+    auto &logger = LogManager::getInstance().registerLogger("BNDRY", "FltLim", LogLevel::kInfo);
+    // Room left for the old fixed estimate (24 characters), not for the numbers below
+    const std::string head(LogStream::MAX_LOG_SIZE - 26, 'x');
+    for (double value : {1.0e15, -1234567890123.5, 1.0e300}) {
+        char expected[NumberFormat::kMaxRealChars];
+        const size_t len = NumberFormat::formatDouble(expected, sizeof(expected), value);
+        ASSERT_GT(len, 25u);    // More than the 25 characters left inline
+
+        auto&& stream = logger.WithLevel(LogLevel::kError);
+        stream << head.c_str() << value;
+        EXPECT_EQ(std::string(stream.getBuffer(), stream.getBufferSize()), head + std::string(expected, len));
+    }
+
+    const float large = 3.0e38f;
+    char expected[NumberFormat::kMaxRealChars];
+    const size_t len = NumberFormat::formatFloat(expected, sizeof(expected), large);
+    auto&& stream = logger.WithLevel(LogLevel::kError);
+    stream << head.c_str() << large;
+    EXPECT_EQ(std::string(stream.getBuffer(), stream.getBufferSize()), head + std::string(expected, len));
+}
+
+namespace {
+    class RecordSink : public ISink {
+    public:
+        void write(UInt64 timestamp, UInt32, LogLevelType, StringView contextId, StringView message) noexcept override {
+            if (contextId == "LONG") {
+                records.emplace_back(message.data(), message.size());
+                timestamps.push_back(timestamp);
+            }
+        }
+        void flush() noexcept override {}
+        Bool isEnabled() const noexcept override { return true; }
+        StringView getName() const noexcept override { return "Record"; }
+        void setLevel(LogLevel) noexcept override {}
+        Bool shouldLog(LogLevel) const noexcept override { return true; }
+
+        std::vector<std::string> records;
+        std::vector<UInt64> timestamps;
+    };
+}
+
+// Messages longer than the inline buffer reach the sinks as exactly one record
+TEST_F(BoundaryValueTest, LongMessageSingleRecord) {
+    auto &mgr = LogManager::getInstance();
+    auto sink = std::make_unique<RecordSink>();
+    RecordSink* records = sink.get();
+    mgr.getSinkManager().addSink(std::move(sink));
+    auto &logger = mgr.registerLogger("LONG", "Long messages", LogLevel::kVerbose);
+
+    for (size_t size : {64u, 199u, 200u, 1024u, 4096u}) {
+        std::string text(size, 'a');
+        for (size_t i = 0; i < size; ++i) {
+            text[i] = static_cast<char>('a' + i % 26);
+        }
+        logger.LogError() << "[" << static_cast<uint32_t>(size) << "] " << text.c_str() << " end";
+        ASSERT_FALSE(records->records.empty());
+        EXPECT_EQ(records->records.back(), "[" + std::to_string(size) + "] " + text + " end");
+    }
+    EXPECT_EQ(records->records.size(), 5u);
+
+    // Many small appends crossing the inline size
+    {
+        auto&& stream = logger.LogError();
+        for (int i = 0; i < 100; ++i) {
+            stream << static_cast<int32_t>(i) << ",";
+        }
+    }
+    EXPECT_EQ(records->records.size(), 6u);
+    EXPECT_EQ(records->records.back().substr(0, 10), "0,1,2,3,4,");
+    EXPECT_EQ(records->records.back().substr(records->records.back().size() - 6), "98,99,");
+
+    mgr.getSinkManager().removeSink("Record");
+}
+
+// Output past the configured cap is dropped, never emitted as a second record
+TEST_F(BoundaryValueTest, MessageSizeCap) {
+    auto &mgr = LogManager::getInstance();
+    auto sink = std::make_unique<RecordSink>();
+    RecordSink* records = sink.get();
+    mgr.getSinkManager().addSink(std::move(sink));
+    auto &logger = mgr.registerLogger("LONG", "Long messages", LogLevel::kVerbose);
+    const size_t saved = LogStream::GetMaxMessageSize();
+
+    LogStream::SetMaxMessageSize(1000);
+    EXPECT_EQ(LogStream::GetMaxMessageSize(), 1000u);
+    logger.LogError() << std::string(3000, 'c').c_str() << static_cast<int32_t>(42);
+    ASSERT_EQ(records->records.size(), 1u);
+    EXPECT_EQ(records->records[0], std::string(1000, 'c'));
+
+    // Clamped to the inline size and to the 16-bit record length
+    LogStream::SetMaxMessageSize(10);
+    EXPECT_EQ(LogStream::GetMaxMessageSize(), LogStream::MAX_LOG_SIZE - 1);
+    LogStream::SetMaxMessageSize(1u << 20);
+    EXPECT_EQ(LogStream::GetMaxMessageSize(), LogStream::MAX_MESSAGE_SIZE_LIMIT);
+
+    LogStream::SetMaxMessageSize(saved);
+    mgr.getSinkManager().removeSink("Record");
+}
+
+// A second long stream on the same thread while the arena is in use
+TEST_F(BoundaryValueTest, NestedLongStreams) {
+    auto &mgr = LogManager::getInstance();
+    auto sink = std::make_unique<RecordSink>();
+    RecordSink* records = sink.get();
+    mgr.getSinkManager().addSink(std::move(sink));
+    auto &logger = mgr.registerLogger("LONG", "Long messages", LogLevel::kVerbose);
+
+    {
+        auto&& outer = logger.LogError();
+        outer << std::string(500, 'o').c_str();
+        {
+            auto&& inner = logger.LogError();
+            inner << std::string(700, 'i').c_str();
+        }
+        outer << "!";
+    }
+
+    ASSERT_EQ(records->records.size(), 2u);
+    EXPECT_EQ(records->records[0], std::string(700, 'i'));
+    EXPECT_EQ(records->records[1], std::string(500, 'o') + "!");
+
+    mgr.getSinkManager().removeSink("Record");
+}
+
+static std::string referenceDateTime(uint64_t ns) {
+    time_t seconds = static_cast<time_t>(ns / 1000000000);
+    struct tm tmInfo;
+    localtime_r(&seconds, &tmInfo);
+    char text[64];
+    snprintf(text, sizeof(text), "%04d-%02d-%02d %02d:%02d:%02d.%03u",
+             tmInfo.tm_year + 1900, tmInfo.tm_mon + 1, tmInfo.tm_mday,
+             tmInfo.tm_hour, tmInfo.tm_min, tmInfo.tm_sec,
+             static_cast<unsigned>(ns % 1000000000 / 1000000));
+    return text;
+}
+
+TEST_F(BoundaryValueTest, TimestampFormatMatchesLocaltime) {
+    char out[TimestampFormat::kMaxDateTimeChars];
+    
+    // Second, minute, day and year rollovers, millisecond edges, and jumps back in time
+    const uint64_t base = 1735689599ULL * 1000000;  // 2024-12-31 23:59:59 UTC
+    const std::vector<uint64_t> samples = {
+        0, 999, 1000, 999999, 1000000,
+        base, base + 999, base + 999999, base + 1000000, base + 1000001,
+        base - 1, base + 3600ULL * 1000000, base, 4102444799999999ULL,
+        1761000000123456ULL, 1761000000999999ULL, 1761000001000000ULL, 1761000000500000ULL
+    };
+    
+    for (uint64_t us : samples) {
+        uint64_t ns = us * 1000;
+        size_t len = TimestampFormat::formatDateTime(out, ns);
+        EXPECT_EQ(std::string(out, len), referenceDateTime(ns)) << us;
+        
+        len = TimestampFormat::formatTime(out, ns);
+        EXPECT_EQ(std::string(out, len), referenceDateTime(ns).substr(11)) << us;
+    }
+    
+    // Dense sweep: many records per second, each one patched from the cache
+    for (uint64_t us = base - 2000000; us < base + 2000000; us += 7919) {
+        size_t len = TimestampFormat::formatDateTime(out, us * 1000);
+        ASSERT_EQ(std::string(out, len), referenceDateTime(us * 1000)) << us;
+    }
+}
+
+TEST_F(BoundaryValueTest, TimestampFormatThreadLocalCache) {
+    // Threads working on different seconds must not see each other's cached text
+    const uint64_t bases[] = { 1000000000ULL * 1000000, 1700000000ULL * 1000000, 1761000000ULL * 1000000 };
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(3, 0);
+    
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([&, t]() {
+            char out[TimestampFormat::kMaxDateTimeChars];
+            for (uint64_t i = 0; i < 20000; ++i) {
+                uint64_t ns = (bases[t] + i * 499) * 1000;
+                size_t len = TimestampFormat::formatDateTime(out, ns);
+                if (std::string(out, len) != referenceDateTime(ns)) {
+                    ++mismatches[t];
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    
+    for (int t = 0; t < 3; ++t) {
+        EXPECT_EQ(mismatches[t], 0) << "thread " << t;
+    }
+}
+
+TEST_F(BoundaryValueTest, TimestampFormatPrecision) {
+    char out[TimestampFormat::kMaxDateTimeChars];
+    const uint64_t ns = 1761000000ULL * 1000000000 + 123456789;
+    const std::string seconds = referenceDateTime(ns).substr(0, 19);
+    
+    TimestampFormat::setPrecision(TimestampPrecision::kMicro);
+    size_t len = TimestampFormat::formatDateTime(out, ns);
+    EXPECT_EQ(std::string(out, len), seconds + ".123456");
+    len = TimestampFormat::formatTime(out, ns);
+    EXPECT_EQ(std::string(out, len), seconds.substr(11) + ".123456");
+    
+    TimestampFormat::setPrecision(TimestampPrecision::kNano);
+    len = TimestampFormat::formatDateTime(out, ns);
+    EXPECT_EQ(len, TimestampFormat::kMaxDateTimeChars);
+    EXPECT_EQ(std::string(out, len), seconds + ".123456789");
+    len = TimestampFormat::formatDateTime(out, ns - 123456789 + 7);
+    EXPECT_EQ(std::string(out, len), seconds + ".000000007");
+    
+    TimestampFormat::setPrecision(TimestampPrecision::kMilli);
+    len = TimestampFormat::formatDateTime(out, ns);
+    EXPECT_EQ(std::string(out, len), seconds + ".123");
+}
+
+TEST_F(BoundaryValueTest, LogClockSources) {
+    auto wallNow = []() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    };
+    
+    const ClockSource sources[] = { ClockSource::kRealtime, ClockSource::kRealtimeCoarse,
+                                    ClockSource::kMonotonic, ClockSource::kTsc };
+    for (ClockSource source : sources) {
+        ClockSource used = LogClock::setSource(source);
+        EXPECT_EQ(used, LogClock::getSource());
+        if (source != ClockSource::kTsc) {
+            EXPECT_EQ(used, source);
+        }
+        
+        // Nanoseconds since epoch, within the coarse clock's tick of the wall clock
+        uint64_t before = wallNow();
+        uint64_t stamp = LogClock::now();
+        uint64_t after = wallNow();
+        EXPECT_GT(stamp + 20000000ULL, before) << toString(source).data();
+        EXPECT_LT(stamp, after + 20000000ULL) << toString(source).data();
+        
+        if (used == ClockSource::kMonotonic || used == ClockSource::kTsc) {
+            uint64_t last = LogClock::now();
+            for (int i = 0; i < 10000; ++i) {
+                uint64_t next = LogClock::now();
+                ASSERT_GE(next, last) << toString(source).data();
+                last = next;
+            }
+        }
+    }
+    LogClock::setSource(ClockSource::kRealtime);
+}
+
+TEST_F(BoundaryValueTest, TimestampTakenAtCreation) {
+    auto &mgr = LogManager::getInstance();
+    auto sink = std::make_unique<RecordSink>();
+    RecordSink* records = sink.get();
+    mgr.getSinkManager().addSink(std::move(sink));
+    auto &logger = mgr.registerLogger("LONG", "Long messages", LogLevel::kVerbose);
+    
+    uint64_t created = 0;
+    uint64_t beforeDispatch = 0;
+    {
+        auto&& stream = logger.LogError();
+        created = stream.getTimestamp();
+        stream << "delayed record";
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        beforeDispatch = LogClock::now();
+    }
+    
+    // The sinks see the creation time, not the dispatch time
+    ASSERT_EQ(records->timestamps.size(), 1u);
+    EXPECT_EQ(records->timestamps.back(), created);
+    EXPECT_GE(beforeDispatch - created, 30000000ULL);
+    EXPECT_GT(created, 1600000000ULL * 1000000000);  // Nanoseconds since epoch
+    
+    mgr.getSinkManager().removeSink("Record");
+}
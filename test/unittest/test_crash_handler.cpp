@@ -0,0 +1,325 @@
+/**
+ * @file        test_crash_handler.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Crash handler and async-signal-safe emergency path tests
+ * @date        2026-10-16
+ */
+
+#include <gtest/gtest.h>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "CCrashHandler.hpp"
+#include "CAsyncLogQueue.hpp"
+#include "CSinkManager.hpp"
+#include "CFileSink.hpp"
+#include "CArgEncoding.hpp"
+#include "CLogClock.hpp"
+#include "CTimestampFormat.hpp"
+
+using namespace lap::log;
+using namespace lap::core;
+
+namespace {
+    std::vector<std::string> readLines(const std::string& path) {
+        std::vector<std::string> lines;
+        std::ifstream in(path);
+        std::string line;
+        while (std::getline(in, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    constexpr LogLevelType kInfo = static_cast<LogLevelType>(LogLevel::kInfo);
+
+    // Batched sink whose flush() parks while the manager holds its lock
+    class ParkingSink : public ISink {
+    public:
+        void write(UInt64, UInt32, LogLevelType, StringView, StringView) noexcept override {}
+        void flush() noexcept override {
+            parked = true;
+            while (!release) {
+                std::this_thread::yield();
+            }
+            parked = false;
+        }
+        Bool writeEmergency(UInt64, UInt32, LogLevelType, StringView, StringView) noexcept override {
+            ++staged;
+            return true;
+        }
+        Bool writeEmergencyUnbatched(UInt64, UInt32, LogLevelType, StringView, StringView) noexcept override {
+            ++unbatched;
+            return true;
+        }
+        void flushEmergency() noexcept override { ++emergencyFlushes; }
+        Bool isEnabled() const noexcept override { return true; }
+        StringView getName() const noexcept override { return "Parking"; }
+        void setLevel(LogLevel) noexcept override {}
+        Bool shouldLog(LogLevel) const noexcept override { return true; }
+        Bool isThreadSafe() const noexcept override { return false; }
+
+        std::atomic<bool> parked{ false };
+        std::atomic<bool> release{ false };
+        std::atomic<int> staged{ 0 };
+        std::atomic<int> unbatched{ 0 };
+        std::atomic<int> emergencyFlushes{ 0 };
+    };
+
+    // Thread-safe sink whose write() of "slow" holds the async worker for 100 ms
+    class SlowSink : public ISink {
+    public:
+        void write(UInt64, UInt32, LogLevelType, StringView, StringView message) noexcept override {
+            if (message == "slow") {
+                inSlow = true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            record(message);
+        }
+        void flush() noexcept override {}
+        Bool writeEmergency(UInt64, UInt32, LogLevelType, StringView, StringView message) noexcept override {
+            record(message);
+            return true;
+        }
+        Bool isEnabled() const noexcept override { return true; }
+        StringView getName() const noexcept override { return "Slow"; }
+        void setLevel(LogLevel) noexcept override {}
+        Bool shouldLog(LogLevel) const noexcept override { return true; }
+        Bool isThreadSafe() const noexcept override { return true; }
+
+        std::vector<std::string> received() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return messages;
+        }
+
+        std::atomic<bool> inSlow{ false };
+
+    private:
+        void record(StringView message) {
+            std::lock_guard<std::mutex> lock(mutex);
+            messages.emplace_back(message.data(), message.size());
+        }
+
+        std::mutex mutex;
+        std::vector<std::string> messages;
+    };
+}
+
+class CrashHandlerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = "/tmp/lap_crash_test_" + std::to_string(::getpid()) + ".log";
+        std::remove(path_.c_str());
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    // Run body in a child process, return its wait status
+    template <typename Body>
+    int runChild(Body body) {
+        std::fflush(nullptr);
+        const pid_t child = ::fork();
+        if (child == 0) {
+            body();
+            ::_exit(0);     // Not reached when the body crashes
+        }
+        int status = 0;
+        ::waitpid(child, &status, 0);
+        return status;
+    }
+
+    std::string path_;
+};
+
+TEST_F(CrashHandlerTest, SignalSafeTimestampMatchesLocaltime) {
+    TimestampFormat::refreshUtcOffset();
+    const UInt64 now = LogClock::now();
+    const UInt64 samples[] = { now, now + 123456789ULL, now - 86400ULL * 1000000000ULL * 40 };
+    for (UInt64 ts : samples) {
+        char expected[TimestampFormat::kMaxDateTimeChars];
+        char actual[TimestampFormat::kMaxDateTimeChars];
+        const Size expectedLen = TimestampFormat::formatDateTime(expected, ts);
+        ASSERT_EQ(TimestampFormat::formatDateTimeSignalSafe(actual, ts), expectedLen);
+        if (std::string(expected, expectedLen) != std::string(actual, expectedLen)) {
+            // Only a daylight saving switch between the samples may differ (by the hour)
+            EXPECT_EQ(std::string(expected, 11), std::string(actual, 11));
+            EXPECT_EQ(std::string(expected + 13, expectedLen - 13), std::string(actual + 13, expectedLen - 13));
+        }
+
+        const Size timeLen = TimestampFormat::formatTimeSignalSafe(actual, ts);
+        EXPECT_EQ(std::string(actual, timeLen), std::string(expected + 11, expectedLen - 11).substr(0, timeLen));
+    }
+}
+
+TEST_F(CrashHandlerTest, SegfaultFlushesBufferedFileRecords) {
+    const int status = runChild([this] {
+        SinkManager sinks;
+        FileBufferConfig buffer;
+        buffer.bufferSize = 64 * 1024;
+        buffer.flushIntervalMs = 60 * 1000;
+        sinks.addSink(MakeUnique<FileSink>(path_, 0, 1, LogLevel::kVerbose, "CRSH", buffer));
+
+        ISink* file = sinks.getSink("File");
+        for (int i = 0; i < 100; ++i) {
+            const std::string msg = "buffered " + std::to_string(i);
+            file->write(LogClock::now(), 42, kInfo, "TEST", msg);
+        }
+
+        CrashHandler::attach(&sinks, nullptr);
+        CrashHandler::install();
+        ::raise(SIGSEGV);
+    });
+
+    ASSERT_TRUE(WIFSIGNALED(status));
+    EXPECT_EQ(WTERMSIG(status), SIGSEGV);
+
+    const auto lines = readLines(path_);
+    ASSERT_EQ(lines.size(), 101u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_NE(lines[i].find("[CRSH] [INFO ] [TEST] buffered " + std::to_string(i)), std::string::npos) << lines[i];
+    }
+    EXPECT_NE(lines[100].find("[FATAL] [CRSH] Fatal signal 11 (SIGSEGV)"), std::string::npos) << lines[100];
+}
+
+TEST_F(CrashHandlerTest, AbortDrainsAsyncQueue) {
+    const int status = runChild([this] {
+        SinkManager sinks;
+        sinks.addSink(MakeUnique<FileSink>(path_, 0, 1, LogLevel::kVerbose, "CRSH"));
+
+        AsyncLogQueue::Config config;
+        config.setPolicy(OverflowPolicy::kBlock);
+        AsyncLogQueue queue(sinks, config);
+        queue.start();
+
+        // Records stay in the ring as if the worker had fallen behind
+        queue.haltWorker();
+        for (int i = 0; i < 200; ++i) {
+            const std::string msg = "queued " + std::to_string(i);
+            queue.push(LogClock::now(), 7, kInfo, "ASYN", msg);
+        }
+        UInt8 args[64];
+        ArgEncoder encoder(args, sizeof(args));
+        encoder.put(StringView(), StringView("deferred "));
+        encoder.put(StringView(), static_cast<Int32>(-5));
+        queue.push(LogClock::now(), 7, kInfo, "ASYN",
+                   StringView(reinterpret_cast<const Char*>(args), encoder.size()), RecordFormat::kArgs);
+
+        CrashHandler::attach(&sinks, &queue);
+        CrashHandler::install();
+        std::abort();
+    });
+
+    ASSERT_TRUE(WIFSIGNALED(status));
+    EXPECT_EQ(WTERMSIG(status), SIGABRT);
+
+    const auto lines = readLines(path_);
+    ASSERT_EQ(lines.size(), 202u);
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_NE(lines[i].find("[ASYN] queued " + std::to_string(i)), std::string::npos) << lines[i];
+    }
+    EXPECT_NE(lines[200].find("[ASYN] deferred -5"), std::string::npos) << lines[200];
+    EXPECT_NE(lines[201].find("[FATAL] [CRSH] Fatal signal 6 (SIGABRT)"), std::string::npos) << lines[201];
+}
+
+TEST_F(CrashHandlerTest, LogFatalWithoutCrashResumesWorker) {
+    {
+        SinkManager sinks;
+        FileBufferConfig buffer;
+        buffer.bufferSize = 4096;
+        buffer.flushIntervalMs = 60 * 1000;
+        sinks.addSink(MakeUnique<FileSink>(path_, 0, 1, LogLevel::kVerbose, "CRSH", buffer));
+
+        AsyncLogQueue queue(sinks);
+        ASSERT_TRUE(queue.start());
+        CrashHandler::attach(&sinks, &queue);
+
+        queue.push(LogClock::now(), 1, kInfo, "TEST", "before");
+        CrashHandler::logFatal("TEST", "from a signal handler");
+
+        // Worker runs again afterwards
+        queue.push(LogClock::now(), 1, kInfo, "TEST", "after");
+        EXPECT_TRUE(queue.flush());
+
+        CrashHandler::attach(nullptr, nullptr);
+        queue.stop();
+    }
+
+    const auto lines = readLines(path_);
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_NE(lines[0].find("[INFO ] [TEST] before"), std::string::npos) << lines[0];
+    EXPECT_NE(lines[1].find("[FATAL] [TEST] from a signal handler"), std::string::npos) << lines[1];
+    EXPECT_NE(lines[2].find("[INFO ] [TEST] after"), std::string::npos) << lines[2];
+}
+
+TEST_F(CrashHandlerTest, LogFatalWaitsForSlowWorkerPass) {
+    SinkManager sinks;
+    auto owned = MakeUnique<SlowSink>();
+    SlowSink* sink = owned.get();
+    sinks.addSink(Move(owned));
+
+    AsyncLogQueue queue(sinks);
+    ASSERT_TRUE(queue.start());
+    CrashHandler::attach(&sinks, &queue);
+
+    // One worker pass takes all three and stays in the sink well past 20 ms
+    queue.haltWorker();
+    queue.push(LogClock::now(), 1, kInfo, "TEST", "slow");
+    queue.push(LogClock::now(), 1, kInfo, "TEST", "a");
+    queue.push(LogClock::now(), 1, kInfo, "TEST", "b");
+    queue.resumeWorker();
+    while (!sink->inSlow) {
+        std::this_thread::yield();
+    }
+
+    // The rings are not drained behind the worker's back: every record exactly once
+    CrashHandler::logFatal("TEST", "fatal");
+    queue.push(LogClock::now(), 1, kInfo, "TEST", "after");
+    EXPECT_TRUE(queue.flush());
+
+    CrashHandler::attach(nullptr, nullptr);
+    queue.stop();
+
+    const std::vector<std::string> expected = { "slow", "a", "b", "fatal", "after" };
+    EXPECT_EQ(sink->received(), expected);
+}
+
+TEST_F(CrashHandlerTest, LogFatalLeavesLockedBatchAlone) {
+    SinkManager sinks;
+    auto owned = MakeUnique<ParkingSink>();
+    ParkingSink* sink = owned.get();
+    sinks.addSink(Move(owned));
+    CrashHandler::attach(&sinks, nullptr);
+
+    // Another thread holds the sink lock: the batch is neither flushed nor appended to
+    std::thread holder([&sinks]() { sinks.flushAll(); });
+    while (!sink->parked) {
+        std::this_thread::yield();
+    }
+    CrashHandler::logFatal("TEST", "while locked");
+    EXPECT_EQ(sink->emergencyFlushes.load(), 0);
+    EXPECT_EQ(sink->staged.load(), 0);
+    EXPECT_EQ(sink->unbatched.load(), 1);
+
+    sink->release = true;
+    holder.join();
+
+    // Lock free again: batch first, then the record staged into it
+    CrashHandler::logFatal("TEST", "unlocked");
+    EXPECT_EQ(sink->emergencyFlushes.load(), 2);
+    EXPECT_EQ(sink->staged.load(), 1);
+    EXPECT_EQ(sink->unbatched.load(), 1);
+
+    CrashHandler::attach(nullptr, nullptr);
+}
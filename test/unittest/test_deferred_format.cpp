@@ -0,0 +1,164 @@
+/**
+ * @file        test_deferred_format.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Deferred LogStream formatting (binary argument capture) unit tests
+ * @date        2026-10-16
+ */
+
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <lap/core/CConfig.hpp>
+#include "CLogManager.hpp"
+#include "CLogger.hpp"
+#include "CSinkManager.hpp"
+#include "CArgEncoding.hpp"
+
+using namespace lap::log;
+using namespace lap::core;
+
+namespace {
+    // Text sink: deferred records reach it rendered
+    class TextSink : public ISink {
+    public:
+        void write(UInt64, UInt32, LogLevelType, StringView contextId, StringView message) noexcept override {
+            if (contextId == "DFMT") {
+                std::lock_guard<std::mutex> lock(mutex);
+                records.emplace_back(message.data(), message.size());
+            }
+        }
+        void flush() noexcept override {}
+        Bool isEnabled() const noexcept override { return true; }
+        StringView getName() const noexcept override { return "DeferredText"; }
+        void setLevel(LogLevel) noexcept override {}
+        Bool shouldLog(LogLevel) const noexcept override { return true; }
+
+        std::vector<std::string> take() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return std::move(records);
+        }
+
+        std::mutex mutex;
+        std::vector<std::string> records;
+    };
+
+    // Binary sink: consumes the encoded values, never sees text
+    class ArgsSink : public TextSink {
+    public:
+        Bool writeArgs(UInt64, UInt32, LogLevelType, StringView contextId, const UInt8* args, Size size) noexcept override {
+            if (contextId == "DFMT") {
+                std::lock_guard<std::mutex> lock(mutex);
+                payloads.emplace_back(args, args + size);
+            }
+            return true;
+        }
+        StringView getName() const noexcept override { return "DeferredArgs"; }
+
+        std::vector<std::vector<UInt8>> payloads;
+    };
+
+    void logEverything(const Logger& logger) {
+        logger.LogError() << "b=" << true << " u8=" << static_cast<UInt8>(200) << " u16=" << static_cast<UInt16>(65535)
+                          << " u32=" << static_cast<UInt32>(4000000000u) << " u64=" << static_cast<UInt64>(18446744073709551615ULL)
+                          << " i8=" << static_cast<Int8>(-100) << " i16=" << static_cast<Int16>(-30000)
+                          << " i32=" << static_cast<Int32>(-123456) << " i64=" << static_cast<Int64>(-9223372036854775807LL - 1)
+                          << " f=" << 1.5f << " d=" << 2.25;
+        logger.LogError() << LogHex8{ 0x1f } << " " << LogHex16{ 0xBEEF } << " " << LogHex32{ 0xDEADBEEF } << " "
+                          << LogHex64{ 0x0123456789ABCDEFULL } << " " << LogBin8{ 0xA5, true } << " " << LogBin16{ 0x0F0F };
+        logger.LogError() << "level=" << LogLevel::kWarn << " ec=" << ErrorCode() << " s=" << String("std::string")
+                          << " sv=" << StringView("view") << " empty=" << "";
+    }
+}
+
+class DeferredFormatTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        lap::core::ConfigManager::getInstance();
+        LogManager::getInstance().initialize();
+        logger_ = &LogManager::getInstance().registerLogger("DFMT", "Deferred formatting", LogLevel::kInfo);
+    }
+
+    void TearDown() override {
+        LogStream::SetDeferredFormat(false);
+        LogManager::getInstance().uninitialize();
+    }
+
+    Logger* logger_;
+};
+
+TEST_F(DeferredFormatTest, RenderingMatchesEagerFormatting) {
+    auto sink = std::make_unique<TextSink>();
+    TextSink* capture = sink.get();
+    LogManager::getInstance().getSinkManager().addSink(std::move(sink));
+
+    LogStream::SetDeferredFormat(false);
+    logEverything(*logger_);
+    const auto eager = capture->take();
+
+    LogStream::SetDeferredFormat(true);
+    logEverything(*logger_);
+    const auto deferred = capture->take();
+
+    LogManager::getInstance().getSinkManager().removeSink("DeferredText");
+
+    ASSERT_EQ(eager.size(), 3u);
+    EXPECT_EQ(deferred, eager);
+    EXPECT_EQ(eager[2], "level=Warn ec=Stub:0 s=std::string sv=view empty=");
+}
+
+TEST_F(DeferredFormatTest, ArgsSinksGetEncodedValues) {
+    auto sink = std::make_unique<ArgsSink>();
+    ArgsSink* capture = sink.get();
+    LogManager::getInstance().getSinkManager().addSink(std::move(sink));
+
+    LogStream::SetDeferredFormat(true);
+    logger_->LogError() << "temp=" << 97.5 << LogHex16{ 0x1f };
+
+    std::vector<std::vector<UInt8>> payloads;
+    std::vector<std::string> records;
+    {
+        std::lock_guard<std::mutex> lock(capture->mutex);
+        payloads = capture->payloads;
+        records = capture->records;
+    }
+    LogManager::getInstance().getSinkManager().removeSink("DeferredArgs");
+
+    EXPECT_TRUE(records.empty());
+    ASSERT_EQ(payloads.size(), 1u);
+
+    // [tag][len:2]"temp=" + [tag][f64] + [tag][u16], no names
+    const auto& payload = payloads[0];
+    EXPECT_EQ(payload.size(), (1 + 2 + 5) + (1 + 8) + (1 + 2));
+    ArgDecoder decoder(payload.data(), payload.size());
+    ArgView arg;
+    ASSERT_TRUE(decoder.next(arg));
+    EXPECT_EQ(arg.type, ArgType::kString);
+    EXPECT_TRUE(arg.name.empty());
+    ASSERT_TRUE(decoder.next(arg));
+    EXPECT_EQ(arg.type, ArgType::kDouble);
+    EXPECT_DOUBLE_EQ(arg.real, 97.5);
+    ASSERT_TRUE(decoder.next(arg));
+    EXPECT_EQ(arg.type, ArgType::kHex16);
+    EXPECT_EQ(arg.bits, 0x1fu);
+    EXPECT_FALSE(decoder.next(arg));
+}
+
+TEST_F(DeferredFormatTest, HardCapCutsLastString) {
+    auto sink = std::make_unique<TextSink>();
+    TextSink* capture = sink.get();
+    LogManager::getInstance().getSinkManager().addSink(std::move(sink));
+
+    const Size savedCap = LogStream::GetMaxMessageSize();
+    LogStream::SetMaxMessageSize(LogStream::MAX_LOG_SIZE - 1);
+    LogStream::SetDeferredFormat(true);
+    logger_->LogError() << static_cast<UInt32>(7) << std::string(500, 'x') << static_cast<UInt32>(8);
+    LogStream::SetMaxMessageSize(savedCap);
+
+    const auto records = capture->take();
+    LogManager::getInstance().getSinkManager().removeSink("DeferredText");
+
+    // 199 bytes: [tag][u32] = 5, [tag][len:2] = 3, 191 'x'; the trailing value is dropped
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0], "7" + std::string(LogStream::MAX_LOG_SIZE - 1 - 5 - 3, 'x'));
+}
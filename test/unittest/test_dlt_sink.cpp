@@ -0,0 +1,87 @@
+/**
+ * @file        test_dlt_sink.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       DLTSink unit tests
+ * @date        2026-10-16
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CDLTSink.hpp"
+#include "CSinkManager.hpp"
+
+using namespace lap::log;
+using namespace lap::core;
+
+TEST(DLTSink, ContextsRegisteredOnFirstUse) {
+    DLTSink::DLTConfig config;
+    config.contextId = "DCTX";
+    DLTSink sink(config, LogLevel::kVerbose);
+    
+    EXPECT_EQ(sink.getName(), "DLT");
+    EXPECT_EQ(sink.getContextCount(), 0u);
+    
+    // Default and empty context IDs go to the default context
+    sink.write(0, 0, static_cast<LogLevelType>(LogLevel::kWarn), "DCTX", "default");
+    sink.write(0, 0, static_cast<LogLevelType>(LogLevel::kWarn), "", "default");
+    EXPECT_EQ(sink.getContextCount(), 0u);
+    
+    sink.write(0, 0, static_cast<LogLevelType>(LogLevel::kWarn), "CTXA", "a");
+    sink.write(0, 0, static_cast<LogLevelType>(LogLevel::kWarn), "CTXB", "b");
+    sink.write(0, 0, static_cast<LogLevelType>(LogLevel::kWarn), "CTXA", "a again");
+    EXPECT_EQ(sink.getContextCount(), 2u);
+    
+    // Eager registration of a known ID does not add another context
+    EXPECT_TRUE(sink.registerContext("CTXB", "Context B", LogLevel::kInfo));
+    EXPECT_TRUE(sink.registerContext("CTXC", "Context C", LogLevel::kInfo));
+    EXPECT_EQ(sink.getContextCount(), 3u);
+}
+
+TEST(DLTSink, ContextsRegisteredThroughSinkManager) {
+    SinkManager manager;
+    auto owned = MakeUnique<DLTSink>(DLTSink::DLTConfig(), LogLevel::kVerbose);
+    DLTSink* sink = owned.get();
+    manager.addSink(Move(owned));
+    
+    // As LogManager::registerLogger() does: no lookup by name, no cast
+    manager.registerContext("CTXM", "Managed", LogLevel::kInfo, TraceStatus::kDefault);
+    manager.registerContext("CTXM", "Managed", LogLevel::kInfo, TraceStatus::kDefault);
+    EXPECT_EQ(sink->getContextCount(), 1u);
+}
+
+TEST(DLTSink, ContextTableFallsBackToDefault) {
+    DLTSink sink(DLTSink::DLTConfig(), LogLevel::kVerbose);
+    
+    for (Size i = 0; i < DLTSink::kMaxContexts + 10; ++i) {
+        char id[5];
+        snprintf(id, sizeof(id), "%04zu", i);
+        sink.write(0, 0, static_cast<LogLevelType>(LogLevel::kWarn), StringView(id, 4), "msg");
+    }
+    EXPECT_EQ(sink.getContextCount(), DLTSink::kMaxContexts);
+    
+    // Already registered IDs are still found after the table filled up
+    EXPECT_TRUE(sink.registerContext("0000", "first"));
+    EXPECT_EQ(sink.getContextCount(), DLTSink::kMaxContexts);
+}
+
+TEST(DLTSink, ConcurrentFirstUse) {
+    DLTSink sink(DLTSink::DLTConfig(), LogLevel::kVerbose);
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&sink]() {
+            for (int i = 0; i < 1000; ++i) {
+                char id[5];
+                snprintf(id, sizeof(id), "T%03d", i % 32);
+                sink.write(0, 0, static_cast<LogLevelType>(LogLevel::kWarn), StringView(id, 4), "msg");
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    
+    EXPECT_EQ(sink.getContextCount(), 32u);
+}
@@ -0,0 +1,267 @@
+/**
+ * @file        test_log_collector.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       LogCollector (per-process shared memory rings, one file owner) tests
+ * @date        2026-10-16
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "CLogCollector.hpp"
+#include "CShmRingSink.hpp"
+#include "CSinkManager.hpp"
+#include "CArgEncoding.hpp"
+
+using namespace lap::log;
+using namespace lap::core;
+
+namespace
+{
+    struct Captured
+    {
+        UInt64          timestamp;
+        UInt32          threadId;
+        LogLevelType    level;
+        std::string     context;
+        std::string     message;
+    };
+
+    // Sink that records every message it receives
+    class CaptureSink : public ISink
+    {
+    public:
+        void write(UInt64 timestamp, UInt32 threadId, LogLevelType level,
+                   StringView contextId, StringView message) noexcept override
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_records.push_back({ timestamp, threadId, level, std::string(contextId.data(), contextId.size()),
+                                  std::string(message.data(), message.size()) });
+        }
+
+        void flush() noexcept override {}
+        Bool isEnabled() const noexcept override { return true; }
+        StringView getName() const noexcept override { return "Capture"; }
+        void setLevel(LogLevel level) noexcept override { (void)level; }
+        Bool shouldLog(LogLevel level) const noexcept override { (void)level; return true; }
+
+        std::vector<Captured> records() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_records;
+        }
+
+    private:
+        mutable std::mutex      m_mutex;
+        std::vector<Captured>   m_records;
+    };
+}
+
+class LogCollectorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char dir[] = "/dev/shm/lap_collect_XXXXXX";
+        ASSERT_NE(::mkdtemp(dir), nullptr);
+        dir_ = dir;
+        config_.directory = dir_;
+        config_.scanIntervalMs = 0;
+
+        auto capture = std::make_unique<CaptureSink>();
+        sink_ = capture.get();
+        manager_.addSink(std::move(capture));
+    }
+
+    void TearDown() override {
+        std::system(("rm -rf " + dir_).c_str());
+    }
+
+    std::string ringPath() const {
+        return std::string(ShmRingSink::collectPath(StringView(dir_.c_str()), "TEST"));
+    }
+
+    std::string dir_;
+    LogCollector::Config config_;
+    SinkManager manager_;
+    CaptureSink* sink_{ nullptr };
+};
+
+TEST_F(LogCollectorTest, ForwardsInOrderAndRetiresClosedRing) {
+    constexpr int kRecords = 2000;
+    auto ring = std::make_unique<ShmRingSink>(ringPath(), 16 * 1024, LogLevel::kVerbose, "TEST", false, true);
+    ASSERT_TRUE(ring->isEnabled());
+
+    LogCollector collector(manager_, config_);
+    for (int i = 0; i < kRecords; ++i) {
+        ring->write(static_cast<UInt64>(i), 42, static_cast<LogLevelType>(LogLevel::kInfo), "COLL", "record " + std::to_string(i));
+        if (i % 100 == 99) {
+            collector.poll();   // 2000 records do not fit a 16 KiB ring at once
+        }
+    }
+    collector.poll();
+    EXPECT_EQ(ring->getDropped(), 0u);
+
+    auto records = sink_->records();
+    ASSERT_EQ(records.size(), static_cast<size_t>(kRecords));
+    for (int i = 0; i < kRecords; ++i) {
+        EXPECT_EQ(records[i].timestamp, static_cast<UInt64>(i));
+        EXPECT_EQ(records[i].threadId, 42u);
+        EXPECT_EQ(records[i].context, "COLL");
+        EXPECT_EQ(records[i].message, "record " + std::to_string(i));
+    }
+
+    // Client alive: the ring stays attached
+    EXPECT_EQ(collector.getStats().rings, 1u);
+    EXPECT_EQ(::access(ringPath().c_str(), F_OK), 0);
+
+    // Clean shutdown closes the ring, the collector drains and removes it
+    ring->write(kRecords, 42, static_cast<LogLevelType>(LogLevel::kInfo), "COLL", "last");
+    ring.reset();
+    EXPECT_EQ(::access(ringPath().c_str(), F_OK), 0);
+    collector.poll();
+
+    records = sink_->records();
+    ASSERT_EQ(records.size(), static_cast<size_t>(kRecords + 1));
+    EXPECT_EQ(records.back().message, "last");
+    const auto stats = collector.getStats();
+    EXPECT_EQ(stats.records, static_cast<UInt64>(kRecords + 1));
+    EXPECT_EQ(stats.rings, 0u);
+    EXPECT_EQ(stats.retired, 1u);
+    EXPECT_NE(::access(ringPath().c_str(), F_OK), 0);
+}
+
+TEST_F(LogCollectorTest, DeferredRecordsAreRendered) {
+    ShmRingSink ring(ringPath(), 16 * 1024, LogLevel::kVerbose, "TEST", false, true);
+
+    UInt8 buffer[64];
+    ArgEncoder encoder(buffer, sizeof(buffer));
+    encoder.put(StringView(), StringView("count="));
+    encoder.put(StringView(), static_cast<UInt32>(7));
+    ASSERT_TRUE(ring.writeArgs(5, 1, static_cast<LogLevelType>(LogLevel::kWarn), "ARGS", encoder.data(), encoder.size()));
+
+    LogCollector collector(manager_, config_);
+    EXPECT_EQ(collector.poll(), 1u);
+
+    const auto records = sink_->records();
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].context, "ARGS");
+    EXPECT_EQ(records[0].message, "count=7");
+    EXPECT_EQ(records[0].level, static_cast<LogLevelType>(LogLevel::kWarn));
+}
+
+TEST_F(LogCollectorTest, FullRingDropsAndReports) {
+    ShmRingSink ring(ringPath(), 4096, LogLevel::kVerbose, "TEST", false, true);
+    constexpr int kRecords = 500;
+    for (int i = 0; i < kRecords; ++i) {
+        ring.write(static_cast<UInt64>(i), 1, static_cast<LogLevelType>(LogLevel::kInfo), "FULL", "record " + std::to_string(i));
+    }
+    const UInt64 dropped = ring.getDropped();
+    ASSERT_GT(dropped, 0u);
+
+    LogCollector collector(manager_, config_);
+    collector.poll();
+
+    // The oldest records survive, the ones that found the ring full are counted
+    const auto records = sink_->records();
+    ASSERT_EQ(records.size(), static_cast<size_t>(kRecords - dropped + 1));
+    EXPECT_EQ(records.front().message, "record 0");
+    EXPECT_EQ(records.back().context, "LOGC");
+    EXPECT_EQ(records.back().level, static_cast<LogLevelType>(LogLevel::kWarn));
+    EXPECT_NE(records.back().message.find(std::to_string(dropped) + " records dropped by process"), std::string::npos);
+    EXPECT_EQ(collector.getStats().dropped, dropped);
+
+    // Space is released: new records fit again and no second report is made
+    ring.write(kRecords, 1, static_cast<LogLevelType>(LogLevel::kInfo), "FULL", "after drain");
+    collector.poll();
+    EXPECT_EQ(ring.getDropped(), dropped);
+    EXPECT_EQ(sink_->records().back().message, "after drain");
+}
+
+TEST_F(LogCollectorTest, KilledClientIsDrainedAndRetired) {
+    const pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        // The ring is named after the client pid; no destructor runs, the ring is never closed
+        auto* ring = new ShmRingSink(ShmRingSink::collectPath(StringView(dir_.c_str()), "TEST"),
+                                     64 * 1024, LogLevel::kVerbose, "TEST", false, true);
+        for (int i = 0; i < 100; ++i) {
+            ring->write(static_cast<UInt64>(i), 7, static_cast<LogLevelType>(LogLevel::kDebug), "DEAD", "before crash " + std::to_string(i));
+        }
+        ::raise(SIGKILL);
+        ::_exit(0);
+    }
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFSIGNALED(status));
+
+    // Simulate a record reserved but never committed when the client died
+    const std::string childPath = dir_ + "/" + ShmRingSink::kCollectPrefix + "TEST-" + std::to_string(child) + ".ring";
+    const int fd = ::open(childPath.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+    void* map = ::mmap(nullptr, ShmRingSink::kHeaderSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ASSERT_NE(map, MAP_FAILED);
+    reinterpret_cast<std::atomic<UInt64>*>(static_cast<UInt8*>(map) + ShmRingSink::kHeadOffset)->fetch_add(64);
+    ::munmap(map, ShmRingSink::kHeaderSize);
+    ::close(fd);
+
+    LogCollector collector(manager_, config_);
+    collector.poll();
+
+    const auto records = sink_->records();
+    ASSERT_EQ(records.size(), 100u);
+    EXPECT_EQ(records.back().message, "before crash 99");
+    EXPECT_EQ(records.back().threadId, 7u);
+
+    const auto stats = collector.getStats();
+    EXPECT_EQ(stats.tornBytes, 64u);
+    EXPECT_EQ(stats.retired, 1u);
+    EXPECT_NE(::access(childPath.c_str(), F_OK), 0);
+}
+
+TEST_F(LogCollectorTest, RunDrainsConcurrentProducers) {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 5000;
+    ShmRingSink ring(ringPath(), 64 * 1024, LogLevel::kVerbose, "TEST", false, true);
+
+    std::atomic<Bool> stop{ false };
+    LogCollector collector(manager_, config_);
+    std::thread worker([&] { collector.run(stop); });
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&ring, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                ring.write(static_cast<UInt64>(i), static_cast<UInt32>(t), static_cast<LogLevelType>(LogLevel::kInfo),
+                           "MT", "t" + std::to_string(t) + " #" + std::to_string(i));
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    stop.store(true);
+    worker.join();
+
+    // Whatever was not dropped arrives exactly once, per-thread order preserved
+    const auto records = sink_->records();
+    const UInt64 dropped = ring.getDropped();
+    size_t forwarded = 0;
+    std::vector<Int64> last(kThreads, -1);
+    for (const auto& r : records) {
+        if (r.context != "MT") {
+            continue;
+        }
+        ++forwarded;
+        EXPECT_GT(static_cast<Int64>(r.timestamp), last[r.threadId]);
+        last[r.threadId] = static_cast<Int64>(r.timestamp);
+    }
+    EXPECT_EQ(forwarded + dropped, static_cast<size_t>(kThreads * kPerThread));
+}
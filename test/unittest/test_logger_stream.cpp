@@ -3,6 +3,8 @@
 #include "CLogManager.hpp"
 #include "CLogger.hpp"
 #include "CLogStream.hpp"
+#include "CLog.hpp"
+#include "CSinkManager.hpp"
 #include <lap/core/CConfig.hpp>
 
 using namespace lap::log;
@@ -42,3 +44,75 @@ TEST_F(LogFixture, LogStreamFormatAndBinaryHex) {
     logger.LogVerbose() << HexFormat(0x12u) << BinFormat(static_cast<uint16_t>(0x34u)) << " text";
     logger.LogVerbose().logFormat("formatted %d %s", 42, "ok");
 }
+
+namespace {
+    int g_evaluated = 0;
+    int countEvaluation() { return ++g_evaluated; }
+
+    class GateSink : public ISink {
+    public:
+        void write(lap::core::UInt64, lap::core::UInt32, LogLevelType, lap::core::StringView,
+                   lap::core::StringView) noexcept override { ++writes; }
+        void flush() noexcept override {}
+        lap::core::Bool isEnabled() const noexcept override { return true; }
+        lap::core::StringView getName() const noexcept override { return "Gate"; }
+        void setLevel(LogLevel level) noexcept override { m_level = level; notifyChanged(); }
+        lap::core::Bool shouldLog(LogLevel level) const noexcept override { return level <= m_level; }
+
+        int writes{ 0 };
+    private:
+        LogLevel m_level{ LogLevel::kVerbose };
+    };
+}
+
+TEST_F(LogFixture, EffectiveLevelGating) {
+    auto &mgr = LogManager::getInstance();
+    auto &sinkMgr = mgr.getSinkManager();
+    auto &logger = mgr.registerLogger("GATE", "GateCtx", LogLevel::kDebug);
+    const LogLevel savedGlobal = sinkMgr.getGlobalMinLevel();
+
+    // Global filter caps every logger
+    sinkMgr.setGlobalMinLevel(LogLevel::kError);
+    EXPECT_TRUE(logger.ShouldLog(LogLevel::kError));
+    EXPECT_FALSE(logger.ShouldLog(LogLevel::kWarn));
+    EXPECT_FALSE(logger.LogDebug().IsEnabled());
+
+    // Disabled macro statements do not evaluate their arguments
+    g_evaluated = 0;
+    LAP_LOG_DEBUG("GATE") << countEvaluation();
+    EXPECT_EQ(g_evaluated, 0);
+    LAP_LOG_ERROR("GATE") << countEvaluation();
+    EXPECT_EQ(g_evaluated, 1);
+
+    // Dangling-else safety
+    if (g_evaluated == 0)
+        LAP_LOG_ERROR("GATE") << "unreachable";
+    else
+        ++g_evaluated;
+    EXPECT_EQ(g_evaluated, 2);
+
+    // A verbose sink plus a permissive global level: logger level becomes the limit
+    auto sink = std::make_unique<GateSink>();
+    GateSink* gate = sink.get();
+    sinkMgr.addSink(std::move(sink));
+    sinkMgr.setGlobalMinLevel(LogLevel::kVerbose);
+    EXPECT_TRUE(logger.ShouldLog(LogLevel::kDebug));
+    EXPECT_FALSE(logger.ShouldLog(LogLevel::kVerbose));
+
+    logger.LogDebug() << "reaches the gate sink";
+    EXPECT_EQ(gate->writes, 1);
+    logger.LogVerbose() << "filtered by the logger level";
+    EXPECT_EQ(gate->writes, 1);
+
+    // Direct sink reconfiguration takes effect at once (change listener)
+    gate->setLevel(LogLevel::kInfo);
+    const bool otherSinkDebug = sinkMgr.shouldLog(LogLevel::kDebug);
+    EXPECT_EQ(logger.ShouldLog(LogLevel::kDebug), otherSinkDebug);
+    gate->setLevel(LogLevel::kVerbose);
+    EXPECT_TRUE(logger.ShouldLog(LogLevel::kDebug));
+    logger.LogDebug() << "raised verbosity is not lost";
+    EXPECT_EQ(gate->writes, 2);
+
+    EXPECT_TRUE(sinkMgr.removeSink("Gate"));
+    sinkMgr.setGlobalMinLevel(savedGlobal);
+}
@@ -0,0 +1,256 @@
+/**
+ * @file        test_modeled_message.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Modeled message and binary argument encoding unit tests
+ * @date        2026-10-16
+ */
+
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <lap/core/CConfig.hpp>
+#include "CLogManager.hpp"
+#include "CLogger.hpp"
+#include "CAsyncLogQueue.hpp"
+#include "CSinkManager.hpp"
+#include "CModeledMessage.hpp"
+
+using namespace lap::log;
+using namespace lap::core;
+
+namespace {
+    struct StartupMessage : MessageId<1000> {};
+    struct OverTempMessage : MessageId<1001, LogLevel::kWarn> {};
+    struct TraceMessage : MessageId<1002, LogLevel::kVerbose> {};
+
+    // Text sink: receives the "[MsgId:NNNN] ..." rendering through write()
+    class TextSink : public ISink {
+    public:
+        void write(UInt64, UInt32, LogLevelType level, StringView contextId, StringView message) noexcept override {
+            if (contextId == "MODL") {
+                std::lock_guard<std::mutex> lock(mutex);
+                levels.push_back(level);
+                records.emplace_back(message.data(), message.size());
+            }
+        }
+        void flush() noexcept override {}
+        Bool isEnabled() const noexcept override { return true; }
+        StringView getName() const noexcept override { return "ModeledText"; }
+        void setLevel(LogLevel) noexcept override {}
+        Bool shouldLog(LogLevel) const noexcept override { return true; }
+
+        std::mutex mutex;
+        std::vector<LogLevelType> levels;
+        std::vector<std::string> records;
+    };
+
+    // Binary sink: consumes the encoded arguments, never sees text
+    class BinarySink : public TextSink {
+    public:
+        Bool writeModeled(UInt64, UInt32, LogLevelType, StringView contextId, const ModeledRecord& record) noexcept override {
+            if (contextId == "MODL") {
+                std::lock_guard<std::mutex> lock(mutex);
+                messageIds.push_back(record.getMessageId());
+                payloads.emplace_back(record.getPayload(), record.getPayload() + record.getPayloadSize());
+            }
+            return true;
+        }
+        StringView getName() const noexcept override { return "ModeledBinary"; }
+
+        std::vector<UInt32> messageIds;
+        std::vector<std::vector<UInt8>> payloads;
+    };
+
+    std::string render(const ArgView& arg) {
+        char text[128];
+        return std::string(text, ArgFormat::formatValue(text, sizeof(text), arg));
+    }
+}
+
+class ModeledMessageTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        lap::core::ConfigManager::getInstance();
+        LogManager::getInstance().initialize();
+        auto& sinkMgr = LogManager::getInstance().getSinkManager();
+        savedGlobal_ = sinkMgr.getGlobalMinLevel();
+        sinkMgr.setGlobalMinLevel(LogLevel::kVerbose);
+        logger_ = &LogManager::getInstance().registerLogger("MODL", "Modeled messages", LogLevel::kInfo);
+    }
+
+    void TearDown() override {
+        LogManager::getInstance().getSinkManager().setGlobalMinLevel(savedGlobal_);
+        LogManager::getInstance().uninitialize();
+    }
+
+    Logger* logger_;
+    LogLevel savedGlobal_;
+};
+
+TEST(ArgEncoding, RoundTripAllTypes) {
+    UInt8 buffer[512];
+    ArgEncoder encoder(buffer, sizeof(buffer));
+    encoder.put("b", true);
+    encoder.put("u8", static_cast<UInt8>(200));
+    encoder.put("u64", static_cast<UInt64>(18446744073709551615ULL));
+    encoder.put("i8", static_cast<Int8>(-100));
+    encoder.put("i32", static_cast<Int32>(-123456));
+    encoder.put("i64", static_cast<Int64>(-9223372036854775807LL - 1));
+    encoder.put("f", 1.5f);
+    encoder.put("d", 2.25);
+    encoder.put("h16", LogHex16{ 0xBEEF });
+    encoder.put("b8", LogBin8{ 0xA5, true });
+    encoder.put("lvl", LogLevel::kError);
+    encoder.put("s", "text");
+    encoder.put("", static_cast<UInt32>(7));   // Unnamed
+    EXPECT_FALSE(encoder.truncated());
+
+    ArgDecoder decoder(encoder.data(), encoder.size());
+    std::vector<std::pair<std::string, std::string>> decoded;
+    ArgView arg;
+    while (decoder.next(arg)) {
+        decoded.emplace_back(std::string(arg.name.data(), arg.name.size()), render(arg));
+    }
+
+    const std::vector<std::pair<std::string, std::string>> expected = {
+        { "b", "1" }, { "u8", "200" }, { "u64", "18446744073709551615" }, { "i8", "-100" },
+        { "i32", "-123456" }, { "i64", "-9223372036854775808" }, { "f", "1.500000" }, { "d", "2.250000000000" },
+        { "h16", "0xBEEF" }, { "b8", "0b1010_0101" }, { "lvl", "Error" }, { "s", "text" }, { "", "7" },
+    };
+    EXPECT_EQ(decoded, expected);
+}
+
+TEST(ArgEncoding, TruncationKeepsWholeArguments) {
+    UInt8 buffer[16];
+    ArgEncoder encoder(buffer, sizeof(buffer));
+    encoder.put("a", static_cast<UInt32>(1));   // 1 + 2 + 4 = 7 bytes
+    encoder.put("s", "abcdefghijkl");           // cut to what is left
+    encoder.put("c", static_cast<UInt64>(3));   // dropped
+    EXPECT_TRUE(encoder.truncated());
+    EXPECT_EQ(encoder.size(), sizeof(buffer));
+
+    ArgDecoder decoder(encoder.data(), encoder.size());
+    ArgView arg;
+    ASSERT_TRUE(decoder.next(arg));
+    EXPECT_EQ(arg.bits, 1u);
+    ASSERT_TRUE(decoder.next(arg));
+    EXPECT_EQ(std::string(arg.text.data(), arg.text.size()), "abcd");
+    EXPECT_FALSE(decoder.next(arg));
+}
+
+TEST_F(ModeledMessageTest, TextSinksGetMsgIdRendering) {
+    auto sink = std::make_unique<TextSink>();
+    TextSink* capture = sink.get();
+    LogManager::getInstance().getSinkManager().addSink(std::move(sink));
+
+    logger_->Log(StartupMessage{}, "version", "1.0.0", "pid", static_cast<Int32>(4242));
+    logger_->Log(OverTempMessage{}, "sensor", LogHex8{ 0x1f }, "celsius", 97.5);
+    logger_->Log(StartupMessage{});
+    logger_->Log(TraceMessage{}, "dropped", 1);     // kVerbose is below the logger level
+
+    ASSERT_EQ(capture->records.size(), 3u);
+    EXPECT_EQ(capture->records[0], "[MsgId:1000] version=1.0.0, pid=4242");
+    EXPECT_EQ(capture->records[1], "[MsgId:1001] sensor=0x1F, celsius=97.500000000000");
+    EXPECT_EQ(capture->records[2], "[MsgId:1000]");
+    EXPECT_EQ(capture->levels[0], static_cast<LogLevelType>(LogLevel::kInfo));
+    EXPECT_EQ(capture->levels[1], static_cast<LogLevelType>(LogLevel::kWarn));
+
+    LogManager::getInstance().getSinkManager().removeSink("ModeledText");
+}
+
+TEST_F(ModeledMessageTest, StringsWithSeparatorsAreQuoted) {
+    auto sink = std::make_unique<TextSink>();
+    TextSink* capture = sink.get();
+    LogManager::getInstance().getSinkManager().addSink(std::move(sink));
+
+    logger_->Log(StartupMessage{}, "msg", "a, \"b\"", "path", String("/etc/app.conf"));
+
+    ASSERT_EQ(capture->records.size(), 1u);
+    EXPECT_EQ(capture->records[0], "[MsgId:1000] msg=\"a, \\\"b\\\"\", path=/etc/app.conf");
+
+    LogManager::getInstance().getSinkManager().removeSink("ModeledText");
+}
+
+TEST_F(ModeledMessageTest, BinarySinksGetEncodedArguments) {
+    auto sink = std::make_unique<BinarySink>();
+    BinarySink* capture = sink.get();
+    LogManager::getInstance().getSinkManager().addSink(std::move(sink));
+
+    logger_->Log(OverTempMessage{}, "sensor", static_cast<UInt16>(3), "celsius", 97.5);
+
+    ASSERT_EQ(capture->messageIds.size(), 1u);
+    EXPECT_TRUE(capture->records.empty());
+    EXPECT_EQ(capture->messageIds[0], 1001u);
+
+    // 2 tagged, named values: [tag][6]"sensor"[u16] + [tag][7]"celsius"[f64]
+    const auto& payload = capture->payloads[0];
+    EXPECT_EQ(payload.size(), (1 + 1 + 6 + 2) + (1 + 1 + 7 + 8));
+    ArgDecoder decoder(payload.data(), payload.size());
+    ArgView arg;
+    ASSERT_TRUE(decoder.next(arg));
+    EXPECT_EQ(arg.type, ArgType::kUInt16);
+    EXPECT_EQ(arg.bits, 3u);
+    ASSERT_TRUE(decoder.next(arg));
+    EXPECT_EQ(arg.type, ArgType::kDouble);
+    EXPECT_DOUBLE_EQ(arg.real, 97.5);
+
+    LogManager::getInstance().getSinkManager().removeSink("ModeledBinary");
+}
+
+TEST(ModeledMessageAsync, QueuedAsMessageIdAndArguments) {
+    // Same as BinarySinksGetEncodedArguments/TextSinksGetMsgIdRendering, through the async queue
+    auto& cfgMgr = lap::core::ConfigManager::getInstance();
+    auto logObj = cfgMgr.getModuleConfigJson("log");
+    if (!logObj.is_object()) {
+        logObj = decltype(logObj)::object();
+    }
+    logObj["asyncQueue"]["enable"] = true;
+    cfgMgr.setModuleConfigJson("log", logObj);
+
+    auto& logMgr = LogManager::getInstance();
+    logMgr.initialize();
+    ASSERT_NE(logMgr.getAsyncQueue(), nullptr);
+    auto& sinkMgr = logMgr.getSinkManager();
+    const LogLevel savedGlobal = sinkMgr.getGlobalMinLevel();
+    sinkMgr.setGlobalMinLevel(LogLevel::kVerbose);
+
+    auto binary = std::make_unique<BinarySink>();
+    BinarySink* binaryCapture = binary.get();
+    auto text = std::make_unique<TextSink>();
+    TextSink* textCapture = text.get();
+    sinkMgr.addSink(std::move(binary));
+    sinkMgr.addSink(std::move(text));
+
+    Logger& logger = logMgr.registerLogger("MODL", "Modeled messages", LogLevel::kInfo);
+    logger.Log(OverTempMessage{}, "sensor", static_cast<UInt16>(3), "celsius", 97.5);
+    ASSERT_TRUE(logMgr.getAsyncQueue()->flush());
+
+    {
+        std::lock_guard<std::mutex> lock(binaryCapture->mutex);
+        ASSERT_EQ(binaryCapture->messageIds.size(), 1u);
+        EXPECT_TRUE(binaryCapture->records.empty());
+        EXPECT_EQ(binaryCapture->messageIds[0], 1001u);
+        ASSERT_EQ(binaryCapture->payloads[0].size(), (1 + 1 + 6 + 2) + (1 + 1 + 7 + 8));
+        ArgDecoder decoder(binaryCapture->payloads[0].data(), binaryCapture->payloads[0].size());
+        ArgView arg;
+        ASSERT_TRUE(decoder.next(arg));
+        EXPECT_EQ(arg.bits, 3u);
+        ASSERT_TRUE(decoder.next(arg));
+        EXPECT_DOUBLE_EQ(arg.real, 97.5);
+    }
+    {
+        std::lock_guard<std::mutex> lock(textCapture->mutex);
+        ASSERT_EQ(textCapture->records.size(), 1u);
+        EXPECT_EQ(textCapture->records[0].rfind("[MsgId:1001]", 0), 0u) << textCapture->records[0];
+        EXPECT_EQ(textCapture->levels[0], static_cast<LogLevelType>(LogLevel::kWarn));
+    }
+
+    sinkMgr.removeSink("ModeledBinary");
+    sinkMgr.removeSink("ModeledText");
+    sinkMgr.setGlobalMinLevel(savedGlobal);
+    logMgr.uninitialize();
+    // Parsed options persist across initialize(): switch the queue off explicitly
+    logObj["asyncQueue"]["enable"] = false;
+    cfgMgr.setModuleConfigJson("log", logObj);
+}
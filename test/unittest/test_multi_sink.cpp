@@ -8,9 +8,25 @@
 #include <gtest/gtest.h>
 #include <thread>
 #include <chrono>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <limits>
+#include <fstream>
+#include <set>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <utime.h>
+#include <unistd.h>
 #include "CConsoleSink.hpp"
 #include "CFileSink.hpp"
 #include "CSinkManager.hpp"
+#if LAP_LOG_HAS_ZLIB
+#include <zlib.h>
+#endif
 
 using namespace lap::log;
 using namespace lap::core;
@@ -26,7 +42,7 @@ TEST(MultiSink, ConsoleSinkBasic) {
     
     // Write directly with sink's write method
     auto now = ::std::chrono::system_clock::now();
-    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::microseconds>(
+    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
         now.time_since_epoch()).count();
     UInt32 threadId = static_cast<UInt32>(::std::hash<::std::thread::id>{}(::std::this_thread::get_id()));
     
@@ -34,6 +50,178 @@ TEST(MultiSink, ConsoleSinkBasic) {
     sink.flush();
 }
 
+namespace {
+    // Points fd 1 or 2 at a temporary file while alive; no gtest output in between (gtest writes to fd 1)
+    class StreamCapture {
+    public:
+        explicit StreamCapture(int fd) : m_fd(fd) {
+            std::fflush(nullptr);
+            m_saved = ::dup(fd);
+            m_file = ::open(m_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+            ::dup2(m_file, fd);
+        }
+        ~StreamCapture() { restore(); ::close(m_file); ::unlink(m_path); }
+
+        void restore() {
+            if (m_saved >= 0) {
+                ::dup2(m_saved, m_fd);
+                ::close(m_saved);
+                m_saved = -1;
+            }
+        }
+
+        std::string contents() const {
+            std::string text;
+            char buffer[4096];
+            ssize_t n;
+            for (off_t offset = 0; (n = ::pread(m_file, buffer, sizeof(buffer), offset)) > 0; offset += n) {
+                text.append(buffer, static_cast<size_t>(n));
+            }
+            return text;
+        }
+
+        size_t lines() const {
+            const std::string text = contents();
+            return static_cast<size_t>(std::count(text.begin(), text.end(), '\n'));
+        }
+
+    private:
+        const char* m_path = "/tmp/lap_test_console.out";
+        int m_fd;
+        int m_saved{ -1 };
+        int m_file{ -1 };
+    };
+}
+
+TEST(MultiSink, ConsoleSinkRedirectedDropsColors) {
+    StreamCapture capture(STDERR_FILENO);
+    {
+        ConsoleSink sink(true, LogLevel::kVerbose);
+        EXPECT_FALSE(sink.isColorized());
+        sink.write(0, 1, static_cast<LogLevelType>(LogLevel::kWarn), "PIPE", "plain text");
+    }
+    {
+        ConsoleConfig config;
+        config.forceColor = true;
+        ConsoleSink sink(true, LogLevel::kVerbose, config);
+        EXPECT_TRUE(sink.isColorized());
+        sink.write(0, 1, static_cast<LogLevelType>(LogLevel::kWarn), "PIPE", "colored text");
+    }
+    capture.restore();
+
+    const std::string text = capture.contents();
+    const size_t split = text.find('\n');
+    ASSERT_NE(split, std::string::npos);
+    const std::string plain = text.substr(0, split);
+    EXPECT_EQ(plain.find('\033'), std::string::npos);
+    EXPECT_EQ(plain.front(), '[');
+    EXPECT_NE(plain.find("] [WARN ] [PIPE] plain text"), std::string::npos);
+    EXPECT_NE(text.find(std::string(ANSI_YELLOW) + "["), std::string::npos);
+    EXPECT_NE(text.find(std::string(ANSI_RESET) + " colored text\n"), std::string::npos);
+}
+
+TEST(MultiSink, ConsoleSinkBatched) {
+    ConsoleConfig config;
+    config.bufferSize = 4096;
+    config.flushIntervalMs = 60000;
+    StreamCapture capture(STDERR_FILENO);
+    ConsoleSink sink(false, LogLevel::kVerbose, config);
+    EXPECT_FALSE(sink.isThreadSafe());     // SinkManager serializes the buffer
+
+    const auto info = static_cast<LogLevelType>(LogLevel::kInfo);
+    for (int i = 0; i < 3; ++i) {
+        sink.write(0, 1, info, "BTCH", "buffered " + std::to_string(i));
+    }
+    const size_t beforeError = capture.lines();
+
+    // ERROR pushes out the batch together with itself
+    sink.write(0, 1, static_cast<LogLevelType>(LogLevel::kError), "BTCH", "urgent");
+    const size_t afterError = capture.lines();
+
+    // A record larger than the buffer goes out after what is pending, in order
+    sink.write(0, 1, info, "BTCH", "pending");
+    sink.write(0, 1, info, "BTCH", std::string(8192, 'x'));
+    const size_t afterLarge = capture.lines();
+
+    sink.write(0, 1, info, "BTCH", "until flush");
+    const size_t beforeFlush = capture.lines();
+    sink.flush();
+    capture.restore();
+
+    EXPECT_EQ(beforeError, 0u);
+    EXPECT_EQ(afterError, 4u);
+    EXPECT_EQ(afterLarge, 6u);
+    EXPECT_EQ(beforeFlush, 6u);
+    EXPECT_EQ(capture.lines(), 7u);
+
+    const std::string text = capture.contents();
+    EXPECT_LT(text.find("buffered 2"), text.find("urgent"));
+    EXPECT_LT(text.find("pending"), text.find(std::string(8192, 'x')));
+    EXPECT_NE(text.find(std::string(8192, 'x') + "\n"), std::string::npos);
+}
+
+TEST(MultiSink, ConsoleSinkBatchedTimerFlush) {
+    ConsoleConfig config;
+    config.bufferSize = 4096;
+    config.flushIntervalMs = 100;
+    StreamCapture capture(STDERR_FILENO);
+    SinkManager manager;
+    manager.addSink(std::make_unique<ConsoleSink>(false, LogLevel::kVerbose, config));
+
+    alignas(64) char storage[sizeof(LogEntry) + 16];
+    LogEntry* entry = new (storage) LogEntry();
+    entry->level = static_cast<LogLevelType>(LogLevel::kInfo);
+    entry->contextIdLen = 4;
+    entry->messageLen = 4;
+    std::memcpy(storage + sizeof(LogEntry), "BTCHidle", 8);
+
+    // One record, then nothing: the flush timer writes it out
+    const auto start = std::chrono::steady_clock::now();
+    manager.write(*entry);
+    const size_t written = capture.lines();
+    while (capture.lines() == 0 && std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    const size_t flushed = capture.lines();
+    capture.restore();
+
+    EXPECT_EQ(written, 0u);
+    EXPECT_EQ(flushed, 1u);
+    EXPECT_LE(elapsed.count(), 100 + 100);  // Interval plus scheduling slack
+}
+
+TEST(MultiSink, ConsoleSinkBufferAllocationFails) {
+    ConsoleConfig config;
+    config.bufferSize = std::numeric_limits<size_t>::max();
+    StreamCapture capture(STDERR_FILENO);
+    ConsoleSink sink(false, LogLevel::kVerbose, config);
+
+    // Falls back to one writev() per record instead of terminating
+    EXPECT_TRUE(sink.isThreadSafe());
+    EXPECT_EQ(sink.getFlushIntervalMs(), 0u);
+    sink.write(0, 1, static_cast<LogLevelType>(LogLevel::kInfo), "NOBF", "unbuffered");
+    const size_t written = capture.lines();
+    capture.restore();
+
+    EXPECT_EQ(written, 2u);     // Allocation warning plus the record
+    EXPECT_NE(capture.contents().find("] [INFO ] [NOBF] unbuffered\n"), std::string::npos);
+}
+
+TEST(MultiSink, ConsoleSinkStdout) {
+    ConsoleConfig config;
+    config.stream = ConsoleStream::kStdout;
+    config.bufferSize = 1024;
+    StreamCapture capture(STDOUT_FILENO);
+    {
+        ConsoleSink sink(true, LogLevel::kVerbose, config);
+        sink.write(0, 1, static_cast<LogLevelType>(LogLevel::kInfo), "OUT", "to stdout");
+    }   // Destructor writes the batch
+    capture.restore();
+
+    EXPECT_NE(capture.contents().find("] [INFO ] [OUT] to stdout\n"), std::string::npos);
+}
+
 TEST(MultiSink, FileSinkBasic) {
     const char* testFile = "/tmp/lap_test.log";
     
@@ -47,7 +235,7 @@ TEST(MultiSink, FileSinkBasic) {
     
     // Get common parameters
     auto now = ::std::chrono::system_clock::now();
-    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::microseconds>(
+    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
         now.time_since_epoch()).count();
     UInt32 threadId = static_cast<UInt32>(::std::hash<::std::thread::id>{}(::std::this_thread::get_id()));
     
@@ -90,7 +278,7 @@ TEST(MultiSink, FileSinkRotation) {
     
     // Get common parameters
     auto now = ::std::chrono::system_clock::now();
-    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::microseconds>(
+    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
         now.time_since_epoch()).count();
     UInt32 threadId = static_cast<UInt32>(::std::hash<::std::thread::id>{}(::std::this_thread::get_id()));
     
@@ -101,6 +289,7 @@ TEST(MultiSink, FileSinkRotation) {
     }
     
     sink.flush();
+    sink.waitRotation();  // Backups are shifted on the rotator thread
     
     // Check that rotation happened
     FILE* f = fopen(testFile, "r");
@@ -124,6 +313,750 @@ TEST(MultiSink, FileSinkRotation) {
     ::unlink((String(testFile) + ".2").c_str());
 }
 
+static int countLines(const char* path) {
+    std::ifstream in(path);
+    std::string line;
+    int count = 0;
+    while (std::getline(in, line)) {
+        ++count;
+    }
+    return count;
+}
+
+TEST(MultiSink, FileSinkBuffered) {
+    const char* testFile = "/tmp/lap_test_buffered.log";
+    ::unlink(testFile);
+    
+    FileBufferConfig bufferConfig;
+    bufferConfig.bufferSize = 64 * 1024;
+    bufferConfig.flushIntervalMs = 60 * 1000;  // Only explicit/threshold flushes in this test
+    
+    {
+        FileSink sink(testFile, 100 * 1024 * 1024, 1, LogLevel::kVerbose, "", bufferConfig);
+        
+        // Records stay in the buffer until a flush trigger
+        for (int i = 0; i < 100; ++i) {
+            String msg = "Buffered message #" + std::to_string(i);
+            sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "BUF", msg.c_str());
+        }
+        EXPECT_EQ(countLines(testFile), 0);
+        EXPECT_GT(sink.getCurrentSize(), 0u);  // Pending bytes count towards rotation
+        
+        // flush() writes everything out, in order
+        sink.flush();
+        EXPECT_EQ(countLines(testFile), 100);
+        
+        // ERROR flushes immediately, including the INFO queued before it
+        sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "BUF", "info before error");
+        sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x02), "BUF", "error");
+        EXPECT_EQ(countLines(testFile), 102);
+        
+        // Filling the buffer flushes it
+        String big(1000, 'x');
+        for (int i = 0; i < 80; ++i) {
+            sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "BUF", big.c_str());
+        }
+        EXPECT_GT(countLines(testFile), 102);
+        
+        sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "BUF", "last");
+    }
+    
+    // Destructor writes what is left
+    std::ifstream in(testFile);
+    std::string line;
+    std::vector<std::string> lines;
+    while (std::getline(in, line)) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 183u);
+    EXPECT_NE(lines[0].find("Buffered message #0"), std::string::npos);
+    EXPECT_NE(lines[99].find("Buffered message #99"), std::string::npos);
+    EXPECT_NE(lines.back().find("last"), std::string::npos);
+    
+    ::unlink(testFile);
+}
+
+TEST(MultiSink, FileSinkBufferedIntervalFlush) {
+    const char* testFile = "/tmp/lap_test_buffered_interval.log";
+    ::unlink(testFile);
+    
+    FileBufferConfig bufferConfig;
+    bufferConfig.bufferSize = 64 * 1024;
+    bufferConfig.flushIntervalMs = 20;
+    
+    FileSink sink(testFile, 100 * 1024 * 1024, 1, LogLevel::kVerbose, "", bufferConfig);
+    sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "BUF", "first");
+    EXPECT_EQ(countLines(testFile), 0);
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    
+    // The next write finds the oldest record past the interval
+    sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "BUF", "second");
+    EXPECT_EQ(countLines(testFile), 2);
+    
+    ::unlink(testFile);
+}
+
+TEST(MultiSink, FileSinkBufferedTimerFlush) {
+    const char* testFile = "/tmp/lap_test_buffered_timer.log";
+    ::unlink(testFile);
+    
+    FileBufferConfig bufferConfig;
+    bufferConfig.bufferSize = 64 * 1024;
+    bufferConfig.flushIntervalMs = 200;
+    
+    SinkManager manager;
+    manager.addSink(std::make_unique<FileSink>(testFile, 100 * 1024 * 1024, 1, LogLevel::kVerbose, "", bufferConfig));
+    
+    alignas(64) char storage[sizeof(LogEntry) + 16];
+    LogEntry* entry = new (storage) LogEntry();
+    entry->level = 0x04;
+    entry->contextIdLen = 3;
+    entry->messageLen = 4;
+    std::memcpy(storage + sizeof(LogEntry), "BUFonly", 7);
+    
+    // A single record and no further write: SinkManager's flush timer writes it out
+    const auto start = std::chrono::steady_clock::now();
+    manager.write(*entry);
+    EXPECT_EQ(countLines(testFile), 0);
+    while (countLines(testFile) == 0 &&
+           std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    
+    EXPECT_EQ(countLines(testFile), 1);
+    EXPECT_GE(elapsed.count(), 150);     // Held back, not written through
+    EXPECT_LE(elapsed.count(), 200 + 100);  // Interval plus scheduling slack
+    
+    ::unlink(testFile);
+}
+
+TEST(MultiSink, FileSinkBufferedRotation) {
+    const char* testFile = "/tmp/lap_test_buffered_rotate.log";
+    auto cleanup = [&]() {
+        ::unlink(testFile);
+        for (int i = 1; i <= 5; ++i) {
+            ::unlink((String(testFile) + "." + std::to_string(i)).c_str());
+        }
+    };
+    cleanup();
+    
+    FileBufferConfig bufferConfig;
+    bufferConfig.bufferSize = 64 * 1024;
+    bufferConfig.flushIntervalMs = 60 * 1000;
+    
+    {
+        FileSink sink(testFile, 2048, 5, LogLevel::kVerbose, "", bufferConfig);
+        for (int i = 0; i < 50; ++i) {
+            String msg = "Rotating buffered message #" + std::to_string(i);
+            sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "ROT", msg.c_str());
+        }
+    }
+    
+    // Nothing lost: pending records are written before each rotation
+    EXPECT_GT(countLines((String(testFile) + ".1").c_str()), 0);
+    int total = countLines(testFile);
+    for (int i = 1; i <= 5; ++i) {
+        total += countLines((String(testFile) + "." + std::to_string(i)).c_str());
+    }
+    EXPECT_EQ(total, 50);
+    
+    cleanup();
+}
+
+static std::vector<std::string> readLines(const String& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::vector<std::string> lines;
+    while (std::getline(in, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+TEST(MultiSink, FileSinkIoUring) {
+    const char* testFile = "/tmp/lap_test_io_uring.log";
+    ::unlink(testFile);
+    
+    FileBufferConfig bufferConfig;
+    bufferConfig.bufferSize = 8 * 1024;
+    bufferConfig.flushIntervalMs = 60 * 1000;
+    bufferConfig.ioEngine = FileIoEngine::kIoUring;
+    
+    {
+        FileSink sink(testFile, 0, 1, LogLevel::kVerbose, "", bufferConfig);
+        
+        // Many batches in flight back to back: the chains must land in order
+        for (int i = 0; i < 5000; ++i) {
+            String msg = "Ring message #" + std::to_string(i);
+            sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "URG", msg.c_str());
+        }
+        
+        // flush() returns with every submitted batch written
+        sink.flush();
+        EXPECT_EQ(countLines(testFile), 5000);
+        
+        // ERROR waits for its batch, like the write(2) path
+        sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x02), "URG", "error");
+        EXPECT_EQ(countLines(testFile), 5001);
+        
+        // Without io_uring (old kernel, seccomp) the same records go out with write(2)
+        const FileIoStats stats = sink.getIoStats();
+        if (stats.ringEnters > 0) {
+            EXPECT_EQ(stats.writeCalls, 0u);
+        } else {
+            EXPECT_GT(stats.writeCalls, 0u);
+        }
+        
+        sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "URG", "last");
+    }
+    
+    // Destructor submits the rest with a linked fsync
+    const auto lines = readLines(testFile);
+    ASSERT_EQ(lines.size(), 5002u);
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_NE(lines[i].find("Ring message #" + std::to_string(i)), std::string::npos) << lines[i];
+    }
+    EXPECT_NE(lines.back().find("last"), std::string::npos);
+    
+    ::unlink(testFile);
+}
+
+TEST(MultiSink, FileSinkIoUringRotation) {
+    const char* testFile = "/tmp/lap_test_io_uring_rotate.log";
+    const int kBackups = 40;
+    auto cleanup = [&]() {
+        ::unlink(testFile);
+        for (int i = 1; i <= kBackups; ++i) {
+            ::unlink((String(testFile) + "." + std::to_string(i)).c_str());
+        }
+    };
+    cleanup();
+    
+    FileBufferConfig bufferConfig;
+    bufferConfig.bufferSize = 4096;
+    bufferConfig.ioEngine = FileIoEngine::kIoUring;
+    
+    {
+        // Background rotation switches descriptors only after the ring is idle
+        FileSink sink(testFile, 16 * 1024, kBackups, LogLevel::kVerbose, "", bufferConfig);
+        for (int i = 0; i < 4000; ++i) {
+            String msg = "Ring rotation message #" + std::to_string(i);
+            sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "ROT", msg.c_str());
+        }
+        sink.flush();
+        sink.waitRotation();
+    }
+    
+    std::vector<std::string> lines;
+    for (int i = kBackups; i >= 0; --i) {
+        const auto part = readLines(i == 0 ? String(testFile) : String(testFile) + "." + std::to_string(i));
+        lines.insert(lines.end(), part.begin(), part.end());
+    }
+    ASSERT_EQ(lines.size(), 4000u);
+    for (int i = 0; i < 4000; ++i) {
+        ASSERT_NE(lines[i].find("message #" + std::to_string(i)), std::string::npos) << lines[i];
+    }
+    
+    cleanup();
+}
+
+TEST(MultiSink, FileSinkSyncOnError) {
+    const char* testFile = "/tmp/lap_test_sync_error.log";
+    ::unlink(testFile);
+    
+    FileSyncConfig syncConfig;
+    syncConfig.policy = FileSyncPolicy::kOnError;
+    
+    {
+        FileSink sink(testFile, 0, 1, LogLevel::kVerbose, "", FileBufferConfig(), FileRotationConfig(), syncConfig);
+        for (int i = 0; i < 100; ++i) {
+            sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "SYNC", "info");
+        }
+        EXPECT_EQ(sink.getIoStats().syncCalls, 0u);
+        
+        // FATAL returns only once its record is synced
+        sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x01), "SYNC", "fatal");
+        EXPECT_EQ(sink.getIoStats().syncCalls, 1u);
+        
+        // ERRORs do not wait; a burst is served by few syncs, sync() waits for the last one
+        for (int i = 0; i < 50; ++i) {
+            sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x02), "SYNC", "error");
+        }
+        EXPECT_TRUE(sink.sync());
+        const UInt64 afterBurst = sink.getIoStats().syncCalls;
+        EXPECT_GE(afterBurst, 2u);
+        EXPECT_LE(afterBurst, 51u);
+        
+        // Nothing new written: sync() needs no fdatasync
+        EXPECT_TRUE(sink.sync());
+        EXPECT_EQ(sink.getIoStats().syncCalls, afterBurst);
+        
+        // INFO records and flush() (async queue going idle) trigger no sync under this policy
+        for (int i = 0; i < 10; ++i) {
+            sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "SYNC", "info");
+            sink.flush();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_EQ(sink.getIoStats().syncCalls, afterBurst);
+    }
+    EXPECT_EQ(countLines(testFile), 161);
+    
+    ::unlink(testFile);
+}
+
+TEST(MultiSink, FileSinkSyncPeriodicAndBytes) {
+    const char* testFile = "/tmp/lap_test_sync_policy.log";
+    ::unlink(testFile);
+    
+    {
+        FileSyncConfig syncConfig;
+        syncConfig.policy = FileSyncPolicy::kPeriodic;
+        syncConfig.intervalMs = 20;
+        FileSink sink(testFile, 0, 1, LogLevel::kVerbose, "", FileBufferConfig(), FileRotationConfig(), syncConfig);
+        
+        sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "SYNC", "periodic");
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        const UInt64 synced = sink.getIoStats().syncCalls;
+        EXPECT_GE(synced, 1u);
+        
+        // Idle file: the timer finds nothing to sync
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        EXPECT_EQ(sink.getIoStats().syncCalls, synced);
+    }
+    
+    {
+        FileSyncConfig syncConfig;
+        syncConfig.policy = FileSyncPolicy::kEveryBytes;
+        syncConfig.everyBytes = 4096;
+        FileBufferConfig bufferConfig;
+        bufferConfig.bufferSize = 1024;
+        FileSink sink(testFile, 0, 1, LogLevel::kVerbose, "", bufferConfig, FileRotationConfig(), syncConfig);
+        
+        // ~64 KiB written: at most one request per 4 KiB, coalesced while a sync runs
+        String msg(100, 'b');
+        for (int i = 0; i < 500; ++i) {
+            sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "SYNC", msg.c_str());
+        }
+        EXPECT_TRUE(sink.sync());
+        const UInt64 syncs = sink.getIoStats().syncCalls;
+        EXPECT_GE(syncs, 1u);
+        EXPECT_LE(syncs, 18u);
+    }
+    
+    {
+        // No policy: flush() stays cheap, sync() is explicit
+        FileSink sink(testFile, 0, 1, LogLevel::kVerbose);
+        sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "SYNC", "none");
+        sink.flush();
+        EXPECT_EQ(sink.getIoStats().syncCalls, 0u);
+        EXPECT_TRUE(sink.sync());
+        EXPECT_EQ(sink.getIoStats().syncCalls, 1u);
+    }
+    
+    ::unlink(testFile);
+}
+
+TEST(MultiSink, FileSinkBackgroundRotation) {
+    const char* testFile = "/tmp/lap_test_bg_rotate.log";
+    const int kBackups = 20;
+    auto cleanup = [&]() {
+        ::unlink(testFile);
+        for (int i = 1; i <= kBackups; ++i) {
+            ::unlink((String(testFile) + "." + std::to_string(i)).c_str());
+        }
+    };
+    cleanup();
+    
+    {
+        FileRotationConfig rotation;
+        rotation.background = true;
+        FileSink sink(testFile, 4096, kBackups, LogLevel::kVerbose, "", FileBufferConfig(), rotation);
+        for (int i = 0; i < 400; ++i) {
+            String msg = "Background rotation message #" + std::to_string(i);
+            sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "ROT", msg.c_str());
+        }
+        sink.waitRotation();
+        
+        // Staging file is ready for the next switch, nothing waits for a shift
+        EXPECT_EQ(::access((String(testFile) + ".next").c_str(), F_OK), 0);
+        EXPECT_NE(::access((String(testFile) + ".rotating").c_str(), F_OK), 0);
+    }
+    EXPECT_NE(::access((String(testFile) + ".next").c_str(), F_OK), 0);
+    
+    // Nothing lost, and the backups are in order: .N oldest ... .1, then the active file
+    std::vector<std::string> lines;
+    for (int i = kBackups; i >= 0; --i) {
+        std::ifstream in(i == 0 ? String(testFile) : String(testFile) + "." + std::to_string(i));
+        std::string line;
+        while (std::getline(in, line)) {
+            lines.push_back(line);
+        }
+    }
+    ASSERT_EQ(lines.size(), 400u);
+    for (int i = 0; i < 400; ++i) {
+        EXPECT_NE(lines[i].find("message #" + std::to_string(i)), std::string::npos) << lines[i];
+    }
+    
+    cleanup();
+}
+
+static Size allocatedBytes(const String& path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 ? static_cast<Size>(st.st_blocks) * 512 : 0;
+}
+
+TEST(MultiSink, FileSinkPreallocation) {
+    const char* testFile = "/tmp/lap_test_prealloc.log";
+    const Size kMaxSize = 256 * 1024;
+    auto cleanup = [&]() {
+        ::unlink(testFile);
+        ::unlink((String(testFile) + ".1").c_str());
+        ::unlink((String(testFile) + ".2").c_str());
+    };
+    
+    for (bool background : { true, false }) {
+        cleanup();
+        
+        FileSpaceConfig space;
+        space.preallocate = true;
+        space.dropCacheBytes = 64 * 1024;
+        FileRotationConfig rotation;
+        rotation.background = background;
+        {
+            FileSink sink(testFile, kMaxSize, 2, LogLevel::kVerbose, "", FileBufferConfig(), rotation,
+                          FileSyncConfig(), space);
+            
+            // Blocks reserved up front, the visible size is untouched
+            struct stat st;
+            ASSERT_EQ(::stat(testFile, &st), 0);
+            if (allocatedBytes(testFile) < kMaxSize) {
+                GTEST_SKIP() << "fallocate not supported on /tmp";
+            }
+            EXPECT_EQ(st.st_size, 0);
+            
+            String msg(200, 'p');
+            for (int i = 0; i < 2000; ++i) {
+                sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "PRE", msg.c_str());
+            }
+            sink.waitRotation();
+            
+            // Rotated out: the unused tail went back; the new file is reserved again
+            EXPECT_LE(allocatedBytes(String(testFile) + ".1"), kMaxSize + 64 * 1024);
+            EXPECT_GE(allocatedBytes(testFile), kMaxSize);
+        }
+        
+        // Closed: only the written part stays allocated
+        struct stat st;
+        ASSERT_EQ(::stat(testFile, &st), 0);
+        EXPECT_LT(allocatedBytes(testFile), static_cast<Size>(st.st_size) + 64 * 1024);
+        
+        // Nothing lost across rotations and cache drops (three files hold all records)
+        int total = countLines(testFile) + countLines((String(testFile) + ".1").c_str()) +
+                    countLines((String(testFile) + ".2").c_str());
+        EXPECT_EQ(total, 2000);
+        EXPECT_GT(countLines((String(testFile) + ".1").c_str()), 0);
+    }
+    
+    cleanup();
+}
+
+TEST(MultiSink, FileSinkTimeRotation) {
+    const char* testFile = "/tmp/lap_test_time_rotate.log";
+    
+    for (bool background : { true, false }) {
+        ::unlink(testFile);
+        ::unlink((String(testFile) + ".1").c_str());
+        
+        // Written two hours ago: the hourly boundary has passed since
+        {
+            std::ofstream old(testFile);
+            old << "from the previous period" << std::endl;
+        }
+        struct utimbuf times;
+        times.actime = times.modtime = ::time(nullptr) - 2 * 3600;
+        ASSERT_EQ(::utime(testFile, &times), 0);
+        
+        FileRotationConfig rotation;
+        rotation.interval = RotationInterval::kHourly;
+        rotation.background = background;
+        {
+            // maxSize 0: time-based only
+            FileSink sink(testFile, 0, 3, LogLevel::kVerbose, "", FileBufferConfig(), rotation);
+            sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "ROT", "first of this period");
+            sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "ROT", "second of this period");
+            sink.waitRotation();
+        }
+        
+        // Checked before each record: both land in the new file
+        EXPECT_EQ(countLines((String(testFile) + ".1").c_str()), 1) << "background=" << background;
+        EXPECT_EQ(countLines(testFile), 2) << "background=" << background;
+        std::ifstream in((String(testFile) + ".1").c_str());
+        std::string line;
+        std::getline(in, line);
+        EXPECT_EQ(line, "from the previous period");
+    }
+    
+    ::unlink(testFile);
+    ::unlink((String(testFile) + ".1").c_str());
+}
+
+#if LAP_LOG_HAS_ZLIB
+TEST(MultiSink, FileSinkCompressedRotation) {
+    const char* testFile = "/tmp/lap_test_gz_rotate.log";
+    const int kBackups = 5;
+    auto cleanup = [&]() {
+        ::unlink(testFile);
+        for (int i = 1; i <= kBackups + 1; ++i) {
+            ::unlink((String(testFile) + "." + std::to_string(i)).c_str());
+            ::unlink((String(testFile) + "." + std::to_string(i) + ".gz").c_str());
+        }
+    };
+    cleanup();
+    
+    FileRotationConfig rotation;
+    rotation.compression = CompressionType::kGzip;
+    rotation.compressBytesPerSec = 0;
+    {
+        FileSink sink(testFile, 4096, kBackups, LogLevel::kVerbose, "", FileBufferConfig(), rotation);
+        for (int i = 0; i < 400; ++i) {
+            String msg = "Compressed rotation message #" + std::to_string(i);
+            sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "ROT", msg.c_str());
+        }
+        sink.waitRotation();
+        sink.waitCompression();
+    }
+    
+    // Every backup compressed, retention counts .N.gz like .N
+    EXPECT_NE(::access((String(testFile) + ".compressing").c_str(), F_OK), 0);
+    EXPECT_NE(::access((String(testFile) + "." + std::to_string(kBackups + 1) + ".gz").c_str(), F_OK), 0);
+    std::vector<std::string> lines;
+    for (int i = kBackups; i >= 1; --i) {
+        const String path = String(testFile) + "." + std::to_string(i);
+        EXPECT_NE(::access(path.c_str(), F_OK), 0) << path;
+        gzFile gz = ::gzopen((path + ".gz").c_str(), "rb");
+        ASSERT_NE(gz, nullptr) << path;
+        char buffer[256];
+        while (::gzgets(gz, buffer, sizeof(buffer)) != nullptr) {
+            lines.emplace_back(buffer);
+        }
+        ::gzclose(gz);
+    }
+    std::ifstream in(testFile);
+    std::string line;
+    while (std::getline(in, line)) {
+        lines.push_back(line);
+    }
+    
+    // Newest records, contiguous up to the last one
+    ASSERT_FALSE(lines.empty());
+    const int first = 400 - static_cast<int>(lines.size());
+    for (size_t i = 0; i < lines.size(); ++i) {
+        EXPECT_NE(lines[i].find("message #" + std::to_string(first + static_cast<int>(i))), std::string::npos) << lines[i];
+    }
+    
+    cleanup();
+}
+#endif
+
+#if LAP_LOG_HAS_ZSTD
+TEST(MultiSink, FileSinkZstdRotation) {
+    const char* testFile = "/tmp/lap_test_zst_rotate.log";
+    ::unlink(testFile);
+    ::unlink((String(testFile) + ".1.zst").c_str());
+    
+    FileRotationConfig rotation;
+    rotation.compression = CompressionType::kZstd;
+    {
+        FileSink sink(testFile, 0, 1, LogLevel::kVerbose, "", FileBufferConfig(), rotation);
+        for (int i = 0; i < 100; ++i) {
+            sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "ROT", "zstd compressed record");
+        }
+        ASSERT_TRUE(sink.rotate());
+        sink.waitCompression();
+    }
+    
+    std::ifstream in((String(testFile) + ".1.zst").c_str(), std::ios::binary);
+    unsigned char magic[4] = {};
+    in.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    EXPECT_EQ(magic[0], 0x28);
+    EXPECT_EQ(magic[1], 0xB5);
+    EXPECT_EQ(magic[2], 0x2F);
+    EXPECT_EQ(magic[3], 0xFD);
+    EXPECT_NE(::access((String(testFile) + ".1").c_str(), F_OK), 0);
+    
+    ::unlink(testFile);
+    ::unlink((String(testFile) + ".1.zst").c_str());
+}
+#endif
+
+TEST(MultiSink, FileSinkBufferedMultiProcess) {
+    const char* testFile = "/tmp/lap_test_buffered_mp.log";
+    ::unlink(testFile);
+    
+    const int kProcesses = 4;
+    const int kRecords = 2000;
+    
+    for (int mode = 0; mode < 2; ++mode) {
+        ::unlink(testFile);
+        
+        std::vector<pid_t> children;
+        for (int p = 0; p < kProcesses; ++p) {
+            pid_t pid = ::fork();
+            ASSERT_GE(pid, 0);
+            if (pid == 0) {
+                FileBufferConfig bufferConfig;
+                bufferConfig.bufferSize = 16 * 1024;
+                bufferConfig.multiProcess = (mode == 1);
+                FileSink sink(testFile, 0, 1, LogLevel::kVerbose, "", bufferConfig);
+                // Records of varying length so chunk boundaries move around
+                for (int i = 0; i < kRecords; ++i) {
+                    String msg = "P" + std::to_string(p) + " #" + std::to_string(i) + " " + String(static_cast<size_t>(i % 300), 'a' + p);
+                    sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "MP", msg.c_str());
+                }
+                sink.flush();
+                ::_exit(0);
+            }
+            children.push_back(pid);
+        }
+        for (pid_t pid : children) {
+            int status = 0;
+            ::waitpid(pid, &status, 0);
+        }
+        
+        // Every line must be exactly one complete record
+        std::ifstream in(testFile);
+        std::string line;
+        std::set<std::string> seen;
+        int count = 0;
+        while (std::getline(in, line)) {
+            ++count;
+            auto pos = line.find("[MP] P");
+            ASSERT_NE(pos, std::string::npos) << line;
+            std::string body = line.substr(pos + 5);
+            int p = body[1] - '0';
+            int i = std::stoi(body.substr(body.find('#') + 1));
+            String expected = "P" + std::to_string(p) + " #" + std::to_string(i) + " " + String(static_cast<size_t>(i % 300), 'a' + p);
+            EXPECT_EQ(body, expected);
+            seen.insert(body.substr(0, body.find(' ', 3)));
+        }
+        EXPECT_EQ(count, kProcesses * kRecords) << "mode " << mode;
+        EXPECT_EQ(seen.size(), static_cast<size_t>(kProcesses * kRecords));
+    }
+
+    ::unlink(testFile);
+}
+
+namespace {
+    // Several processes log into one rotating file; returns the lines found across the file and its backups
+    std::vector<std::string> writeSharedRotatingFile(const std::string& testFile, int processes, int records,
+                                                     const FileBufferConfig& bufferConfig,
+                                                     const FileRotationConfig& rotationConfig) {
+        const UInt32 kBackups = 64;
+        auto removeAll = [&]() {
+            ::unlink(testFile.c_str());
+            for (UInt32 i = 1; i <= kBackups + 1; ++i) {
+                ::unlink((testFile + "." + std::to_string(i)).c_str());
+            }
+        };
+        removeAll();
+
+        std::vector<pid_t> children;
+        for (int p = 0; p < processes; ++p) {
+            pid_t pid = ::fork();
+            if (pid == 0) {
+                FileSink sink(testFile, 32 * 1024, kBackups, LogLevel::kVerbose, "", bufferConfig, rotationConfig);
+                for (int i = 0; i < records; ++i) {
+                    String msg = "P" + std::to_string(p) + " #" + std::to_string(i);
+                    sink.write(0, 0, static_cast<lap::log::LogLevelType>(0x04), "MP", msg.c_str());
+                }
+                sink.flush();
+                ::_exit(0);
+            }
+            children.push_back(pid);
+        }
+        for (pid_t pid : children) {
+            int status = 0;
+            ::waitpid(pid, &status, 0);
+        }
+
+        std::vector<std::string> lines;
+        for (UInt32 i = 0; i <= kBackups; ++i) {
+            std::ifstream in(i == 0 ? testFile : testFile + "." + std::to_string(i));
+            std::string line;
+            while (std::getline(in, line)) {
+                lines.push_back(line);
+            }
+        }
+        removeAll();
+        return lines;
+    }
+
+    // Each "[MP] P<p> #<i>" record exactly once
+    void expectEachRecordOnce(const std::vector<std::string>& lines, int total) {
+        std::set<std::string> seen;
+        for (const auto& line : lines) {
+            auto pos = line.find("[MP] P");
+            ASSERT_NE(pos, std::string::npos) << line;
+            seen.insert(line.substr(pos + 5));
+        }
+        EXPECT_EQ(lines.size(), static_cast<size_t>(total));
+        EXPECT_EQ(seen.size(), static_cast<size_t>(total));
+    }
+}
+
+TEST(MultiSink, FileSinkMultiProcessRotation) {
+    const std::string testFile = "/tmp/lap_test_rotate_mp.log";
+    const int kProcesses = 4;
+    const int kRecords = 3000;
+
+    // Background rotation is requested but must not be used: every process rotates under flock()
+    FileBufferConfig bufferConfig;
+    bufferConfig.bufferSize = 4 * 1024;
+    bufferConfig.multiProcess = true;
+    FileRotationConfig rotationConfig;
+    rotationConfig.background = true;
+    const auto lines = writeSharedRotatingFile(testFile, kProcesses, kRecords, bufferConfig, rotationConfig);
+    expectEachRecordOnce(lines, kProcesses * kRecords);
+    EXPECT_NE(::access((testFile + ".next").c_str(), F_OK), 0);
+}
+
+TEST(MultiSink, FileSinkSharedUnbufferedRotation) {
+    const std::string testFile = "/tmp/lap_test_rotate_shared.log";
+    const int kProcesses = 4;
+    const int kRecords = 3000;
+
+    // Default configuration (unbuffered, inline rotation): processes that find the file full
+    // at the same time rotate it once, the others follow to the new file
+    const auto lines = writeSharedRotatingFile(testFile, kProcesses, kRecords, FileBufferConfig(), FileRotationConfig());
+    expectEachRecordOnce(lines, kProcesses * kRecords);
+    EXPECT_NE(::access((testFile + ".next").c_str(), F_OK), 0);
+}
+
+TEST(MultiSink, FileSinkThreadId) {
+    const char* testFile = "/tmp/lap_test_tid.log";
+    ::unlink(testFile);
+    
+    {
+        FileSink sink(testFile, 0, 1, LogLevel::kVerbose, "TID");
+        sink.write(0, 4242, static_cast<lap::log::LogLevelType>(0x04), "CTX", "without");
+        sink.setWithThreadId(true);
+        sink.write(0, 4242, static_cast<lap::log::LogLevelType>(0x04), "CTX", "with");
+    }
+    
+    std::ifstream in(testFile);
+    std::string first;
+    std::string second;
+    std::getline(in, first);
+    std::getline(in, second);
+    EXPECT_EQ(first.find("tid:"), std::string::npos);
+    EXPECT_NE(first.find("[CTX] without"), std::string::npos);
+    EXPECT_NE(second.find("[CTX] [tid:4242] with"), std::string::npos) << second;
+    
+    ::unlink(testFile);
+}
+
 TEST(MultiSink, SinkManagerMultipleDestinations) {
     const char* testFile = "/tmp/lap_manager_test.log";
     ::unlink(testFile);
@@ -134,7 +1067,7 @@ TEST(MultiSink, SinkManagerMultipleDestinations) {
     
     // Get common parameters
     auto now = ::std::chrono::system_clock::now();
-    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::microseconds>(
+    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
         now.time_since_epoch()).count();
     UInt32 threadId = static_cast<UInt32>(::std::hash<::std::thread::id>{}(::std::this_thread::get_id()));
     
@@ -181,6 +1114,23 @@ TEST(MultiSink, SinkManagerLevelFiltering) {
     EXPECT_FALSE(manager.shouldLog(LogLevel::kVerbose));
 }
 
+TEST(MultiSink, SinkManagerFollowsSinkReconfiguration) {
+    SinkManager manager;
+    manager.addSink(std::make_unique<ConsoleSink>(false, LogLevel::kWarn));
+    EXPECT_EQ(manager.getMaxLevel(), LogLevel::kWarn);
+
+    // Reconfiguring the registered sink directly reaches the precomputed level
+    auto* console = static_cast<ConsoleSink*>(manager.getSink("Console"));
+    ASSERT_NE(console, nullptr);
+    console->setLevel(LogLevel::kDebug);
+    EXPECT_EQ(manager.getMaxLevel(), LogLevel::kDebug);
+
+    console->setEnabled(false);
+    EXPECT_EQ(manager.getMaxLevel(), LogLevel::kOff);
+    console->setEnabled(true);
+    EXPECT_EQ(manager.getMaxLevel(), LogLevel::kDebug);
+}
+
 TEST(MultiSink, SinkManagerRemoval) {
     SinkManager manager;
     
@@ -204,6 +1154,145 @@ TEST(MultiSink, SinkManagerRemoval) {
     EXPECT_FALSE(manager.removeSink("NonExistent"));
 }
 
+namespace {
+    // Sink that flags use after destruction and counts calls without locking
+    class LifetimeSink : public ISink {
+    public:
+        LifetimeSink(const char* name, std::atomic<int>& alive) : m_name(name), m_alive(alive) { ++m_alive; }
+        ~LifetimeSink() noexcept override { m_magic = 0; --m_alive; }
+
+        void write(UInt64, UInt32, LogLevelType, StringView, StringView) noexcept override {
+            EXPECT_EQ(m_magic, 0x5A5A5A5Au);
+            m_writes.fetch_add(1, std::memory_order_relaxed);
+        }
+        Bool writeEmergency(UInt64, UInt32, LogLevelType, StringView, StringView) noexcept override {
+            EXPECT_EQ(m_magic, 0x5A5A5A5Au);
+            return true;
+        }
+        void flushEmergency() noexcept override {
+            EXPECT_EQ(m_magic, 0x5A5A5A5Au);
+        }
+        void flush() noexcept override {}
+        Bool isEnabled() const noexcept override { return true; }
+        StringView getName() const noexcept override { return m_name; }
+        void setLevel(LogLevel) noexcept override {}
+        Bool shouldLog(LogLevel) const noexcept override { return true; }
+        Bool isThreadSafe() const noexcept override { return true; }
+
+    private:
+        const char*             m_name;
+        std::atomic<int>&       m_alive;
+        volatile UInt32         m_magic{ 0x5A5A5A5Au };
+        std::atomic<UInt64>     m_writes{ 0 };
+    };
+}
+
+TEST(MultiSink, SinkManagerConcurrentUpdate) {
+    SinkManager manager;
+    std::atomic<int> alive{ 0 };
+    std::atomic<bool> stop{ false };
+
+    manager.addSink(std::make_unique<LifetimeSink>("Stable", alive));
+
+    // Writers take no lock while sinks come and go
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&manager, &stop]() {
+            alignas(64) char storage[sizeof(LogEntry) + 16];
+            LogEntry* entry = new (storage) LogEntry();
+            entry->level = 0x04;
+            entry->contextIdLen = 4;
+            entry->messageLen = 4;
+            std::memcpy(storage + sizeof(LogEntry), "RCU_ping", 8);
+
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (manager.shouldLog(LogLevel::kInfo)) {
+                    manager.write(*entry);
+                }
+                manager.flushAll();
+            }
+        });
+    }
+    // logFatal() path outside a crash: the emergency reader pins the snapshot too
+    writers.emplace_back([&manager, &stop]() {
+        while (!stop.load(std::memory_order_relaxed)) {
+            manager.writeEmergency(1, 1, 0x01, "EMRG", "fatal", RecordFormat::kText, false);
+            manager.flushEmergency(false);
+        }
+    });
+
+    for (int i = 0; i < 200; ++i) {
+        manager.addSink(std::make_unique<LifetimeSink>("Churn", alive));
+        EXPECT_EQ(manager.getSinkCount(), 2u);
+        EXPECT_TRUE(manager.removeSink("Churn"));
+        // Removed sink is reclaimed once no writer can reference it
+        EXPECT_EQ(alive.load(), 1);
+    }
+
+    stop = true;
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    manager.clearAll();
+    EXPECT_EQ(alive.load(), 0);
+    EXPECT_EQ(manager.getSinkCount(), 0u);
+}
+
+namespace {
+    // Removes another sink from inside its own write(), i.e. within a read-side section
+    class RemovingSink : public ISink {
+    public:
+        RemovingSink(SinkManager& manager, std::atomic<int>& alive) : m_manager(manager), m_alive(alive) {}
+
+        void write(UInt64, UInt32, LogLevelType, StringView, StringView) noexcept override {
+            m_removed = m_manager.removeSink("Victim");
+            // The list being dispatched stays valid, the victim is still alive
+            EXPECT_EQ(m_alive.load(), 1);
+        }
+        void flush() noexcept override {}
+        Bool isEnabled() const noexcept override { return true; }
+        StringView getName() const noexcept override { return "Remover"; }
+        void setLevel(LogLevel) noexcept override {}
+        Bool shouldLog(LogLevel) const noexcept override { return true; }
+        Bool isThreadSafe() const noexcept override { return true; }
+
+        Bool                    m_removed{ false };
+
+    private:
+        SinkManager&            m_manager;
+        std::atomic<int>&       m_alive;
+    };
+}
+
+TEST(MultiSink, SinkManagerRemoveFromWrite) {
+    SinkManager manager;
+    std::atomic<int> alive{ 0 };
+
+    auto remover = std::make_unique<RemovingSink>(manager, alive);
+    RemovingSink* removerPtr = remover.get();
+    manager.addSink(std::move(remover));
+    manager.addSink(std::make_unique<LifetimeSink>("Victim", alive));
+
+    alignas(64) char storage[sizeof(LogEntry) + 16];
+    LogEntry* entry = new (storage) LogEntry();
+    entry->level = 0x04;
+    entry->contextIdLen = 4;
+    entry->messageLen = 4;
+    std::memcpy(storage + sizeof(LogEntry), "TESTping", 8);
+
+    // Must not wait for its own read-side section; the old list is retired instead
+    manager.write(*entry);
+    EXPECT_TRUE(removerPtr->m_removed);
+    EXPECT_EQ(manager.getSinkCount(), 1u);
+
+    // Reclaimed by the next update made outside a read-side section
+    manager.addSink(std::make_unique<LifetimeSink>("Other", alive));
+    EXPECT_EQ(alive.load(), 1);
+    manager.clearAll();
+    EXPECT_EQ(alive.load(), 0);
+}
+
 TEST(MultiSink, PerformanceBenchmark) {
     const char* testFile = "/tmp/lap_perf_test.log";
     ::unlink(testFile);
@@ -215,7 +1304,7 @@ TEST(MultiSink, PerformanceBenchmark) {
     
     // Get common parameters
     auto now = ::std::chrono::system_clock::now();
-    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::microseconds>(
+    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
         now.time_since_epoch()).count();
     UInt32 threadId = static_cast<UInt32>(::std::hash<::std::thread::id>{}(::std::this_thread::get_id()));
     
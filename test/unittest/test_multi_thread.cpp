@@ -5,6 +5,14 @@
 #include <chrono>
 #include "CLogManager.hpp"
 #include "CLogger.hpp"
+#include "CThreadId.hpp"
+#include <mutex>
+#include <set>
+#include <map>
+#include <string>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <lap/core/CConfig.hpp>
 
 using namespace lap::log;
@@ -184,3 +192,96 @@ TEST_F(MultiThreadTest, MultipleLoggers) {
     
     SUCCEED() << "Multiple loggers test completed";
 }
+
+namespace {
+    // Collects (threadId, message) of records from context "TIDS"
+    class ThreadIdSink : public ISink {
+    public:
+        void write(UInt64, UInt32 threadId, LogLevelType, StringView contextId, StringView message) noexcept override {
+            if (contextId == "TIDS") {
+                std::lock_guard<std::mutex> lock(mutex);
+                records.emplace_back(threadId, std::string(message.data(), message.size()));
+            }
+        }
+        void flush() noexcept override {}
+        Bool isEnabled() const noexcept override { return true; }
+        StringView getName() const noexcept override { return "ThreadIds"; }
+        void setLevel(LogLevel) noexcept override {}
+        Bool shouldLog(LogLevel) const noexcept override { return true; }
+
+        std::mutex mutex;
+        std::vector<std::pair<UInt32, std::string>> records;
+    };
+}
+
+// 测试：线程ID缓存与内核TID一致
+TEST_F(MultiThreadTest, ThreadIdIsKernelTid) {
+    EXPECT_EQ(ThreadId::current(), static_cast<UInt32>(::syscall(SYS_gettid)));
+    EXPECT_EQ(ThreadId::current(), ThreadId::current());
+    
+    std::vector<UInt32> ids(4, 0);
+    std::vector<UInt32> kernelIds(4, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            ids[t] = ThreadId::current();
+            kernelIds[t] = static_cast<UInt32>(::syscall(SYS_gettid));
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    
+    std::set<UInt32> unique(ids.begin(), ids.end());
+    EXPECT_EQ(unique.size(), 4u);
+    EXPECT_EQ(ids, kernelIds);
+    
+    // A forked child reports its own TID, not the parent's cached one
+    UInt32 parentTid = ThreadId::current();
+    pid_t pid = ::fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        bool ok = ThreadId::current() == static_cast<UInt32>(::syscall(SYS_gettid)) && ThreadId::current() != parentTid;
+        ::_exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+// 测试：每条记录携带生产线程的TID
+TEST_F(MultiThreadTest, RecordsCarryThreadId) {
+    auto sink = std::make_unique<ThreadIdSink>();
+    ThreadIdSink* capture = sink.get();
+    LogManager::getInstance().getSinkManager().addSink(std::move(sink));
+    auto& logger = LogManager::getInstance().registerLogger("TIDS", "Thread ID test", LogLevel::kVerbose);
+    
+    const int numThreads = 4;
+    std::vector<UInt32> tids(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            tids[t] = static_cast<UInt32>(::syscall(SYS_gettid));
+            for (int i = 0; i < 50; ++i) {
+                logger.LogError() << "thread " << static_cast<Int32>(t);
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    
+    std::map<std::string, std::set<UInt32>> idsByThread;
+    for (const auto& record : capture->records) {
+        idsByThread[record.second].insert(record.first);
+    }
+    // Removing the sink destroys it: collect the records first
+    LogManager::getInstance().getSinkManager().removeSink("ThreadIds");
+    ASSERT_EQ(idsByThread.size(), static_cast<size_t>(numThreads));
+    for (int t = 0; t < numThreads; ++t) {
+        const auto& ids = idsByThread["thread " + std::to_string(t)];
+        ASSERT_EQ(ids.size(), 1u);
+        EXPECT_EQ(*ids.begin(), tids[t]);
+    }
+}
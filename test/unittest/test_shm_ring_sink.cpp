@@ -0,0 +1,175 @@
+/**
+ * @file        test_shm_ring_sink.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Shared memory ring (flight recorder) sink unit tests
+ * @date        2026-10-16
+ */
+
+#include <gtest/gtest.h>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "CShmRingSink.hpp"
+
+using namespace lap::log;
+using namespace lap::core;
+
+namespace {
+    struct RingRecord {
+        UInt64 timestamp;
+        UInt32 threadId;
+        UInt8 level;
+        UInt8 kind;
+        std::string context;
+        std::string payload;
+    };
+
+    std::vector<UInt8> readFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<UInt8>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    // Minimal reader of doc/design/ShmRing_Format.md, same resync rule as tools/recover_shm_ring.py
+    std::vector<RingRecord> recover(const std::vector<UInt8>& file) {
+        std::vector<RingRecord> records;
+        if (file.size() < ShmRingSink::kHeaderSize || std::memcmp(file.data(), "LAPR", 4) != 0) {
+            return records;
+        }
+        UInt64 capacity, head;
+        std::memcpy(&capacity, file.data() + 8, 8);
+        std::memcpy(&head, file.data() + ShmRingSink::kHeadOffset, 8);
+        const UInt8* data = file.data() + ShmRingSink::kHeaderSize;
+        auto read = [&](UInt64 pos, size_t len) {
+            std::string out(len, '\0');
+            for (size_t i = 0; i < len; ++i) out[i] = static_cast<char>(data[(pos + i) & (capacity - 1)]);
+            return out;
+        };
+
+        UInt64 pos = head > capacity ? head - capacity : 0;
+        while (pos + ShmRingSink::kRecordHeaderSize <= head) {
+            const std::string h = read(pos, ShmRingSink::kRecordHeaderSize);
+            UInt32 size, commit;
+            std::memcpy(&size, h.data(), 4);
+            std::memcpy(&commit, h.data() + 4, 4);
+            if (commit != ShmRingSink::commitTag(pos) || size < ShmRingSink::kRecordHeaderSize || pos + size > head) {
+                pos += ShmRingSink::kRecordAlign;
+                continue;
+            }
+            RingRecord r;
+            std::memcpy(&r.timestamp, h.data() + 8, 8);
+            std::memcpy(&r.threadId, h.data() + 16, 4);
+            r.level = static_cast<UInt8>(h[24]);
+            r.kind = static_cast<UInt8>(h[25]);
+            const size_t contextLen = static_cast<UInt8>(h[26]);
+            const std::string body = read(pos + ShmRingSink::kRecordHeaderSize, size - ShmRingSink::kRecordHeaderSize);
+            r.context = body.substr(0, contextLen);
+            r.payload = body.substr(contextLen);
+            records.push_back(r);
+            pos += (size + ShmRingSink::kRecordAlign - 1) & ~(ShmRingSink::kRecordAlign - 1);
+        }
+        return records;
+    }
+}
+
+class ShmRingSinkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = "/dev/shm/lap_ring_test_" + std::to_string(::getpid()) + ".ring";
+        std::remove(path_.c_str());
+    }
+
+    void TearDown() override {
+        std::remove(path_.c_str());
+    }
+
+    std::string path_;
+};
+
+TEST_F(ShmRingSinkTest, ConcurrentProducersAllRecovered) {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 500;
+    {
+        ShmRingSink sink(path_, 1024 * 1024, LogLevel::kVerbose, "RING");
+        ASSERT_TRUE(sink.isEnabled());
+        EXPECT_TRUE(sink.isThreadSafe());
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&sink, t] {
+                for (int i = 0; i < kPerThread; ++i) {
+                    const std::string msg = "t" + std::to_string(t) + " #" + std::to_string(i);
+                    sink.write(1000 + i, static_cast<UInt32>(t), static_cast<LogLevelType>(LogLevel::kVerbose), "CTX", msg);
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+
+        // Readable while the process is alive
+        const auto records = recover(readFile(path_));
+        ASSERT_EQ(records.size(), static_cast<size_t>(kThreads * kPerThread));
+        std::set<std::string> unique;
+        for (const auto& r : records) {
+            EXPECT_EQ(r.context, "CTX");
+            EXPECT_EQ(r.kind, static_cast<UInt8>(ShmRingSink::RecordKind::kText));
+            unique.insert(r.payload);
+        }
+        EXPECT_EQ(unique.size(), static_cast<size_t>(kThreads * kPerThread));
+    }
+
+    // Clean shutdown removes the ring
+    EXPECT_NE(::access(path_.c_str(), F_OK), 0);
+}
+
+TEST_F(ShmRingSinkTest, WrapKeepsMostRecentRecords) {
+    ShmRingSink sink(path_, 4096, LogLevel::kVerbose, "RING", true);
+    ASSERT_EQ(sink.getCapacity(), 4096u);
+
+    constexpr int kRecords = 1000;
+    for (int i = 0; i < kRecords; ++i) {
+        sink.write(static_cast<UInt64>(i), 1, static_cast<LogLevelType>(LogLevel::kInfo), "WRAP", "record " + std::to_string(i));
+    }
+    EXPECT_GT(sink.getHead(), sink.getCapacity());
+
+    const auto records = recover(readFile(path_));
+    ASSERT_GT(records.size(), 10u);
+    ASSERT_LT(records.size(), static_cast<size_t>(kRecords));
+
+    // Contiguous tail of the stream, ending with the last record
+    for (size_t i = 0; i < records.size(); ++i) {
+        const UInt64 expected = kRecords - records.size() + i;
+        EXPECT_EQ(records[i].timestamp, expected);
+        EXPECT_EQ(records[i].payload, "record " + std::to_string(expected));
+    }
+}
+
+TEST_F(ShmRingSinkTest, RecordsSurviveKilledProcess) {
+    const pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        // No destructor, no flush: the process dies with the records in the ring
+        auto* sink = new ShmRingSink(path_, 64 * 1024, LogLevel::kVerbose, "RING");
+        for (int i = 0; i < 100; ++i) {
+            sink->write(static_cast<UInt64>(i), 7, static_cast<LogLevelType>(LogLevel::kDebug), "DEAD", "before crash " + std::to_string(i));
+        }
+        ::raise(SIGKILL);
+        ::_exit(0);
+    }
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFSIGNALED(status));
+
+    const auto records = recover(readFile(path_));
+    ASSERT_EQ(records.size(), 100u);
+    EXPECT_EQ(records.back().payload, "before crash 99");
+    EXPECT_EQ(records.back().threadId, 7u);
+    EXPECT_EQ(records.back().level, static_cast<UInt8>(LogLevel::kDebug));
+}
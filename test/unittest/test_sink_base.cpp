@@ -44,7 +44,7 @@ TEST(SinkBase, PolymorphicBehavior) {
     
     // Write through polymorphic interface with direct parameters
     auto now = ::std::chrono::system_clock::now();
-    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::microseconds>(
+    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
         now.time_since_epoch()).count();
     UInt32 threadId = static_cast<UInt32>(::std::hash<::std::thread::id>{}(::std::this_thread::get_id()));
     
@@ -103,7 +103,7 @@ TEST(SinkBase, EnableDisableState) {
     
     // Get common parameters
     auto now = ::std::chrono::system_clock::now();
-    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::microseconds>(
+    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
         now.time_since_epoch()).count();
     UInt32 threadId = static_cast<UInt32>(::std::hash<::std::thread::id>{}(::std::this_thread::get_id()));
     
@@ -127,7 +127,7 @@ TEST(SinkBase, LogEntryParsing) {
     
     // Get common parameters
     auto now = ::std::chrono::system_clock::now();
-    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::microseconds>(
+    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
         now.time_since_epoch()).count();
     UInt32 threadId = static_cast<UInt32>(::std::hash<::std::thread::id>{}(::std::this_thread::get_id()));
     
@@ -159,7 +159,7 @@ TEST(SinkBase, ConcurrentWrites) {
     for (int t = 0; t < NUM_THREADS; ++t) {
         threads.emplace_back([&sink, t]() {
             auto now = ::std::chrono::system_clock::now();
-            UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::microseconds>(
+            UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
                 now.time_since_epoch()).count();
             UInt32 threadId = static_cast<UInt32>(::std::hash<::std::thread::id>{}(::std::this_thread::get_id()));
             
@@ -37,7 +37,7 @@ TEST(SyslogSink, WriteBasicLog) {
     
     // Get common parameters
     auto now = ::std::chrono::system_clock::now();
-    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::microseconds>(
+    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
         now.time_since_epoch()).count();
     UInt32 threadId = static_cast<UInt32>(::std::hash<::std::thread::id>{}(::std::this_thread::get_id()));
     
@@ -71,7 +71,7 @@ TEST(SyslogSink, EnableDisable) {
     
     // Get common parameters
     auto now = ::std::chrono::system_clock::now();
-    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::microseconds>(
+    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
         now.time_since_epoch()).count();
     UInt32 threadId = static_cast<UInt32>(::std::hash<::std::thread::id>{}(::std::this_thread::get_id()));
     
@@ -102,7 +102,7 @@ TEST(SyslogSink, MultipleMessages) {
     
     // Get common parameters
     auto now = ::std::chrono::system_clock::now();
-    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::microseconds>(
+    UInt64 timestamp = ::std::chrono::duration_cast<::std::chrono::nanoseconds>(
         now.time_since_epoch()).count();
     UInt32 threadId = static_cast<UInt32>(::std::hash<::std::thread::id>{}(::std::this_thread::get_id()));
     
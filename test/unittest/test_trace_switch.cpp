@@ -0,0 +1,120 @@
+/**
+ * @file        test_trace_switch.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       TraceSwitch compile-time routing unit tests
+ * @date        2026-10-16
+ * @details     The zero-cost check of TraceRoute::kNone in an optimized build is
+ *              test/zerocost/trace_switch_zero_cost.cpp
+ */
+
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <lap/core/CConfig.hpp>
+#include "CLogManager.hpp"
+#include "CLogger.hpp"
+#include "CSinkManager.hpp"
+#include "CTraceSwitch.hpp"
+
+using namespace lap::log;
+using namespace lap::core;
+
+namespace routing {
+    struct LoggerMessage : MessageId<2000> {};
+    struct NoneMessage : MessageId<2001> {};
+    struct ArtiMessage : MessageId<2002> {};
+    struct BothMessage : MessageId<2003> {};
+
+    // Found by ADL, preferred over the lap::log::TraceArti default
+    std::vector<UInt32> artiCalls;
+
+    template <typename... Params>
+    void TraceArti(const ArtiMessage&, const Params&...) noexcept { artiCalls.push_back(ArtiMessage::id); }
+
+    template <typename... Params>
+    void TraceArti(const BothMessage&, const Params&...) noexcept { artiCalls.push_back(BothMessage::id); }
+}
+
+template <> struct lap::log::TraceSwitch<routing::NoneMessage> { static constexpr TraceRoute route = TraceRoute::kNone; };
+template <> struct lap::log::TraceSwitch<routing::ArtiMessage> { static constexpr TraceRoute route = TraceRoute::kArti; };
+template <> struct lap::log::TraceSwitch<routing::BothMessage> { static constexpr TraceRoute route = TraceRoute::kBoth; };
+
+static_assert(TraceSwitch<routing::LoggerMessage>::route == TraceRoute::kLogger, "default route is kLogger");
+static_assert(isRoutedToLogger<routing::LoggerMessage>() && !isRoutedToArti<routing::LoggerMessage>(), "kLogger");
+static_assert(!isRoutedToLogger<routing::NoneMessage>() && !isRoutedToArti<routing::NoneMessage>(), "kNone");
+static_assert(!isRoutedToLogger<routing::ArtiMessage>() && isRoutedToArti<routing::ArtiMessage>(), "kArti");
+static_assert(isRoutedToLogger<routing::BothMessage>() && isRoutedToArti<routing::BothMessage>(), "kBoth");
+
+namespace {
+    class CaptureSink : public ISink {
+    public:
+        void write(UInt64, UInt32, LogLevelType, StringView contextId, StringView message) noexcept override {
+            if (contextId == "TSWT") {
+                std::lock_guard<std::mutex> lock(mutex);
+                records.emplace_back(message.data(), message.size());
+            }
+        }
+        void flush() noexcept override {}
+        Bool isEnabled() const noexcept override { return true; }
+        StringView getName() const noexcept override { return "TraceSwitchCapture"; }
+        void setLevel(LogLevel) noexcept override {}
+        Bool shouldLog(LogLevel) const noexcept override { return true; }
+
+        std::mutex mutex;
+        std::vector<std::string> records;
+    };
+}
+
+class TraceSwitchTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        lap::core::ConfigManager::getInstance();
+        LogManager::getInstance().initialize();
+        auto& sinkMgr = LogManager::getInstance().getSinkManager();
+        savedGlobal_ = sinkMgr.getGlobalMinLevel();
+        sinkMgr.setGlobalMinLevel(LogLevel::kVerbose);
+        logger_ = &LogManager::getInstance().registerLogger("TSWT", "TraceSwitch routing", LogLevel::kInfo);
+        routing::artiCalls.clear();
+    }
+
+    void TearDown() override {
+        LogManager::getInstance().getSinkManager().setGlobalMinLevel(savedGlobal_);
+        LogManager::getInstance().uninitialize();
+    }
+
+    Logger* logger_;
+    LogLevel savedGlobal_;
+};
+
+TEST_F(TraceSwitchTest, MessagesFollowTheirRoute) {
+    auto sink = std::make_unique<CaptureSink>();
+    CaptureSink* capture = sink.get();
+    LogManager::getInstance().getSinkManager().addSink(std::move(sink));
+
+    logger_->Log(routing::LoggerMessage{}, "v", 1);
+    logger_->Log(routing::NoneMessage{}, "v", 2);
+    logger_->Log(routing::ArtiMessage{}, "v", 3);
+    logger_->Log(routing::BothMessage{}, "v", 4);
+
+    std::vector<std::string> records;
+    {
+        std::lock_guard<std::mutex> lock(capture->mutex);
+        records = capture->records;
+    }
+    LogManager::getInstance().getSinkManager().removeSink("TraceSwitchCapture");
+
+    const std::vector<std::string> expectedRecords = { "[MsgId:2000] v=1", "[MsgId:2003] v=4" };
+    const std::vector<UInt32> expectedArti = { 2002, 2003 };
+    EXPECT_EQ(records, expectedRecords);
+    EXPECT_EQ(routing::artiCalls, expectedArti);
+}
+
+TEST_F(TraceSwitchTest, ArtiRouteIgnoresLoggerLevel) {
+    // The logger level filters the log sinks only; ARTI has its own filtering
+    Logger& silent = LogManager::getInstance().registerLogger("TSOF", "TraceSwitch, logging off", LogLevel::kOff);
+    silent.Log(routing::BothMessage{}, "v", 1);
+
+    ASSERT_EQ(routing::artiCalls.size(), 1u);
+    EXPECT_EQ(routing::artiCalls[0], 2003u);
+}
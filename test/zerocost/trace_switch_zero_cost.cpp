@@ -0,0 +1,130 @@
+/**
+ * @file        trace_switch_zero_cost.cpp
+ * @author      ddkv587 ( ddkv587@gmail.com )
+ * @brief       Checks that modeled messages routed to TraceRoute::kNone cost nothing
+ * @date        2026-10-16
+ * @details     Built with -O2 and run by ctest. The program inspects its own ELF image:
+ *              - zc_disabled_loop(), which only logs a kNone message, must be an empty
+ *                function (symbol size of a bare return)
+ *              - the parameter names and string values of the kNone message must not
+ *                be in the binary
+ *              zc_enabled_loop() logs the same message routed to kLogger as the
+ *              positive control: its code and string value must be present (short
+ *              names may be inlined as immediates, so only the value is checked).
+ *              Returns 0 on success, 1 if a check failed.
+ */
+
+#include <elf.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <lap/core/CConfig.hpp>
+#include "CLogManager.hpp"
+#include "CLogger.hpp"
+#include "CTraceSwitch.hpp"
+
+using namespace lap::log;
+using namespace lap::core;
+
+namespace {
+    struct DisabledMessage : MessageId<9001> {};
+    struct EnabledMessage : MessageId<9002> {};
+
+    // Upper bound of an empty function: ret, plus endbr64 under -fcf-protection
+    constexpr std::size_t kEmptyFunctionSize = 16;
+
+    // Needles are stored reversed so that the checker itself does not put them in the binary
+    std::string unreverse(const char* reversed) {
+        std::string text(reversed);
+        std::reverse(text.begin(), text.end());
+        return text;
+    }
+
+    bool contains(const std::vector<char>& image, const std::string& needle) {
+        return std::search(image.begin(), image.end(), needle.begin(), needle.end()) != image.end();
+    }
+
+    // Size of a function symbol from .symtab, -1 if the binary is stripped or the symbol is missing
+    long symbolSize(const std::vector<char>& image, const char* name) {
+        if (image.size() < sizeof(Elf64_Ehdr) || std::memcmp(image.data(), ELFMAG, SELFMAG) != 0 ||
+            image[EI_CLASS] != ELFCLASS64) {
+            return -1;
+        }
+        const auto* ehdr = reinterpret_cast<const Elf64_Ehdr*>(image.data());
+        if (ehdr->e_shoff == 0 || ehdr->e_shoff + ehdr->e_shnum * sizeof(Elf64_Shdr) > image.size()) {
+            return -1;
+        }
+        const auto* shdr = reinterpret_cast<const Elf64_Shdr*>(image.data() + ehdr->e_shoff);
+        for (unsigned i = 0; i < ehdr->e_shnum; ++i) {
+            if (shdr[i].sh_type != SHT_SYMTAB || shdr[i].sh_link >= ehdr->e_shnum) {
+                continue;
+            }
+            const Elf64_Shdr& strtab = shdr[shdr[i].sh_link];
+            const auto* symbols = reinterpret_cast<const Elf64_Sym*>(image.data() + shdr[i].sh_offset);
+            const std::size_t count = shdr[i].sh_size / sizeof(Elf64_Sym);
+            for (std::size_t s = 0; s < count; ++s) {
+                if (ELF64_ST_TYPE(symbols[s].st_info) == STT_FUNC &&
+                    std::strcmp(image.data() + strtab.sh_offset + symbols[s].st_name, name) == 0) {
+                    return static_cast<long>(symbols[s].st_size);
+                }
+            }
+        }
+        return -1;
+    }
+}
+
+template <> struct lap::log::TraceSwitch<DisabledMessage> { static constexpr TraceRoute route = TraceRoute::kNone; };
+
+extern "C" __attribute__((noinline, used)) void zc_disabled_loop(const Logger& logger, int count) {
+    for (int i = 0; i < count; ++i) {
+        logger.Log(DisabledMessage{}, "zcDisabledParamName", i, "zcDisabledOther", "zcDisabledStringValue");
+    }
+}
+
+extern "C" __attribute__((noinline, used)) void zc_enabled_loop(const Logger& logger, int count) {
+    for (int i = 0; i < count; ++i) {
+        logger.Log(EnabledMessage{}, "zcEnabledParamName", i, "zcEnabledOther", "zcEnabledStringValue");
+    }
+}
+
+int main() {
+    lap::core::ConfigManager::getInstance();
+    LogManager::getInstance().initialize();
+    Logger& logger = LogManager::getInstance().registerLogger("ZERO", "TraceSwitch zero cost", LogLevel::kInfo);
+    zc_disabled_loop(logger, 4);
+    zc_enabled_loop(logger, 4);
+    LogManager::getInstance().uninitialize();
+
+    std::ifstream file("/proc/self/exe", std::ios::binary);
+    const std::vector<char> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (image.empty()) {
+        std::fprintf(stderr, "FAILED: cannot read /proc/self/exe\n");
+        return 1;
+    }
+
+    int failures = 0;
+    auto check = [&failures](bool ok, const char* what) {
+        std::printf("%s %s\n", ok ? "[  OK  ]" : "[FAILED]", what);
+        failures += ok ? 0 : 1;
+    };
+
+    check(!contains(image, unreverse("emaNmaraPdelbasiDcz")), "kNone parameter name not in binary");
+    check(!contains(image, unreverse("eulaVgnirtSdelbasiDcz")), "kNone string value not in binary");
+    check(contains(image, unreverse("eulaVgnirtSdelbanEcz")), "kLogger string value in binary (control)");
+
+    const long disabledSize = symbolSize(image, "zc_disabled_loop");
+    const long enabledSize = symbolSize(image, "zc_enabled_loop");
+    if (disabledSize < 0 || enabledSize < 0) {
+        std::printf("[ SKIP ] symbol sizes: no .symtab (stripped binary)\n");
+    } else {
+        std::printf("         zc_disabled_loop: %ld bytes, zc_enabled_loop: %ld bytes\n", disabledSize, enabledSize);
+        check(disabledSize <= static_cast<long>(kEmptyFunctionSize), "kNone loop compiles to an empty function");
+        check(enabledSize > static_cast<long>(kEmptyFunctionSize), "kLogger loop has code (control)");
+    }
+
+    return failures == 0 ? 0 : 1;
+}
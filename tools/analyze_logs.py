@@ -28,49 +28,69 @@ def load_catalog(catalog_file):
         print(f"Error loading catalog: {e}", file=sys.stderr)
         sys.exit(1)
 
+LEVEL_NAMES = {'FATAL', 'ERROR', 'WARN', 'INFO', 'DEBUG', 'VERB', 'VERBOSE', 'UNKNW'}
+
+MODELED_PATTERN = re.compile(r'^\s*((?:\[[^\]]*\]\s*)*?)\[MsgId:(\d+)\]\s*(.*)$')
+BRACKET_PATTERN = re.compile(r'\[([^\]]*)\]')
+PARAM_PATTERN = re.compile(r'(\w+)=("(?:[^"\\]|\\.)*"|[^,]*?)(?:,\s*|\s*$)')
+
+def parse_params(params_str):
+    """
+    Parse "key=value, key=value". Values containing ',' or '"' are written
+    quoted by the library ("a, \\"b\\"") and unquoted here.
+    """
+    params = {}
+    for match in PARAM_PATTERN.finditer(params_str):
+        key = match.group(1)
+        value = match.group(2).strip()
+        if len(value) >= 2 and value[0] == '"' and value[-1] == '"':
+            value = re.sub(r'\\(.)', r'\1', value[1:-1])
+        params[key] = value
+    return params
+
 def parse_modeled_message(line):
     """
     Parse a modeled message log line.
     
-    Format: [LEVEL] [CONTEXT] [MsgId:NNNN] param1=value1, param2=value2
+    FileSink format:    [timestamp] [APPID] [LEVEL] [CONTEXT] [tid:N] [MsgId:NNNN] param1=value1, param2=value2
+    ([APPID] and [tid:N] are optional)
     
     Returns: {
         'timestamp': '...',
         'level': 'INFO',
         'context': 'APP',
+        'tid': '1234' or None,
         'msg_id': '1000',
         'params': {'param1': 'value1', 'param2': 'value2'}
     }
     """
-    # Pattern: [timestamp] [LEVEL] [CONTEXT] [MsgId:NNNN] params...
-    pattern = r'\[([^\]]+)\]\s*\[([^\]]+)\]\s*\[([^\]]+)\]\s*\[MsgId:(\d+)\]\s*(.+)'
-    match = re.search(pattern, line)
-    
+    match = MODELED_PATTERN.match(line)
     if not match:
         return None
     
-    timestamp = match.group(1)
-    level = match.group(2)
-    context = match.group(3)
-    msg_id = match.group(4)
-    params_str = match.group(5)
+    fields = [f.strip() for f in BRACKET_PATTERN.findall(match.group(1))]
+    if len(fields) < 3:
+        return None
     
-    # Parse parameters (key=value format)
-    params = {}
-    if params_str:
-        # Split by comma, but respect quoted strings
-        param_pattern = r'(\w+)=([^,]+?)(?:,\s*|$)'
-        for match in re.finditer(param_pattern, params_str):
-            key = match.group(1)
-            value = match.group(2).strip().strip('"')
-            params[key] = value
+    timestamp = fields[0]
+    level = ''
+    context = ''
+    tid = None
+    for field in fields[1:]:
+        if field.startswith('tid:'):
+            tid = field[4:]
+        elif field in LEVEL_NAMES:
+            level = field
+        else:
+            context = field     # The last plain field is the context ID (an app ID precedes it)
     
     return {
         'timestamp': timestamp,
         'level': level,
         'context': context,
-        'msg_id': msg_id,
-        'params': params,
+        'tid': tid,
+        'msg_id': match.group(2),
+        'params': parse_params(match.group(3)),
         'raw': line.strip()
     }
 
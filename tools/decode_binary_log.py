@@ -0,0 +1,403 @@
+#!/usr/bin/env python3
+"""
+Binary Log Decoder for LightAP BinaryFileSink
+
+Converts files written by the "binary" sink back to the FileSink text format:
+
+    [YYYY-MM-DD HH:MM:SS.mmm] [APPID] [LEVEL] [CONTEXT] [tid:N] message
+
+Deferred LogStream records and modeled messages are rendered from their
+argument encoding exactly as the library renders them for text sinks, so the
+output can be fed to analyze_logs.py unchanged.
+
+File format: doc/design/BinaryLog_Format.md
+Argument encoding: doc/design/ArgEncoding_Format.md
+
+Usage:
+    ./decode_binary_log.py <file.lapb> [file.lapb.1 ...] [-o output.log] [--utc] [--no-tid]
+
+Example:
+    ./decode_binary_log.py /var/log/lightap.lapb.1 /var/log/lightap.lapb > lightap.log
+"""
+
+import sys
+import struct
+import argparse
+import datetime
+
+MAGIC = b'LAPB'
+SUPPORTED_VERSION = 2
+
+KIND_CONTEXT = 0
+KIND_TEXT = 1
+KIND_ARGS = 2
+KIND_MODELED = 3
+KIND_TEMPLATE = 4
+KIND_TEMPLATED = 4      # Added to Text/Args/Modeled: stored as template and values
+RECORD_HAS_TID = 0x80
+
+LEVEL_NAMES = {1: 'FATAL', 2: 'ERROR', 3: 'WARN ', 4: 'INFO ', 5: 'DEBUG', 6: 'VERB '}
+LOG_LEVEL_TEXT = {0: 'Off', 1: 'Fatal', 2: 'Error', 3: 'Warn', 4: 'Info', 5: 'Debug', 6: 'Verbose'}
+
+# ArgEncoding tag bits and types
+ARG_NAMED = 0x80
+ARG_GROUPED = 0x40
+ARG_TYPE_MASK = 0x3F
+
+T_BOOL = 0x01
+T_UINT = {0x02: 'B', 0x03: 'H', 0x04: 'I', 0x05: 'Q'}
+T_INT = {0x06: 'b', 0x07: 'h', 0x08: 'i', 0x09: 'q'}
+T_FLOAT = 0x0A
+T_DOUBLE = 0x0B
+T_HEX = {0x0C: 1, 0x0D: 2, 0x0E: 4, 0x0F: 8}
+T_BIN = {0x10: 1, 0x11: 2, 0x12: 4, 0x13: 8}
+T_STRING = 0x14
+T_LOGLEVEL = 0x15
+T_ERRORCODE = 0x16
+
+FLOAT_FIXED = 0
+FLOAT_SCIENTIFIC = 1
+FLOAT_SHORTEST = 2
+
+
+class FormatError(Exception):
+    pass
+
+
+class Header:
+    """32 byte file header"""
+
+    def __init__(self, data):
+        if len(data) < 32 or data[0:4] != MAGIC:
+            raise FormatError('not a LightAP binary log (bad magic)')
+        self.version = data[4]
+        if self.version != SUPPORTED_VERSION:
+            raise FormatError(f'unsupported format version {self.version}')
+        if data[5] not in (1, 2):
+            raise FormatError(f'bad byte order marker {data[5]}')
+        self.endian = '<' if data[5] == 1 else '>'
+        self.header_size = struct.unpack_from(self.endian + 'H', data, 6)[0]
+        self.app_id = data[8:12].rstrip(b'\0').decode('utf-8', 'replace')
+        self.ts_digits = data[12] if data[12] in (3, 6, 9) else 3
+        self.time_unit = 10 ** (9 - self.ts_digits)     # Nanoseconds per timestamp tick
+        self.float_format = data[13]
+        self.float_precision = data[14]
+        self.double_precision = data[15]
+        self.base_timestamp = struct.unpack_from(self.endian + 'Q', data, 16)[0]
+        self.utc_offset = struct.unpack_from(self.endian + 'i', data, 24)[0]
+
+
+def read_varint(data, pos, end):
+    """LEB128, returns (value, new_pos)"""
+    value = 0
+    shift = 0
+    while True:
+        if pos >= end or shift > 63:
+            raise FormatError('truncated varint')
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if byte < 0x80:
+            return value, pos
+        shift += 7
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def format_timestamp(ns, header, utc):
+    """Same text as TimestampFormat::formatDateTime (fraction truncated)"""
+    seconds, fraction = divmod(ns, 1000000000)
+    offset = 0 if utc else header.utc_offset
+    dt = datetime.datetime(1970, 1, 1) + datetime.timedelta(seconds=seconds + offset)
+    digits = header.ts_digits
+    return dt.strftime('%Y-%m-%d %H:%M:%S') + '.' + f'{fraction:09d}'[:digits]
+
+
+def shortest_float32(value):
+    """Shortest decimal that reads back as the same binary32 value"""
+    for precision in range(1, 10):
+        text = f'{value:.{precision}g}'
+        if struct.unpack('<f', struct.pack('<f', float(text)))[0] == value:
+            return text
+    return f'{value:.9g}'
+
+
+def format_real(value, is_float, header):
+    precision = header.float_precision if is_float else header.double_precision
+    if header.float_format == FLOAT_SCIENTIFIC:
+        return f'{value:.{precision}e}'
+    if header.float_format == FLOAT_SHORTEST:
+        return shortest_float32(value) if is_float else repr(value)
+    return f'{value:.{precision}f}'
+
+
+def group_bits(text):
+    """0b10100101 -> 0b1010_0101"""
+    bits = text[2:]
+    return '0b' + '_'.join(bits[i:i + 4] for i in range(0, len(bits), 4))
+
+
+def decode_args(payload, header):
+    """
+    Decode an ArgEncoding payload into [(name, type, rendered_value)].
+    Stops at the first malformed argument like ArgDecoder::next().
+    """
+    e = header.endian
+    args = []
+    pos = 0
+    end = len(payload)
+    while pos < end:
+        tag = payload[pos]
+        pos += 1
+        arg_type = tag & ARG_TYPE_MASK
+        name = ''
+        if tag & ARG_NAMED:
+            if pos >= end or pos + 1 + payload[pos] > end:
+                break
+            name_len = payload[pos]
+            name = payload[pos + 1:pos + 1 + name_len].decode('utf-8', 'replace')
+            pos += 1 + name_len
+
+        if arg_type in (T_STRING, T_ERRORCODE):
+            code = None
+            if arg_type == T_ERRORCODE:
+                if pos + 10 > end:
+                    break
+                code = struct.unpack_from(e + 'q', payload, pos)[0]
+                pos += 8
+            if pos + 2 > end:
+                break
+            length = struct.unpack_from(e + 'H', payload, pos)[0]
+            pos += 2
+            if pos + length > end:
+                break
+            text = payload[pos:pos + length].decode('utf-8', 'replace')
+            pos += length
+            args.append((name, arg_type, text if code is None else f'{text}:{code}'))
+            continue
+
+        if arg_type == T_BOOL or arg_type == T_LOGLEVEL:
+            size = 1
+        elif arg_type in T_UINT:
+            size = struct.calcsize(T_UINT[arg_type])
+        elif arg_type in T_INT:
+            size = struct.calcsize(T_INT[arg_type])
+        elif arg_type == T_FLOAT:
+            size = 4
+        elif arg_type == T_DOUBLE:
+            size = 8
+        elif arg_type in T_HEX:
+            size = T_HEX[arg_type]
+        elif arg_type in T_BIN:
+            size = T_BIN[arg_type]
+        else:
+            break
+        if pos + size > end:
+            break
+        raw = payload[pos:pos + size]
+        pos += size
+
+        if arg_type == T_BOOL:
+            text = '1' if raw[0] else '0'
+        elif arg_type == T_LOGLEVEL:
+            text = LOG_LEVEL_TEXT.get(raw[0], 'Unknow')
+        elif arg_type in T_UINT:
+            text = str(struct.unpack(e + T_UINT[arg_type], raw)[0])
+        elif arg_type in T_INT:
+            text = str(struct.unpack(e + T_INT[arg_type], raw)[0])
+        elif arg_type == T_FLOAT:
+            text = format_real(struct.unpack(e + 'f', raw)[0], True, header)
+        elif arg_type == T_DOUBLE:
+            text = format_real(struct.unpack(e + 'd', raw)[0], False, header)
+        else:
+            value = int.from_bytes(raw, 'little' if e == '<' else 'big')
+            if arg_type in T_HEX:
+                text = '0x' + f'{value:0{size * 2}X}'
+            else:
+                text = '0b' + f'{value:0{size * 8}b}'
+                if tag & ARG_GROUPED:
+                    text = group_bits(text)
+        args.append((name, arg_type, text))
+    return args
+
+
+def expand_text(template, data, pos, end):
+    """Text template: every 0x00 is a number stored as varint"""
+    parts = []
+    for byte in template:
+        if byte == 0:
+            value, pos = read_varint(data, pos, end)
+            parts.append(str(value).encode())
+        else:
+            parts.append(bytes((byte,)))
+    return b''.join(parts)
+
+
+def expand_args(template, data, pos, end, header):
+    """
+    Argument template: tags, names and strings; integers are (zigzag) varints in
+    the record, other fixed size values raw bytes. Returns the ArgEncoding payload.
+    """
+    e = header.endian
+    out = bytearray()
+    i = 0
+    while i < len(template):
+        tag = template[i]
+        start = i
+        i += 1
+        if tag & ARG_NAMED:
+            i += 1 + template[i]
+        out += template[start:i]
+        arg_type = tag & ARG_TYPE_MASK
+        if arg_type in (T_STRING, T_ERRORCODE):
+            if arg_type == T_ERRORCODE:
+                value, pos = read_varint(data, pos, end)
+                out += struct.pack(e + 'q', unzigzag(value))
+            length = struct.unpack_from(e + 'H', template, i)[0]
+            out += template[i:i + 2 + length]
+            i += 2 + length
+        elif arg_type in T_UINT:
+            value, pos = read_varint(data, pos, end)
+            out += struct.pack(e + T_UINT[arg_type], value)
+        elif arg_type in T_INT:
+            value, pos = read_varint(data, pos, end)
+            out += struct.pack(e + T_INT[arg_type], unzigzag(value))
+        else:
+            if arg_type in (T_BOOL, T_LOGLEVEL):
+                size = 1
+            elif arg_type == T_FLOAT:
+                size = 4
+            elif arg_type == T_DOUBLE:
+                size = 8
+            else:
+                size = T_HEX.get(arg_type) or T_BIN[arg_type]
+            out += data[pos:pos + size]
+            pos += size
+    return bytes(out)
+
+
+def quote_if_needed(text):
+    """ModeledRecord::getText() quotes strings containing ',' or '"'"""
+    if ',' in text or '"' in text:
+        return '"' + text.replace('"', '\\"') + '"'
+    return text
+
+
+def render_modeled(message_id, args):
+    """"[MsgId:NNNN] name=value, name=value", as ModeledRecord::getText()"""
+    parts = []
+    for name, arg_type, text in args:
+        if arg_type == T_STRING:
+            text = quote_if_needed(text)
+        parts.append(f'{name}={text}' if name else text)
+    return f'[MsgId:{message_id}]' + (' ' + ', '.join(parts) if parts else '')
+
+
+def decode_file(path, out, utc=False, show_tid=True):
+    """Decode one file, returns the number of records written"""
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    header = Header(data)
+    contexts = {}
+    templates = []
+    tick = header.base_timestamp // header.time_unit
+    pos = header.header_size
+    end = len(data)
+    count = 0
+
+    while pos < end:
+        length, body = read_varint(data, pos, end)
+        if length == 0:
+            break       # Zero-filled pre-allocated tail (file not closed cleanly)
+        if body + length > end:
+            print(f'{path}: truncated record at offset {pos}, stopping', file=sys.stderr)
+            break
+        pos = body + length
+
+        first = data[body]
+        kind = (first >> 4) & 0x07
+        level = first & 0x0F
+        p = body + 1
+
+        if kind == KIND_CONTEXT:
+            index, p = read_varint(data, p, pos)
+            contexts[index] = data[p:pos].decode('utf-8', 'replace')
+            continue
+        if kind == KIND_TEMPLATE:
+            index, p = read_varint(data, p, pos)
+            if index != len(templates):
+                raise FormatError(f'template {index} out of order at offset {body}')
+            templates.append(data[p:pos])
+            continue
+
+        delta, p = read_varint(data, p, pos)
+        tick += unzigzag(delta)
+        context_index, p = read_varint(data, p, pos)
+        thread_id = None
+        if first & RECORD_HAS_TID:
+            thread_id, p = read_varint(data, p, pos)
+
+        message_id = None
+        if kind in (KIND_MODELED, KIND_MODELED + KIND_TEMPLATED):
+            message_id, p = read_varint(data, p, pos)
+        if kind > KIND_TEMPLATE:
+            kind -= KIND_TEMPLATED
+            index, p = read_varint(data, p, pos)
+            if index >= len(templates):
+                raise FormatError(f'undefined template {index} at offset {body}')
+            if kind == KIND_TEXT:
+                payload = expand_text(templates[index], data, p, pos)
+            else:
+                payload = expand_args(templates[index], data, p, pos, header)
+        else:
+            payload = data[p:pos]
+
+        if kind == KIND_TEXT:
+            message = payload.decode('utf-8', 'replace')
+        elif kind == KIND_ARGS:
+            message = ''.join(text for _, _, text in decode_args(payload, header))
+        elif kind == KIND_MODELED:
+            message = render_modeled(message_id, decode_args(payload, header))
+        else:
+            print(f'{path}: unknown record kind {kind} at offset {body}, skipped', file=sys.stderr)
+            continue
+
+        line = (f'[{format_timestamp(tick * header.time_unit, header, utc)}] [{header.app_id}] '
+                f'[{LEVEL_NAMES.get(level, "UNKNW")}] [{contexts.get(context_index, "????")}]')
+        if thread_id is not None and show_tid:
+            line += f' [tid:{thread_id}]'
+        out.write(f'{line} {message}\n')
+        count += 1
+
+    return count
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Convert LightAP binary log files to the FileSink text format')
+    parser.add_argument('files', nargs='+', help='Binary log files, decoded in the given order')
+    parser.add_argument('-o', '--output', help='Output text file (default: stdout)')
+    parser.add_argument('--utc', action='store_true', help='Print UTC instead of the writer\'s local time')
+    parser.add_argument('--no-tid', action='store_true', help='Omit "[tid:N]" even if recorded')
+    args = parser.parse_args()
+
+    out = open(args.output, 'w', encoding='utf-8') if args.output else sys.stdout
+    status = 0
+    try:
+        for path in args.files:
+            try:
+                decode_file(path, out, utc=args.utc, show_tid=not args.no_tid)
+            except (OSError, FormatError) as e:
+                print(f'{path}: {e}', file=sys.stderr)
+                status = 1
+    finally:
+        if out is not sys.stdout:
+            out.close()
+    return status
+
+
+if __name__ == '__main__':
+    sys.exit(main())
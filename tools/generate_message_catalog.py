@@ -25,13 +25,17 @@ def extract_message_ids(file_path):
     
     Looks for patterns like:
         struct StartupMessage : MessageId<1000> {};
+        struct OverTempMessage : MessageId<1001, LogLevel::kWarn> {};
     
-    Returns list of (name, id, line_number) tuples
+    Returns list of message dicts (name, id, severity, line, file, description)
     """
     messages = []
     
-    # Pattern: struct NAME : MessageId<ID> {};
-    pattern = re.compile(r'struct\s+(\w+)\s*:\s*MessageId<(\d+)>\s*\{', re.MULTILINE)
+    # Pattern: struct NAME : MessageId<ID> {};  or  MessageId<ID, LogLevel::kLevel>
+    pattern = re.compile(
+        r'struct\s+(\w+)\s*:\s*(?:public\s+)?(?:[\w:]*::)?MessageId\s*<\s*(\d+)\s*'
+        r'(?:,\s*(?:[\w:]*::)?LogLevel::k(\w+)\s*)?>\s*\{',
+        re.MULTILINE)
     
     # Pattern for documentation comments
     doc_pattern = re.compile(r'/\*\*\s*(.*?)\s*\*/', re.DOTALL)
@@ -44,6 +48,7 @@ def extract_message_ids(file_path):
             for match in pattern.finditer(content):
                 name = match.group(1)
                 msg_id = match.group(2)
+                severity = (match.group(3) or 'Info').upper()
                 line_num = content[:match.start()].count('\n') + 1
                 
                 # Try to find documentation comment before this line
@@ -58,6 +63,7 @@ def extract_message_ids(file_path):
                 messages.append({
                     'name': name,
                     'id': msg_id,
+                    'severity': severity,
                     'line': line_num,
                     'file': str(file_path),
                     'description': doc
@@ -103,16 +109,18 @@ def extract_trace_switch_config(file_path):
     Extract TraceSwitch specializations to determine routing configuration.
     
     Looks for patterns like:
-        template<>
-        struct TraceSwitch<StartupMessage> {
-            static constexpr TraceRoute route = TraceRoute::Both;
+        template <>
+        struct lap::log::TraceSwitch< myapp::StartupMessage > {
+            static constexpr TraceRoute route = TraceRoute::kBoth;
         };
+
+    Routes are reported without the 'k' prefix (None, Logger, Arti, Both).
     """
     routing = {}
     
     pattern = re.compile(
-        r'template<>\s*struct\s+TraceSwitch<(\w+)>\s*\{[^}]*'
-        r'TraceRoute\s+route\s*=\s*TraceRoute::(\w+)',
+        r'template\s*<\s*>\s*struct\s+(?:[\w:]*::)?TraceSwitch\s*<\s*(?:[\w:]*::)?(\w+)\s*>\s*\{[^}]*'
+        r'TraceRoute\s+route\s*=\s*(?:[\w:]*::)?TraceRoute::(\w+)',
         re.MULTILINE | re.DOTALL
     )
     
@@ -121,7 +129,7 @@ def extract_trace_switch_config(file_path):
             content = f.read()
             for match in pattern.finditer(content):
                 msg_name = match.group(1)
-                route = match.group(2)
+                route = re.sub(r'^k(?=[A-Z])', '', match.group(2))
                 routing[msg_name] = route
     except Exception as e:
         print(f"Warning: Failed to parse {file_path}: {e}", file=sys.stderr)
@@ -175,6 +183,7 @@ def generate_catalog(messages, routing, output_file):
         catalog["messages"][msg_id] = {
             "id": int(msg_id),
             "name": msg_name,
+            "severity": msg_info.get('severity', 'INFO'),
             "description": msg_info.get('description', ''),
             "routing": routing.get(msg_name, 'Logger'),  # Default: Logger
             "source": {
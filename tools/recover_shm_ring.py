@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+"""
+Flight Recorder Recovery for LightAP ShmRingSink
+
+Reads a shared memory ring left behind by a process (normally after a crash,
+or with "keepOnExit": true) and prints the records it still holds in the
+FileSink text format, oldest first:
+
+    [YYYY-MM-DD HH:MM:SS.mmm] [APPID] [LEVEL] [CONTEXT] [tid:N] message
+
+Records torn by the crash or overwritten while being read are skipped; the
+scan resynchronizes on the next committed record.
+
+Ring layout: doc/design/ShmRing_Format.md
+
+Usage:
+    ./recover_shm_ring.py <ring file> [-o output.log] [--last-mb N] [--utc] [--no-tid] [--copy saved.ring]
+
+Example:
+    ./recover_shm_ring.py /dev/shm/lightap-APP1-4242.ring --last-mb 1 > crash.log
+"""
+
+import os
+import sys
+import struct
+import argparse
+import shutil
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent))
+from decode_binary_log import (FormatError, LEVEL_NAMES, KIND_TEXT, KIND_ARGS, KIND_MODELED,  # noqa: E402
+                               decode_args, render_modeled, format_timestamp)
+
+MAGIC = b'LAPR'
+SUPPORTED_VERSION = 1
+HEAD_OFFSET = 64
+RECORD_HEADER_SIZE = 32
+RECORD_ALIGN = 8
+RECORD_HAS_TID = 0x01
+
+
+class RingHeader:
+    """128 byte ring header, attribute names shared with decode_binary_log.Header"""
+
+    def __init__(self, data):
+        if len(data) < 128 or data[0:4] != MAGIC:
+            raise FormatError('not a LightAP shared memory ring (bad magic)')
+        self.version = data[4]
+        if self.version != SUPPORTED_VERSION:
+            raise FormatError(f'unsupported ring version {self.version}')
+        if data[5] not in (1, 2):
+            raise FormatError(f'bad byte order marker {data[5]}')
+        e = '<' if data[5] == 1 else '>'
+        self.endian = e
+        self.header_size = struct.unpack_from(e + 'H', data, 6)[0]
+        self.capacity = struct.unpack_from(e + 'Q', data, 8)[0]
+        self.pid = struct.unpack_from(e + 'I', data, 16)[0]
+        self.app_id = data[20:24].rstrip(b'\0').decode('utf-8', 'replace')
+        self.created = struct.unpack_from(e + 'Q', data, 24)[0]
+        self.ts_digits = data[32] if data[32] in (3, 6, 9) else 3
+        self.float_format = data[33]
+        self.float_precision = data[34]
+        self.double_precision = data[35]
+        self.utc_offset = struct.unpack_from(e + 'i', data, 36)[0]
+        self.head = struct.unpack_from(e + 'Q', data, HEAD_OFFSET)[0]
+        if self.capacity == 0 or self.capacity & (self.capacity - 1):
+            raise FormatError(f'bad ring capacity {self.capacity}')
+        if len(data) < self.header_size + self.capacity:
+            raise FormatError('ring file shorter than its capacity')
+
+
+def commit_tag(pos):
+    """ShmRingSink::commitTag()"""
+    return ~(pos // RECORD_ALIGN) & 0xFFFFFFFF
+
+
+class Ring:
+    def __init__(self, data, header):
+        self.data = data
+        self.header = header
+        self.base = header.header_size
+        self.mask = header.capacity - 1
+
+    def read(self, pos, length):
+        """length bytes at ring stream position pos, wrapping at the end"""
+        offset = pos & self.mask
+        first = min(length, self.header.capacity - offset)
+        chunk = self.data[self.base + offset:self.base + offset + first]
+        if first < length:
+            chunk += self.data[self.base:self.base + length - first]
+        return chunk
+
+    def record_at(self, pos, end):
+        """Decoded record committed at pos, or None"""
+        e = self.header.endian
+        size, commit = struct.unpack(e + 'II', self.read(pos, 8))
+        if commit != commit_tag(pos):
+            return None
+        if size < RECORD_HEADER_SIZE or size > self.header.capacity // 4 or pos + size > end:
+            return None
+        raw = self.read(pos, size)
+        timestamp, thread_id, message_id = struct.unpack_from(e + 'QII', raw, 8)
+        level, kind, context_len, flags = raw[24], raw[25], raw[26], raw[27]
+        if kind not in (KIND_TEXT, KIND_ARGS, KIND_MODELED) or RECORD_HEADER_SIZE + context_len > size:
+            return None
+        context = raw[RECORD_HEADER_SIZE:RECORD_HEADER_SIZE + context_len].decode('utf-8', 'replace')
+        payload = raw[RECORD_HEADER_SIZE + context_len:size]
+        return {
+            'size': size, 'timestamp': timestamp, 'thread_id': thread_id, 'message_id': message_id,
+            'level': level, 'kind': kind, 'context': context, 'payload': payload,
+            'has_tid': bool(flags & RECORD_HAS_TID),
+        }
+
+
+def aligned(size):
+    return (size + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1)
+
+
+def scan(ring, window):
+    """(records, skipped_bytes) of the committed records in the last window bytes, oldest first"""
+    head = ring.header.head
+    start = max(0, head - min(window, ring.header.capacity))
+    pos = start - start % RECORD_ALIGN
+    if pos < start:
+        pos += RECORD_ALIGN
+    records = []
+    skipped = 0
+    while pos + RECORD_HEADER_SIZE <= head:
+        record = ring.record_at(pos, head)
+        if record is None:
+            # Torn, uncommitted or overwritten: resynchronize on the next aligned position
+            pos += RECORD_ALIGN
+            skipped += RECORD_ALIGN
+            continue
+        records.append(record)
+        pos += aligned(record['size'])
+    return records, skipped
+
+
+def render(record, header, utc, show_tid):
+    kind = record['kind']
+    if kind == KIND_TEXT:
+        message = record['payload'].decode('utf-8', 'replace')
+    elif kind == KIND_ARGS:
+        message = ''.join(text for _, _, text in decode_args(record['payload'], header))
+    else:
+        message = render_modeled(record['message_id'], decode_args(record['payload'], header))
+    line = (f'[{format_timestamp(record["timestamp"], header, utc)}] [{header.app_id}] '
+            f'[{LEVEL_NAMES.get(record["level"], "UNKNW")}] [{record["context"]}]')
+    if record['has_tid'] and show_tid:
+        line += f' [tid:{record["thread_id"]}]'
+    return f'{line} {message}\n'
+
+
+def process_alive(pid):
+    try:
+        os.kill(pid, 0)
+        return True
+    except ProcessLookupError:
+        return False
+    except PermissionError:
+        return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Recover the records of a LightAP shared memory ring')
+    parser.add_argument('ring', help='Ring file, e.g. /dev/shm/lightap-APP1-4242.ring')
+    parser.add_argument('-o', '--output', help='Output text file (default: stdout)')
+    parser.add_argument('--last-mb', type=float, help='Only the most recent N MiB of the ring')
+    parser.add_argument('--utc', action='store_true', help='Print UTC instead of the writer\'s local time')
+    parser.add_argument('--no-tid', action='store_true', help='Omit "[tid:N]" even if requested by the writer')
+    parser.add_argument('--copy', help='Save a raw copy of the ring file first (/dev/shm does not survive a reboot)')
+    args = parser.parse_args()
+
+    try:
+        if args.copy:
+            shutil.copyfile(args.ring, args.copy)
+        with open(args.ring, 'rb') as f:
+            data = f.read()
+        header = RingHeader(data)
+    except (OSError, FormatError) as e:
+        print(f'{args.ring}: {e}', file=sys.stderr)
+        return 1
+
+    window = int(args.last_mb * 1024 * 1024) if args.last_mb else header.capacity
+    records, skipped = scan(Ring(data, header), window)
+
+    state = 'running' if process_alive(header.pid) else 'not running'
+    print(f'{args.ring}: pid {header.pid} ({state}), {header.capacity} byte ring, '
+          f'{header.head} bytes written, {len(records)} records recovered, {skipped} bytes skipped',
+          file=sys.stderr)
+
+    out = open(args.output, 'w', encoding='utf-8') if args.output else sys.stdout
+    try:
+        for record in records:
+            out.write(render(record, header, args.utc, not args.no_tid))
+    finally:
+        if out is not sys.stdout:
+            out.close()
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())